@@ -1,6 +1,7 @@
 #include "block.h"
 #include "page.h"
 #include "dtta.h"
+#include "timestamp.h"
 #include <string.h>
 
 /**
@@ -62,10 +63,28 @@ zc_internal_result_t zc_acquire_block_for_writing(zc_block_header_t* block,
         {
             block->lut_offset = ZC_BLOCK_HEADER_SIZE + acquire_size;
             block->cover_page_count = need_page_count;
+            // 页链在切分处断开，避免沿页尾走进新块
+            (next_header_page - 1)->tail.next_page_addr = 0;
         }
     }
 
-    // 省略时间戳
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 时间戳在提交时而非获取时盖上，同一写入者的块按提交顺序得到递增的时间戳
+ * 
+ */
+zc_internal_result_t zc_commit_block_for_writing(zc_block_header_t* block,
+    zc_writer_id_t writer_id)
+{
+    // 假设传入的参数都是有效的
+
+    if (block->state != ZC_BLOCK_STATE_FREE || block->writer_id != writer_id || !block->writer_ref[writer_id])
+        return ZC_INTERNAL_BLOCK_UNEXPECTED;
+
+    block->timestamp = zc_timestamp();
+    atomic_store_explicit(&block->state, ZC_BLOCK_STATE_USING, memory_order_release);
 
     return ZC_INTERNAL_OK;
 }
@@ -158,12 +177,19 @@ zc_internal_result_t zc_block_create(void* block_start_ptr,
     block->state = ZC_BLOCK_STATE_FREE;
     block->cover_page_count = page_count;
     block->lut_offset = ZC_BLOCK_HEADER_SIZE + userdate_size;
+    block->retire_epoch = 0;
 
     memset(block->writer_ref, 0, ZC_MAX_WRITERS + ZC_MAX_READERS_PER * 2);
 
-    zc_dtt_lut_header_t* lut_header = (zc_dtt_lut_header_t*)(block->lut_offset);
-    lut_header->entry_count = 0;
-    lut_header->lut_first_entry_offset = zc_block_ptr_to_offset(block, lut_header + 1);
+    // 块页在创建时连续，填好页缓存与页链后 zc_block_offset_to_ptr 才可用
+    for (i = 0; i < ZC_BLOCK_MAX_CACHED_PAGES; i++) block->page_cache[i] = i < page_count ? start_page + i : NULL;
+    for (i = 0; i < page_count; i++)
+    {
+        (start_page + i)->header.prev_page_addr = i > 0 ? (uint64_t)(uintptr_t)(start_page + i - 1) : 0;
+        (start_page + i)->tail.next_page_addr = i + 1 < page_count ? (uint64_t)(uintptr_t)(start_page + i + 1) : 0;
+    }
+
+    if (unlikely(zc_dtt_init(block) != ZC_INTERNAL_OK)) return ZC_INTERNAL_BLOCK_ERROR;
 
     // 后续应改为 CAS
     start_page->header.state = ZC_PAGE_STATE_AS_HEAD;
@@ -197,8 +223,10 @@ zc_internal_result_t zc_block_delete(zc_block_header_t* block,
     return ZC_INTERNAL_OK;
 }
 
-// 已检查，未测试
-inline void* zc_block_offset_to_ptr(zc_block_header_t* block, uint64_t offset)
+/**
+ * 前 ZC_BLOCK_MAX_CACHED_PAGES 页经页缓存直达，其后沿页尾链接逐页前进
+ */
+void* zc_block_offset_to_ptr(zc_block_header_t* block, uint64_t offset)
 {
     if (unlikely(offset >= block->cover_page_count * ZC_PAGE_DATA_SIZE))
     {
@@ -217,11 +245,34 @@ inline void* zc_block_offset_to_ptr(zc_block_header_t* block, uint64_t offset)
         page = block->page_cache[ZC_BLOCK_MAX_CACHED_PAGES - 1];
         for (uint64_t i = ZC_BLOCK_MAX_CACHED_PAGES - 1; i < page_idx && page; i++)
         {
-            page = page->tail.next_page_addr;
+            page = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
         }
     }
 
     if (!page) return NULL;
     uint64_t in_page = offset % ZC_PAGE_DATA_SIZE;
     return (char*)page + ZC_PAGE_HEADER_SIZE + in_page;
-}
\ No newline at end of file
+}
+
+/**
+ * 与 zc_block_offset_to_ptr 同序遍历块页，ptr 不在块的数据区内时返回 UINT64_MAX
+ */
+uint64_t zc_block_ptr_to_offset(zc_block_header_t* block, void* ptr)
+{
+    const char* p = ptr;
+    zc_page_t* page = block->page_cache[0];
+
+    uint64_t page_idx;
+    for (page_idx = 0; page_idx < block->cover_page_count && page; page_idx++)
+    {
+        if (p >= page->data && p < page->data + ZC_PAGE_DATA_SIZE)
+        {
+            return page_idx * ZC_PAGE_DATA_SIZE + (uint64_t)(p - page->data);
+        }
+
+        if (page_idx + 1 < ZC_BLOCK_MAX_CACHED_PAGES) page = block->page_cache[page_idx + 1];
+        else page = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
+    }
+
+    return UINT64_MAX;
+}
@@ -24,19 +24,22 @@ typedef struct zc_block_header {
     _Atomic uint16_t  state;             // FREE=0, USING=1, CLEAN=2
     uint16_t          reserved_flags;    // 未来扩展位
     zc_writer_id_t    writer_id;         // 写入者 ID
-    zc_time_t         timestamp;         // 写入时间戳
+    zc_time_t         timestamp;         // 提交时间戳，由 zc_commit_block_for_writing 写入
     uint64_t          cover_page_count;  // 块跨越的页数量
     uint64_t          lut_offset;        // DTTA 查找表偏移量(从 header 首地址开始计算)
 
     // === 块页缓存 ===
     uint8_t    lut_disabled;
-    uint8_t    reserved_flags[7];
+    uint8_t    reserved_bytes[7];
     zc_page_t* page_cache[ZC_BLOCK_MAX_CACHED_PAGES]; // 块页缓存，用于快速访问前7页；如果块页数较多，在第8页补充一个小的mid_metadata_cache，在其中记录接下来的7个页，依此类推
 
     // === 并行引用位图===
     bool      writer_ref[ZC_MAX_WRITERS];         // 写入者实时引用
     bool      reader_ref[ZC_MAX_READERS_PER];     // 读取者实时引用
     bool      reader_visited[ZC_MAX_READERS_PER]; // 读取者访问历史
+
+    // === 纪元回收 ===
+    _Atomic uint64_t  retire_epoch;      // 清理者退役该块时的全局纪元，0 表示未退役
 } zc_block_header_t;
 
 typedef enum zc_block_state {
@@ -51,6 +54,21 @@ zc_internal_result_t zc_acquire_block_for_writing(
     zc_writer_id_t writer_id
 );
 
+/**
+ * @brief 提交写入者已填好的块：盖上提交时间戳后把块置为 USING，对读取者可见。
+ *
+ * 读取者的访问水位线与清理者的回收判断都以 timestamp 为准，必须在提交时取得；
+ * 否则先获取、后提交的块会带着早于已提交块的时间戳出现，被读取者的水位线误判为已访问。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_BLOCK_UNEXPECTED: 块不是 FREE，或不由该写入者持有。
+ */
+zc_internal_result_t zc_commit_block_for_writing(
+    zc_block_header_t* block,
+    zc_writer_id_t writer_id
+);
+
 zc_internal_result_t zc_acquire_block_for_reading(
     zc_block_header_t* block,
     zc_reader_id_t reader_id
@@ -73,13 +91,24 @@ zc_internal_result_t zc_block_delete(
     zc_time_t* timestamp
 );
 
-// 已检查，未测试
-inline void* zc_block_offset_to_ptr(
+/**
+ * @brief 块内偏移换算为地址。偏移从块首（即首页数据区）起算，按页数据区连续编号。
+ * @param block 块头，page_cache 与页尾链接须已由 zc_block_create 填好
+ * @param offset 块内偏移
+ * @return 对应地址；越界或页链断开时返回 NULL
+ */
+void* zc_block_offset_to_ptr(
     zc_block_header_t* block,
     uint64_t offset
 );
 
-inline uint64_t zc_block_ptr_to_offset(
+/**
+ * @brief 地址换算为块内偏移，为 zc_block_offset_to_ptr 的逆操作。
+ * @param block 块头
+ * @param ptr 块内某页数据区中的地址
+ * @return 块内偏移；ptr 不属于该块时返回 UINT64_MAX
+ */
+uint64_t zc_block_ptr_to_offset(
     zc_block_header_t* block,
     void* ptr
 );
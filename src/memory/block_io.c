@@ -0,0 +1,284 @@
+#include "block_io.h"
+#include <string.h>
+#include "simd.h"
+
+#if ZC_SIMD_X86
+#include <emmintrin.h>
+#endif
+
+/**
+ * 块内按页前进的游标。next 在进入一页时求出，既用于预取也用于翻页
+ */
+typedef struct zc_block_cursor {
+    zc_block_header_t* block;
+    uint64_t           offset;    // 当前位置（相对于块首）
+    uint8_t*           data;      // 当前位置的地址
+    uint64_t           avail;     // 当前页剩余字节
+    uint8_t*           next;      // 下一页数据区首地址，可能为 NULL
+} zc_block_cursor_t;
+
+/**
+ * 下一页数据区首地址。优先沿页尾链接，未链接时按偏移查找
+ */
+static inline uint8_t* zc_block_next_page(zc_block_header_t* block, uint8_t* page_data, uint64_t next_offset)
+{
+    zc_page_t* page = (zc_page_t*)(page_data - ZC_PAGE_HEADER_SIZE);
+    zc_page_t* next = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
+    if (next) return (uint8_t*)next->data;
+    return zc_block_offset_to_ptr(block, next_offset);
+}
+
+static inline void zc_block_prefetch(const uint8_t* data, bool for_write)
+{
+    if (!data) return;
+
+    uint32_t i;
+    for (i = 0; i < ZC_BLOCK_PREFETCH_LINES; i++)
+    {
+        if (for_write) __builtin_prefetch(data + i * ZC_HW_CACHE_LINE_SIZE, 1, 3);
+        else __builtin_prefetch(data + i * ZC_HW_CACHE_LINE_SIZE, 0, 3);
+    }
+}
+
+/**
+ * 定位到 offset 所在页，并求出下一页
+ */
+static zc_internal_result_t zc_block_cursor_init(zc_block_cursor_t* cur, zc_block_header_t* block,
+    uint64_t offset, bool for_write)
+{
+    uint8_t* data = zc_block_offset_to_ptr(block, offset);
+    if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    uint64_t in_page = offset % ZC_PAGE_DATA_SIZE;
+    cur->block = block;
+    cur->offset = offset;
+    cur->data = data;
+    cur->avail = ZC_PAGE_DATA_SIZE - in_page;
+    cur->next = NULL;
+    if (offset + cur->avail < block->cover_page_count * ZC_PAGE_DATA_SIZE)
+    {
+        cur->next = zc_block_next_page(block, data - in_page, offset + cur->avail);
+        zc_block_prefetch(cur->next, for_write);
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 前进 n 字节（不超过 avail），用完本页时翻到下一页
+ */
+static zc_internal_result_t zc_block_cursor_advance(zc_block_cursor_t* cur, uint64_t n, bool more, bool for_write)
+{
+    cur->offset += n;
+    cur->data += n;
+    cur->avail -= n;
+    if (cur->avail != 0 || !more) return ZC_INTERNAL_OK;
+
+    uint8_t* data = cur->next;
+    if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    cur->data = data;
+    cur->avail = ZC_PAGE_DATA_SIZE;
+    cur->next = NULL;
+    if (cur->offset + ZC_PAGE_DATA_SIZE < cur->block->cover_page_count * ZC_PAGE_DATA_SIZE)
+    {
+        cur->next = zc_block_next_page(cur->block, data, cur->offset + ZC_PAGE_DATA_SIZE);
+        zc_block_prefetch(cur->next, for_write);
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 非临时存储拷贝，目标按 16 字节对齐后整段流式写出，首尾零头用普通拷贝
+ */
+static void zc_block_stream_copy(uint8_t* dst, const uint8_t* src, uint64_t n)
+{
+#if ZC_SIMD_X86
+    uint64_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if (head > n) head = n;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    n -= head;
+
+    for (; n >= 64; n -= 64, dst += 64, src += 64)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)src);
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*)(src + 48));
+        _mm_stream_si128((__m128i*)dst, a);
+        _mm_stream_si128((__m128i*)(dst + 16), b);
+        _mm_stream_si128((__m128i*)(dst + 32), c);
+        _mm_stream_si128((__m128i*)(dst + 48), d);
+    }
+    for (; n >= 16; n -= 16, dst += 16, src += 16)
+    {
+        _mm_stream_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+    }
+#endif
+    memcpy(dst, src, n);
+}
+
+static inline void zc_block_stream_fence(void)
+{
+#if ZC_SIMD_X86
+    _mm_sfence();
+#endif
+}
+
+static inline bool zc_block_range_valid(zc_block_header_t* block, uint64_t offset, uint64_t length)
+{
+    uint64_t end = block->cover_page_count * ZC_PAGE_DATA_SIZE;
+    return offset <= end && length <= end - offset;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_block_read(zc_block_header_t* block, uint64_t offset, void* dst, uint64_t length)
+{
+    if (length == 0) return ZC_INTERNAL_OK;
+    if (unlikely(!dst)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(!zc_block_range_valid(block, offset, length))) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+    zc_block_cursor_t cur;
+    zc_internal_result_t res = zc_block_cursor_init(&cur, block, offset, false);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    uint8_t* out = dst;
+    while (length != 0)
+    {
+        uint64_t n = cur.avail < length ? cur.avail : length;
+        memcpy(out, cur.data, n);
+        out += n;
+        length -= n;
+
+        res = zc_block_cursor_advance(&cur, n, length != 0, false);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_block_write(zc_block_header_t* block, uint64_t offset, const void* src, uint64_t length)
+{
+    if (length == 0) return ZC_INTERNAL_OK;
+    if (unlikely(!src)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(!zc_block_range_valid(block, offset, length))) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+    bool stream = length >= ZC_BLOCK_STREAM_THRESHOLD;
+    zc_block_cursor_t cur;
+    zc_internal_result_t res = zc_block_cursor_init(&cur, block, offset, !stream);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    const uint8_t* in = src;
+    while (length != 0)
+    {
+        uint64_t n = cur.avail < length ? cur.avail : length;
+        if (stream) zc_block_stream_copy(cur.data, in, n);
+        else memcpy(cur.data, in, n);
+        in += n;
+        length -= n;
+
+        res = zc_block_cursor_advance(&cur, n, length != 0, !stream);
+        if (unlikely(res != ZC_INTERNAL_OK)) break;
+    }
+
+    if (stream) zc_block_stream_fence();
+    return res;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_block_copy(zc_block_header_t* block, uint64_t dst_offset, uint64_t src_offset,
+    uint64_t length)
+{
+    if (length == 0) return ZC_INTERNAL_OK;
+    if (unlikely(!zc_block_range_valid(block, dst_offset, length) || !zc_block_range_valid(block, src_offset, length)))
+    {
+        return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+    }
+    if (unlikely(dst_offset < src_offset + length && src_offset < dst_offset + length)) return ZC_INTERNAL_PARAM_ERROR;
+
+    bool stream = length >= ZC_BLOCK_STREAM_THRESHOLD;
+    zc_block_cursor_t src;
+    zc_block_cursor_t dst;
+    zc_internal_result_t res = zc_block_cursor_init(&src, block, src_offset, false);
+    if (likely(res == ZC_INTERNAL_OK)) res = zc_block_cursor_init(&dst, block, dst_offset, !stream);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    while (length != 0)
+    {
+        uint64_t n = src.avail < dst.avail ? src.avail : dst.avail;
+        if (n > length) n = length;
+        if (stream) zc_block_stream_copy(dst.data, src.data, n);
+        else memcpy(dst.data, src.data, n);
+        length -= n;
+
+        res = zc_block_cursor_advance(&src, n, length != 0, false);
+        if (likely(res == ZC_INTERNAL_OK)) res = zc_block_cursor_advance(&dst, n, length != 0, !stream);
+        if (unlikely(res != ZC_INTERNAL_OK)) break;
+    }
+
+    if (stream) zc_block_stream_fence();
+    return res;
+}
+
+/**
+ * offset 之后第一个地址按 alignment 对齐的偏移。填充越过页尾时从下一页首重新计算，
+ * 页首的填充小于 alignment，第二次必然落在同一页内
+ */
+static zc_internal_result_t zc_block_align_up(zc_block_header_t* block, uint64_t offset, uint32_t alignment,
+    uint64_t* out_offset)
+{
+    uint32_t round;
+    for (round = 0; round < 2; round++)
+    {
+        uint64_t page_start = offset - offset % ZC_PAGE_DATA_SIZE;
+        uint8_t* base = zc_block_offset_to_ptr(block, page_start);
+        if (unlikely(!base)) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+        uintptr_t addr = (uintptr_t)base + (uintptr_t)(offset - page_start);
+        uint64_t aligned = offset + ((alignment - (addr & (alignment - 1))) & (alignment - 1));
+        if (aligned < page_start + ZC_PAGE_DATA_SIZE)
+        {
+            *out_offset = aligned;
+            return ZC_INTERNAL_OK;
+        }
+        offset = page_start + ZC_PAGE_DATA_SIZE;
+    }
+    return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_block_place(zc_block_header_t* block, uint64_t min_offset, uint64_t width,
+    uint32_t alignment, uint64_t* out_offset)
+{
+    if (unlikely(!out_offset)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (alignment == 0) alignment = 1;
+    if (unlikely((alignment & (alignment - 1)) != 0 || alignment > ZC_BLOCK_MAX_ALIGN)) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint64_t offset;
+    zc_internal_result_t res = zc_block_align_up(block, min_offset, alignment, &offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (width <= ZC_PAGE_DATA_SIZE && offset % ZC_PAGE_DATA_SIZE + width > ZC_PAGE_DATA_SIZE)
+    {
+        uint64_t next;
+        uint64_t next_page = offset - offset % ZC_PAGE_DATA_SIZE + ZC_PAGE_DATA_SIZE;
+        if (zc_block_align_up(block, next_page, alignment, &next) == ZC_INTERNAL_OK
+            && next % ZC_PAGE_DATA_SIZE + width <= ZC_PAGE_DATA_SIZE)
+        {
+            offset = next;
+        }
+    }
+
+    if (unlikely(!zc_block_range_valid(block, offset, width))) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+    *out_offset = offset;
+    return ZC_INTERNAL_OK;
+}
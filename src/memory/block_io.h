@@ -0,0 +1,126 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef BLOCK_IO_H
+#define BLOCK_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单次写入达到该字节数时改用非临时存储，绕过写入者自身的缓存
+#ifndef ZC_BLOCK_STREAM_THRESHOLD
+#define ZC_BLOCK_STREAM_THRESHOLD 32768
+#endif
+
+// zc_block_place 支持的最大对齐，须小于 ZC_PAGE_DATA_SIZE
+#ifndef ZC_BLOCK_MAX_ALIGN
+#define ZC_BLOCK_MAX_ALIGN 256
+#endif
+
+// 进入一页时预取下一页数据区的缓存行数
+#ifndef ZC_BLOCK_PREFETCH_LINES
+#define ZC_BLOCK_PREFETCH_LINES 8
+#endif
+
+/**
+ * @brief 把用户数据区 [offset, offset + length) 聚集拷贝到 dst。
+ *
+ * 按页分段拷贝，跳过页之间的页尾与页头；相邻页优先经 tail.next_page_addr 取得，
+ * 进入一页时预取下一页。
+ *
+ * @param block  [in] 已 acquire 的块头指针。
+ * @param offset [in] 起始偏移（相对于块首）。
+ * @param dst    [out] 目标缓冲，至少 length 字节。
+ * @param length [in] 字节数。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: length 非 0 而 dst 为空。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 区间超出块的页范围。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ */
+zc_internal_result_t zc_block_read(
+    zc_block_header_t* block,
+    uint64_t offset,
+    void* dst,
+    uint64_t length
+);
+
+/**
+ * @brief 把 src 的 length 字节分散写入用户数据区 [offset, offset + length)。
+ *
+ * length 不小于 ZC_BLOCK_STREAM_THRESHOLD 时使用非临时存储并在返回前 sfence，
+ * 数据直接写往内存而不占用写入者的缓存，适合只由其他核上的读取者访问的大帧。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: length 非 0 而 src 为空。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 区间超出块的页范围。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_block_write(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void* src,
+    uint64_t length
+);
+
+/**
+ * @brief 在块内把 [src_offset, src_offset + length) 拷贝到 [dst_offset, dst_offset + length)。
+ *
+ * 两端各自按页分段，非临时存储的规则同 zc_block_write。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: 两个区间重叠。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 区间超出块的页范围。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_block_copy(
+    zc_block_header_t* block,
+    uint64_t dst_offset,
+    uint64_t src_offset,
+    uint64_t length
+);
+
+/**
+ * @brief 为宽度为 width 的变量选择不小于 min_offset 的起始偏移，使其块内地址按 alignment 对齐。
+ *
+ * 页数据区从页首之后 ZC_PAGE_HEADER_SIZE 字节开始且页长不是对齐的倍数，因此按实际地址而非偏移求对齐，
+ * 每页所需的填充可能不同。width 不超过 ZC_PAGE_DATA_SIZE 而对齐后会跨页时，改放到下一页的首个对齐位置；
+ * 下一页也放不下（对齐填充过大）时仍取原位置。
+ *
+ * @param min_offset [in] 候选起点，通常为上一个变量的末尾。
+ * @param alignment  [in] 2 的幂，不超过 ZC_BLOCK_MAX_ALIGN；0 视为 1。
+ * @param out_offset [out] 选定的起始偏移，out_offset - min_offset 即所需填充。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out_offset 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: alignment 不是 2 的幂或过大。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 放置后超出块的页范围。
+ *
+ * @note 只计算偏移，不检查与已有变量的重叠，由随后的 zc_dtt_add 检查。
+ */
+zc_internal_result_t zc_block_place(
+    zc_block_header_t* block,
+    uint64_t min_offset,
+    uint64_t width,
+    uint32_t alignment,
+    uint64_t* out_offset
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_IO_H */
@@ -0,0 +1,146 @@
+#include "epoch.h"
+#include "timestamp.h"
+
+/**
+ *
+ */
+zc_internal_result_t zc_epoch_domain_init(zc_epoch_domain_t* domain)
+{
+    if (unlikely(domain == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    atomic_init(&domain->global_epoch, ZC_EPOCH_INITIAL);
+
+    uint32_t w, r;
+    for (w = 0; w < ZC_MAX_WRITERS; w++)
+    {
+        for (r = 0; r < ZC_MAX_READERS_PER; r++)
+        {
+            zc_epoch_slot_t* slot = &domain->slots[w][r];
+            atomic_init(&slot->epoch, ZC_EPOCH_QUIESCENT);
+            atomic_init(&slot->visited_ts, 0);
+            atomic_init(&slot->online, false);
+        }
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_epoch_reader_register(zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id)
+{
+    if ((uint32_t)(reader_id >> 32) >= ZC_MAX_WRITERS || (uint32_t)reader_id >= ZC_MAX_READERS_PER) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_epoch_slot_t* slot = zc_epoch_get_slot(domain, reader_id);
+    if (atomic_load_explicit(&slot->online, memory_order_relaxed)) return ZC_INTERNAL_PARAM_ERROR;
+
+    // 新读取者只消费注册之后提交的块：水位线从当前时间起算，
+    // 否则清理者与过期索引会一直等待它去读注册之前的块
+    atomic_store_explicit(&slot->epoch, ZC_EPOCH_QUIESCENT, memory_order_relaxed);
+    atomic_store_explicit(&slot->visited_ts, zc_timestamp(), memory_order_relaxed);
+    atomic_store_explicit(&slot->online, true, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_epoch_reader_unregister(zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id)
+{
+    if ((uint32_t)(reader_id >> 32) >= ZC_MAX_WRITERS || (uint32_t)reader_id >= ZC_MAX_READERS_PER) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_epoch_slot_t* slot = zc_epoch_get_slot(domain, reader_id);
+    atomic_store_explicit(&slot->epoch, ZC_EPOCH_QUIESCENT, memory_order_release);
+    atomic_store_explicit(&slot->online, false, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 先宣告纪元再检查块：清理者总是先写 retire_epoch 再推进全局纪元，
+ * 因此观察到新纪元的读取者一定能看到 retire_epoch，观察到旧纪元的读取者一定会被清理者等待。
+ */
+zc_internal_result_t zc_acquire_block_for_reading_epoch(zc_epoch_domain_t* domain,
+    zc_block_header_t* block, zc_reader_id_t reader_id)
+{
+    // 假设传入的参数都是有效的
+
+    zc_epoch_slot_t* slot = zc_epoch_get_slot(domain, reader_id);
+
+    uint64_t epoch = atomic_load_explicit(&domain->global_epoch, memory_order_relaxed);
+    atomic_store_explicit(&slot->epoch, epoch, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (block->state != ZC_BLOCK_STATE_USING || block->writer_id != (reader_id >> 32)) return ZC_INTERNAL_BLOCK_UNEXPECTED;
+    if (atomic_load_explicit(&block->retire_epoch, memory_order_acquire) != 0) return ZC_INTERNAL_BLOCK_UNEXPECTED;
+
+    zc_time_t timestamp = block->timestamp;
+    if (timestamp <= atomic_load_explicit(&slot->visited_ts, memory_order_relaxed)) return ZC_INTERNAL_BLOCK_UNEXPECTED;
+
+    atomic_store_explicit(&slot->visited_ts, timestamp, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_release_block_from_reading_epoch(zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id)
+{
+    zc_epoch_slot_t* slot = zc_epoch_get_slot(domain, reader_id);
+    atomic_store_explicit(&slot->epoch, ZC_EPOCH_QUIESCENT, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_acquire_block_for_cleaning_epoch(zc_epoch_domain_t* domain,
+    zc_block_header_t* block)
+{
+    // 假设传入的参数都是有效的
+
+    if (block->state != ZC_BLOCK_STATE_USING) return ZC_INTERNAL_BLOCK_UNEXPECTED;
+
+    uint32_t i;
+    for (i = 0; i < ZC_MAX_WRITERS; i++)
+    {
+        if (block->writer_ref[i]) return ZC_INTERNAL_BLOCK_UNRELEASED;
+    }
+
+    zc_epoch_slot_t* slots = domain->slots[block->writer_id];
+    uint64_t retire_epoch = atomic_load_explicit(&block->retire_epoch, memory_order_relaxed);
+
+    if (retire_epoch == 0)
+    {
+        // 所有在线读取者都已越过该块后才退役
+        for (i = 0; i < ZC_MAX_READERS_PER; i++)
+        {
+            if (!atomic_load_explicit(&slots[i].online, memory_order_acquire)) continue;
+            if (atomic_load_explicit(&slots[i].visited_ts, memory_order_acquire) < block->timestamp) return ZC_INTERNAL_BLOCK_UNRELEASED;
+        }
+
+        retire_epoch = atomic_load_explicit(&domain->global_epoch, memory_order_relaxed);
+        atomic_store_explicit(&block->retire_epoch, retire_epoch, memory_order_seq_cst);
+        atomic_fetch_add_explicit(&domain->global_epoch, 1, memory_order_seq_cst);
+        return ZC_INTERNAL_BLOCK_UNRELEASED;
+    }
+
+    // 宽限期：仍停留在退役纪元或更早纪元的读取者可能持有该块
+    for (i = 0; i < ZC_MAX_READERS_PER; i++)
+    {
+        uint64_t epoch = atomic_load_explicit(&slots[i].epoch, memory_order_seq_cst);
+        if (epoch != ZC_EPOCH_QUIESCENT && epoch <= retire_epoch) return ZC_INTERNAL_BLOCK_UNRELEASED;
+    }
+
+    block->state = ZC_BLOCK_STATE_CLEAN;
+    atomic_store_explicit(&block->retire_epoch, 0, memory_order_relaxed);
+
+    return ZC_INTERNAL_OK;
+}
@@ -0,0 +1,111 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZC_EPOCH_QUIESCENT 0   // 读取者不持有任何块
+#define ZC_EPOCH_INITIAL   1   // 全局纪元初值，0 保留给“静默”与“未退役”
+
+/**
+ * 读取者纪元槽。
+ * 每个槽独占一条硬件缓存行，只由其所属读取者写入，清理者只读。
+ * 纪元模式下读取者的 poll / release 只写自己的槽，不再写块 Header。
+ */
+typedef struct zc_epoch_slot {
+    _Atomic uint64_t  epoch;       // 进入临界区时观察到的全局纪元；ZC_EPOCH_QUIESCENT 表示静默
+    _Atomic zc_time_t visited_ts;  // 已访问块的提交时间戳水位线，替代 reader_visited
+    _Atomic bool      online;      // 槽是否已被注册
+} __attribute__((aligned(ZC_HW_CACHE_LINE_SIZE))) zc_epoch_slot_t;
+
+typedef struct zc_epoch_domain {
+    _Atomic uint64_t  global_epoch;
+    char              padding[ZC_HW_CACHE_LINE_SIZE - sizeof(uint64_t)];
+    zc_epoch_slot_t   slots[ZC_MAX_WRITERS][ZC_MAX_READERS_PER];
+} zc_epoch_domain_t;
+
+zc_internal_result_t zc_epoch_domain_init(
+    zc_epoch_domain_t* domain
+);
+
+/**
+ * @brief 注册纪元模式读取者。访问水位线初始化为当前时间戳，注册之前提交的块视为已越过。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: ID 越界或槽已在线。
+ */
+zc_internal_result_t zc_epoch_reader_register(
+    zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id
+);
+
+zc_internal_result_t zc_epoch_reader_unregister(
+    zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id
+);
+
+/**
+ * @brief 纪元模式下读取者获取块。
+ *
+ * 先以当前全局纪元宣告进入临界区，再检查块状态；成功后推进本读取者的访问水位线。
+ * 读取者同一时刻只缓存一个块，重新宣告纪元即隐式释放上一个块。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 获取成功。
+ * - ZC_INTERNAL_BLOCK_UNEXPECTED: 块不是 USING、写入者不匹配、已被访问或已被退役。
+ *
+ * @note
+ * - 函数不检查参数的指针有效性。
+ * - 不写入块 Header。
+ * - 水位线按提交时间戳推进，乱序到达的更旧的块视为已遗漏。
+ */
+zc_internal_result_t zc_acquire_block_for_reading_epoch(
+    zc_epoch_domain_t* domain,
+    zc_block_header_t* block,
+    zc_reader_id_t reader_id
+);
+
+zc_internal_result_t zc_release_block_from_reading_epoch(
+    zc_epoch_domain_t* domain,
+    zc_reader_id_t reader_id
+);
+
+/**
+ * @brief 纪元模式下清理者获取块。
+ *
+ * 第一次满足“无写入者引用且所有在线读取者的水位线已越过该块”时，把块退役到当前纪元并推进全局纪元，
+ * 返回 ZC_INTERNAL_BLOCK_UNRELEASED；之后再次调用时，若所有在线读取者都已静默或进入更新的纪元，
+ * 则把块置为 CLEAN。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 宽限期已过，块已置为 CLEAN。
+ * - ZC_INTERNAL_BLOCK_UNEXPECTED: 块不是 USING。
+ * - ZC_INTERNAL_BLOCK_UNRELEASED: 仍有引用、仍有读取者未访问，或宽限期未过。
+ *
+ * @note 只由清理者调用，不同清理者不得同时处理同一个块。
+ */
+zc_internal_result_t zc_acquire_block_for_cleaning_epoch(
+    zc_epoch_domain_t* domain,
+    zc_block_header_t* block
+);
+
+static inline zc_epoch_slot_t* zc_epoch_get_slot(zc_epoch_domain_t* domain, zc_reader_id_t reader_id)
+{
+    return &domain->slots[(uint32_t)(reader_id >> 32)][(uint32_t)reader_id];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EPOCH_H */
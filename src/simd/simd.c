@@ -0,0 +1,37 @@
+#include "simd.h"
+
+_Atomic int g_zc_simd_level = -1;
+_Atomic int g_zc_simd_bf16 = -1;
+
+/**
+ *
+ */
+zc_simd_level_t zc_simd_detect(void)
+{
+#if ZC_SIMD_X86
+    // __builtin_cpu_supports 同时检查了 XGETBV，操作系统未保存对应寄存器状态时返回假
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+    if (avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl"))
+    {
+        return ZC_SIMD_AVX512;
+    }
+    if (avx2) return ZC_SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return ZC_SIMD_SSE42;
+#endif
+    return ZC_SIMD_BASELINE;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_simd_set_level(zc_simd_level_t level)
+{
+    if (unlikely((int)level < 0 || level >= ZC_SIMD_LEVEL_COUNT)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_simd_level_t detected = zc_simd_detect();
+    atomic_store_explicit(&g_zc_simd_level, (int)(level < detected ? level : detected), memory_order_relaxed);
+
+    return ZC_INTERNAL_OK;
+}
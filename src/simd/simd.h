@@ -0,0 +1,98 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 运行时选择的指令集级别。内核以同一份源码在各级别的 target 属性下分别编译，
+ * 调用时按当前级别查表分发。
+ */
+typedef enum zc_simd_level {
+    ZC_SIMD_BASELINE = 0,   // 编译器默认目标（x86-64 下为 SSE2）
+    ZC_SIMD_SSE42    = 1,
+    ZC_SIMD_AVX2     = 2,   // AVX2 + FMA + F16C
+    ZC_SIMD_AVX512   = 3,   // AVX-512 F + BW + VL
+    ZC_SIMD_LEVEL_COUNT
+} zc_simd_level_t;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ZC_SIMD_X86 1
+#define ZC_SIMD_TARGET_SSE42  __attribute__((target("sse4.2")))
+#define ZC_SIMD_TARGET_AVX2   __attribute__((target("avx2,fma,f16c")))
+#define ZC_SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,f16c")))
+#define ZC_SIMD_TARGET_AVX512_BF16 __attribute__((target("avx512f,avx512bw,avx512vl,f16c,avx512bf16")))
+#else
+#define ZC_SIMD_X86 0
+#endif
+
+// 内核统一按 64 字节向量编写，低级别由编译器拆成多条指令
+#define ZC_SIMD_VECTOR_BYTES 64
+
+extern _Atomic int g_zc_simd_level;   // -1 表示尚未探测
+extern _Atomic int g_zc_simd_bf16;    // -1 表示尚未探测
+
+/**
+ * 探测 CPU 与操作系统共同支持的最高级别
+ */
+zc_simd_level_t zc_simd_detect(void);
+
+/**
+ * @brief 限制内核使用的最高级别，主要用于测试与基准对比。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功，实际级别为 min(level, 探测结果)。
+ * - ZC_INTERNAL_PARAM_ERROR: level 越界。
+ */
+zc_internal_result_t zc_simd_set_level(
+    zc_simd_level_t level
+);
+
+/**
+ * 当前使用的级别，首次调用时探测
+ */
+static inline zc_simd_level_t zc_simd_level(void)
+{
+    int level = atomic_load_explicit(&g_zc_simd_level, memory_order_relaxed);
+    if (unlikely(level < 0))
+    {
+        level = (int)zc_simd_detect();
+        atomic_store_explicit(&g_zc_simd_level, level, memory_order_relaxed);
+    }
+    return (zc_simd_level_t)level;
+}
+
+/**
+ * 当前级别为 AVX512 时，CPU 是否还支持 AVX-512 BF16 扩展。该扩展不构成独立级别，只由个别内核按需使用
+ */
+static inline bool zc_simd_has_bf16(void)
+{
+    if (zc_simd_level() != ZC_SIMD_AVX512) return false;
+
+    int has = atomic_load_explicit(&g_zc_simd_bf16, memory_order_relaxed);
+    if (unlikely(has < 0))
+    {
+#if ZC_SIMD_X86
+        __builtin_cpu_init();
+        has = __builtin_cpu_supports("avx512bf16") ? 1 : 0;
+#else
+        has = 0;
+#endif
+        atomic_store_explicit(&g_zc_simd_bf16, has, memory_order_relaxed);
+    }
+    return has != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_H */
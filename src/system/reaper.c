@@ -0,0 +1,51 @@
+#include "reaper.h"
+
+/**
+ *
+ */
+zc_internal_result_t zc_reaper_init(zc_reaper_t* reaper, zc_epoch_domain_t* epoch_domain,
+    zc_reaper_hook_fn hook, void* hook_ctx)
+{
+    if (unlikely(reaper == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    reaper->epoch_domain = epoch_domain;
+    reaper->hook = hook;
+    reaper->hook_ctx = hook_ctx;
+    reaper->reaped_count = 0;
+
+    uint32_t i;
+    for (i = 0; i < ZC_HEARTBEAT_SLOT_COUNT; i++) atomic_init(&reaper->held[i].block, NULL);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+void zc_reaper_on_timeout(void* ctx, uint32_t slot_index, zc_time_t last_beat)
+{
+    zc_reaper_t* reaper = ctx;
+    if (unlikely(reaper == NULL || slot_index >= ZC_HEARTBEAT_SLOT_COUNT)) return;
+
+    zc_thread_timeout_info_t info;
+    info.writer_id = slot_index / (ZC_MAX_READERS_PER + 1);
+    info.is_writer = slot_index % (ZC_MAX_READERS_PER + 1) == 0;
+    info.reader_id = info.is_writer ? 0 : ((zc_reader_id_t)info.writer_id << 32) | (slot_index % (ZC_MAX_READERS_PER + 1) - 1);
+    info.last_beat = last_beat;
+    info.block = atomic_exchange_explicit(&reaper->held[slot_index].block, NULL, memory_order_acquire);
+
+    if (info.block != NULL)
+    {
+        if (info.is_writer) info.block->writer_ref[info.writer_id] = false;
+        else info.block->reader_ref[(uint32_t)info.reader_id] = false;
+    }
+
+    // 纪元模式下读取者的引用在纪元槽上，下线后清理者不再等待它
+    if (!info.is_writer && reaper->epoch_domain != NULL)
+    {
+        zc_epoch_reader_unregister(reaper->epoch_domain, info.reader_id);
+    }
+
+    reaper->reaped_count++;
+    if (reaper->hook != NULL) reaper->hook(ZC_REAPER_HOOK_ON_THREAD_TIMEOUT, &info, reaper->hook_ctx);
+}
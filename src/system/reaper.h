@@ -0,0 +1,89 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "block.h"
+#include "epoch.h"
+#include "watchdog.h"
+
+#ifndef REAPER_H
+#define REAPER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZC_REAPER_HOOK_ON_THREAD_TIMEOUT 6   // 与 lib/zerocore.h 中 ZC_HOOK_ON_THREAD_TIMEOUT 取值一致
+
+/**
+ * 线程超时钩子，与公开接口的 zc_hook_callback_t 同形：event 为 ZC_HOOK_ON_THREAD_TIMEOUT，
+ * data 指向 zc_thread_timeout_info_t，仅在回调期间有效。
+ */
+typedef void (*zc_reaper_hook_fn)(int event, void* data, void* user_ctx);
+
+typedef struct zc_thread_timeout_info {
+    zc_writer_id_t     writer_id;
+    zc_reader_id_t     reader_id;   // 写入者超时时无意义
+    bool               is_writer;
+    zc_time_t          last_beat;
+    zc_block_header_t* block;       // 被解除引用的块，未持有块时为 NULL
+} zc_thread_timeout_info_t;
+
+/**
+ * 持有块登记槽。每个槽独占一条硬件缓存行，只由所属线程写入，超时回收时由看门狗线程取走。
+ */
+typedef struct zc_held_block_slot {
+    _Atomic(zc_block_header_t*) block;
+} __attribute__((aligned(ZC_HW_CACHE_LINE_SIZE))) zc_held_block_slot_t;
+
+/**
+ * 线程超时回收器，作为看门狗的 on_timeout 上下文。
+ * 槽位布局与心跳槽一致：[writer_id][0] 为写入者，[writer_id][reader_idx + 1] 为读取者。
+ */
+typedef struct zc_reaper {
+    zc_held_block_slot_t held[ZC_HEARTBEAT_SLOT_COUNT];
+
+    // === 以下仅由看门狗线程访问 ===
+    zc_epoch_domain_t*   epoch_domain;   // 非 NULL 时读取者处于纪元模式，超时即从纪元域下线
+    zc_reaper_hook_fn    hook;
+    void*                hook_ctx;
+    uint64_t             reaped_count;   // 累计回收的线程数
+} zc_reaper_t;
+
+zc_internal_result_t zc_reaper_init(
+    zc_reaper_t* reaper,
+    zc_epoch_domain_t* epoch_domain,
+    zc_reaper_hook_fn hook,
+    void* hook_ctx
+);
+
+/**
+ * @brief 看门狗超时回调，传给 zc_watchdog_init 时 ctx 为回收器。
+ *
+ * 取走该线程登记的持有块并清除其 writer_ref / reader_ref；读取者在纪元模式下从纪元域下线，
+ * 其访问水位线与纪元不再阻挡清理；最后触发 ZC_HOOK_ON_THREAD_TIMEOUT。
+ *
+ * @note 只由看门狗线程在 zc_watchdog_advance 中调用。
+ */
+void zc_reaper_on_timeout(
+    void* ctx,
+    uint32_t slot_index,
+    zc_time_t last_beat
+);
+
+/**
+ * 登记线程当前缓存的块，在成功 acquire 之后调用；NULL 表示已释放。
+ * 线程同一时刻只缓存一个块，新登记覆盖旧登记。
+ */
+static inline void zc_reaper_hold(zc_reaper_t* reaper, uint32_t slot_index, zc_block_header_t* block)
+{
+    atomic_store_explicit(&reaper->held[slot_index].block, block, memory_order_release);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REAPER_H */
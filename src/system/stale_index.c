@@ -0,0 +1,161 @@
+#include "stale_index.h"
+
+static inline uint32_t zc_stale_block_visited_mask(zc_block_header_t* block)
+{
+    uint32_t mask = 0;
+    uint32_t i;
+    for (i = 0; i < ZC_MAX_READERS_PER; i++)
+    {
+        mask |= (uint32_t)block->reader_visited[i] << i;
+    }
+    return mask;
+}
+
+/**
+ * 纪元模式下读取者只推进自己槽的水位线，水位线越过块的提交时间戳即视为已访问
+ */
+static inline uint32_t zc_stale_epoch_visited_mask(zc_epoch_domain_t* domain, zc_writer_id_t writer_id,
+    zc_time_t commit_ts)
+{
+    zc_epoch_slot_t* slots = domain->slots[writer_id];
+    uint32_t mask = 0;
+    uint32_t i;
+    for (i = 0; i < ZC_MAX_READERS_PER; i++)
+    {
+        if (atomic_load_explicit(&slots[i].visited_ts, memory_order_acquire) >= commit_ts) mask |= 1U << i;
+    }
+    return mask;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_stale_index_init(zc_stale_index_t* index, zc_time_t threshold_ns,
+    zc_stale_block_fn on_stale, void* ctx)
+{
+    if (unlikely(index == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    index->threshold_ns = threshold_ns;
+    index->on_stale = on_stale;
+    index->ctx = ctx;
+    index->epoch_domain = NULL;
+
+    uint32_t i;
+    for (i = 0; i < ZC_MAX_WRITERS; i++)
+    {
+        zc_stale_fifo_t* fifo = &index->fifos[i];
+        atomic_init(&fifo->tail, 0);
+        atomic_init(&fifo->head, 0);
+        atomic_init(&fifo->reader_mask, 0);
+        fifo->next_seq = 0;
+        fifo->dropped_count = 0;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_stale_index_set_epoch_domain(zc_stale_index_t* index,
+    zc_epoch_domain_t* epoch_domain)
+{
+    if (unlikely(index == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    index->epoch_domain = epoch_domain;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_stale_index_set_reader(zc_stale_index_t* index,
+    zc_reader_id_t reader_id, bool registered)
+{
+    zc_writer_id_t writer_id = (zc_writer_id_t)(reader_id >> 32);
+    uint32_t reader_idx = (uint32_t)reader_id;
+    if (writer_id >= ZC_MAX_WRITERS || reader_idx >= ZC_MAX_READERS_PER) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_stale_fifo_t* fifo = &index->fifos[writer_id];
+    if (registered) atomic_fetch_or_explicit(&fifo->reader_mask, 1U << reader_idx, memory_order_release);
+    else atomic_fetch_and_explicit(&fifo->reader_mask, ~(1U << reader_idx), memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_stale_index_push(zc_stale_index_t* index, zc_writer_id_t writer_id,
+    zc_block_header_t* block, zc_time_t commit_ts)
+{
+    // 假设传入的参数都是有效的
+
+    zc_stale_fifo_t* fifo = &index->fifos[writer_id];
+    uint64_t tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    uint64_t seq = fifo->next_seq++;
+
+    if (unlikely(tail - atomic_load_explicit(&fifo->head, memory_order_acquire) >= ZC_STALE_FIFO_CAPACITY))
+    {
+        fifo->dropped_count++;
+        return ZC_INTERNAL_GENERAL_ERROR;
+    }
+
+    zc_stale_entry_t* entry = &fifo->entries[tail & ZC_STALE_FIFO_MASK];
+    entry->block = block;
+    entry->seq = seq;
+    entry->commit_ts = commit_ts;
+    atomic_store_explicit(&fifo->tail, tail + 1, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_stale_index_scan(zc_stale_index_t* index, zc_time_t now,
+    uint32_t* out_stale_count)
+{
+    uint32_t stale_count = 0;
+
+    uint32_t w;
+    for (w = 0; w < ZC_MAX_WRITERS; w++)
+    {
+        zc_stale_fifo_t* fifo = &index->fifos[w];
+        uint64_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+        uint64_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+        uint32_t expected = atomic_load_explicit(&fifo->reader_mask, memory_order_acquire);
+
+        // 条目按提交顺序排列，出队或报告之后即不再跟踪，因此队首之前不会留下未处理的条目
+        for (; head < tail; head++)
+        {
+            zc_stale_entry_t* entry = &fifo->entries[head & ZC_STALE_FIFO_MASK];
+            zc_block_header_t* block = entry->block;
+
+            // 块已被清理或复用，或已被所有读取者访问
+            uint32_t missing = 0;
+            if (block->state == ZC_BLOCK_STATE_USING && block->timestamp == entry->commit_ts)
+            {
+                uint32_t visited = index->epoch_domain
+                    ? zc_stale_epoch_visited_mask(index->epoch_domain, w, entry->commit_ts)
+                    : zc_stale_block_visited_mask(block);
+                missing = expected & ~visited;
+            }
+            if (missing == 0) continue;
+
+            // 之后的条目都更新，不可能过期
+            zc_time_t age = now > entry->commit_ts ? now - entry->commit_ts : 0;
+            if (age < index->threshold_ns) break;
+
+            stale_count++;
+            if (index->on_stale) index->on_stale(index->ctx, w, block, missing, age);
+        }
+
+        atomic_store_explicit(&fifo->head, head, memory_order_release);
+    }
+
+    if (out_stale_count) *out_stale_count = stale_count;
+
+    return ZC_INTERNAL_OK;
+}
@@ -0,0 +1,124 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "block.h"
+#include "epoch.h"
+
+#ifndef STALE_INDEX_H
+#define STALE_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ZC_STALE_FIFO_CAPACITY
+#define ZC_STALE_FIFO_CAPACITY 4096   // 必须是 2 的幂
+#endif
+#define ZC_STALE_FIFO_MASK (ZC_STALE_FIFO_CAPACITY - 1)
+
+#if ZC_MAX_READERS_PER > 32
+#error "zc_stale_index uses a 32-bit reader mask"
+#endif
+
+typedef struct zc_stale_entry {
+    zc_block_header_t* block;      // 已提交的块
+    uint64_t           seq;        // 写入者内的提交序号
+    zc_time_t          commit_ts;  // 提交时间戳，同时用于识别块是否已被回收复用
+} zc_stale_entry_t;
+
+/**
+ * 单个写入者的提交顺序 FIFO。写入者单生产，清理者当值者单消费。
+ */
+typedef struct zc_stale_fifo {
+    // === 写入者私有 ===
+    _Atomic uint64_t  tail;
+    uint64_t          next_seq;
+    uint64_t          dropped_count;   // FIFO 满时未被索引的提交数
+    char              padding0[ZC_HW_CACHE_LINE_SIZE - 3 * sizeof(uint64_t)];
+
+    // === 清理者私有 ===
+    _Atomic uint64_t  head;
+    _Atomic uint32_t  reader_mask;     // 已注册读取者位图，注册 / 注销时更新
+    uint32_t          reserved;
+    char              padding1[ZC_HW_CACHE_LINE_SIZE - 2 * sizeof(uint64_t)];
+
+    zc_stale_entry_t  entries[ZC_STALE_FIFO_CAPACITY];
+} zc_stale_fifo_t;
+
+/**
+ * 过期块回调。
+ * 由系统层实现：向 missing_reader_mask 中的读取者发送 ZC_MSG_MISSING_BLOCK，并触发 ZC_HOOK_ON_BLOCK_STALE。
+ */
+typedef void (*zc_stale_block_fn)(void* ctx, zc_writer_id_t writer_id, zc_block_header_t* block,
+    uint32_t missing_reader_mask, zc_time_t age);
+
+typedef struct zc_stale_index {
+    zc_time_t          threshold_ns;
+    zc_stale_block_fn  on_stale;
+    void*              ctx;
+    zc_epoch_domain_t* epoch_domain;   // 非 NULL 时读取者处于纪元模式，按槽的 visited_ts 判断是否已访问
+    zc_stale_fifo_t    fifos[ZC_MAX_WRITERS];
+} zc_stale_index_t;
+
+zc_internal_result_t zc_stale_index_init(
+    zc_stale_index_t* index,
+    zc_time_t threshold_ns,
+    zc_stale_block_fn on_stale,
+    void* ctx
+);
+
+/**
+ * @brief 切换到纪元模式。纪元模式下读取者不写 reader_visited，改按纪元槽的访问水位线判断。
+ *
+ * @param epoch_domain 读取者所用的纪元域，NULL 表示恢复为按 reader_visited 判断。
+ */
+zc_internal_result_t zc_stale_index_set_epoch_domain(
+    zc_stale_index_t* index,
+    zc_epoch_domain_t* epoch_domain
+);
+
+zc_internal_result_t zc_stale_index_set_reader(
+    zc_stale_index_t* index,
+    zc_reader_id_t reader_id,
+    bool registered
+);
+
+/**
+ * @brief 记录一次提交，在 zc_commit_block_for_writing 把块置为 USING 之后由写入者调用。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_GENERAL_ERROR: FIFO 已满，本次提交不进入索引（计入 dropped_count）。
+ */
+zc_internal_result_t zc_stale_index_push(
+    zc_stale_index_t* index,
+    zc_writer_id_t writer_id,
+    zc_block_header_t* block,
+    zc_time_t commit_ts
+);
+
+/**
+ * @brief 检查所有写入者的过期块。
+ *
+ * 每个 FIFO 从最旧的条目开始：已被全部读取者访问或已被回收的条目出队；
+ * 已超过阈值且仍有读取者未访问的条目报告一次后出队；遇到第一个未超过阈值的条目即停止。
+ * 代价为 O(出队数 + 写入者数)，与内存池大小无关。
+ *
+ * @param out_stale_count [out] 本次新报告的过期块数，可为 NULL。
+ *
+ * @note 只由清理者当值者调用。
+ */
+zc_internal_result_t zc_stale_index_scan(
+    zc_stale_index_t* index,
+    zc_time_t now,
+    uint32_t* out_stale_count
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STALE_INDEX_H */
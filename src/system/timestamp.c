@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "timestamp.h"
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define ZC_HAS_TSC 1
+#else
+#define ZC_HAS_TSC 0
+#endif
+
+static zc_clock_t g_clock = { .resync_lock = ATOMIC_FLAG_INIT };
+
+static inline zc_time_t zc_clock_monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (zc_time_t)ts.tv_sec * 1000000000ULL + (zc_time_t)ts.tv_nsec;
+}
+
+static inline uint64_t zc_clock_read_tsc(void)
+{
+#if ZC_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline zc_time_t zc_clock_scale(uint64_t delta, uint64_t mult)
+{
+    return (zc_time_t)(((unsigned __int128)delta * mult) >> ZC_TSC_SHIFT);
+}
+
+static bool zc_clock_tsc_invariant(void)
+{
+#if ZC_HAS_TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) return false;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1U << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+static void zc_clock_publish(uint64_t base_tsc, zc_time_t base_ns, uint64_t mult, uint32_t source)
+{
+    uint32_t seq = atomic_load_explicit(&g_clock.seq, memory_order_relaxed);
+    atomic_store_explicit(&g_clock.seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&g_clock.base_tsc, base_tsc, memory_order_relaxed);
+    atomic_store_explicit(&g_clock.base_ns, base_ns, memory_order_relaxed);
+    atomic_store_explicit(&g_clock.mult, mult, memory_order_relaxed);
+    // resync_cycles = ZC_TSC_RESYNC_NS / ns_per_cycle
+    atomic_store_explicit(&g_clock.resync_cycles, mult ? (uint64_t)(((unsigned __int128)ZC_TSC_RESYNC_NS << ZC_TSC_SHIFT) / mult) : 0, memory_order_relaxed);
+    atomic_store_explicit(&g_clock.source, source, memory_order_relaxed);
+
+    atomic_store_explicit(&g_clock.seq, seq + 2, memory_order_release);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_timestamp_init(void)
+{
+    while (atomic_flag_test_and_set_explicit(&g_clock.resync_lock, memory_order_acquire));
+
+    if (atomic_load_explicit(&g_clock.source, memory_order_relaxed) != ZC_CLOCK_SOURCE_UNINITIALIZED)
+    {
+        atomic_flag_clear_explicit(&g_clock.resync_lock, memory_order_release);
+        return atomic_load_explicit(&g_clock.source, memory_order_relaxed) == ZC_CLOCK_SOURCE_TSC ? ZC_INTERNAL_OK : ZC_INTERNAL_UNREALIZED;
+    }
+
+    zc_internal_result_t res = ZC_INTERNAL_UNREALIZED;
+
+    if (zc_clock_tsc_invariant())
+    {
+        zc_time_t ns0 = zc_clock_monotonic_ns();
+        uint64_t tsc0 = zc_clock_read_tsc();
+        zc_time_t ns1;
+        uint64_t tsc1;
+        do
+        {
+            ns1 = zc_clock_monotonic_ns();
+            tsc1 = zc_clock_read_tsc();
+        } while (ns1 - ns0 < ZC_TSC_CALIBRATE_NS);
+
+        // 只接受 100 MHz ~ 10 GHz 的 TSC 频率
+        uint64_t cycles = tsc1 - tsc0;
+        zc_time_t elapsed = ns1 - ns0;
+        if (cycles > elapsed / 10 && cycles < elapsed * 10)
+        {
+            uint64_t mult = (uint64_t)(((unsigned __int128)elapsed << ZC_TSC_SHIFT) / cycles);
+            g_clock.sync_tsc = tsc1;
+            g_clock.sync_ns = ns1;
+            zc_clock_publish(tsc1, ns1, mult, ZC_CLOCK_SOURCE_TSC);
+            res = ZC_INTERNAL_OK;
+        }
+    }
+
+    if (res != ZC_INTERNAL_OK) zc_clock_publish(0, 0, 0, ZC_CLOCK_SOURCE_MONOTONIC);
+
+    atomic_flag_clear_explicit(&g_clock.resync_lock, memory_order_release);
+    return res;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_timestamp_resync(void)
+{
+    if (atomic_load_explicit(&g_clock.source, memory_order_acquire) != ZC_CLOCK_SOURCE_TSC) return ZC_INTERNAL_UNREALIZED;
+
+    // 已有线程在同步，直接沿用旧参数
+    if (atomic_flag_test_and_set_explicit(&g_clock.resync_lock, memory_order_acquire)) return ZC_INTERNAL_OK;
+
+    zc_time_t real_ns = zc_clock_monotonic_ns();
+    uint64_t tsc = zc_clock_read_tsc();
+
+    uint64_t base_tsc = atomic_load_explicit(&g_clock.base_tsc, memory_order_relaxed);
+    zc_time_t base_ns = atomic_load_explicit(&g_clock.base_ns, memory_order_relaxed);
+    uint64_t mult = atomic_load_explicit(&g_clock.mult, memory_order_relaxed);
+    zc_time_t computed_ns = base_ns + zc_clock_scale(tsc - base_tsc, mult);
+
+    uint64_t cycles = tsc - g_clock.sync_tsc;
+    zc_time_t elapsed = real_ns - g_clock.sync_ns;
+
+    if (unlikely(tsc <= g_clock.sync_tsc || cycles < elapsed / 10 || cycles > elapsed * 10))
+    {
+        // TSC 回退或频率异常（如迁移到不同步的插槽），永久退回系统时钟。
+        // 旧参数下任何线程返回过的值都小于 base_ns + scale(resync_cycles)，以此作为系统时钟的下限，保持单调
+        uint64_t resync_cycles = atomic_load_explicit(&g_clock.resync_cycles, memory_order_relaxed);
+        zc_time_t floor_ns = base_ns + zc_clock_scale(resync_cycles, mult);
+        zc_clock_publish(0, floor_ns > real_ns ? floor_ns : real_ns, 0, ZC_CLOCK_SOURCE_MONOTONIC);
+        atomic_flag_clear_explicit(&g_clock.resync_lock, memory_order_release);
+        return ZC_INTERNAL_UNREALIZED;
+    }
+
+    uint64_t new_mult = (uint64_t)(((unsigned __int128)elapsed << ZC_TSC_SHIFT) / cycles);
+    zc_time_t new_base = real_ns;
+    if (computed_ns > real_ns)
+    {
+        // 推算值超前时不能回拨，从推算值起步并放慢乘数，使下一个同步周期内时钟少走 ahead 纳秒；
+        // 每周期至多收回半个周期，时钟速率不低于真实速率的 2/3
+        zc_time_t ahead = computed_ns - real_ns;
+        if (ahead > ZC_TSC_RESYNC_NS / 2) ahead = ZC_TSC_RESYNC_NS / 2;
+        new_mult = (uint64_t)(((unsigned __int128)new_mult * ZC_TSC_RESYNC_NS) / (ZC_TSC_RESYNC_NS + ahead));
+        new_base = computed_ns;
+    }
+    zc_clock_publish(tsc, new_base, new_mult, ZC_CLOCK_SOURCE_TSC);
+
+    g_clock.sync_tsc = tsc;
+    g_clock.sync_ns = real_ns;
+
+    atomic_flag_clear_explicit(&g_clock.resync_lock, memory_order_release);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_clock_source_t zc_timestamp_source(void)
+{
+    return (zc_clock_source_t)atomic_load_explicit(&g_clock.source, memory_order_acquire);
+}
+
+/**
+ *
+ */
+zc_time_t zc_timestamp(void)
+{
+    for (;;)
+    {
+        uint32_t seq = atomic_load_explicit(&g_clock.seq, memory_order_acquire);
+        if (unlikely(seq & 1)) continue;
+
+        uint32_t source = atomic_load_explicit(&g_clock.source, memory_order_relaxed);
+        uint64_t base_tsc = atomic_load_explicit(&g_clock.base_tsc, memory_order_relaxed);
+        zc_time_t base_ns = atomic_load_explicit(&g_clock.base_ns, memory_order_relaxed);
+        uint64_t mult = atomic_load_explicit(&g_clock.mult, memory_order_relaxed);
+        uint64_t resync_cycles = atomic_load_explicit(&g_clock.resync_cycles, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (unlikely(atomic_load_explicit(&g_clock.seq, memory_order_relaxed) != seq)) continue;
+
+        if (likely(source == ZC_CLOCK_SOURCE_TSC))
+        {
+            uint64_t delta = zc_clock_read_tsc() - base_tsc;
+            if (likely(delta < resync_cycles)) return base_ns + zc_clock_scale(delta, mult);
+
+            zc_timestamp_resync();
+            continue;
+        }
+
+        if (source == ZC_CLOCK_SOURCE_MONOTONIC)
+        {
+            zc_time_t now = zc_clock_monotonic_ns();
+            return now > base_ns ? now : base_ns;
+        }
+
+        zc_timestamp_init();
+    }
+}
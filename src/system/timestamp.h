@@ -0,0 +1,96 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ZC_TSC_SHIFT
+#define ZC_TSC_SHIFT 32                        // 定点乘数的小数位数
+#endif
+
+#ifndef ZC_TSC_CALIBRATE_NS
+#define ZC_TSC_CALIBRATE_NS 10000000ULL        // 首次校准时长 10 ms
+#endif
+
+#ifndef ZC_TSC_RESYNC_NS
+#define ZC_TSC_RESYNC_NS 1000000000ULL         // 与 CLOCK_MONOTONIC 重新同步的间隔 1 s
+#endif
+
+#ifndef ZC_SHORT_TIME_SHIFT
+#define ZC_SHORT_TIME_SHIFT 20                 // 短时间戳精度约 1.05 ms，约 52 天回绕
+#endif
+
+typedef enum zc_clock_source {
+    ZC_CLOCK_SOURCE_UNINITIALIZED = 0,
+    ZC_CLOCK_SOURCE_TSC           = 1,         // 不变 TSC + 校准乘数
+    ZC_CLOCK_SOURCE_MONOTONIC     = 2,         // clock_gettime(CLOCK_MONOTONIC)，走 vDSO
+} zc_clock_source_t;
+
+/**
+ * TSC 到纳秒的换算参数，以序列锁保护：
+ * ns = base_ns + ((tsc - base_tsc) * mult) >> ZC_TSC_SHIFT
+ */
+typedef struct zc_clock {
+    _Atomic uint32_t  seq;            // 奇数表示正在更新
+    _Atomic uint32_t  source;         // zc_clock_source_t
+    _Atomic uint64_t  base_tsc;
+    _Atomic zc_time_t base_ns;        // 系统时钟源下为返回值的下限
+    _Atomic uint64_t  mult;
+    _Atomic uint64_t  resync_cycles;  // 距 base_tsc 超过此周期数时重新同步
+
+    // === 仅由持有 resync_lock 的线程访问 ===
+    atomic_flag       resync_lock;
+    uint64_t          sync_tsc;       // 上一次与系统时钟对齐时的 TSC
+    zc_time_t         sync_ns;        // 上一次与系统时钟对齐时的 CLOCK_MONOTONIC
+} zc_clock_t;
+
+/**
+ * @brief 校准时钟源。
+ *
+ * 检查 CPU 是否提供不变 TSC，并以 CLOCK_MONOTONIC 校准换算乘数；
+ * 不满足条件或校准结果异常时退回 clock_gettime。
+ * zc_init 时应调用一次，未调用时首次取时间戳会自动调用。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 使用 TSC。
+ * - ZC_INTERNAL_UNREALIZED: 平台不支持可靠 TSC，已退回 clock_gettime。
+ */
+zc_internal_result_t zc_timestamp_init(void);
+
+/**
+ * @brief 与 CLOCK_MONOTONIC 重新同步换算参数。
+ *
+ * 由 zc_timestamp 在超过 ZC_TSC_RESYNC_NS 后自动触发，也可由清理者定时调用。
+ * 同步保持单调：TSC 推算值落后于系统时钟时向前对齐；超前时从推算值起步，
+ * 在下一个同步周期内放慢乘数把超前量收回，乘数按系统时钟重新测得的频率计算，不累积放慢的部分。
+ */
+zc_internal_result_t zc_timestamp_resync(void);
+
+zc_clock_source_t zc_timestamp_source(void);
+
+/**
+ * @brief 获取系统时间戳（纳秒，单调递增），用于块 Header、提交、取消与心跳。
+ */
+zc_time_t zc_timestamp(void);
+
+/**
+ * @brief 获取粗粒度短时间戳，用于消息头 create_time。
+ */
+static inline zc_short_time_t zc_short_timestamp(void)
+{
+    return (zc_short_time_t)(zc_timestamp() >> ZC_SHORT_TIME_SHIFT);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMESTAMP_H */
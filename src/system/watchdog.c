@@ -0,0 +1,249 @@
+#include "watchdog.h"
+#include "timestamp.h"
+
+zc_watchdog_t* g_watchdog = NULL;
+
+static inline uint64_t zc_watchdog_time_to_tick(zc_watchdog_t* wd, zc_time_t time)
+{
+    if (time <= wd->base_time) return 0;
+    return (time - wd->base_time + ZC_WATCHDOG_TICK_NS - 1) / ZC_WATCHDOG_TICK_NS;
+}
+
+static void zc_timer_unlink(zc_watchdog_t* wd, uint32_t index)
+{
+    zc_timer_node_t* node = &wd->nodes[index];
+    if (!node->linked) return;
+
+    if (node->prev != ZC_TIMER_NIL) wd->nodes[node->prev].next = node->next;
+    else wd->wheel[node->level][(node->expire_tick >> (node->level * ZC_TIMER_WHEEL_BITS)) & ZC_TIMER_WHEEL_MASK] = node->next;
+    if (node->next != ZC_TIMER_NIL) wd->nodes[node->next].prev = node->prev;
+
+    node->prev = ZC_TIMER_NIL;
+    node->next = ZC_TIMER_NIL;
+    node->linked = 0;
+}
+
+static void zc_timer_link(zc_watchdog_t* wd, uint32_t index, uint64_t expire_tick, uint64_t min_tick)
+{
+    zc_timer_node_t* node = &wd->nodes[index];
+
+    if (expire_tick < min_tick) expire_tick = min_tick;
+
+    uint64_t delta = expire_tick - wd->current_tick;
+    uint8_t level = 0;
+    while (level < ZC_TIMER_WHEEL_LEVELS - 1 && delta >= (1ULL << ((level + 1) * ZC_TIMER_WHEEL_BITS))) level++;
+
+    // 超出最高层范围的定时器截断到最高层可表示的最远刻度，到期时会被重新评估
+    uint64_t max_delta = (1ULL << (ZC_TIMER_WHEEL_LEVELS * ZC_TIMER_WHEEL_BITS)) - 1;
+    if (delta > max_delta) expire_tick = wd->current_tick + max_delta;
+
+    uint32_t* head = &wd->wheel[level][(expire_tick >> (level * ZC_TIMER_WHEEL_BITS)) & ZC_TIMER_WHEEL_MASK];
+
+    node->expire_tick = expire_tick;
+    node->level = level;
+    node->prev = ZC_TIMER_NIL;
+    node->next = *head;
+    if (*head != ZC_TIMER_NIL) wd->nodes[*head].prev = index;
+    *head = index;
+    node->linked = 1;
+}
+
+/**
+ * 把高层某个槽中的定时器全部重新挂入，它们会落到更低的层级
+ */
+static void zc_timer_cascade(zc_watchdog_t* wd, uint8_t level)
+{
+    uint32_t* head = &wd->wheel[level][(wd->current_tick >> (level * ZC_TIMER_WHEEL_BITS)) & ZC_TIMER_WHEEL_MASK];
+    uint32_t index = *head;
+    *head = ZC_TIMER_NIL;
+
+    while (index != ZC_TIMER_NIL)
+    {
+        uint32_t next = wd->nodes[index].next;
+        wd->nodes[index].linked = 0;
+        // 级联发生在处理本刻度之前，恰好在本刻度到期的定时器仍可落入当前槽
+        zc_timer_link(wd, index, wd->nodes[index].expire_tick, wd->current_tick);
+        index = next;
+    }
+}
+
+/**
+ * 取走所有监视请求并在时间轮上生效。只由看门狗线程调用
+ */
+static void zc_watchdog_apply_requests(zc_watchdog_t* wd)
+{
+    uint32_t w;
+    for (w = 0; w < ZC_WATCHDOG_PENDING_WORDS; w++)
+    {
+        if (likely(atomic_load_explicit(&wd->pending[w], memory_order_relaxed) == 0)) continue;
+
+        uint64_t bits = atomic_exchange_explicit(&wd->pending[w], 0, memory_order_acquire);
+        while (bits)
+        {
+            uint32_t index = w * 64 + (uint32_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            uint32_t request = atomic_exchange_explicit(&wd->beats[index].request, ZC_WATCHDOG_REQUEST_NONE, memory_order_acquire);
+            if (request == ZC_WATCHDOG_REQUEST_NONE) continue;
+
+            zc_timer_unlink(wd, index);
+            if (request == ZC_WATCHDOG_REQUEST_WATCH)
+            {
+                zc_time_t last_beat = atomic_load_explicit(&wd->beats[index].last_beat, memory_order_relaxed);
+                zc_timer_link(wd, index, zc_watchdog_time_to_tick(wd, last_beat + wd->timeout_ns), wd->current_tick + 1);
+            }
+        }
+    }
+}
+
+/**
+ * 请求先写入槽，再置位图：看门狗取走位图后读到的一定是最新的请求
+ */
+static void zc_watchdog_post_request(zc_watchdog_t* wd, uint32_t slot_index, uint32_t request)
+{
+    atomic_store_explicit(&wd->beats[slot_index].request, request, memory_order_relaxed);
+    atomic_fetch_or_explicit(&wd->pending[slot_index / 64], 1ULL << (slot_index % 64), memory_order_release);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_watchdog_init(zc_watchdog_t* wd, zc_time_t timeout_ns,
+    zc_time_t now, zc_watchdog_timeout_fn on_timeout, void* ctx)
+{
+    if (unlikely(wd == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(timeout_ns == 0)) return ZC_INTERNAL_PARAM_ERROR;
+
+    wd->timeout_ns = timeout_ns;
+    wd->base_time = now;
+    wd->current_tick = 0;
+    wd->missed_count = 0;
+    wd->on_timeout = on_timeout;
+    wd->ctx = ctx;
+
+    uint32_t i, j;
+    for (i = 0; i < ZC_TIMER_WHEEL_LEVELS; i++)
+    {
+        for (j = 0; j < ZC_TIMER_WHEEL_SLOTS; j++) wd->wheel[i][j] = ZC_TIMER_NIL;
+    }
+    for (i = 0; i < ZC_WATCHDOG_PENDING_WORDS; i++) atomic_init(&wd->pending[i], 0);
+    for (i = 0; i < ZC_HEARTBEAT_SLOT_COUNT; i++)
+    {
+        atomic_init(&wd->beats[i].last_beat, 0);
+        atomic_init(&wd->beats[i].request, ZC_WATCHDOG_REQUEST_NONE);
+        wd->nodes[i].prev = ZC_TIMER_NIL;
+        wd->nodes[i].next = ZC_TIMER_NIL;
+        wd->nodes[i].linked = 0;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_watchdog_attach(zc_watchdog_t* wd)
+{
+    g_watchdog = wd;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_watchdog_watch(zc_watchdog_t* wd, uint32_t slot_index, zc_time_t now)
+{
+    if (unlikely(slot_index >= ZC_HEARTBEAT_SLOT_COUNT)) return ZC_INTERNAL_PARAM_ERROR;
+
+    atomic_store_explicit(&wd->beats[slot_index].last_beat, now, memory_order_relaxed);
+    zc_watchdog_post_request(wd, slot_index, ZC_WATCHDOG_REQUEST_WATCH);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_watchdog_unwatch(zc_watchdog_t* wd, uint32_t slot_index)
+{
+    if (unlikely(slot_index >= ZC_HEARTBEAT_SLOT_COUNT)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_watchdog_post_request(wd, slot_index, ZC_WATCHDOG_REQUEST_UNWATCH);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_watchdog_advance(zc_watchdog_t* wd, zc_time_t now,
+    uint32_t* out_expired_count)
+{
+    zc_watchdog_apply_requests(wd);
+
+    uint64_t target_tick = zc_watchdog_time_to_tick(wd, now);
+    uint32_t expired_count = 0;
+
+    while (wd->current_tick < target_tick)
+    {
+        wd->current_tick++;
+
+        // 自高向低级联，保证被级联的定时器在本刻度之前就位
+        uint8_t level = 0;
+        while (level < ZC_TIMER_WHEEL_LEVELS - 1
+            && ((wd->current_tick >> (level * ZC_TIMER_WHEEL_BITS)) & ZC_TIMER_WHEEL_MASK) == 0)
+        {
+            level++;
+        }
+        for (; level > 0; level--) zc_timer_cascade(wd, level);
+
+        uint32_t* head = &wd->wheel[0][wd->current_tick & ZC_TIMER_WHEEL_MASK];
+        while (*head != ZC_TIMER_NIL)
+        {
+            uint32_t index = *head;
+            zc_timer_unlink(wd, index);
+
+            zc_time_t last_beat = atomic_load_explicit(&wd->beats[index].last_beat, memory_order_relaxed);
+            zc_time_t deadline = last_beat + wd->timeout_ns;
+            uint64_t deadline_tick = zc_watchdog_time_to_tick(wd, deadline);
+
+            if (deadline_tick > wd->current_tick)
+            {
+                // 期间有过心跳，按最近一次心跳重新计时
+                zc_timer_link(wd, index, deadline_tick, wd->current_tick + 1);
+                continue;
+            }
+
+            expired_count++;
+            wd->missed_count++;
+            if (wd->on_timeout) wd->on_timeout(wd->ctx, index, last_beat);
+        }
+    }
+
+    if (out_expired_count) *out_expired_count = expired_count;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+void zc_writer_send_heartbeat(zc_writer_id_t writer_id)
+{
+    zc_watchdog_t* wd = g_watchdog;
+    if (unlikely(wd == NULL || writer_id >= ZC_MAX_WRITERS)) return;
+
+    zc_heartbeat_send(wd, zc_heartbeat_slot_of_writer(writer_id), zc_timestamp());
+}
+
+/**
+ *
+ */
+void zc_reader_send_heartbeat(zc_reader_id_t reader_id)
+{
+    zc_watchdog_t* wd = g_watchdog;
+    if (unlikely(wd == NULL || (uint32_t)(reader_id >> 32) >= ZC_MAX_WRITERS || (uint32_t)reader_id >= ZC_MAX_READERS_PER)) return;
+
+    zc_heartbeat_send(wd, zc_heartbeat_slot_of_reader(reader_id), zc_timestamp());
+}
@@ -0,0 +1,179 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 心跳槽按 [writer_id][0] / [writer_id][reader_idx + 1] 展开，与 Zora 线程缓存数组布局一致
+#define ZC_HEARTBEAT_SLOT_COUNT (ZC_MAX_WRITERS * (ZC_MAX_READERS_PER + 1))
+
+#ifndef ZC_WATCHDOG_TICK_NS
+#define ZC_WATCHDOG_TICK_NS 1000000ULL   // 时间轮刻度 1 ms
+#endif
+
+#ifndef ZC_TIMER_WHEEL_BITS
+#define ZC_TIMER_WHEEL_BITS 6
+#endif
+#define ZC_TIMER_WHEEL_SLOTS (1U << ZC_TIMER_WHEEL_BITS)
+#define ZC_TIMER_WHEEL_MASK  (ZC_TIMER_WHEEL_SLOTS - 1)
+
+#ifndef ZC_TIMER_WHEEL_LEVELS
+#define ZC_TIMER_WHEEL_LEVELS 4          // 覆盖 2^24 个刻度，约 4.6 小时
+#endif
+
+#define ZC_TIMER_NIL UINT32_MAX
+
+#define ZC_WATCHDOG_PENDING_WORDS ((ZC_HEARTBEAT_SLOT_COUNT + 63) / 64)
+
+typedef enum zc_watchdog_request {
+    ZC_WATCHDOG_REQUEST_NONE    = 0,
+    ZC_WATCHDOG_REQUEST_WATCH   = 1,
+    ZC_WATCHDOG_REQUEST_UNWATCH = 2,
+} zc_watchdog_request_t;
+
+/**
+ * 心跳槽。每个槽独占一条硬件缓存行，只由所属线程以 relaxed 写入，看门狗只读。
+ * request 是注册 / 注销时留给看门狗的监视请求，由看门狗取走。
+ */
+typedef struct zc_heartbeat_slot {
+    _Atomic zc_time_t last_beat;
+    _Atomic uint32_t  request;    // zc_watchdog_request_t，多次请求以最后一次为准
+} __attribute__((aligned(ZC_HW_CACHE_LINE_SIZE))) zc_heartbeat_slot_t;
+
+typedef struct zc_timer_node {
+    uint64_t expire_tick;   // 到期刻度
+    uint32_t prev;          // 同一时间轮槽内的前一节点
+    uint32_t next;          // 同一时间轮槽内的后一节点
+    uint8_t  level;         // 所在层级
+    uint8_t  linked;        // 是否在时间轮中
+    uint8_t  reserved[6];
+} zc_timer_node_t;
+
+/**
+ * 看门狗超时回调。
+ * 系统层的实现为 zc_reaper_on_timeout：强制清除该线程在其缓存块上的 writer_ref / reader_ref（或纪元槽），
+ * 并触发 ZC_HOOK_ON_THREAD_TIMEOUT。
+ */
+typedef void (*zc_watchdog_timeout_fn)(void* ctx, uint32_t slot_index, zc_time_t last_beat);
+
+typedef struct zc_watchdog {
+    // === 外部线程写入区 ===
+    zc_heartbeat_slot_t    beats[ZC_HEARTBEAT_SLOT_COUNT];
+    _Alignas(ZC_HW_CACHE_LINE_SIZE) _Atomic uint64_t pending[ZC_WATCHDOG_PENDING_WORDS];   // 有未处理监视请求的槽位图
+
+    // === 以下仅由看门狗线程访问 ===
+    zc_time_t              timeout_ns;     // 心跳超时阈值（通常为 heartbeat_interval 的数倍）
+    zc_time_t              base_time;      // 刻度 0 对应的时间
+    uint64_t               current_tick;   // 已处理到的刻度
+    uint64_t               missed_count;   // 累计超时次数，汇总到 zc_stats_t.heartbeat_missed
+    zc_watchdog_timeout_fn on_timeout;
+    void*                  ctx;
+
+    uint32_t               wheel[ZC_TIMER_WHEEL_LEVELS][ZC_TIMER_WHEEL_SLOTS];
+    zc_timer_node_t        nodes[ZC_HEARTBEAT_SLOT_COUNT];
+} zc_watchdog_t;
+
+extern zc_watchdog_t* g_watchdog;
+
+zc_internal_result_t zc_watchdog_init(
+    zc_watchdog_t* wd,
+    zc_time_t timeout_ns,
+    zc_time_t now,
+    zc_watchdog_timeout_fn on_timeout,
+    void* ctx
+);
+
+/**
+ * @brief 把看门狗设为当前进程的全局看门狗，公开的心跳接口写入它的心跳槽。传入 NULL 解除。
+ */
+zc_internal_result_t zc_watchdog_attach(
+    zc_watchdog_t* wd
+);
+
+/**
+ * @brief 开始监视一个线程，在注册时调用。
+ *
+ * 只记录请求，不触碰时间轮；看门狗在下一次 zc_watchdog_advance 开始时把定时器挂入。
+ * 可由任意线程调用。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: slot_index 越界。
+ */
+zc_internal_result_t zc_watchdog_watch(
+    zc_watchdog_t* wd,
+    uint32_t slot_index,
+    zc_time_t now
+);
+
+/**
+ * @brief 停止监视一个线程，在注销时调用。
+ *
+ * 与 zc_watchdog_watch 一样只记录请求，定时器在下一次 zc_watchdog_advance 开始时摘除。
+ */
+zc_internal_result_t zc_watchdog_unwatch(
+    zc_watchdog_t* wd,
+    uint32_t slot_index
+);
+
+/**
+ * @brief 推进时间轮到 now，并处理所有到期的定时器。
+ *
+ * 先处理注册 / 注销留下的监视请求，再推进刻度。
+ * 心跳不触碰时间轮：定时器到期时才读取心跳槽，若期间有过心跳则按最近一次心跳重新挂入，
+ * 否则判定线程超时并调用 on_timeout，定时器不再挂回。
+ * 单次调用的代价为 O(经过的刻度数 + 到期的定时器数 + 监视请求数)，与已注册线程总数无关。
+ *
+ * @param out_expired_count [out] 本次判定超时的线程数，可为 NULL。
+ *
+ * @note 只由看门狗线程调用，建议每 100 ms 调用一次。
+ */
+zc_internal_result_t zc_watchdog_advance(
+    zc_watchdog_t* wd,
+    zc_time_t now,
+    uint32_t* out_expired_count
+);
+
+static inline uint32_t zc_heartbeat_slot_of_writer(zc_writer_id_t writer_id)
+{
+    return writer_id * (ZC_MAX_READERS_PER + 1);
+}
+
+static inline uint32_t zc_heartbeat_slot_of_reader(zc_reader_id_t reader_id)
+{
+    return (uint32_t)(reader_id >> 32) * (ZC_MAX_READERS_PER + 1) + (uint32_t)reader_id + 1;
+}
+
+/**
+ * 发送心跳：对线程私有缓存行的一次 relaxed 写入。
+ */
+static inline void zc_heartbeat_send(zc_watchdog_t* wd, uint32_t slot_index, zc_time_t now)
+{
+    atomic_store_explicit(&wd->beats[slot_index].last_beat, now, memory_order_relaxed);
+}
+
+/**
+ * 公开心跳接口，声明见 lib/zerocore.h：以当前时间戳写入所属心跳槽。
+ * 未 attach 全局看门狗或 ID 越界时不做任何事。
+ */
+void zc_writer_send_heartbeat(
+    zc_writer_id_t writer_id
+);
+
+void zc_reader_send_heartbeat(
+    zc_reader_id_t reader_id
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WATCHDOG_H */
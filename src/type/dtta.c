@@ -1,268 +1,1610 @@
 #include "dtta.h"
+#include "dtta_search.h"
+#include "block_io.h"
+#include "schema.h"
 #include "type_descriptor.h"
+#include <stdlib.h>
 #include <string.h>
 
+/**
+ * 自根到叶子的查找路径。内部层记录所走的子节点下标，叶子层记录 <= key 的键数。
+ */
+typedef struct zc_dtt_index_path
+{
+    uint64_t node_offset[ZC_DTT_INDEX_MAX_HEIGHT];
+    uint32_t child_index[ZC_DTT_INDEX_MAX_HEIGHT];
+} zc_dtt_index_path_t;
+
+/**
+ * LUT 头紧随用户数据区；放不进当前页剩余部分时移到下一页页首，不跨页放置
+ */
+static inline uint64_t zc_dtt_lut_header_offset(zc_block_header_t* block)
+{
+    uint64_t offset = ZC_BLOCK_HEADER_SIZE + block->lut_offset;
+    uint64_t in_page = offset % ZC_PAGE_DATA_SIZE;
+    if (in_page + ZC_DTT_LUT_HEADER_SIZE > ZC_PAGE_DATA_SIZE) offset += ZC_PAGE_DATA_SIZE - in_page;
+    return offset;
+}
+
+static inline zc_internal_result_t zc_dtt_resolve_lut(zc_block_header_t* block, zc_dtt_lut_header_t** out_lut_hdr)
+{
+    zc_dtt_lut_header_t* lut_hdr = zc_block_offset_to_ptr(block, zc_dtt_lut_header_offset(block));
+    if (unlikely(!lut_hdr)) return ZC_INTERNAL_BLOCK_ERROR;
+
+    *out_lut_hdr = lut_hdr;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 从 DTTA 堆按 8 字节对齐分配。块页之间不连续，不足一页的对象不跨页放置。
+ * 空间不足时返回 0（堆始终位于块头之后，0 不是合法的堆偏移）。
+ */
+static uint64_t zc_dtt_heap_alloc(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr, uint64_t size)
+{
+    uint64_t offset = (lut_hdr->heap_start_offset + lut_hdr->heap_used + 7) & ~7ULL;
+    uint64_t in_page = offset % ZC_PAGE_DATA_SIZE;
+    if (size <= ZC_PAGE_DATA_SIZE && in_page + size > ZC_PAGE_DATA_SIZE) offset += ZC_PAGE_DATA_SIZE - in_page;
+
+    if (unlikely(offset + size > block->cover_page_count * ZC_PAGE_DATA_SIZE)) return 0;
+
+    lut_hdr->heap_used = offset + size - lut_hdr->heap_start_offset;
+    return offset;
+}
+
+/**
+ * 从 DTTA 堆按整页分配，起点对齐到页首
+ */
+static uint64_t zc_dtt_heap_alloc_pages(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr, uint64_t page_count)
+{
+    uint64_t end = lut_hdr->heap_start_offset + lut_hdr->heap_used;
+    uint64_t offset = (end + ZC_PAGE_DATA_SIZE - 1) / ZC_PAGE_DATA_SIZE * ZC_PAGE_DATA_SIZE;
+
+    if (unlikely(offset + page_count * ZC_PAGE_DATA_SIZE > block->cover_page_count * ZC_PAGE_DATA_SIZE)) return 0;
+
+    lut_hdr->heap_used = offset + page_count * ZC_PAGE_DATA_SIZE - lut_hdr->heap_start_offset;
+    return offset;
+}
+
+static inline zc_dtt_index_node_t* zc_dtt_node_init(zc_block_header_t* block, uint64_t node_offset, uint8_t is_leaf)
+{
+    zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, node_offset);
+    if (unlikely(!node)) return NULL;
+
+    uint32_t i;
+    for (i = 0; i < ZC_DTT_INDEX_FANOUT; i++)
+    {
+        node->keys[i] = ZC_DTT_KEY_SENTINEL;
+        node->slots[i] = 0;
+    }
+    node->next_leaf = 0;
+    node->count = 0;
+    node->is_leaf = is_leaf;
+    memset(node->reserved, 0, sizeof(node->reserved));
+    return node;
+}
+
+static inline void zc_dtt_node_insert_at(zc_dtt_index_node_t* node, uint32_t pos, uint64_t key, uint64_t slot)
+{
+    uint32_t move = node->count - pos;
+    memmove(&node->keys[pos + 1], &node->keys[pos], move * sizeof(uint64_t));
+    memmove(&node->slots[pos + 1], &node->slots[pos], move * sizeof(uint64_t));
+    node->keys[pos] = key;
+    node->slots[pos] = slot;
+    node->count++;
+}
+
+static inline void zc_dtt_node_remove_at(zc_dtt_index_node_t* node, uint32_t pos)
+{
+    uint32_t move = node->count - pos - 1;
+    memmove(&node->keys[pos], &node->keys[pos + 1], move * sizeof(uint64_t));
+    memmove(&node->slots[pos], &node->slots[pos + 1], move * sizeof(uint64_t));
+    node->count--;
+    node->keys[node->count] = ZC_DTT_KEY_SENTINEL;
+    node->slots[node->count] = 0;
+}
+
+/**
+ * 自根下降到 key 所在的叶子。内部节点的键是子树的最小键，每层一次 16 键比较；
+ * key 小于子树最小键时沿 0 号子节点下降，此时叶子层的计数为 0。
+ */
+static zc_internal_result_t zc_dtt_index_descend(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t key, zc_dtt_index_path_t* path, zc_dtt_index_node_t** out_leaf)
+{
+    uint64_t node_offset = lut_hdr->index_root_offset;
+    uint32_t level;
+    for (level = 0; level < lut_hdr->index_height; level++)
+    {
+        zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, node_offset);
+        if (unlikely(!node)) return ZC_INTERNAL_BLOCK_ERROR;
+
+        uint32_t rank = zc_dtt_key_rank16(node->keys, key);
+        path->node_offset[level] = node_offset;
+
+        if (node->is_leaf)
+        {
+            path->child_index[level] = rank;
+            *out_leaf = node;
+            return ZC_INTERNAL_OK;
+        }
+
+        uint32_t child = rank ? rank - 1 : 0;
+        path->child_index[level] = child;
+        node_offset = node->slots[child];
+    }
+
+    return ZC_INTERNAL_BLOCK_ERROR;
+}
+
+/**
+ * data_offset <= key 的最后一个条目，不存在时为 0
+ */
+static zc_internal_result_t zc_dtt_index_floor(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t key, uint64_t* out_entry_offset)
+{
+    *out_entry_offset = 0;
+    if (lut_hdr->index_height == 0) return ZC_INTERNAL_OK;
+
+    zc_dtt_index_path_t path;
+    zc_dtt_index_node_t* leaf;
+    zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, key, &path, &leaf);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    uint32_t rank = path.child_index[lut_hdr->index_height - 1];
+    if (rank > 0) *out_entry_offset = leaf->slots[rank - 1];
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * data_offset > key 的第一个条目，不存在时为 0
+ */
+static zc_internal_result_t zc_dtt_index_higher(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t key, uint64_t* out_entry_offset)
+{
+    *out_entry_offset = 0;
+    if (lut_hdr->index_height == 0) return ZC_INTERNAL_OK;
+
+    zc_dtt_index_path_t path;
+    zc_dtt_index_node_t* leaf;
+    zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, key, &path, &leaf);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    uint32_t rank = path.child_index[lut_hdr->index_height - 1];
+    if (rank < leaf->count)
+    {
+        *out_entry_offset = leaf->slots[rank];
+        return ZC_INTERNAL_OK;
+    }
+    if (leaf->next_leaf == 0) return ZC_INTERNAL_OK;
+
+    zc_dtt_index_node_t* next = zc_block_offset_to_ptr(block, leaf->next_leaf);
+    if (unlikely(!next)) return ZC_INTERNAL_BLOCK_ERROR;
+    *out_entry_offset = next->slots[0];
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 检查 [data_offset, data_offset + obj_width) 与现有条目是否重叠。exclude_offset 为正在修改的条目，不参与检查
+ */
+static zc_internal_result_t zc_dtt_index_check_overlap(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t data_offset, uint64_t obj_width, uint64_t exclude_offset)
+{
+    uint64_t prev_offset, next_offset;
+    zc_internal_result_t res = zc_dtt_index_floor(block, lut_hdr, data_offset, &prev_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (prev_offset != 0 && prev_offset == exclude_offset)
+    {
+        zc_dtt_lut_entry_t* excluded = zc_block_offset_to_ptr(block, exclude_offset);
+        if (unlikely(!excluded)) return ZC_INTERNAL_BLOCK_ERROR;
+        prev_offset = 0;
+        if (excluded->data_offset > 0)
+        {
+            res = zc_dtt_index_floor(block, lut_hdr, excluded->data_offset - 1, &prev_offset);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        }
+    }
+    if (prev_offset != 0)
+    {
+        zc_dtt_lut_entry_t* prev = zc_block_offset_to_ptr(block, prev_offset);
+        if (unlikely(!prev)) return ZC_INTERNAL_BLOCK_ERROR;
+        if (prev->data_offset + prev->obj_width > data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+    }
+
+    res = zc_dtt_index_higher(block, lut_hdr, data_offset, &next_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (next_offset != 0 && next_offset == exclude_offset)
+    {
+        zc_dtt_lut_entry_t* excluded = zc_block_offset_to_ptr(block, exclude_offset);
+        if (unlikely(!excluded)) return ZC_INTERNAL_BLOCK_ERROR;
+        res = zc_dtt_index_higher(block, lut_hdr, excluded->data_offset, &next_offset);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+    if (next_offset != 0)
+    {
+        zc_dtt_lut_entry_t* next = zc_block_offset_to_ptr(block, next_offset);
+        if (unlikely(!next)) return ZC_INTERNAL_BLOCK_ERROR;
+        if (data_offset + obj_width > next->data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 插入 key 需要新分配的节点数：自叶子向上连续满节点的个数，全部满时另加一个新根
+ */
+static uint32_t zc_dtt_index_split_count(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_index_path_t* path)
+{
+    if (lut_hdr->index_height == 0) return 1;
+
+    uint32_t count = 0;
+    int32_t level;
+    for (level = (int32_t)lut_hdr->index_height - 1; level >= 0; level--)
+    {
+        zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, path->node_offset[level]);
+        if (!node || node->count < ZC_DTT_INDEX_FANOUT) return count;
+        count++;
+    }
+    return count + 1;
+}
+
+/**
+ * 预留 count 个节点。失败时堆回退到调用前的位置
+ */
+static zc_internal_result_t zc_dtt_index_reserve(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    uint32_t count, uint64_t* out_nodes)
+{
+    uint64_t heap_used = lut_hdr->heap_used;
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        out_nodes[i] = zc_dtt_heap_alloc(block, lut_hdr, sizeof(zc_dtt_index_node_t));
+        if (unlikely(out_nodes[i] == 0))
+        {
+            lut_hdr->heap_used = heap_used;
+            return ZC_INTERNAL_DTTA_OVERFLOW;
+        }
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 把 (key, entry_offset) 插入 B+ 树。path 为 key 的查找路径，分裂所需节点已由 zc_dtt_index_reserve 预留。
+ * 满节点对半分裂，每个节点内至多移动 16 个键；已有条目不移动。
+ *
+ * @return 实际使用的预留节点数
+ */
+static uint32_t zc_dtt_index_insert(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_index_path_t* path, uint64_t key, uint64_t entry_offset, const uint64_t* nodes)
+{
+    uint32_t used = 0;
+
+    if (lut_hdr->index_height == 0)
+    {
+        zc_dtt_index_node_t* root = zc_dtt_node_init(block, nodes[used], 1);
+        zc_dtt_node_insert_at(root, 0, key, entry_offset);
+        lut_hdr->index_root_offset = nodes[used++];
+        lut_hdr->index_height = 1;
+        return used;
+    }
+
+    int32_t level = (int32_t)lut_hdr->index_height - 1;
+    uint32_t pos = path->child_index[level];
+
+    // 只有插入全局最小键时叶子位置为 0，此时路径全部沿 0 号子节点，先更新各层的最小键
+    if (pos == 0)
+    {
+        int32_t l;
+        for (l = 0; l < level; l++)
+        {
+            zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, path->node_offset[l]);
+            node->keys[0] = key;
+        }
+    }
+
+    uint64_t slot = entry_offset;
+    for (;;)
+    {
+        uint64_t node_offset = path->node_offset[level];
+        zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, node_offset);
+        if (node->count < ZC_DTT_INDEX_FANOUT)
+        {
+            zc_dtt_node_insert_at(node, pos, key, slot);
+            break;
+        }
+
+        uint64_t right_offset = nodes[used++];
+        zc_dtt_index_node_t* right = zc_dtt_node_init(block, right_offset, node->is_leaf);
+        if (unlikely(!right)) break;
+        uint32_t half = ZC_DTT_INDEX_FANOUT / 2;
+        memcpy(right->keys, &node->keys[half], half * sizeof(uint64_t));
+        memcpy(right->slots, &node->slots[half], half * sizeof(uint64_t));
+        right->count = half;
+        uint32_t i;
+        for (i = half; i < ZC_DTT_INDEX_FANOUT; i++)
+        {
+            node->keys[i] = ZC_DTT_KEY_SENTINEL;
+            node->slots[i] = 0;
+        }
+        node->count = half;
+
+        if (pos <= half) zc_dtt_node_insert_at(node, pos, key, slot);
+        else zc_dtt_node_insert_at(right, pos - half, key, slot);
+
+        if (node->is_leaf)
+        {
+            right->next_leaf = node->next_leaf;
+            node->next_leaf = right_offset;
+        }
+
+        if (level == 0)
+        {
+            uint64_t root_offset = nodes[used++];
+            zc_dtt_index_node_t* root = zc_dtt_node_init(block, root_offset, 0);
+            zc_dtt_node_insert_at(root, 0, node->keys[0], node_offset);
+            zc_dtt_node_insert_at(root, 1, right->keys[0], right_offset);
+            lut_hdr->index_root_offset = root_offset;
+            lut_hdr->index_height++;
+            break;
+        }
+
+        key = right->keys[0];
+        slot = right_offset;
+        level--;
+        pos = path->child_index[level] + 1;
+    }
+
+    return used;
+}
+
+/**
+ * 从 B+ 树删除 path 所指的叶子键。清空的节点从父节点摘除（不回收，随块一并释放），
+ * 单子节点的根被折叠。
+ */
+static zc_internal_result_t zc_dtt_index_remove(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_index_path_t* path)
+{
+    int32_t level = (int32_t)lut_hdr->index_height - 1;
+    zc_dtt_index_node_t* leaf = zc_block_offset_to_ptr(block, path->node_offset[level]);
+    uint32_t pos = path->child_index[level] - 1;
+
+    // 叶子将被清空时先从叶子链表摘除：前驱叶子是 key - 1 所在的叶子
+    if (leaf->count == 1 && leaf->keys[0] > 0)
+    {
+        zc_dtt_index_path_t prev_path;
+        zc_dtt_index_node_t* prev;
+        zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, leaf->keys[0] - 1, &prev_path, &prev);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        if (prev != leaf) prev->next_leaf = leaf->next_leaf;
+    }
+
+    for (;;)
+    {
+        zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, path->node_offset[level]);
+        zc_dtt_node_remove_at(node, pos);
+
+        if (node->count > 0)
+        {
+            // 删除了最小键，沿路径更新父节点中的子树最小键
+            while (pos == 0 && level > 0)
+            {
+                uint64_t min_key = node->keys[0];
+                level--;
+                pos = path->child_index[level];
+                node = zc_block_offset_to_ptr(block, path->node_offset[level]);
+                node->keys[pos] = min_key;
+            }
+            break;
+        }
+
+        if (level == 0)
+        {
+            lut_hdr->index_root_offset = 0;
+            lut_hdr->index_height = 0;
+            return ZC_INTERNAL_OK;
+        }
+
+        level--;
+        pos = path->child_index[level];
+    }
+
+    while (lut_hdr->index_height > 1)
+    {
+        zc_dtt_index_node_t* root = zc_block_offset_to_ptr(block, lut_hdr->index_root_offset);
+        if (root->count != 1) break;
+        lut_hdr->index_root_offset = root->slots[0];
+        lut_hdr->index_height--;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 顺序建叶子：键按升序逐个追加，当前叶子满 16 个后开新叶子并串入链表，最后自底向上建内部层。
+ * 节点先取 pool 中回收的旧索引节点，取完后再从堆分配
+ */
+typedef struct zc_dtt_leaf_builder
+{
+    uint64_t             first_leaf;
+    uint32_t             leaf_count;
+    uint32_t             entry_count;
+    zc_dtt_index_node_t* leaf;
+    const uint64_t*      pool;
+    uint32_t             pool_count;
+    uint32_t             pool_used;
+} zc_dtt_leaf_builder_t;
+
+static inline uint64_t zc_dtt_leaf_builder_alloc(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    zc_dtt_leaf_builder_t* builder)
+{
+    if (builder->pool_used < builder->pool_count) return builder->pool[builder->pool_used++];
+    return zc_dtt_heap_alloc(block, lut_hdr, sizeof(zc_dtt_index_node_t));
+}
+
+/**
+ * 由叶子链表自底向上建立内部层。各层节点构建期间借用 next_leaf 串联，建成后清零
+ */
+static zc_internal_result_t zc_dtt_index_build_levels(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    zc_dtt_leaf_builder_t* builder)
+{
+    uint64_t first_offset = builder->first_leaf;
+    uint32_t node_count = builder->leaf_count;
+    uint32_t height = 1;
+    uint8_t child_is_leaf = 1;
+
+    while (node_count > 1)
+    {
+        if (unlikely(height >= ZC_DTT_INDEX_MAX_HEIGHT)) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+        uint64_t child_offset = first_offset;
+        uint64_t parent_first = 0;
+        zc_dtt_index_node_t* parent = NULL;
+        uint32_t parent_count = 0;
+
+        while (child_offset != 0)
+        {
+            zc_dtt_index_node_t* child = zc_block_offset_to_ptr(block, child_offset);
+            if (unlikely(!child)) return ZC_INTERNAL_BLOCK_ERROR;
+
+            if (parent == NULL || parent->count == ZC_DTT_INDEX_FANOUT)
+            {
+                uint64_t parent_offset = zc_dtt_leaf_builder_alloc(block, lut_hdr, builder);
+                if (unlikely(parent_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+                zc_dtt_index_node_t* next_parent = zc_dtt_node_init(block, parent_offset, 0);
+                if (unlikely(!next_parent)) return ZC_INTERNAL_BLOCK_ERROR;
+                if (parent != NULL) parent->next_leaf = parent_offset;
+                else parent_first = parent_offset;
+                parent = next_parent;
+                parent_count++;
+            }
+
+            zc_dtt_node_insert_at(parent, parent->count, child->keys[0], child_offset);
+            child_offset = child->next_leaf;
+            if (!child_is_leaf) child->next_leaf = 0;
+        }
+
+        first_offset = parent_first;
+        node_count = parent_count;
+        child_is_leaf = 0;
+        height++;
+    }
+
+    if (!child_is_leaf)
+    {
+        zc_dtt_index_node_t* root = zc_block_offset_to_ptr(block, first_offset);
+        root->next_leaf = 0;
+    }
+
+    lut_hdr->index_root_offset = first_offset;
+    lut_hdr->index_height = height;
+    return ZC_INTERNAL_OK;
+}
+
+static zc_internal_result_t zc_dtt_leaf_builder_push(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    zc_dtt_leaf_builder_t* builder, uint64_t key, uint64_t entry_offset)
+{
+    if (builder->leaf == NULL || builder->leaf->count == ZC_DTT_INDEX_FANOUT)
+    {
+        uint64_t leaf_offset = zc_dtt_leaf_builder_alloc(block, lut_hdr, builder);
+        if (unlikely(leaf_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+        zc_dtt_index_node_t* leaf = zc_dtt_node_init(block, leaf_offset, 1);
+        if (unlikely(!leaf)) return ZC_INTERNAL_BLOCK_ERROR;
+
+        if (builder->leaf != NULL) builder->leaf->next_leaf = leaf_offset;
+        else builder->first_leaf = leaf_offset;
+        builder->leaf = leaf;
+        builder->leaf_count++;
+    }
+
+    zc_dtt_node_insert_at(builder->leaf, builder->leaf->count, key, entry_offset);
+    builder->entry_count++;
+    return ZC_INTERNAL_OK;
+}
+
+static zc_internal_result_t zc_dtt_leaf_builder_finish(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    zc_dtt_leaf_builder_t* builder)
+{
+    if (builder->leaf_count == 0)
+    {
+        lut_hdr->index_root_offset = 0;
+        lut_hdr->index_height = 0;
+    }
+    else
+    {
+        zc_internal_result_t res = zc_dtt_index_build_levels(block, lut_hdr, builder);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    lut_hdr->entry_count = builder->entry_count;
+    return ZC_INTERNAL_OK;
+}
+
+static zc_internal_result_t zc_dtt_heap_append_entry(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_lut_entry_t* src, uint64_t* out_entry_offset)
+{
+    uint64_t entry_offset = zc_dtt_heap_alloc(block, lut_hdr, ZC_DTT_LUT_ENTRY_SIZE);
+    if (unlikely(entry_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+    zc_dtt_lut_entry_t* entry = zc_block_offset_to_ptr(block, entry_offset);
+    if (unlikely(!entry)) return ZC_INTERNAL_BLOCK_ERROR;
+
+    *entry = *src;
+    *out_entry_offset = entry_offset;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 把按 data_offset 升序的条目批量装入空的 DTTA：条目依次追加到堆，叶子填满 16 个后再建内部层
+ */
+static zc_internal_result_t zc_dtt_index_bulk_load(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_lut_entry_t* sorted, uint32_t count)
+{
+    zc_dtt_leaf_builder_t builder = { 0 };
+
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        uint64_t entry_offset;
+        zc_internal_result_t res = zc_dtt_heap_append_entry(block, lut_hdr, &sorted[i], &entry_offset);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        res = zc_dtt_leaf_builder_push(block, lut_hdr, &builder, sorted[i].data_offset, entry_offset);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    return zc_dtt_leaf_builder_finish(block, lut_hdr, &builder);
+}
+
+/**
+ * 写路径使用：块引用模式时先把模式条目装入块内 DTTA。失败时块仍引用模式
+ */
+static zc_internal_result_t zc_dtt_resolve_lut_for_write(zc_block_header_t* block,
+    zc_dtt_lut_header_t** out_lut_hdr)
+{
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (unlikely(lut_hdr->frozen)) return ZC_INTERNAL_DTTA_FROZEN;
+
+    if (lut_hdr->schema_id != ZC_SCHEMA_ID_NONE)
+    {
+        if (unlikely(g_schema_table == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+        zc_schema_slot_t* schema = zc_schema_get(g_schema_table, lut_hdr->schema_id);
+        if (unlikely(!schema)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+        uint64_t heap_used = lut_hdr->heap_used;
+        res = zc_dtt_index_bulk_load(block, lut_hdr, &g_schema_table->entries[schema->first_entry], schema->entry_count);
+        if (unlikely(res != ZC_INTERNAL_OK))
+        {
+            lut_hdr->heap_used = heap_used;
+            lut_hdr->index_root_offset = 0;
+            lut_hdr->index_height = 0;
+            return res;
+        }
+        lut_hdr->schema_id = ZC_SCHEMA_ID_NONE;
+    }
+
+    *out_lut_hdr = lut_hdr;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_dtt_init(zc_block_header_t* block)
+{
+    uint64_t lut_hdr_offset = zc_dtt_lut_header_offset(block);
+    zc_dtt_lut_header_t* lut_hdr = zc_block_offset_to_ptr(block, lut_hdr_offset);
+    if (unlikely(!lut_hdr)) return ZC_INTERNAL_BLOCK_ERROR;
+
+    lut_hdr->entry_count = 0;
+    lut_hdr->schema_id = ZC_SCHEMA_ID_NONE;
+    lut_hdr->index_root_offset = 0;
+    lut_hdr->index_height = 0;
+    lut_hdr->frozen = 0;
+    lut_hdr->heap_start_offset = (lut_hdr_offset + ZC_DTT_LUT_HEADER_SIZE + 7) & ~7ULL;
+    lut_hdr->heap_used = 0;
+    lut_hdr->descriptor_length = 0;
+    lut_hdr->frozen_entry_offset = 0;
+    lut_hdr->frozen_table_offset = 0;
+    lut_hdr->frozen_granule_shift = 0;
+    lut_hdr->frozen_granule_count = 0;
+    lut_hdr->frozen_dir_addr = 0;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 插入 LUT 条目。type_id 非 0 时描述符已驻留，不写入块内描述符池
+ */
+static zc_internal_result_t zc_dtt_insert(zc_block_header_t* block, uint64_t data_offset,
+    uint64_t obj_width, const uint8_t* type_desc, uint64_t desc_len, zc_type_id_t type_id)
+{
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut_for_write(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (unlikely(desc_len == 0 || obj_width == 0 || obj_width > ZC_DTT_OBJ_WIDTH_MAX)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    res = zc_type_registry_check_width(g_type_registry, type_id, type_desc, desc_len, obj_width);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // Check LUT entry count
+    if (lut_hdr->entry_count >= ZC_DTT_LUT_ENTRY_MAX_COUNT) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+    // Check overlap with prev / next
+    res = zc_dtt_index_check_overlap(block, lut_hdr, data_offset, obj_width, 0);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    zc_dtt_index_path_t path;
+    zc_dtt_index_node_t* leaf;
+    if (lut_hdr->index_height > 0)
+    {
+        res = zc_dtt_index_descend(block, lut_hdr, data_offset, &path, &leaf);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    uint32_t split_count = zc_dtt_index_split_count(block, lut_hdr, &path);
+    if (unlikely(lut_hdr->index_height + (split_count > lut_hdr->index_height) > ZC_DTT_INDEX_MAX_HEIGHT)) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+    // Allocate descriptor, entry and split nodes, roll back on overflow
+    uint64_t heap_used = lut_hdr->heap_used;
+    uint64_t desc_offset = 0;
+    if (type_id == ZC_TYPE_ID_NONE)
+    {
+        desc_offset = zc_dtt_heap_alloc(block, lut_hdr, desc_len);
+        if (unlikely(desc_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+    }
+    uint64_t entry_offset = zc_dtt_heap_alloc(block, lut_hdr, ZC_DTT_LUT_ENTRY_SIZE);
+    uint64_t nodes[ZC_DTT_INDEX_MAX_HEIGHT + 1];
+    if (unlikely(entry_offset == 0 || zc_dtt_index_reserve(block, lut_hdr, split_count, nodes) != ZC_INTERNAL_OK))
+    {
+        lut_hdr->heap_used = heap_used;
+        return ZC_INTERNAL_DTTA_OVERFLOW;
+    }
+
+    zc_dtt_lut_entry_t* entry = zc_block_offset_to_ptr(block, entry_offset);
+    if (unlikely(!entry)) return ZC_INTERNAL_BLOCK_ERROR;
+    entry->data_offset = data_offset;
+    entry->desc_offset = desc_offset;
+    entry->obj_width = obj_width;
+    entry->type_tag = type_desc[0];
+    entry->desc_length = (uint32_t)desc_len;
+    entry->type_id = type_id;
+    entry->desc_hash = zc_type_desc_hash(type_desc, desc_len);
+
+    // Write descriptor
+    if (type_id == ZC_TYPE_ID_NONE)
+    {
+        void* desc_ptr = zc_block_offset_to_ptr(block, desc_offset);
+        if (unlikely(!desc_ptr)) return ZC_INTERNAL_BLOCK_ERROR;
+        memcpy(desc_ptr, type_desc, desc_len);
+        lut_hdr->descriptor_length += desc_len;
+    }
+
+    zc_dtt_index_insert(block, lut_hdr, &path, data_offset, entry_offset, nodes);
+    lut_hdr->entry_count++;
+
+    return ZC_INTERNAL_OK;
+}
+
 /**
  * 添加一个新变量的 dtt 数据
  */
 zc_internal_result_t zc_dtt_add(zc_block_header_t* block,
     uint64_t data_offset, uint64_t obj_width, const uint8_t* type_desc, uint64_t desc_len)
 {
-    // Get LUT pointers
-    zc_dtt_lut_header_t* lut_hdr = zc_block_offset_to_ptr(block, ZC_BLOCK_HEADER_SIZE + block->lut_offset);
-    if (unlikely(!lut_hdr)) return ZC_INTERNAL_BLOCK_ERROR;
-    zc_dtt_lut_entry_t* entries = zc_block_offset_to_ptr(block, lut_hdr->lut_first_entry_offset);
-    if (unlikely(!entries)) return ZC_INTERNAL_BLOCK_ERROR;
+    zc_type_id_t type_id = ZC_TYPE_ID_NONE;
+    if (g_type_registry != NULL && desc_len <= ZC_TYPE_DESC_MAX_LEN)
+    {
+        // 驻留表已满时退回块内描述符池
+        if (zc_type_registry_intern(g_type_registry, type_desc, desc_len, &type_id) != ZC_INTERNAL_OK) type_id = ZC_TYPE_ID_NONE;
+    }
+
+    return zc_dtt_insert(block, data_offset, obj_width, type_desc, desc_len, type_id);
+}
+
+/**
+ * 由描述符推导放置对齐
+ */
+static zc_internal_result_t zc_dtt_placement_align(const uint8_t* type_desc, uint64_t desc_len, uint64_t obj_width,
+    uint32_t* out_align)
+{
+    if (unlikely(!type_desc || desc_len == 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    uint64_t pos = 0;
+    while (pos < desc_len && (type_desc[pos] == ELEMENT_TYPE_ARRAY || type_desc[pos] == ELEMENT_TYPE_SZARRAY)) pos++;
+    if (unlikely(pos >= desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    // 数组的对齐即元素的对齐，只解码元素
+    zc_type_desc_info_t leaf;
+    zc_internal_result_t res = zc_type_desc_decode(type_desc + pos, desc_len - pos, &leaf);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    bool vector = type_desc[pos] == ELEMENT_TYPE_FLOATTENSOR;
+    if (pos > 0 && (leaf.flags & ZC_TYPE_DESC_FIXED_LEAF) && obj_width >= ZC_DTT_VECTOR_ALIGN) vector = true;
+
+    *out_align = vector ? ZC_DTT_VECTOR_ALIGN : leaf.align;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 对齐放置并添加一个新变量的 dtt 数据
+ */
+zc_internal_result_t zc_dtt_add_aligned(zc_block_header_t* block, uint64_t min_offset, uint64_t obj_width,
+    const uint8_t* type_desc, uint64_t desc_len, uint32_t alignment, uint64_t* out_offset)
+{
+    if (unlikely(!out_offset)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_internal_result_t res;
+    if (alignment == 0)
+    {
+        res = zc_dtt_placement_align(type_desc, desc_len, obj_width, &alignment);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    uint64_t data_offset;
+    res = zc_block_place(block, min_offset, obj_width, alignment, &data_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    res = zc_dtt_add(block, data_offset, obj_width, type_desc, desc_len);
+    if (likely(res == ZC_INTERNAL_OK)) *out_offset = data_offset;
+    return res;
+}
+
+/**
+ * 以驻留类型 ID 添加一个新变量的 dtt 数据
+ */
+zc_internal_result_t zc_dtt_add_by_id(zc_block_header_t* block,
+    uint64_t data_offset, uint64_t obj_width, zc_type_id_t type_id)
+{
+    if (unlikely(g_type_registry == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+
+    const uint8_t* type_desc;
+    uint64_t desc_len;
+    zc_internal_result_t res = zc_type_registry_get_desc(g_type_registry, type_id, &type_desc, &desc_len);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    return zc_dtt_insert(block, data_offset, obj_width, type_desc, desc_len, type_id);
+}
+
+/**
+ * 批量添加暂存的条目。type_desc 仅在描述符未驻留时使用
+ */
+typedef struct zc_dtt_staged_field
+{
+    zc_dtt_lut_entry_t entry;
+    const uint8_t*     type_desc;
+} zc_dtt_staged_field_t;
+
+static int zc_dtt_staged_compare(const void* a, const void* b)
+{
+    uint64_t lhs = ((const zc_dtt_staged_field_t*)a)->entry.data_offset;
+    uint64_t rhs = ((const zc_dtt_staged_field_t*)b)->entry.data_offset;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * 校验宽度、驻留描述符并按 data_offset 排序
+ */
+static zc_internal_result_t zc_dtt_stage_fields(const zc_dtt_field_t* fields, uint32_t field_count,
+    zc_dtt_staged_field_t* staged)
+{
+    uint32_t i;
+    for (i = 0; i < field_count; i++)
+    {
+        const zc_dtt_field_t* field = &fields[i];
+        if (unlikely(field->desc_len == 0 || field->obj_width == 0 || field->obj_width > ZC_DTT_OBJ_WIDTH_MAX)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+        zc_type_id_t type_id = ZC_TYPE_ID_NONE;
+        if (g_type_registry != NULL && field->desc_len <= ZC_TYPE_DESC_MAX_LEN)
+        {
+            // 驻留表已满时退回块内描述符池
+            if (zc_type_registry_intern(g_type_registry, field->type_desc, field->desc_len, &type_id) != ZC_INTERNAL_OK) type_id = ZC_TYPE_ID_NONE;
+        }
+        zc_internal_result_t res = zc_type_registry_check_width(g_type_registry, type_id, field->type_desc, field->desc_len, field->obj_width);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        staged[i].entry.data_offset = field->data_offset;
+        staged[i].entry.desc_offset = 0;
+        staged[i].entry.obj_width = field->obj_width;
+        staged[i].entry.type_tag = field->type_desc[0];
+        staged[i].entry.desc_length = (uint32_t)field->desc_len;
+        staged[i].entry.type_id = type_id;
+        staged[i].entry.desc_hash = zc_type_desc_hash(field->type_desc, field->desc_len);
+        staged[i].type_desc = field->type_desc;
+    }
+
+    qsort(staged, field_count, sizeof(zc_dtt_staged_field_t), zc_dtt_staged_compare);
+    return ZC_INTERNAL_OK;
+}
+
+typedef struct zc_dtt_merged_key
+{
+    uint64_t key;
+    uint64_t entry_offset;
+} zc_dtt_merged_key_t;
+
+/**
+ * 以一次有序归并合并现有条目与暂存条目，检查相邻区间重叠，写入新条目与描述符，得到合并后的有序键。
+ * 只在堆尾追加，不修改现有索引
+ */
+static zc_internal_result_t zc_dtt_merge_staged(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    zc_dtt_staged_field_t* staged, uint32_t staged_count, zc_dtt_merged_key_t* merged)
+{
+    zc_dtt_index_node_t* leaf = NULL;
+    uint32_t leaf_pos = 0;
+    if (lut_hdr->index_height > 0)
+    {
+        zc_dtt_index_path_t path;
+        zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, 0, &path, &leaf);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    uint64_t prev_end = 0;
+    uint32_t merged_count = 0;
+    uint32_t i = 0;
+
+    while (leaf != NULL || i < staged_count)
+    {
+        uint64_t entry_offset;
+        uint64_t data_offset;
+        uint64_t obj_width;
+
+        if (leaf != NULL && (i == staged_count || leaf->keys[leaf_pos] < staged[i].entry.data_offset))
+        {
+            entry_offset = leaf->slots[leaf_pos];
+            zc_dtt_lut_entry_t* entry = zc_block_offset_to_ptr(block, entry_offset);
+            if (unlikely(!entry)) return ZC_INTERNAL_BLOCK_ERROR;
+            data_offset = entry->data_offset;
+            obj_width = entry->obj_width;
+
+            if (++leaf_pos >= leaf->count)
+            {
+                leaf = leaf->next_leaf ? zc_block_offset_to_ptr(block, leaf->next_leaf) : NULL;
+                leaf_pos = 0;
+            }
+        }
+        else
+        {
+            zc_dtt_staged_field_t* field = &staged[i++];
+            data_offset = field->entry.data_offset;
+            obj_width = field->entry.obj_width;
+
+            if (field->entry.type_id == ZC_TYPE_ID_NONE)
+            {
+                field->entry.desc_offset = zc_dtt_heap_alloc(block, lut_hdr, field->entry.desc_length);
+                if (unlikely(field->entry.desc_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+                void* desc_ptr = zc_block_offset_to_ptr(block, field->entry.desc_offset);
+                if (unlikely(!desc_ptr)) return ZC_INTERNAL_BLOCK_ERROR;
+                memcpy(desc_ptr, field->type_desc, field->entry.desc_length);
+                lut_hdr->descriptor_length += field->entry.desc_length;
+            }
+
+            zc_internal_result_t res = zc_dtt_heap_append_entry(block, lut_hdr, &field->entry, &entry_offset);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        }
+
+        if (data_offset < prev_end) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+        prev_end = data_offset + obj_width;
+
+        if (unlikely(merged_count == lut_hdr->entry_count + staged_count)) return ZC_INTERNAL_BLOCK_ERROR;
+        merged[merged_count].key = data_offset;
+        merged[merged_count].entry_offset = entry_offset;
+        merged_count++;
+    }
+
+    if (unlikely(merged_count != lut_hdr->entry_count + staged_count)) return ZC_INTERNAL_BLOCK_ERROR;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 按层收集现有索引的全部节点
+ */
+static zc_internal_result_t zc_dtt_index_collect_nodes(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t** out_nodes, uint32_t* out_count)
+{
+    *out_nodes = NULL;
+    *out_count = 0;
+    if (lut_hdr->index_height == 0) return ZC_INTERNAL_OK;
+
+    uint32_t capacity = 64;
+    uint64_t* nodes = malloc(capacity * sizeof(uint64_t));
+    if (unlikely(nodes == NULL)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    nodes[0] = lut_hdr->index_root_offset;
+    uint32_t count = 1;
+    uint32_t level_begin = 0;
+    uint32_t level;
+    for (level = 1; level < lut_hdr->index_height; level++)
+    {
+        uint32_t level_end = count;
+        uint32_t k;
+        for (k = level_begin; k < level_end; k++)
+        {
+            zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, nodes[k]);
+            if (unlikely(!node || node->is_leaf || node->count > ZC_DTT_INDEX_FANOUT))
+            {
+                free(nodes);
+                return ZC_INTERNAL_BLOCK_ERROR;
+            }
+
+            if (count + node->count > capacity)
+            {
+                uint64_t* grown = malloc((count + node->count) * 2 * sizeof(uint64_t));
+                if (unlikely(grown == NULL))
+                {
+                    free(nodes);
+                    return ZC_INTERNAL_RUN_PTRNULL;
+                }
+                memcpy(grown, nodes, count * sizeof(uint64_t));
+                free(nodes);
+                nodes = grown;
+                capacity = (count + node->count) * 2;
+            }
+            memcpy(&nodes[count], node->slots, node->count * sizeof(uint64_t));
+            count += node->count;
+        }
+        level_begin = level_end;
+    }
+
+    *out_nodes = nodes;
+    *out_count = count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 由 key_count 个有序键顺序建树所需的节点数
+ */
+static uint32_t zc_dtt_index_node_total(uint32_t key_count)
+{
+    uint32_t level = (key_count + ZC_DTT_INDEX_FANOUT - 1) / ZC_DTT_INDEX_FANOUT;
+    uint32_t total = level;
+    while (level > 1)
+    {
+        level = (level + ZC_DTT_INDEX_FANOUT - 1) / ZC_DTT_INDEX_FANOUT;
+        total += level;
+    }
+    return total;
+}
+
+/**
+ * 由合并后的有序键整体重建索引。旧索引的节点全部回收复用，不足的部分先一次预留；
+ * 预留成功后建树不再分配堆空间，旧索引只在新索引一定能建成时才被覆盖
+ */
+static zc_internal_result_t zc_dtt_index_rebuild(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr,
+    const zc_dtt_merged_key_t* merged, uint32_t merged_count)
+{
+    uint64_t* old_nodes;
+    uint32_t old_count;
+    zc_internal_result_t res = zc_dtt_index_collect_nodes(block, lut_hdr, &old_nodes, &old_count);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    uint32_t total = zc_dtt_index_node_total(merged_count);
+    uint32_t pool_count = total > old_count ? total : old_count;
+    uint64_t* pool = old_nodes;
+    if (pool_count > old_count)
+    {
+        pool = realloc(old_nodes, pool_count * sizeof(uint64_t));
+        if (unlikely(pool == NULL))
+        {
+            free(old_nodes);
+            return ZC_INTERNAL_RUN_PTRNULL;
+        }
+        res = zc_dtt_index_reserve(block, lut_hdr, pool_count - old_count, &pool[old_count]);
+        if (unlikely(res != ZC_INTERNAL_OK))
+        {
+            free(pool);
+            return res;
+        }
+    }
+
+    zc_dtt_leaf_builder_t builder = { 0 };
+    builder.pool = pool;
+    builder.pool_count = pool_count;
+
+    uint32_t i;
+    for (i = 0; i < merged_count && res == ZC_INTERNAL_OK; i++)
+    {
+        res = zc_dtt_leaf_builder_push(block, lut_hdr, &builder, merged[i].key, merged[i].entry_offset);
+    }
+    if (res == ZC_INTERNAL_OK) res = zc_dtt_leaf_builder_finish(block, lut_hdr, &builder);
+
+    free(pool);
+    return res;
+}
+
+/**
+ * 先在本地完成驻留和排序，再一次归并写入条目与描述符，最后复用旧索引节点重建索引，失败时 DTTA 保持不变
+ */
+zc_internal_result_t zc_dtt_add_bulk(zc_block_header_t* block,
+    const zc_dtt_field_t* fields, uint32_t field_count)
+{
+    if (field_count == 0) return ZC_INTERNAL_OK;
+
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut_for_write(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if ((uint64_t)lut_hdr->entry_count + field_count > ZC_DTT_LUT_ENTRY_MAX_COUNT) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+    zc_dtt_staged_field_t* staged = malloc(field_count * sizeof(zc_dtt_staged_field_t));
+    if (unlikely(staged == NULL)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    uint32_t merged_count = lut_hdr->entry_count + field_count;
+    zc_dtt_merged_key_t* merged = malloc(merged_count * sizeof(zc_dtt_merged_key_t));
+    if (unlikely(merged == NULL))
+    {
+        free(staged);
+        return ZC_INTERNAL_RUN_PTRNULL;
+    }
+
+    res = zc_dtt_stage_fields(fields, field_count, staged);
+    if (res == ZC_INTERNAL_OK)
+    {
+        uint64_t heap_used = lut_hdr->heap_used;
+        uint64_t descriptor_length = lut_hdr->descriptor_length;
+        res = zc_dtt_merge_staged(block, lut_hdr, staged, field_count, merged);
+        if (res == ZC_INTERNAL_OK) res = zc_dtt_index_rebuild(block, lut_hdr, merged, merged_count);
+        if (res != ZC_INTERNAL_OK)
+        {
+            lut_hdr->heap_used = heap_used;
+            lut_hdr->descriptor_length = descriptor_length;
+        }
+    }
+
+    free(merged);
+    free(staged);
+    return res;
+}
+
+/**
+ * 
+ */
+zc_internal_result_t zc_dtt_init_from_schema(zc_block_header_t* block, uint32_t schema_id)
+{
+    if (unlikely(g_schema_table == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+    zc_schema_slot_t* schema = zc_schema_get(g_schema_table, schema_id);
+    if (unlikely(!schema)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (lut_hdr->entry_count != 0) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+    if (zc_schema_data_extent(schema) > block->lut_offset) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+    lut_hdr->entry_count = schema->entry_count;
+    lut_hdr->schema_id = schema_id;
+
+    return ZC_INTERNAL_OK;
+}
+
+zc_internal_result_t zc_dtt_modify(zc_block_header_t* block,
+    uint64_t data_offset, uint64_t new_data_offset, uint64_t new_obj_width,
+    const uint8_t* new_type_desc, uint64_t new_desc_len)
+{
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut_for_write(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // Search for old entry
+    if (lut_hdr->index_height == 0) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+    zc_dtt_index_path_t path;
+    zc_dtt_index_node_t* leaf;
+    res = zc_dtt_index_descend(block, lut_hdr, data_offset, &path, &leaf);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    // Check LUT entry count
-    if (lut_hdr->entry_count >= ZC_DTT_LUT_ENTRY_MAX_COUNT) return ZC_INTERNAL_DTTA_LUT_FULL;
+    uint32_t rank = path.child_index[lut_hdr->index_height - 1];
+    if (rank == 0 || leaf->keys[rank - 1] != data_offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    uint64_t entry_offset = leaf->slots[rank - 1];
+    zc_dtt_lut_entry_t* old_entry = zc_block_offset_to_ptr(block, entry_offset);
+    if (unlikely(!old_entry)) return ZC_INTERNAL_BLOCK_ERROR;
+
+    // Check basic type and desc length
+    if (new_desc_len != old_entry->desc_length || new_type_desc[0] != old_entry->type_tag) return ZC_INTERNAL_DTTA_DESC_MISMATCH;
 
-    // Binary search for insert position
-    int lo = 0;
-    int hi = lut_hdr->entry_count;
-    while (lo < hi)
+    // 驻留描述符不可原地修改，改为引用新描述符的 ID
+    uint8_t* old_desc = NULL;
+    zc_type_id_t new_type_id = ZC_TYPE_ID_NONE;
+    if (old_entry->type_id != ZC_TYPE_ID_NONE)
     {
-        int mid = (lo + hi) / 2;
-        if (entries[mid].data_offset < data_offset)
-            lo = mid + 1;
-        else
-            hi = mid;
+        if (unlikely(g_type_registry == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+        res = zc_type_registry_intern(g_type_registry, new_type_desc, new_desc_len, &new_type_id);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+    else
+    {
+        old_desc = zc_block_offset_to_ptr(block, old_entry->desc_offset);
+        if (unlikely(!old_desc)) return ZC_INTERNAL_RUN_PTRNULL;
     }
-    int insert_pos = lo;
 
-    // Check overlap with prev
-    if (insert_pos > 0)
+    if (unlikely(new_obj_width == 0 || new_obj_width > ZC_DTT_OBJ_WIDTH_MAX)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    res = zc_type_registry_check_width(g_type_registry, new_type_id, new_type_desc, new_desc_len, new_obj_width);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // Check overlap, ignoring the entry being modified
+    res = zc_dtt_index_check_overlap(block, lut_hdr, new_data_offset, new_obj_width, entry_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // If data_offset changes, move the key in the index. The entry itself stays in place
+    if (new_data_offset != data_offset)
     {
-        zc_dtt_lut_entry_t* prev = &entries[insert_pos - 1];
-        uint64_t prev_width;
-        uint8_t* prev_desc = zc_block_offset_to_ptr(block, prev->desc_offset);
-        if (!prev_desc) return ZC_INTERNAL_RUN_PTRNULL;
+        // 删除后新路径上的满节点数不超过原树高 + 1，先按上限预留，未用部分归还
+        uint64_t heap_used = lut_hdr->heap_used;
+        uint64_t nodes[ZC_DTT_INDEX_MAX_HEIGHT + 1];
+        uint32_t reserve_count = lut_hdr->index_height + 1;
+        if (reserve_count > ZC_DTT_INDEX_MAX_HEIGHT) reserve_count = ZC_DTT_INDEX_MAX_HEIGHT;
+        res = zc_dtt_index_reserve(block, lut_hdr, reserve_count, nodes);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-        zc_internal_result_t res = zc_type_desc_get_obj_size(prev_desc, prev->desc_length, &prev_width);
+        res = zc_dtt_index_remove(block, lut_hdr, &path);
         if (unlikely(res != ZC_INTERNAL_OK)) return res;
-        if (prev->data_offset + prev_width > data_offset)
+
+        if (lut_hdr->index_height > 0)
         {
-            return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+            res = zc_dtt_index_descend(block, lut_hdr, new_data_offset, &path, &leaf);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
         }
+
+        uint32_t used = zc_dtt_index_insert(block, lut_hdr, &path, new_data_offset, entry_offset, nodes);
+        if (used == 0) lut_hdr->heap_used = heap_used;
+        else lut_hdr->heap_used = nodes[used - 1] + sizeof(zc_dtt_index_node_t) - lut_hdr->heap_start_offset;
+    }
+
+    // Apply modifications
+    if (old_desc != NULL) memcpy(old_desc, new_type_desc, new_desc_len);
+    else old_entry->type_id = new_type_id;
+    old_entry->desc_hash = zc_type_desc_hash(new_type_desc, new_desc_len);
+    old_entry->obj_width = new_obj_width;
+    old_entry->data_offset = new_data_offset;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 冻结段第 page 页的数据区，经页目录取得，不沿页链从块首定位
+ */
+static inline uint8_t* zc_dtt_frozen_page(const zc_dtt_lut_header_t* lut_hdr, uint64_t page)
+{
+    zc_page_t* dir = (zc_page_t*)(uintptr_t)lut_hdr->frozen_dir_addr;
+    while (unlikely(page >= ZC_DTT_FROZEN_DIR_PER_PAGE))
+    {
+        dir = (zc_page_t*)(uintptr_t)dir->tail.next_page_addr;
+        page -= ZC_DTT_FROZEN_DIR_PER_PAGE;
+    }
+    return (uint8_t*)(uintptr_t)((const uint64_t*)dir->data)[page];
+}
+
+static inline zc_dtt_lut_entry_t* zc_dtt_frozen_entry(const zc_dtt_lut_header_t* lut_hdr, uint32_t index)
+{
+    return (zc_dtt_lut_entry_t*)(zc_dtt_frozen_page(lut_hdr, index / ZC_DTT_FROZEN_ENTRIES_PER_PAGE)
+        + (uint64_t)(index % ZC_DTT_FROZEN_ENTRIES_PER_PAGE) * ZC_DTT_LUT_ENTRY_SIZE);
+}
+
+static inline uint32_t* zc_dtt_frozen_slot(const zc_dtt_lut_header_t* lut_hdr, uint32_t granule)
+{
+    uint64_t entry_pages = (lut_hdr->entry_count + ZC_DTT_FROZEN_ENTRIES_PER_PAGE - 1) / ZC_DTT_FROZEN_ENTRIES_PER_PAGE;
+    return (uint32_t*)(zc_dtt_frozen_page(lut_hdr, entry_pages + granule / ZC_DTT_FROZEN_SLOTS_PER_PAGE)
+        + (uint64_t)(granule % ZC_DTT_FROZEN_SLOTS_PER_PAGE) * sizeof(uint32_t));
+}
+
+/**
+ * 复制条目到分段数组并建立页目录与粒度区间表
+ */
+static zc_internal_result_t zc_dtt_freeze_build(zc_block_header_t* block, zc_dtt_lut_header_t* lut_hdr)
+{
+    uint32_t entry_count = lut_hdr->entry_count;
+
+    // 粒度取满足表项数上限的最小 2 的幂
+    uint64_t extent = block->lut_offset;
+    uint64_t granule_limit = (uint64_t)entry_count * ZC_DTT_FROZEN_GRANULES_PER_ENTRY;
+    if (granule_limit == 0) granule_limit = 1;
+    uint32_t shift = 0;
+    while (((extent - 1) >> shift) + 1 > granule_limit) shift++;
+    uint32_t granule_count = (uint32_t)(((extent - 1) >> shift) + 1);
+
+    uint64_t entry_pages = (entry_count + ZC_DTT_FROZEN_ENTRIES_PER_PAGE - 1) / ZC_DTT_FROZEN_ENTRIES_PER_PAGE;
+    uint64_t table_pages = ((uint64_t)granule_count + 1 + ZC_DTT_FROZEN_SLOTS_PER_PAGE - 1) / ZC_DTT_FROZEN_SLOTS_PER_PAGE;
+    uint64_t frozen_pages = entry_pages + table_pages;
+    uint64_t dir_pages = (frozen_pages + ZC_DTT_FROZEN_DIR_PER_PAGE - 1) / ZC_DTT_FROZEN_DIR_PER_PAGE;
+
+    // 目录页、条目页、区间表页依次连续分配
+    uint64_t dir_offset = zc_dtt_heap_alloc_pages(block, lut_hdr, dir_pages + frozen_pages);
+    if (unlikely(dir_offset == 0)) return ZC_INTERNAL_DTTA_OVERFLOW;
+    uint8_t* dir_data = zc_block_offset_to_ptr(block, dir_offset);
+    if (unlikely(!dir_data)) return ZC_INTERNAL_BLOCK_ERROR;
+
+    // 沿页链解析一次各分段页的地址
+    zc_page_t* dir = (zc_page_t*)(dir_data - offsetof(zc_page_t, data));
+    zc_page_t* page = dir;
+    uint64_t k;
+    for (k = 0; k < dir_pages; k++)
+    {
+        page = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
+        if (unlikely(!page)) return ZC_INTERNAL_BLOCK_ERROR;
     }
 
-    // Check overlap with next
-    if (insert_pos < lut_hdr->entry_count)
+    zc_page_t* dir_page = dir;
+    for (k = 0; k < frozen_pages; k++)
     {
-        zc_dtt_lut_entry_t* next = &entries[insert_pos];
-        if (data_offset + obj_width > next->data_offset)
+        if (k > 0 && k % ZC_DTT_FROZEN_DIR_PER_PAGE == 0) dir_page = (zc_page_t*)(uintptr_t)dir_page->tail.next_page_addr;
+        ((uint64_t*)dir_page->data)[k % ZC_DTT_FROZEN_DIR_PER_PAGE] = (uint64_t)(uintptr_t)page->data;
+        if (k + 1 == frozen_pages) break;
+        page = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
+        if (unlikely(!page)) return ZC_INTERNAL_BLOCK_ERROR;
+    }
+
+    lut_hdr->frozen_entry_offset = dir_offset + dir_pages * ZC_PAGE_DATA_SIZE;
+    lut_hdr->frozen_table_offset = lut_hdr->frozen_entry_offset + entry_pages * ZC_PAGE_DATA_SIZE;
+    lut_hdr->frozen_granule_shift = shift;
+    lut_hdr->frozen_granule_count = granule_count;
+    lut_hdr->frozen_dir_addr = (uint64_t)(uintptr_t)dir;
+
+    // 沿叶子链表顺序复制
+    zc_dtt_index_node_t* leaf = NULL;
+    if (lut_hdr->index_height > 0)
+    {
+        zc_dtt_index_path_t path;
+        zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, 0, &path, &leaf);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    }
+
+    uint32_t i = 0;
+    while (leaf != NULL)
+    {
+        uint32_t pos;
+        for (pos = 0; pos < leaf->count; pos++)
         {
-            return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+            zc_dtt_lut_entry_t* src = zc_block_offset_to_ptr(block, leaf->slots[pos]);
+            if (unlikely(!src || i >= entry_count)) return ZC_INTERNAL_BLOCK_ERROR;
+            *zc_dtt_frozen_entry(lut_hdr, i++) = *src;
         }
+        leaf = leaf->next_leaf ? zc_block_offset_to_ptr(block, leaf->next_leaf) : NULL;
     }
+    if (unlikely(i != entry_count)) return ZC_INTERNAL_BLOCK_ERROR;
 
-    // Check DTTA descriptor pool space
-    uint64_t current_end = lut_hdr->descriptor_start_offset + lut_hdr->descriptor_length;
-    if (lut_hdr->descriptor_length + desc_len > block->cover_page_count * ZC_PAGE_DATA_SIZE)
+    // 表项为起点早于粒度起点（含）的条目数，末项为条目总数
+    uint32_t rank = 0;
+    uint32_t g;
+    for (g = 0; g < granule_count; g++)
     {
-        return ZC_INTERNAL_DTTA_OVERFLOW;
+        uint64_t start = (uint64_t)g << shift;
+        while (rank < entry_count && zc_dtt_frozen_entry(lut_hdr, rank)->data_offset <= start) rank++;
+        *zc_dtt_frozen_slot(lut_hdr, g) = rank;
     }
+    *zc_dtt_frozen_slot(lut_hdr, granule_count) = entry_count;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 
+ */
+zc_internal_result_t zc_dtt_freeze(zc_block_header_t* block)
+{
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // 模式条目本身已是不可变的有序数组
+    if (lut_hdr->frozen || lut_hdr->schema_id != ZC_SCHEMA_ID_NONE) return ZC_INTERNAL_OK;
 
-    // Insert LUT entry
-    if (insert_pos < lut_hdr->entry_count)
+    uint64_t heap_used = lut_hdr->heap_used;
+    res = zc_dtt_freeze_build(block, lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK))
     {
-        memmove(&entries[insert_pos + 1], &entries[insert_pos],
-                (lut_hdr->entry_count - insert_pos) * ZC_DTT_LUT_ENTRY_SIZE);
+        lut_hdr->heap_used = heap_used;
+        return res;
     }
-    entries[insert_pos].data_offset = data_offset;
-    entries[insert_pos].desc_offset = current_end;
-    entries[insert_pos].desc_length = desc_len;
 
-    // Write descriptor
-    void* desc_ptr = zc_block_offset_to_ptr(block, current_end);
-    if (unlikely(!desc_ptr)) return ZC_INTERNAL_BLOCK_ERROR;
-    memcpy(desc_ptr, type_desc, desc_len);
+    lut_hdr->frozen = 1;
+    return ZC_INTERNAL_OK;
+}
 
-    // Update metadata
-    lut_hdr->entry_count++;
-    lut_hdr->descriptor_length += desc_len;
+/**
+ * 按 data_offset 升序遍历条目的游标，统一冻结数组、模式数组与 B+ 树叶子链表三种形态
+ */
+typedef struct zc_dtt_cursor
+{
+    zc_block_header_t*         block;
+    const zc_dtt_lut_header_t* lut_hdr;
+    zc_dtt_lut_entry_t*        entries;   // 模式形态的条目数组
+    zc_dtt_index_node_t*       leaf;      // B+ 树形态的当前叶子
+    uint32_t                   pos;       // 数组下标或叶内位置
+    zc_dtt_lut_entry_t*        entry;     // 当前条目，越界时为 NULL
+} zc_dtt_cursor_t;
+
+static zc_internal_result_t zc_dtt_cursor_load(zc_dtt_cursor_t* cursor)
+{
+    cursor->entry = NULL;
+
+    if (cursor->lut_hdr->frozen || cursor->entries)
+    {
+        if (cursor->pos >= cursor->lut_hdr->entry_count) return ZC_INTERNAL_OK;
+        cursor->entry = cursor->entries ? &cursor->entries[cursor->pos]
+            : zc_dtt_frozen_entry(cursor->lut_hdr, cursor->pos);
+    }
+    else
+    {
+        if (!cursor->leaf || cursor->pos >= cursor->leaf->count) return ZC_INTERNAL_OK;
+        cursor->entry = zc_block_offset_to_ptr(cursor->block, cursor->leaf->slots[cursor->pos]);
+    }
 
+    if (unlikely(!cursor->entry)) return ZC_INTERNAL_BLOCK_ERROR;
     return ZC_INTERNAL_OK;
 }
 
-zc_internal_result_t zc_dtt_modify(zc_block_header_t* block,
-    uint64_t data_offset, uint64_t new_data_offset, uint64_t new_obj_width,
-    const uint8_t* new_type_desc, uint64_t new_desc_len)
+/**
+ * 定位到 data_offset <= key 的最后一个条目，不存在时 entry 为 NULL。
+ * 冻结后使用粒度区间表，块引用模式时在模式的有序键数组上查找
+ */
+static zc_internal_result_t zc_dtt_cursor_seek(zc_block_header_t* block, const zc_dtt_lut_header_t* lut_hdr,
+    uint64_t key, zc_dtt_cursor_t* cursor)
 {
-    // Get LUT pointers
-    zc_dtt_lut_header_t* lut_hdr = zc_block_offset_to_ptr(block, ZC_BLOCK_HEADER_SIZE + block->lut_offset);
-    if (unlikely(!lut_hdr)) return ZC_INTERNAL_BLOCK_ERROR;
-    zc_dtt_lut_entry_t* entries = zc_block_offset_to_ptr(block, lut_hdr->lut_first_entry_offset);
-    if (unlikely(!entries)) return ZC_INTERNAL_BLOCK_ERROR;
+    cursor->block = block;
+    cursor->lut_hdr = lut_hdr;
+    cursor->entries = NULL;
+    cursor->leaf = NULL;
+    cursor->pos = 0;
+    cursor->entry = NULL;
 
-    // Binary search for old entry
-    int lo = 0;
-    int hi = lut_hdr->entry_count;
-    while (lo < hi)
+    uint32_t rank;
+    if (lut_hdr->frozen)
     {
-        int mid = (lo + hi) / 2;
-        if (entries[mid].data_offset < data_offset)
-            lo = mid + 1;
+        uint64_t granule = key >> lut_hdr->frozen_granule_shift;
+        if (unlikely(granule >= lut_hdr->frozen_granule_count)) rank = lut_hdr->entry_count;
         else
-            hi = mid;
+        {
+            // 粒度 g 之前开始的条目都 <= key，之后开始的都 > key，只需在粒度内开始的条目上二分
+            uint32_t lo = *zc_dtt_frozen_slot(lut_hdr, (uint32_t)granule);
+            uint32_t hi = *zc_dtt_frozen_slot(lut_hdr, (uint32_t)granule + 1);
+            while (lo < hi)
+            {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (zc_dtt_frozen_entry(lut_hdr, mid)->data_offset <= key) lo = mid + 1;
+                else hi = mid;
+            }
+            rank = lo;
+        }
     }
-    if (lo >= lut_hdr->entry_count || entries[lo].data_offset != data_offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+    else if (lut_hdr->schema_id != ZC_SCHEMA_ID_NONE)
+    {
+        if (unlikely(g_schema_table == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+        zc_schema_slot_t* schema = zc_schema_get(g_schema_table, lut_hdr->schema_id);
+        if (unlikely(!schema)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
 
-    int old_index = lo;
-    zc_dtt_lut_entry_t* old_entry = &entries[old_index];
+        cursor->entries = &g_schema_table->entries[schema->first_entry];
+        rank = zc_dtt_key_rank(&g_schema_table->keys[schema->first_entry],
+            ZC_DTT_KEY_PADDED_COUNT(schema->entry_count), key);
+    }
+    else
+    {
+        if (lut_hdr->index_height == 0) return ZC_INTERNAL_OK;
 
-    // Check basic type and desc length
-    uint8_t* old_desc = zc_block_offset_to_ptr(block, old_entry->desc_offset);
-    if (unlikely(!old_desc)) return ZC_INTERNAL_RUN_PTRNULL;
+        zc_dtt_index_path_t path;
+        zc_internal_result_t res = zc_dtt_index_descend(block, lut_hdr, key, &path, &cursor->leaf);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        rank = path.child_index[lut_hdr->index_height - 1];
+    }
 
-    if (new_desc_len != old_entry->desc_length || new_type_desc[0] != old_desc[0]) return ZC_INTERNAL_DTTA_DESC_MISMATCH;
+    if (rank == 0) return ZC_INTERNAL_OK;
+    cursor->pos = rank - 1;
+    return zc_dtt_cursor_load(cursor);
+}
 
-    // Check overlap
-    int insert_pos = old_index;
-    uint64_t new_end = new_data_offset + new_obj_width;
-    uint64_t old_obj_width;
-    zc_internal_result_t res = zc_type_desc_get_obj_size(old_desc, old_entry->desc_length, &old_obj_width);
-    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+/**
+ * 前进到下一个条目，B+ 树形态沿叶子链表跨叶
+ */
+static zc_internal_result_t zc_dtt_cursor_next(zc_dtt_cursor_t* cursor)
+{
+    cursor->pos++;
+    if (cursor->leaf && cursor->pos >= cursor->leaf->count && cursor->leaf->next_leaf)
+    {
+        cursor->leaf = zc_block_offset_to_ptr(cursor->block, cursor->leaf->next_leaf);
+        if (unlikely(!cursor->leaf)) return ZC_INTERNAL_BLOCK_ERROR;
+        cursor->pos = 0;
+    }
+    return zc_dtt_cursor_load(cursor);
+}
 
-    if (new_data_offset != data_offset)
+/**
+ * 复合对象中第一个结束于 offset 之后的直接字段，iter 停在该字段之后。不存在时 out_found 为 false
+ */
+static zc_internal_result_t zc_dtt_field_seek(zc_type_field_iter_t* iter, uint64_t base, uint64_t offset,
+    zc_type_field_t* out_field, bool* out_found)
+{
+    *out_found = false;
+    while (!zc_type_field_iter_done(iter))
     {
-        // data_offset changes, search for new insert position
-        lo = 0;
-        hi = lut_hdr->entry_count;
-        while (lo < hi)
+        zc_internal_result_t res = zc_type_field_iter_next(iter, out_field);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        if (base + out_field->offset + out_field->size > offset)
         {
-            int mid = (lo + hi) / 2;
-            if (entries[mid].data_offset < new_data_offset)
-                lo = mid + 1;
-            else
-                hi = mid;
+            *out_found = true;
+            return ZC_INTERNAL_OK;
         }
-        insert_pos = lo;
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 检查 [start, end) 是否恰好覆盖复合对象中某一层连续的平级字段。
+ * 范围落在单个字段内部时下降一层，每层只顺序解析一次描述符
+ */
+static zc_internal_result_t zc_dtt_check_field_coverage(const uint8_t* desc, uint64_t desc_len,
+    uint64_t base, uint64_t start, uint64_t end)
+{
+    for (;;)
+    {
+        if (!zc_type_is_composite(desc[0])) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
 
-        // Check overlap with prev
-        if (insert_pos > 0)
+        zc_type_field_iter_t iter;
+        zc_internal_result_t res = zc_type_field_iter_init(&iter, desc, desc_len);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        zc_type_field_t field;
+        bool found;
+        res = zc_dtt_field_seek(&iter, base, start, &field, &found);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        // start 落在填充字节中
+        if (!found || base + field.offset > start) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+
+        uint64_t covered = base + field.offset + field.size;
+        if (base + field.offset < start || covered > end)
         {
-            zc_dtt_lut_entry_t* prev = &entries[insert_pos - 1];
-            if (prev != old_entry)
-            {
-                uint64_t prev_width;
-                uint8_t* prev_desc_ptr = zc_block_offset_to_ptr(block, prev->desc_offset);
-                if (unlikely(!prev_desc_ptr)) return ZC_INTERNAL_RUN_PTRNULL;
-                res = zc_type_desc_get_obj_size(prev_desc_ptr, prev->desc_length, &prev_width);
-                if (unlikely(res != ZC_INTERNAL_OK)) return res;
-                if (prev->data_offset + prev_width > new_data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
-            }
+            desc = field.desc;
+            desc_len = field.desc_len;
+            base += field.offset;
+            continue;
         }
 
-        // Check overlap with next
-        if (insert_pos < lut_hdr->entry_count)
+        // 字段之间的对齐填充属于被覆盖的范围
+        while (covered < end)
         {
-            zc_dtt_lut_entry_t* next = &entries[insert_pos];
-            if (next != old_entry)
-            {
-                if (new_end > next->data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
-            }
+            if (zc_type_field_iter_done(&iter)) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+            res = zc_type_field_iter_next(&iter, &field);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+            covered = base + field.offset + field.size;
         }
+        return covered == end ? ZC_INTERNAL_OK : ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
     }
-    else
+}
+
+/**
+ * 条目类型已驻留时取其展开字段表
+ */
+static inline bool zc_dtt_entry_layout(const zc_dtt_lut_entry_t* entry,
+    const zc_type_layout_field_t** out_fields, uint32_t* out_field_count)
+{
+    return entry->type_id != ZC_TYPE_ID_NONE && g_type_registry != NULL && zc_type_is_composite(entry->type_tag)
+        && zc_type_registry_get_layout(g_type_registry, entry->type_id, out_fields, out_field_count) == ZC_INTERNAL_OK;
+}
+
+/**
+ * 展开字段表中 [lo, hi) 这一层第一个结束于 rel 之后的字段，不存在时为 hi
+ */
+static inline uint32_t zc_dtt_layout_seek(const zc_type_layout_field_t* fields, uint32_t lo, uint32_t hi, uint64_t rel)
+{
+    uint32_t i = lo;
+    while (i < hi && fields[i].offset + fields[i].size <= rel) i = fields[i].next;
+    return i;
+}
+
+/**
+ * zc_dtt_check_field_coverage 的展开字段表版本，偏移相对于对象起始，不再解析描述符
+ */
+static zc_internal_result_t zc_dtt_check_layout_coverage(const zc_type_layout_field_t* fields,
+    uint32_t field_count, uint64_t start, uint64_t end)
+{
+    uint32_t lo = 0;
+    uint32_t hi = field_count;
+    for (;;)
     {
-        // data_offset doesn't change, stay at the same LUT index
-        // Check overlap with prev
-        if (old_index > 0)
+        uint32_t i = zc_dtt_layout_seek(fields, lo, hi, start);
+        if (i >= hi || fields[i].offset > start) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+
+        uint64_t covered = fields[i].offset + fields[i].size;
+        if (fields[i].offset < start || covered > end)
         {
-            zc_dtt_lut_entry_t* prev = &entries[old_index - 1];
-            uint64_t prev_width;
-            uint8_t* prev_desc_ptr = zc_block_offset_to_ptr(block, prev->desc_offset);
-            if (!prev_desc_ptr) return ZC_INTERNAL_RUN_PTRNULL;
-            res = zc_type_desc_get_obj_size(prev_desc_ptr, prev->desc_length, &prev_width);
-            if (unlikely(res != ZC_INTERNAL_OK)) return res;
-            if (prev->data_offset + prev_width > new_data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+            if (!zc_type_is_composite(fields[i].tag)) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+            lo = i + 1;
+            hi = fields[i].next;
+            continue;
         }
 
-        // Check overlap with next
-        if (old_index + 1 < lut_hdr->entry_count)
+        for (i = fields[i].next; covered < end; i = fields[i].next)
         {
-            zc_dtt_lut_entry_t* next = &entries[old_index + 1];
-            if (new_end > next->data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+            if (i >= hi) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+            covered = fields[i].offset + fields[i].size;
         }
+        return covered == end ? ZC_INTERNAL_OK : ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
     }
+}
 
-    // Apply modifications
-    memcpy(old_desc, new_type_desc, new_desc_len);
+/**
+ * 检查 [start, end) 是否恰好覆盖连续的平级变量或字段。游标位于 start 的 floor 条目，
+ * 顶层沿有序条目线性前进一次，范围落在单个变量内部时转入字段检查，代价为 O(覆盖的字段数)
+ */
+static zc_internal_result_t zc_dtt_check_range_coverage(zc_dtt_cursor_t* cursor, uint64_t start, uint64_t end)
+{
+    zc_dtt_lut_entry_t* entry = cursor->entry;
+    if (entry == NULL || start >= entry->data_offset + entry->obj_width) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
 
-    // If data_offset changes, reorder entries
-    if (insert_pos > old_index)
+    uint64_t covered = entry->data_offset + entry->obj_width;
+    if (entry->data_offset != start || covered > end)
     {
-        zc_dtt_lut_entry_t buffer = entries[old_index];
-        buffer.data_offset = new_data_offset;
-
-        memmove(&entries[old_index], &entries[old_index + 1], (insert_pos - old_index - 1) * ZC_DTT_LUT_ENTRY_SIZE);
+        const zc_type_layout_field_t* fields;
+        uint32_t field_count;
+        if (zc_dtt_entry_layout(entry, &fields, &field_count))
+        {
+            return zc_dtt_check_layout_coverage(fields, field_count, start - entry->data_offset, end - entry->data_offset);
+        }
 
-        entries[insert_pos - 1] = buffer;
+        uint8_t* desc = zc_dtt_entry_desc(cursor->block, entry);
+        if (unlikely(!desc)) return ZC_INTERNAL_RUN_PTRNULL;
+        return zc_dtt_check_field_coverage(desc, entry->desc_length, entry->data_offset, start, end);
     }
-    else if (insert_pos < old_index)
-    {
-        zc_dtt_lut_entry_t buffer = entries[old_index];
-        buffer.data_offset = new_data_offset;
 
-        memmove(&entries[insert_pos + 1], &entries[insert_pos], (old_index - insert_pos) * ZC_DTT_LUT_ENTRY_SIZE);
+    // 顶层变量之间不允许有空洞
+    while (covered < end)
+    {
+        zc_internal_result_t res = zc_dtt_cursor_next(cursor);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-        entries[insert_pos] = buffer;
+        entry = cursor->entry;
+        if (entry == NULL || entry->data_offset != covered) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+        covered = entry->data_offset + entry->obj_width;
     }
-    // if insert_pos == old_index, nothing to do (should not happen if data_offset changed)
-
-    return ZC_INTERNAL_OK;
+    return covered == end ? ZC_INTERNAL_OK : ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
 }
 
-zc_internal_result_t zc_dtt_get_desc_by_data_offset(zc_block_header_t* block,
-    uint64_t data_offset, uint8_t** out_type_desc,
-    uint64_t* out_desc_len, uint64_t* out_obj_offset)
+zc_internal_result_t zc_dtt_get_entry_by_data_offset(zc_block_header_t* block,
+    uint64_t data_offset, zc_dtt_lut_entry_t** out_entry, uint64_t* out_obj_offset)
 {
     if (data_offset >= block->lut_offset) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
 
-    // Get LUT pointers
-    zc_dtt_lut_header_t* lut_hdr = zc_block_offset_to_ptr(block, ZC_BLOCK_HEADER_SIZE + block->lut_offset);
-    if (unlikely(!lut_hdr)) return ZC_INTERNAL_BLOCK_ERROR;
-    zc_dtt_lut_entry_t* entries = zc_block_offset_to_ptr(block, lut_hdr->lut_first_entry_offset);
-    if (unlikely(!entries)) return ZC_INTERNAL_BLOCK_ERROR;
-
-    uint32_t entry_count = lut_hdr->entry_count;
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    // Binary search for last entry with data_offset <= query_offset
-    int lo = 0;
-    int hi = entry_count;
-    while (lo < hi)
-    {
-        int mid = (lo + hi) / 2;
-        if (entries[mid].data_offset <= data_offset)
-        {
-            lo = mid + 1;
-        }
-        else
-        {
-            hi = mid;
-        }
-    }
-    int candidate_index = lo - 1;
+    // Find the last entry with data_offset <= query_offset
+    zc_dtt_cursor_t cursor;
+    res = zc_dtt_cursor_seek(block, lut_hdr, data_offset, &cursor);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    zc_dtt_lut_entry_t* candidate = cursor.entry;
 
     // Case 1: candidate exists, check if covering query_offset
-    if (candidate_index >= 0)
+    if (candidate != NULL)
     {
-        zc_dtt_lut_entry_t* candidate = &entries[candidate_index];
-        uint8_t* desc_ptr = (uint8_t*)zc_block_offset_to_ptr(block, candidate->desc_offset);
-        if (unlikely(!desc_ptr)) return ZC_INTERNAL_RUN_PTRNULL;
-
-        uint64_t obj_width = 0;
-        zc_internal_result_t res = zc_type_desc_get_obj_size(desc_ptr, candidate->desc_length, &obj_width);
-        if (unlikely(res != ZC_INTERNAL_OK)) return res;
-
-        uint64_t obj_end = candidate->data_offset + obj_width;
+        uint64_t obj_end = candidate->data_offset + candidate->obj_width;
         if (data_offset < obj_end)
         {
             // Offset hits candidate
+            *out_entry = candidate;
             *out_obj_offset = candidate->data_offset;
-            *out_desc_len = candidate->desc_length;
-            *out_type_desc = desc_ptr;
             return ZC_INTERNAL_OK;
         }
         // Else, offset is at the hole after candidate
@@ -274,9 +1616,84 @@ zc_internal_result_t zc_dtt_get_desc_by_data_offset(zc_block_header_t* block,
         *out_obj_offset = 0;
     }
 
-    *out_type_desc = NULL;
-    *out_desc_len = 0;
+    *out_entry = NULL;
+
+    return ZC_INTERNAL_OK;
+}
+
+zc_internal_result_t zc_dtt_get_desc_by_data_offset(zc_block_header_t* block,
+    uint64_t data_offset, uint8_t** out_type_desc,
+    uint64_t* out_desc_len, uint64_t* out_obj_offset)
+{
+    zc_dtt_lut_entry_t* entry = NULL;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, data_offset, &entry, out_obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    if (entry == NULL)
+    {
+        *out_type_desc = NULL;
+        *out_desc_len = 0;
+        return ZC_INTERNAL_OK;
+    }
+
+    uint8_t* desc_ptr = zc_dtt_entry_desc(block, entry);
+    if (unlikely(!desc_ptr)) return ZC_INTERNAL_RUN_PTRNULL;
 
+    *out_type_desc = desc_ptr;
+    *out_desc_len = entry->desc_length;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 准备带类型读取的期望描述符。已 attach 驻留表时将其驻留，之后与已驻留条目的比较只需比较 ID
+ */
+zc_internal_result_t zc_dtt_type_key_init(const uint8_t* desc, uint64_t desc_len, zc_dtt_type_key_t* out_key)
+{
+    if (unlikely(!desc || !out_key)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(desc_len == 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    out_key->desc = desc;
+    out_key->desc_len = desc_len;
+    out_key->desc_hash = zc_type_desc_hash(desc, desc_len);
+    out_key->type_id = ZC_TYPE_ID_NONE;
+    if (g_type_registry != NULL && desc_len <= ZC_TYPE_DESC_MAX_LEN)
+    {
+        // 驻留表已满时退回逐字节比较
+        if (zc_type_registry_intern(g_type_registry, desc, desc_len, &out_key->type_id) != ZC_INTERNAL_OK) out_key->type_id = ZC_TYPE_ID_NONE;
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 条目的描述符是否与期望描述符完全相等
+ */
+static inline bool zc_dtt_entry_matches(zc_block_header_t* block, const zc_dtt_lut_entry_t* entry,
+    const zc_dtt_type_key_t* key)
+{
+    // 驻留 ID 相等等价于描述符相等
+    if (entry->type_id != ZC_TYPE_ID_NONE && key->type_id != ZC_TYPE_ID_NONE) return entry->type_id == key->type_id;
+    if (!zc_dtt_entry_fingerprint_matches(entry, key)) return false;
+
+    // 指纹相同而有一侧未驻留（未 attach 驻留表、驻留表已满或条目写入早于 attach），逐字节确认
+    const uint8_t* desc = zc_dtt_entry_desc(block, entry);
+    return desc != NULL && memcmp(desc, key->desc, key->desc_len) == 0;
+}
+
+zc_internal_result_t zc_dtt_get_entry_typed(zc_block_header_t* block,
+    uint64_t data_offset, const zc_dtt_type_key_t* key, zc_dtt_lut_entry_t** out_entry)
+{
+    if (unlikely(!block || !key || !out_entry)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_dtt_lut_entry_t* entry = NULL;
+    uint64_t obj_offset = 0;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, data_offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != data_offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    if (!zc_dtt_entry_matches(block, entry, key)) return ZC_INTERNAL_TYPE_ERROR;
+
+    *out_entry = entry;
     return ZC_INTERNAL_OK;
 }
 
@@ -304,27 +1721,25 @@ zc_internal_result_t zc_dtt_get_desc_by_ptr_offset(zc_block_header_t* block,
     if (unlikely(!ptr_content)) return ZC_INTERNAL_RUN_PTRNULL;
     uint64_t target_offset = *ptr_content;
 
-    uint8_t* target_desc = NULL;
-    uint64_t target_desc_len = 0;
+    zc_dtt_lut_entry_t* target_entry = NULL;
     uint64_t target_obj_offset = 0;
-    res = zc_dtt_get_desc_by_data_offset(
-        block, target_offset, &target_desc, &target_desc_len, &target_obj_offset);
+    res = zc_dtt_get_entry_by_data_offset(block, target_offset, &target_entry, &target_obj_offset);
     if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    if (target_desc == NULL) return ZC_INTERNAL_TYPE_ILLEGAL_PTR;
+    if (target_entry == NULL) return ZC_INTERNAL_TYPE_ILLEGAL_PTR;
 
     // Verify the legitimacy of the scope
-    uint64_t target_obj_size = 0;
-    res = zc_type_desc_get_obj_size(target_desc, target_desc_len, &target_obj_size);
-    if (unlikely(res != ZC_INTERNAL_OK)) return res;
-
+    uint64_t target_obj_size = target_entry->obj_width;
     if (target_offset + target_size > target_obj_offset + target_obj_size)
     {
         return ZC_INTERNAL_TYPE_ILLEGAL_PTR;
     }
 
+    uint8_t* target_desc = zc_dtt_entry_desc(block, target_entry);
+    if (unlikely(!target_desc)) return ZC_INTERNAL_RUN_PTRNULL;
+
     *out_target_type_desc = target_desc;
-    *out_target_desc_len = target_desc_len;
+    *out_target_desc_len = target_entry->desc_length;
     *out_target_obj_offset = target_obj_offset;
     *out_target_obj_size = target_obj_size;
 
@@ -356,40 +1771,110 @@ zc_internal_result_t zc_dtt_get_desc_by_byref_offset(zc_block_header_t* block,
     uint64_t target_offset = *byref_content;
 
     // Analysis target_offset
-    uint8_t* target_desc = NULL;
-    uint64_t target_desc_len = 0;
-    uint64_t target_obj_offset = 0;
-    res = zc_dtt_get_desc_by_data_offset(
-        block, target_offset, &target_desc, &target_desc_len, &target_obj_offset);
+    if (target_offset >= block->lut_offset) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+    zc_dtt_lut_header_t* lut_hdr;
+    res = zc_dtt_resolve_lut(block, &lut_hdr);
     if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    if (target_desc == NULL || target_desc[0] != target_type_tag) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+    zc_dtt_cursor_t cursor;
+    res = zc_dtt_cursor_seek(block, lut_hdr, target_offset, &cursor);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    // Verify the legitimacy and integrity of the reference scope
-    uint64_t current = target_offset;
-    uint64_t range_end = target_offset + target_size;
-    while (current < range_end)
+    zc_dtt_lut_entry_t* target_entry = cursor.entry;
+    if (target_entry == NULL || target_offset >= target_entry->data_offset + target_entry->obj_width
+        || target_entry->type_tag != target_type_tag)
     {
-        uint64_t next_offset = 0;
-        res = zc_dtt_get_next_sibling_offset(block, current, &next_offset);
-        if (unlikely(res != ZC_INTERNAL_OK)) return res;
-
-        if (next_offset == 0 || next_offset > range_end) return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
-
-        if (next_offset == range_end) break;
+        return ZC_INTERNAL_TYPE_ILLEGAL_BYREF;
+    }
+    uint64_t target_obj_offset = target_entry->data_offset;
 
-        current = next_offset;
+    // Verify the legitimacy and integrity of the reference scope in one pass from the target entry
+    if (target_size > 0)
+    {
+        res = zc_dtt_check_range_coverage(&cursor, target_offset, target_offset + target_size);
+        if (res != ZC_INTERNAL_OK) return res;
     }
 
-    uint64_t target_obj_size = 0;
-    res = zc_type_desc_get_obj_size(target_desc, target_desc_len, &target_obj_size);
-    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    uint8_t* target_desc = zc_dtt_entry_desc(block, target_entry);
+    if (unlikely(!target_desc)) return ZC_INTERNAL_RUN_PTRNULL;
 
     *out_target_type_desc = target_desc;
-    *out_target_desc_len = target_desc_len;
+    *out_target_desc_len = target_entry->desc_length;
     *out_target_obj_offset = target_obj_offset;
-    *out_target_obj_size = target_obj_size;
+    *out_target_obj_size = target_entry->obj_width;
 
     return ZC_INTERNAL_OK;
 }
 
+zc_internal_result_t zc_dtt_get_next_sibling_offset(zc_block_header_t* block,
+    uint64_t offset, uint64_t* out_next_offset)
+{
+    *out_next_offset = 0;
+    if (offset >= block->lut_offset) return ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET;
+
+    zc_dtt_lut_header_t* lut_hdr;
+    zc_internal_result_t res = zc_dtt_resolve_lut(block, &lut_hdr);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    zc_dtt_cursor_t cursor;
+    res = zc_dtt_cursor_seek(block, lut_hdr, offset, &cursor);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    zc_dtt_lut_entry_t* entry = cursor.entry;
+    if (entry == NULL || offset >= entry->data_offset + entry->obj_width) return ZC_INTERNAL_OK;
+    if (entry->data_offset == offset)
+    {
+        *out_next_offset = entry->data_offset + entry->obj_width;
+        return ZC_INTERNAL_OK;
+    }
+
+    // 自外向内取以 offset 起始的最外层字段
+    const zc_type_layout_field_t* fields;
+    uint32_t field_count;
+    if (zc_dtt_entry_layout(entry, &fields, &field_count))
+    {
+        uint64_t rel = offset - entry->data_offset;
+        uint32_t lo = 0;
+        uint32_t hi = field_count;
+        for (;;)
+        {
+            uint32_t i = zc_dtt_layout_seek(fields, lo, hi, rel);
+            if (i >= hi || fields[i].offset > rel) return ZC_INTERNAL_OK;
+            if (fields[i].offset == rel)
+            {
+                *out_next_offset = entry->data_offset + fields[i].offset + fields[i].size;
+                return ZC_INTERNAL_OK;
+            }
+            lo = i + 1;
+            hi = fields[i].next;
+        }
+    }
+
+    const uint8_t* desc = zc_dtt_entry_desc(block, entry);
+    if (unlikely(!desc)) return ZC_INTERNAL_RUN_PTRNULL;
+    uint64_t desc_len = entry->desc_length;
+    uint64_t base = entry->data_offset;
+    while (zc_type_is_composite(desc[0]))
+    {
+        zc_type_field_iter_t iter;
+        res = zc_type_field_iter_init(&iter, desc, desc_len);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        zc_type_field_t field;
+        bool found;
+        res = zc_dtt_field_seek(&iter, base, offset, &field, &found);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        if (!found || base + field.offset > offset) return ZC_INTERNAL_OK;
+
+        if (base + field.offset == offset)
+        {
+            *out_next_offset = base + field.offset + field.size;
+            return ZC_INTERNAL_OK;
+        }
+        desc = field.desc;
+        desc_len = field.desc_len;
+        base += field.offset;
+    }
+    return ZC_INTERNAL_OK;
+}
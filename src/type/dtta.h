@@ -10,34 +10,113 @@ extern "C" {
 #endif
 
 #include "block.h"
+#include "type_registry.h"
 #include "zerocore_internal.h"
 
+#define ZC_DTT_OBJ_WIDTH_MAX ((1ULL << 56) - 1)
+
+/**
+ * LUT 条目，40 字节。对象宽度、主类型码与描述符指纹在 add / modify 时写入，
+ * 查找、重叠检查与类型匹配只读 LUT，不再解析描述符。
+ */
 typedef struct zc_dtt_lut_entry
 {
     uint64_t data_offset;             // UserData 变量的起始偏移 (相对于块首)
     uint64_t desc_offset;             // 类型描述符的起始偏移
-    uint64_t desc_length;             // 类型描述符长度
+    uint64_t obj_width   : 56;        // 对象字节宽度
+    uint64_t type_tag    : 8;         // 主类型码，即描述符首字节
+    uint32_t desc_length;             // 类型描述符长度
+    zc_type_id_t type_id;             // 驻留类型 ID；非 0 时描述符位于全局驻留表，desc_offset 无效
+    uint64_t desc_hash;               // 描述符指纹，即 zc_type_desc_hash 的结果
 } zc_dtt_lut_entry_t;
 
 #ifndef ZC_DTT_LUT_ENTRY_SIZE
 #define ZC_DTT_LUT_ENTRY_SIZE sizeof(zc_dtt_lut_entry_t)
 #endif
 
+/**
+ * 批量添加时由调用者提供的变量描述。
+ */
+typedef struct zc_dtt_field
+{
+    uint64_t       data_offset;       // 变量起始偏移 (相对于块首)
+    uint64_t       obj_width;         // 对象字节宽度
+    const uint8_t* type_desc;         // 类型描述符（非块内偏移）
+    uint64_t       desc_len;          // 类型描述符长度
+} zc_dtt_field_t;
+
+/**
+ * DTTA 的根。条目、索引节点与块内描述符都从紧随其后的 DTTA 堆中按追加顺序分配，
+ * 条目一经分配地址不再变化；按 data_offset 的有序视图由 B+ 树索引维护。
+ */
 typedef struct zc_dtt_lut_header
 {
     uint32_t entry_count;             // LUT 项目数量
-    uint64_t lut_first_entry_offset;  // LUT 首项的起始偏移 (相对于块首)
-    uint64_t descriptor_start_offset; // 描述符字节流的起始偏移 (相对于块首)
-    uint64_t descriptor_length;       // 描述符字节流的长度
+    uint32_t schema_id;               // 引用的模式 ID；非 0 时 LUT 条目位于全局模式表，块内不存放条目
+    uint64_t index_root_offset;       // B+ 树根节点偏移 (相对于块首)，0 表示空树
+    uint32_t index_height;            // B+ 树高度，只有一个叶子时为 1
+    uint32_t frozen;                  // 已由 zc_dtt_freeze 冻结，此后只读
+    uint64_t heap_start_offset;       // DTTA 堆的起始偏移 (相对于块首)
+    uint64_t heap_used;               // DTTA 堆已分配长度
+    uint64_t descriptor_length;       // 块内描述符字节总长度
+
+    // === 冻结后的只读形式，由 zc_dtt_freeze 建立 ===
+    uint64_t frozen_entry_offset;     // 条目数组起始偏移（页首对齐）
+    uint64_t frozen_table_offset;     // 粒度区间表起始偏移（页首对齐）
+    uint32_t frozen_granule_shift;    // 粒度大小为 2^shift 字节
+    uint32_t frozen_granule_count;    // 粒度数，区间表有 granule_count + 1 项
+    uint64_t frozen_dir_addr;         // 页目录首页的地址，目录依次记录条目页与区间表页的数据区地址
 } zc_dtt_lut_header_t;
 
 #ifndef ZC_DTT_LUT_HEADER_SIZE
-#define ZC_DTT_LUT_HEADER_SIZE sizeof(zc_dtt_lut_entry_t)
+#define ZC_DTT_LUT_HEADER_SIZE sizeof(zc_dtt_lut_header_t)
 #endif
 #ifndef ZC_DTT_LUT_ENTRY_MAX_COUNT
-#define ZC_DTT_LUT_ENTRY_MAX_COUNT 16
+#define ZC_DTT_LUT_ENTRY_MAX_COUNT 65536
 #endif
 
+// 冻结数组按页分段，每页只放整数个元素，元素下标可直接换算为块内偏移
+#define ZC_DTT_FROZEN_ENTRIES_PER_PAGE (ZC_PAGE_DATA_SIZE / ZC_DTT_LUT_ENTRY_SIZE)
+#define ZC_DTT_FROZEN_SLOTS_PER_PAGE   (ZC_PAGE_DATA_SIZE / sizeof(uint32_t))
+#define ZC_DTT_FROZEN_DIR_PER_PAGE     (ZC_PAGE_DATA_SIZE / sizeof(uint64_t))
+
+#ifndef ZC_DTT_FROZEN_GRANULES_PER_ENTRY
+#define ZC_DTT_FROZEN_GRANULES_PER_ENTRY 2   // 直接索引表项数上限与条目数之比
+#endif
+
+// 张量与大数组的放置对齐，与 ZC_SIMD_VECTOR_BYTES 一致
+#ifndef ZC_DTT_VECTOR_ALIGN
+#define ZC_DTT_VECTOR_ALIGN 64
+#endif
+
+#define ZC_DTT_INDEX_FANOUT     16    // 与 zc_dtt_key_rank16 一次比较的键数一致
+#define ZC_DTT_INDEX_MAX_HEIGHT 8
+
+/**
+ * B+ 树节点。键为子树最小 data_offset（叶子中为条目的 data_offset），升序，空位为 UINT64_MAX；
+ * 一次 SIMD 比较即可确定下降方向。节点从不跨页分配。
+ */
+typedef struct zc_dtt_index_node
+{
+    uint64_t keys[ZC_DTT_INDEX_FANOUT];
+    uint64_t slots[ZC_DTT_INDEX_FANOUT];  // 内部节点：子节点偏移；叶子：LUT 条目偏移
+    uint64_t next_leaf;                   // 叶子链表，0 表示最后一个叶子
+    uint16_t count;
+    uint8_t  is_leaf;
+    uint8_t  reserved[5];
+} zc_dtt_index_node_t;
+
+/**
+ * @brief 在块的 LUT 头位置初始化空的 DTTA。由 zc_block_create 调用。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_BLOCK_ERROR: LUT 头不在块内。
+ */
+zc_internal_result_t zc_dtt_init(
+    zc_block_header_t* block
+);
+
 /**
  * @brief 在块的 DTTA 中新增一个变量的类型描述条目（LUT + 描述符）。
  *
@@ -48,23 +127,27 @@ typedef struct zc_dtt_lut_header
  *
  * @param block        [in] 已 acquire 的块头指针，状态必须为 FREE。
  * @param data_offset  [in] 新变量在用户数据区内的起始偏移（字节）。
+ * @param obj_width    [in] 新变量的对象字节宽度，写入 LUT 条目，此后不再由描述符重新计算。
  * @param type_desc    [in] 指向类型描述符的内存地址（非块内偏移）。
  * @param desc_len     [in] 类型描述符长度（字节），必须 > 0。
  *
  * @return
  * - ZC_INTERNAL_OK: 成功添加条目。
- * - ZC_INTERNAL_INVALID_TYPE_DESC: type_desc 无法解析或宽度为 0。
- * - ZC_INTERNAL_DTTA_LUT_FULL: LUT 条目已达上限（16 条）。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符长度为 0 或无法解码，或宽度为 0 / 超出 ZC_DTT_OBJ_WIDTH_MAX / 与描述符的对象大小不符。
+ * - ZC_INTERNAL_DTTA_LUT_FULL: LUT 条目已达上限（ZC_DTT_LUT_ENTRY_MAX_COUNT）。
  * - ZC_INTERNAL_DTTA_TYPE_CONFLICT: 新变量与现有变量内存区间重叠。
  * - ZC_INTERNAL_DTTA_OVERFLOW: DTTA 描述符空间不足。
  * - ZC_INTERNAL_BLOCK_ERROR: 块结构损坏（如偏移转换失败）。
  * - ZC_INTERNAL_RUN_PTRNULL: 内部指针为空（严重错误，通常不应发生）。
+ * - ZC_INTERNAL_DTTA_FROZEN: DTTA 已被 zc_dtt_freeze 冻结。
  *
  * @note
  * - 函数不检查参数的指针有效性。
  * - 调用前必须确保调用者拥有块。
  * - 不合并无类型变量；即使两个无类型变量重叠，也视为冲突。
- * - 描述符将追加到 DTTA 描述符池末尾，LUT 条目按 data_offset 升序插入。
+ * - 已 attach 全局驻留表时描述符被驻留，条目只记录类型 ID，不占用块内描述符池；
+ *   驻留表已满或未 attach 时描述符从 DTTA 堆中分配。
+ * - 条目追加到 DTTA 堆，B+ 树插入为 O(log n)，只在节点内移动至多 16 个键，不移动已有条目。
  * - 此函数不移动用户数据，仅更新元数据。
  */
 zc_internal_result_t zc_dtt_add(
@@ -75,6 +158,103 @@ zc_internal_result_t zc_dtt_add(
     uint64_t desc_len
 );
 
+/**
+ * @brief 选择对齐的起始偏移并新增变量，块内按需填充。
+ *
+ * alignment 为 0 时由描述符推导：FLOATTENSOR，以及宽度不小于 ZC_DTT_VECTOR_ALIGN 的定长元素数组按
+ * ZC_DTT_VECTOR_ALIGN 对齐，使内核能对其使用对齐的向量加载；其他变量取描述符的自然对齐。
+ * 对齐按块内实际地址计算，不超过一页的变量不跨页放置，规则见 zc_block_place。
+ *
+ * @param min_offset  [in] 候选起点，通常为上一个变量的末尾。
+ * @param alignment   [in] 显式对齐（2 的幂，不超过 ZC_BLOCK_MAX_ALIGN），0 表示由描述符推导。
+ * @param out_offset  [out] 变量实际的起始偏移。
+ *
+ * @return
+ * - 同 zc_dtt_add。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out_offset 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: alignment 非法。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 放置后超出块的页范围。
+ * - 其他: alignment 为 0 时由 zc_type_desc_decode 透传的错误。
+ */
+zc_internal_result_t zc_dtt_add_aligned(
+    zc_block_header_t* block,
+    uint64_t min_offset,
+    uint64_t obj_width,
+    const uint8_t* type_desc,
+    uint64_t desc_len,
+    uint32_t alignment,
+    uint64_t* out_offset
+);
+
+/**
+ * @brief 以已驻留的类型 ID 新增变量，省去描述符哈希与比较。
+ *
+ * 语义同 zc_dtt_add。写入者对同一类型反复写入时，应先 zc_type_registry_intern 一次并缓存 ID。
+ *
+ * @return
+ * - 同 zc_dtt_add。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: 未 attach 全局驻留表。
+ * - ZC_INTERNAL_TYPE_UNKNOWN_ID: type_id 未驻留。
+ */
+zc_internal_result_t zc_dtt_add_by_id(
+    zc_block_header_t* block,
+    uint64_t data_offset,
+    uint64_t obj_width,
+    zc_type_id_t type_id
+);
+
+/**
+ * @brief 一次性添加多个变量。
+ *
+ * 字段无需有序：先在本地驻留描述符并排序，再把现有条目与新条目做一次有序归并，
+ * 归并中检查相邻区间重叠并写入条目与描述符，最后顺序建叶子并自底向上建内部层。
+ * 代价为 O(m log m + n + m)，而逐个 zc_dtt_add 为 O(m log (n + m)) 且每次都重新解析 LUT 头。
+ *
+ * @param block        [in] 已 acquire 的块头指针，状态必须为 FREE。
+ * @param fields       [in] 字段数组。
+ * @param field_count  [in] 字段数量，为 0 时直接返回成功。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 全部添加成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 某字段描述符长度为 0 或无法解码，或宽度为 0 / 超出 ZC_DTT_OBJ_WIDTH_MAX / 与描述符的对象大小不符。
+ * - ZC_INTERNAL_DTTA_LUT_FULL: 添加后条目数超过 ZC_DTT_LUT_ENTRY_MAX_COUNT。
+ * - ZC_INTERNAL_DTTA_DATA_CONFLICT: 字段之间或与现有变量区间重叠。
+ * - ZC_INTERNAL_DTTA_OVERFLOW: DTTA 堆空间不足。
+ * - ZC_INTERNAL_RUN_PTRNULL: 暂存空间分配失败。
+ * - ZC_INTERNAL_DTTA_FROZEN: DTTA 已被 zc_dtt_freeze 冻结。
+ *
+ * @note
+ * - 全部成功或全部不添加；失败时 DTTA 保持调用前的状态（已驻留的描述符不回退）。
+ * - DTTA 非空时索引被整体重建，新索引复用旧索引的全部节点，只为超出部分分配堆空间。
+ */
+zc_internal_result_t zc_dtt_add_bulk(
+    zc_block_header_t* block,
+    const zc_dtt_field_t* fields,
+    uint32_t field_count
+);
+
+/**
+ * @brief 以已注册的模式初始化块的 DTTA，O(1)。
+ *
+ * 块内只记录模式 ID，查找直接使用模式表中不可变的 LUT 条目。
+ * 之后对该块调用 zc_dtt_add / zc_dtt_modify 时，先把模式条目批量装入块内索引（写时复制）再修改。
+ *
+ * @param block      [in] 已 acquire 的块头指针，状态必须为 FREE，DTTA 必须为空。
+ * @param schema_id  [in] zc_schema_register 返回的模式 ID。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_BLOCK_ERROR: 块结构损坏（LUT 头无效）。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: 未 attach 全局模式表。
+ * - ZC_INTERNAL_TYPE_UNKNOWN_ID: schema_id 未注册。
+ * - ZC_INTERNAL_DTTA_DATA_CONFLICT: 块内 DTTA 非空。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 模式的字段超出块的 UserData 区。
+ */
+zc_internal_result_t zc_dtt_init_from_schema(
+    zc_block_header_t* block,
+    uint32_t schema_id
+);
+
 /**
  * @brief 修改块中已存在变量的类型元数据（LUT 条目 + 描述符）。
  *
@@ -85,7 +265,7 @@ zc_internal_result_t zc_dtt_add(
  * @param block           [in] 已 acquire 的块头指针，状态必须为 FREE。
  * @param data_offset     [in] 原变量在用户数据区的起始偏移（用于定位 LUT 条目）。
  * @param new_data_offset [in] 新的起始偏移（可与原值相同）。
- * @param new_obj_width   [in] 新的对象字节宽度（用于重叠检查）。
+ * @param new_obj_width   [in] 新的对象字节宽度（用于重叠检查，并写回 LUT 条目）。
  * @param new_type_desc   [in] 指向新类型描述符的内存地址（必须非 NULL）。
  * @param new_desc_len    [in] 新描述符长度（字节），必须等于原描述符长度。
  *
@@ -95,14 +275,17 @@ zc_internal_result_t zc_dtt_add(
  * - ZC_INTERNAL_RUN_PTRNULL: 内部指针转换失败（严重错误）。
  * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: 未找到 data_offset 对应的 LUT 条目。
  * - ZC_INTERNAL_DTTA_DESC_MISMATCH: 描述符长度不匹配或基本类型改变。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 新宽度为 0 / 超出 ZC_DTT_OBJ_WIDTH_MAX，或与新描述符的对象大小不符。
  * - ZC_INTERNAL_DTTA_DATA_CONFLICT: 新数据区间与现有变量（含无类型）重叠。
+ * - ZC_INTERNAL_DTTA_FROZEN: DTTA 已被 zc_dtt_freeze 冻结。
  *
  * @note
  * - 函数不检查参数的指针有效性。
  * - 调用前必须确保调用者拥有块。
  * - 不移动用户数据，仅更新 DTTA 元数据。
  * - 描述符池保持紧凑，禁止 desc_len 变化。
- * - LUT 始终按 data_offset 升序维护，data_offset 变更时自动重排序。
+ * - 驻留描述符不原地修改，条目改为引用新描述符的类型 ID。
+ * - data_offset 变更时条目原地更新，只在 B+ 树中移动其键。
  */
 zc_internal_result_t zc_dtt_modify(
     zc_block_header_t* block,
@@ -113,6 +296,55 @@ zc_internal_result_t zc_dtt_modify(
     uint64_t new_desc_len
 );
 
+/**
+ * @brief 把 DTTA 压缩为只读形式。提交路径不会自动冻结，由写入者在提交前按需调用。
+ *
+ * 条目按 data_offset 升序复制到页首对齐的分段数组中，每页只放整数个条目，任何条目都不跨页；
+ * 另建一张按 2^shift 字节粒度划分 UserData 的区间表，第 g 项为起点早于粒度 g 起点（含）的条目数，
+ * 粒度 g 内开始的条目即下标 [slot[g], slot[g + 1]) 的条目。
+ * 各分段页的地址在冻结时沿页链解析一次，记入页目录，查找不再从块首沿页链定位。
+ * 冻结后的查找读两个相邻表项，再在粒度内的条目上二分，不再下降 B+ 树。
+ *
+ * @param block  [in] 写入者持有的块头指针，即将提交。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功，或块引用模式（模式条目本身即为只读有序数组）或已冻结。
+ * - ZC_INTERNAL_DTTA_OVERFLOW: DTTA 堆空间不足，块保持可变形式，查找仍然正确。
+ * - ZC_INTERNAL_BLOCK_ERROR: 块结构损坏。
+ *
+ * @note
+ * - 冻结后 zc_dtt_add / zc_dtt_add_bulk / zc_dtt_modify 返回 ZC_INTERNAL_DTTA_FROZEN。
+ * - 只读形式与 B+ 树同时保留，冻结失败不影响提交。
+ */
+zc_internal_result_t zc_dtt_freeze(
+    zc_block_header_t* block
+);
+
+/**
+ * @brief 查询用户数据区任意偏移所属的 LUT 条目。
+ *
+ * 与 zc_dtt_get_desc_by_data_offset 语义相同，但直接返回 LUT 条目，
+ * 调用者可从条目中取得对象宽度与主类型码而无需解析描述符。
+ *
+ * @param out_entry       [out] 所属变量的 LUT 条目；若为未注册区域则为 NULL。
+ * @param out_obj_offset  [out] 所属对象（或空洞段）在用户数据区的起始偏移。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 查询成功。落在未注册区域也视为成功。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: data_offset 超出用户数据区范围。
+ * - ZC_INTERNAL_BLOCK_ERROR: 块结构损坏（LUT 头或条目偏移无效）。
+ *
+ * @note
+ * - 返回的条目指针指向块内 LUT 条目，在块被持有期间有效；条目本身不会因后续插入而移动。
+ * - 查找为 O(log n)：每层一次 16 键 SIMD 比较；冻结后为一次区间表查找加粒度内二分。
+ */
+zc_internal_result_t zc_dtt_get_entry_by_data_offset(
+    zc_block_header_t* block,
+    uint64_t data_offset,
+    zc_dtt_lut_entry_t** out_entry,
+    uint64_t* out_obj_offset
+);
+
 /**
  * @brief 查询用户数据区任意偏移所属的变量元数据。
  *
@@ -133,7 +365,6 @@ zc_internal_result_t zc_dtt_modify(
  * - ZC_INTERNAL_OUT_OF_BOUNDS: data_offset 超出用户数据区范围。
  * - ZC_INTERNAL_BLOCK_ERROR: 块结构损坏（LUT 头或条目偏移无效）。
  * - ZC_INTERNAL_RUN_PTRNULL: 内部指针转换失败（严重错误）。
- * - ZC_INTERNAL_INVALID_TYPE_DESC: 候选变量的类型描述符无法解析（如损坏或非法格式）。
  *
  * @note
  * - 函数不检查参数的指针有效性。
@@ -216,6 +447,8 @@ zc_internal_result_t zc_dtt_get_desc_by_ptr_offset(
  *
  * @note
  * - 函数不检查参数的指针有效性。
+ * - 范围检查自目标条目起沿有序条目线性前进一次，落在单个变量内部时逐层下降到 VALUETYPE / CLASS 字段，
+ *   代价为 O(log n + 覆盖的字段数)。
  */
 zc_internal_result_t zc_dtt_get_desc_by_byref_offset(
     zc_block_header_t* block,
@@ -226,7 +459,98 @@ zc_internal_result_t zc_dtt_get_desc_by_byref_offset(
     uint64_t* out_target_obj_size
 );
 
-// 给定一个块和一个偏移 offset，若该偏移是某个变量或字段的起始偏移，则传出其结束偏移（即下一个平级起始偏移）；否则传出NULL。
+/**
+ * 条目的描述符：未驻留时位于块内，已驻留时位于全局驻留表。失败返回 NULL
+ */
+static inline uint8_t* zc_dtt_entry_desc(zc_block_header_t* block, const zc_dtt_lut_entry_t* entry)
+{
+    if (entry->type_id == ZC_TYPE_ID_NONE) return zc_block_offset_to_ptr(block, entry->desc_offset);
+    if (unlikely(g_type_registry == NULL)) return NULL;
+
+    const uint8_t* desc;
+    uint64_t desc_len;
+    if (unlikely(zc_type_registry_get_desc(g_type_registry, entry->type_id, &desc, &desc_len) != ZC_INTERNAL_OK)) return NULL;
+    return (uint8_t*)desc;
+}
+
+/**
+ * 条目是否为指定的驻留类型。两侧描述符都已驻留时，描述符完全相等等价于 ID 相等。
+ */
+static inline bool zc_dtt_entry_is_type(const zc_dtt_lut_entry_t* entry, zc_type_id_t type_id)
+{
+    return type_id != ZC_TYPE_ID_NONE && entry->type_id == type_id;
+}
+
+/**
+ * 带类型读取时期望的描述符，由 zc_dtt_type_key_init 准备一次后反复使用。
+ */
+typedef struct zc_dtt_type_key
+{
+    const uint8_t* desc;              // 期望的类型描述符（非块内偏移），在键的使用期间保持有效
+    uint64_t       desc_len;          // 描述符长度
+    uint64_t       desc_hash;         // 描述符指纹
+    zc_type_id_t   type_id;           // 驻留后的 ID，未能驻留时为 ZC_TYPE_ID_NONE
+} zc_dtt_type_key_t;
+
+/**
+ * @brief 计算期望描述符的指纹，并将其驻留到全局驻留表取得类型 ID。
+ *
+ * 键与条目都已驻留时，带类型读取只比较 ID，不再逐字节比较描述符。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。未 attach 驻留表、描述符过长或驻留表已满时 type_id 为 ZC_TYPE_ID_NONE。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: desc_len 为 0。
+ */
+zc_internal_result_t zc_dtt_type_key_init(
+    const uint8_t* desc,
+    uint64_t desc_len,
+    zc_dtt_type_key_t* out_key
+);
+
+/**
+ * 条目与期望描述符的指纹是否相同。指纹不同时描述符必然不同。
+ */
+static inline bool zc_dtt_entry_fingerprint_matches(const zc_dtt_lut_entry_t* entry, const zc_dtt_type_key_t* key)
+{
+    return entry->desc_hash == key->desc_hash && entry->desc_length == key->desc_len;
+}
+
+/**
+ * @brief 取得 data_offset 处变量的条目，并检查其描述符与期望描述符完全相等。
+ *
+ * 两侧都已驻留时比较类型 ID；否则先比较指纹与长度，指纹相同而有一侧未驻留时才逐字节确认。
+ * 类型不符的读取只付出一次整数比较，不访问描述符字节。
+ *
+ * @param block       [in] 已 acquire 的块头指针。
+ * @param data_offset [in] 变量的起始偏移。
+ * @param key         [in] 由 zc_dtt_type_key_init 准备的期望描述符。
+ * @param out_entry   [out] 块内 LUT 条目。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 类型相符。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: data_offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 描述符不相等。
+ * - 其他: 由 zc_dtt_get_entry_by_data_offset 透传的错误。
+ */
+zc_internal_result_t zc_dtt_get_entry_typed(
+    zc_block_header_t* block,
+    uint64_t data_offset,
+    const zc_dtt_type_key_t* key,
+    zc_dtt_lut_entry_t** out_entry
+);
+
+/**
+ * @brief 给定一个块和一个偏移 offset，若该偏移是某个变量或字段的起始偏移，则传出其结束偏移（即下一个平级起始偏移）；否则传出 0。
+ *
+ * 多层字段起始于同一偏移时取最外层。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功（包括 offset 不是起始偏移的情况）。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: offset 越出用户数据区。
+ * - 其他内部错误（如块损坏、描述符解析失败）。
+ */
 zc_internal_result_t zc_dtt_get_next_sibling_offset(
     zc_block_header_t* block,
     uint64_t offset,
@@ -0,0 +1,97 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "simd.h"
+
+#if ZC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#ifndef DTTA_SEARCH_H
+#define DTTA_SEARCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 键以 16 个为一组比较，不足一组的部分以哨兵填充
+#define ZC_DTT_KEY_BLOCK    16
+#define ZC_DTT_KEY_SENTINEL UINT64_MAX
+
+#define ZC_DTT_KEY_PADDED_COUNT(n) (((n) + ZC_DTT_KEY_BLOCK - 1) & ~(uint32_t)(ZC_DTT_KEY_BLOCK - 1))
+
+static inline uint32_t zc_dtt_key_rank16_baseline(const uint64_t* keys, uint64_t key)
+{
+    uint32_t rank = 0;
+    uint32_t i;
+    for (i = 0; i < ZC_DTT_KEY_BLOCK; i++) rank += keys[i] <= key;
+    return rank;
+}
+
+#if ZC_SIMD_X86
+ZC_SIMD_TARGET_AVX2 static inline uint32_t zc_dtt_key_rank16_avx2(const uint64_t* keys, uint64_t key)
+{
+    // AVX2 只有有符号 64 位比较，两侧同时翻转符号位
+    __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    __m256i k = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), bias);
+    uint32_t gt = 0;
+    uint32_t i;
+    for (i = 0; i < ZC_DTT_KEY_BLOCK; i += 4)
+    {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(keys + i)), bias);
+        gt |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, k))) << i;
+    }
+    return ZC_DTT_KEY_BLOCK - (uint32_t)__builtin_popcount(gt);
+}
+
+ZC_SIMD_TARGET_AVX512 static inline uint32_t zc_dtt_key_rank16_avx512(const uint64_t* keys, uint64_t key)
+{
+    __m512i k = _mm512_set1_epi64((long long)key);
+    uint32_t m0 = _mm512_cmple_epu64_mask(_mm512_loadu_si512((const void*)keys), k);
+    uint32_t m1 = _mm512_cmple_epu64_mask(_mm512_loadu_si512((const void*)(keys + 8)), k);
+    return (uint32_t)__builtin_popcount(m0 | (m1 << 8));
+}
+#endif
+
+/**
+ * 一组 16 个升序键中 <= key 的个数。无分支：整组比较后对掩码计数。
+ * 按运行时探测的指令集级别分发，SSE4.2 级别使用标量实现。
+ * 键数组不要求对齐。
+ */
+static inline uint32_t zc_dtt_key_rank16(const uint64_t* keys, uint64_t key)
+{
+#if ZC_SIMD_X86
+    zc_simd_level_t level = zc_simd_level();
+    if (level >= ZC_SIMD_AVX512) return zc_dtt_key_rank16_avx512(keys, key);
+    if (level >= ZC_SIMD_AVX2) return zc_dtt_key_rank16_avx2(keys, key);
+#endif
+    return zc_dtt_key_rank16_baseline(keys, key);
+}
+
+/**
+ * 升序键数组中 <= key 的个数。padded_count 必须是 ZC_DTT_KEY_BLOCK 的倍数，尾部以哨兵填充。
+ * 先以每组首键二分定位所在组，再在组内一次比较，O(log n)。
+ */
+static inline uint32_t zc_dtt_key_rank(const uint64_t* keys, uint32_t padded_count, uint64_t key)
+{
+    uint32_t lo = 0;
+    uint32_t hi = padded_count / ZC_DTT_KEY_BLOCK;
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (keys[mid * ZC_DTT_KEY_BLOCK] <= key) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return 0;
+
+    uint32_t base = (lo - 1) * ZC_DTT_KEY_BLOCK;
+    return base + zc_dtt_key_rank16(keys + base, key);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTTA_SEARCH_H */
@@ -0,0 +1,146 @@
+#include "schema.h"
+#include "dtta_search.h"
+#include <stdlib.h>
+
+zc_schema_table_t* g_schema_table = NULL;
+
+static int zc_schema_entry_compare(const void* a, const void* b)
+{
+    uint64_t lhs = ((const zc_dtt_lut_entry_t*)a)->data_offset;
+    uint64_t rhs = ((const zc_dtt_lut_entry_t*)b)->data_offset;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * 以 CAS 从计数器中预留 count 个单位，超出 limit 时失败
+ */
+static bool zc_schema_reserve(_Atomic uint32_t* counter, uint32_t count, uint32_t limit, uint32_t* out_first)
+{
+    uint32_t used = atomic_load_explicit(counter, memory_order_relaxed);
+    do
+    {
+        if (used + count > limit) return false;
+    } while (!atomic_compare_exchange_weak_explicit(counter, &used, used + count,
+        memory_order_relaxed, memory_order_relaxed));
+
+    *out_first = used;
+    return true;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_schema_table_init(zc_schema_table_t* table)
+{
+    if (unlikely(table == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    table->magic = ZC_SCHEMA_TABLE_MAGIC;
+    atomic_init(&table->schema_count, 0);
+    atomic_init(&table->entries_used, 0);
+
+    uint32_t i;
+    for (i = 0; i < ZC_SCHEMA_CAPACITY; i++) atomic_init(&table->schemas[i].ready, 0);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_schema_table_attach(zc_schema_table_t* table)
+{
+    if (table != NULL && table->magic != ZC_SCHEMA_TABLE_MAGIC) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+
+    g_schema_table = table;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 驻留描述符、校验宽度并排序、检查重叠
+ */
+static zc_internal_result_t zc_schema_stage(const zc_schema_field_t* fields, uint32_t field_count,
+    zc_dtt_lut_entry_t* staged)
+{
+    uint32_t i;
+    for (i = 0; i < field_count; i++)
+    {
+        const zc_schema_field_t* field = &fields[i];
+        if (unlikely(field->obj_width == 0 || field->obj_width > ZC_DTT_OBJ_WIDTH_MAX || field->desc_len == 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+        zc_type_id_t type_id;
+        zc_internal_result_t res = zc_type_registry_intern(g_type_registry, field->type_desc, field->desc_len, &type_id);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        res = zc_type_registry_check_width(g_type_registry, type_id, field->type_desc, field->desc_len, field->obj_width);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        staged[i].data_offset = field->data_offset;
+        staged[i].desc_offset = 0;
+        staged[i].obj_width = field->obj_width;
+        staged[i].type_tag = field->type_desc[0];
+        staged[i].desc_length = (uint32_t)field->desc_len;
+        staged[i].type_id = type_id;
+        staged[i].desc_hash = zc_type_desc_hash(field->type_desc, field->desc_len);
+    }
+
+    qsort(staged, field_count, sizeof(zc_dtt_lut_entry_t), zc_schema_entry_compare);
+
+    for (i = 1; i < field_count; i++)
+    {
+        if (staged[i - 1].data_offset + staged[i - 1].obj_width > staged[i].data_offset) return ZC_INTERNAL_DTTA_DATA_CONFLICT;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 预留模式槽位和条目并发布
+ */
+static zc_internal_result_t zc_schema_publish(zc_schema_table_t* table,
+    const zc_dtt_lut_entry_t* staged, uint32_t field_count, zc_schema_id_t* out_id)
+{
+    uint32_t index, first_entry;
+    if (!zc_schema_reserve(&table->schema_count, 1, ZC_SCHEMA_CAPACITY, &index)) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+    // 条目池不足时已预留的模式槽位保持未就绪，不再复用
+    uint32_t padded_count = ZC_DTT_KEY_PADDED_COUNT(field_count);
+    if (!zc_schema_reserve(&table->entries_used, padded_count, ZC_SCHEMA_ENTRY_POOL_SIZE, &first_entry)) return ZC_INTERNAL_DTTA_LUT_FULL;
+
+    uint32_t i;
+    for (i = 0; i < field_count; i++)
+    {
+        table->entries[first_entry + i] = staged[i];
+        table->keys[first_entry + i] = staged[i].data_offset;
+    }
+    for (; i < padded_count; i++) table->keys[first_entry + i] = ZC_DTT_KEY_SENTINEL;
+
+    zc_schema_slot_t* slot = &table->schemas[index];
+    slot->entry_count = field_count;
+    slot->first_entry = first_entry;
+    slot->reserved = 0;
+    slot->data_extent = staged[field_count - 1].data_offset + staged[field_count - 1].obj_width;
+    atomic_store_explicit(&slot->ready, 1, memory_order_release);
+
+    *out_id = index + 1;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 先在本地完成驻留、排序和重叠检查，再预留模式槽位和条目，非法布局不占用表空间
+ */
+zc_internal_result_t zc_schema_register(zc_schema_table_t* table,
+    const zc_schema_field_t* fields, uint32_t field_count, zc_schema_id_t* out_id)
+{
+    if (unlikely(field_count == 0)) return ZC_INTERNAL_PARAM_ERROR;
+    if (unlikely(field_count > ZC_SCHEMA_ENTRY_POOL_SIZE)) return ZC_INTERNAL_DTTA_LUT_FULL;
+    if (unlikely(g_type_registry == NULL)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+
+    zc_dtt_lut_entry_t* staged = malloc(field_count * sizeof(zc_dtt_lut_entry_t));
+    if (unlikely(staged == NULL)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    zc_internal_result_t res = zc_schema_stage(fields, field_count, staged);
+    if (res == ZC_INTERNAL_OK) res = zc_schema_publish(table, staged, field_count, out_id);
+
+    free(staged);
+    return res;
+}
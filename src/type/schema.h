@@ -0,0 +1,129 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "type_registry.h"
+#include "dtta.h"
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t zc_schema_id_t;
+
+#define ZC_SCHEMA_ID_NONE 0
+
+#ifndef ZC_SCHEMA_CAPACITY
+#define ZC_SCHEMA_CAPACITY 256
+#endif
+
+#ifndef ZC_SCHEMA_ENTRY_POOL_SIZE
+#define ZC_SCHEMA_ENTRY_POOL_SIZE 16384   // 所有模式共享的 LUT 条目池，必须是 16 的倍数
+#endif
+
+#define ZC_SCHEMA_TABLE_MAGIC 0x5A435343U // "ZCSC"
+
+/**
+ * 注册模式时由写入者提供的字段描述，仅在注册期间使用。与 zc_dtt_add_bulk 的字段描述相同。
+ */
+typedef zc_dtt_field_t zc_schema_field_t;
+
+typedef struct zc_schema_slot {
+    _Atomic uint32_t  ready;         // 条目写完后置 1
+    uint32_t          entry_count;
+    uint32_t          first_entry;   // 在条目池中的起始下标
+    uint32_t          reserved;
+    uint64_t          data_extent;   // 最后一个字段的结束偏移，即块所需的 UserData 末端
+} zc_schema_slot_t;
+
+/**
+ * 模式表。注册后不可变，只包含偏移，可直接放在共享内存中。
+ * 条目池中的条目按 data_offset 升序，描述符全部驻留在全局驻留表中。
+ */
+typedef struct zc_schema_table {
+    uint32_t            magic;
+    _Atomic uint32_t    schema_count;
+    _Atomic uint32_t    entries_used;
+    uint32_t            reserved;
+    zc_schema_slot_t    schemas[ZC_SCHEMA_CAPACITY];
+    uint64_t            keys[ZC_SCHEMA_ENTRY_POOL_SIZE];     // 与 entries 平行的 data_offset 键，每个模式以哨兵补齐到 16 的倍数
+    zc_dtt_lut_entry_t  entries[ZC_SCHEMA_ENTRY_POOL_SIZE];
+} zc_schema_table_t;
+
+/**
+ * 当前进程已 attach 的模式表，未 attach 时为 NULL。
+ */
+extern zc_schema_table_t* g_schema_table;
+
+zc_internal_result_t zc_schema_table_init(
+    zc_schema_table_t* table
+);
+
+/**
+ * @brief 把模式表设为当前进程的全局模式表。传入 NULL 解除。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: table 未初始化。
+ */
+zc_internal_result_t zc_schema_table_attach(
+    zc_schema_table_t* table
+);
+
+/**
+ * @brief 注册一个块布局，返回模式 ID。
+ *
+ * 字段无需有序，注册时排序并检查重叠，描述符驻留到 g_type_registry。
+ *
+ * @param fields       [in] 字段数组。
+ * @param field_count  [in] 字段数量，> 0。
+ * @param out_id       [out] 模式 ID，非 0。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: field_count 为 0。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: 未 attach 全局驻留表。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 字段宽度或描述符非法。
+ * - ZC_INTERNAL_DTTA_DATA_CONFLICT: 字段区间重叠。
+ * - ZC_INTERNAL_DTTA_LUT_FULL: 模式表或条目池已满。
+ * - ZC_INTERNAL_TYPE_REGISTRY_FULL: 驻留表已满。
+ *
+ * @note 写入者应在启动时注册一次并缓存 ID。
+ */
+zc_internal_result_t zc_schema_register(
+    zc_schema_table_t* table,
+    const zc_schema_field_t* fields,
+    uint32_t field_count,
+    zc_schema_id_t* out_id
+);
+
+/**
+ * 由模式 ID 取得模式槽位，未注册或未就绪时返回 NULL。
+ */
+static inline zc_schema_slot_t* zc_schema_get(zc_schema_table_t* table, zc_schema_id_t schema_id)
+{
+    if (unlikely(schema_id == ZC_SCHEMA_ID_NONE || schema_id > ZC_SCHEMA_CAPACITY)) return NULL;
+
+    zc_schema_slot_t* slot = &table->schemas[schema_id - 1];
+    if (unlikely(!atomic_load_explicit(&slot->ready, memory_order_acquire))) return NULL;
+    return slot;
+}
+
+/**
+ * 模式的 UserData 末端偏移。acquire 块时以此确定 UserData 大小，块内 DTTA 只需一个 LUT 头。
+ */
+static inline uint64_t zc_schema_data_extent(const zc_schema_slot_t* slot)
+{
+    return slot->data_extent;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEMA_H */
@@ -1,371 +1,523 @@
 #include "type_descriptor.h"
 #include <stdlib.h>
+#include <string.h>
 
 /**
- * 获取类型描述符长度。
- * 实际上，这个函数是局部性的，
- * 它不能识别这个desc是否是一个顶级变量的desc，但是它能识别这个desc的最小完整边界。
- * 
- * @param desc 类型描述符
- * @param out_desc_len 类型描述符长度
+ * 描述符主类型码的解码方式
  */
-zc_internal_result_t zc_get_type_desc_len(const uint8_t* desc, uint64_t* out_desc_len)
+typedef enum zc_type_desc_kind
 {
-    if (unlikely(!desc)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-
-    uint8_t type_tag = desc[0];
-    uint64_t len = 1; // 至少包含tag本身
+    ZC_DESC_KIND_UNREALIZED = 0,
+    ZC_DESC_KIND_FIXED,          // 只有 tag，大小固定
+    ZC_DESC_KIND_VOID,           // 1 字节宽度指数，0 表示无宽度
+    ZC_DESC_KIND_NATIVE_INT,     // 1 字节宽度指数
+    ZC_DESC_KIND_R4,             // 1 字节 R4 token
+    ZC_DESC_KIND_R8,             // 1 字节 R8 token
+    ZC_DESC_KIND_FIXEDPOINT,     // 1 字节定点 token
+    ZC_DESC_KIND_STRING,         // 4 字节字符数
+    ZC_DESC_KIND_PTR,            // 8 字节目标大小
+    ZC_DESC_KIND_BYREF,          // 1 字节目标类型码 + 8 字节目标大小
+    ZC_DESC_KIND_SIZED,          // 8 字节对象大小
+    ZC_DESC_KIND_COMPOSITE,      // 4 字节 tokens_len + 8 字节对象大小 + ...
+    ZC_DESC_KIND_TENSOR,         // 1 字节元素 token + 2 字节阶数 + 阶数 * 2 字节维度
+    ZC_DESC_KIND_ARRAY,          // 元素描述符 + 1 字节维数 + 维数 * 16 字节
+    ZC_DESC_KIND_SZARRAY,        // 元素描述符 + 4 字节元素数
+} zc_type_desc_kind_t;
+
+typedef struct zc_type_desc_rule
+{
+    uint8_t kind;
+    uint8_t size;                // FIXED：对象大小；STRING：每字符字节数
+} zc_type_desc_rule_t;
+
+static const zc_type_desc_rule_t zc_type_desc_rules[256] = {
+    [ELEMENT_TYPE_END]          = { ZC_DESC_KIND_FIXED, 0 },
+    [ELEMENT_TYPE_SEPARATOR]    = { ZC_DESC_KIND_FIXED, 0 },
+    [ELEMENT_TYPE_PREFIX]       = { ZC_DESC_KIND_FIXED, 0 },
+    [ELEMENT_TYPE_INTERNAL]     = { ZC_DESC_KIND_FIXED, 0 },
+    [ELEMENT_TYPE_BOOLEAN]      = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_CHAR]         = { ZC_DESC_KIND_FIXED, 2 },
+    [ELEMENT_TYPE_I1]           = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_U1]           = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_SIGNEDASCII]  = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_ASCII]        = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_I2]           = { ZC_DESC_KIND_FIXED, 2 },
+    [ELEMENT_TYPE_U2]           = { ZC_DESC_KIND_FIXED, 2 },
+    [ELEMENT_TYPE_I4]           = { ZC_DESC_KIND_FIXED, 4 },
+    [ELEMENT_TYPE_U4]           = { ZC_DESC_KIND_FIXED, 4 },
+    [ELEMENT_TYPE_I8]           = { ZC_DESC_KIND_FIXED, 8 },
+    [ELEMENT_TYPE_U8]           = { ZC_DESC_KIND_FIXED, 8 },
+    [ELEMENT_TYPE_VAR]          = { ZC_DESC_KIND_FIXED, 1 },
+    [ELEMENT_TYPE_VOID]         = { ZC_DESC_KIND_VOID, 0 },
+    [ELEMENT_TYPE_I]            = { ZC_DESC_KIND_NATIVE_INT, 0 },
+    [ELEMENT_TYPE_U]            = { ZC_DESC_KIND_NATIVE_INT, 0 },
+    [ELEMENT_TYPE_R4]           = { ZC_DESC_KIND_R4, 0 },
+    [ELEMENT_TYPE_R8]           = { ZC_DESC_KIND_R8, 0 },
+    [ELEMENT_TYPE_FIXEDPOINT]   = { ZC_DESC_KIND_FIXEDPOINT, 0 },
+    [ELEMENT_TYPE_STRING]       = { ZC_DESC_KIND_STRING, 2 },    // UTF-16LE
+    [ELEMENT_TYPE_ASCIISTRING]  = { ZC_DESC_KIND_STRING, 1 },
+    [ELEMENT_TYPE_PTR]          = { ZC_DESC_KIND_PTR, 0 },
+    [ELEMENT_TYPE_BYREF]        = { ZC_DESC_KIND_BYREF, 0 },
+    [ELEMENT_TYPE_OBJECT]       = { ZC_DESC_KIND_SIZED, 0 },
+    [ELEMENT_TYPE_RAWBITS]      = { ZC_DESC_KIND_SIZED, 0 },
+    [ELEMENT_TYPE_VALUETYPE]    = { ZC_DESC_KIND_COMPOSITE, 0 },
+    [ELEMENT_TYPE_CLASS]        = { ZC_DESC_KIND_COMPOSITE, 0 },
+    [ELEMENT_TYPE_FLOATTENSOR]  = { ZC_DESC_KIND_TENSOR, 0 },
+    [ELEMENT_TYPE_ARRAY]        = { ZC_DESC_KIND_ARRAY, 0 },
+    [ELEMENT_TYPE_SZARRAY]      = { ZC_DESC_KIND_SZARRAY, 0 },
+};
+
+static inline uint32_t zc_type_natural_align(uint64_t size)
+{
+    return (size != 0 && size <= 8 && (size & (size - 1)) == 0) ? (uint32_t)size : 1;
+}
 
-    switch (type_tag)
+/**
+ * 解码不带数组前缀的描述符。avail 为可用字节数，读取任何 token 之前先检查边界
+ */
+static zc_internal_result_t zc_type_desc_decode_leaf(const uint8_t* desc, uint64_t avail,
+    zc_type_desc_info_t* out_info)
+{
+    const zc_type_desc_rule_t* rule = &zc_type_desc_rules[desc[0]];
+    uint64_t len = 1;
+    uint64_t size = 0;
+    uint32_t align = 0;              // 0 表示按大小取自然对齐
+    uint32_t flags = ZC_TYPE_DESC_FIXED_LEAF;
+    zc_internal_result_t res = ZC_INTERNAL_OK;
+
+    switch (rule->kind)
     {
-        case ELEMENT_TYPE_END:
-        case ELEMENT_TYPE_SEPARATOR:
-        case ELEMENT_TYPE_PREFIX:
-        case ELEMENT_TYPE_BOOLEAN:
-        case ELEMENT_TYPE_CHAR:
-        case ELEMENT_TYPE_I1:
-        case ELEMENT_TYPE_SIGNEDASCII:
-        case ELEMENT_TYPE_U1:
-        case ELEMENT_TYPE_ASCII:
-        case ELEMENT_TYPE_I2:
-        case ELEMENT_TYPE_U2:
-        case ELEMENT_TYPE_I4:
-        case ELEMENT_TYPE_U4:
-        case ELEMENT_TYPE_I8:
-        case ELEMENT_TYPE_U8:
-        case ELEMENT_TYPE_VAR:
-        case ELEMENT_TYPE_INTERNAL:
+        case ZC_DESC_KIND_FIXED:
         {
-            // 这些类型只有tag，没有附加tokens
+            size = rule->size;
             break;
         }
 
-        case ELEMENT_TYPE_VOID:
-        case ELEMENT_TYPE_R4:
-        case ELEMENT_TYPE_R8:
-        case ELEMENT_TYPE_FIXEDPOINT:
-        case ELEMENT_TYPE_I:
-        case ELEMENT_TYPE_U:
+        case ZC_DESC_KIND_VOID:
+        case ZC_DESC_KIND_NATIVE_INT:
         {
-            len += 1;
+            len = 2;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint8_t exp = desc[1];
+            if (rule->kind == ZC_DESC_KIND_VOID)
+            {
+                if (unlikely(exp > 64)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+                size = exp == 0 ? 0 : 1ULL << (exp - 1U);
+            }
+            else
+            {
+                if (unlikely(exp > 63)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+                size = 1ULL << exp;
+            }
             break;
         }
 
-        case ELEMENT_TYPE_FLOATTENSOR:
-        {
-            uint16_t d = *(uint16_t*)(desc + 2);
-            len += (3 + 2 * d);
-        }
-
-        case ELEMENT_TYPE_STRING:
-        case ELEMENT_TYPE_ASCIISTRING:
+        case ZC_DESC_KIND_R4:
+        case ZC_DESC_KIND_R8:
+        case ZC_DESC_KIND_FIXEDPOINT:
         {
-            len += 4; // 字符数量Length
+            len = 2;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            if (rule->kind == ZC_DESC_KIND_R4) res = zc_type_get_r4_obj_size(desc[1], &size);
+            else if (rule->kind == ZC_DESC_KIND_R8) res = zc_type_get_r8_obj_size(desc[1], &size);
+            else res = zc_type_get_fixpoint_obj_size(desc[1], &size);
             break;
         }
 
-        case ELEMENT_TYPE_PTR:
-        case ELEMENT_TYPE_OBJECT:
-        case ELEMENT_TYPE_RAWBITS:
+        case ZC_DESC_KIND_STRING:
         {
-            len += 8;
+            len = 5;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint32_t length;
+            memcpy(&length, desc + 1, sizeof(uint32_t));
+            size = (uint64_t)length * rule->size;
+            align = rule->size;
+            flags = 0;
             break;
         }
 
-        case ELEMENT_TYPE_BYREF:
+        case ZC_DESC_KIND_PTR:
+        case ZC_DESC_KIND_BYREF:
         {
-            len += 9;
+            len = rule->kind == ZC_DESC_KIND_PTR ? 9 : 10;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            size = 8;
             break;
         }
 
-        case ELEMENT_TYPE_VALUETYPE:
-        case ELEMENT_TYPE_CLASS:
+        case ZC_DESC_KIND_SIZED:
         {
-            uint32_t tokens_len = *(uint32_t*)(desc + 1);
-            len += tokens_len;
+            len = 9;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            memcpy(&size, desc + 1, sizeof(uint64_t));
+            align = 1;
+            flags = 0;
             break;
         }
 
-        case ELEMENT_TYPE_ARRAY:
+        case ZC_DESC_KIND_COMPOSITE:
         {
-            uint64_t elem_desc_len;
-            zc_internal_result_t res = zc_get_type_desc_len(desc + 1, &elem_desc_len);
-            if (res != ZC_INTERNAL_OK) return res;
-            len += elem_desc_len;
+            if (unlikely(avail < 13)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint32_t tokens_len;
+            memcpy(&tokens_len, desc + 1, sizeof(uint32_t));
+            memcpy(&size, desc + 5, sizeof(uint64_t));
+            len = (uint64_t)tokens_len + 1;
+            if (unlikely(len < 13 || avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
 
-            uint8_t dim_count = *(uint8_t*)(desc + len);
-            len += dim_count * (8 + 8);
+            // VALUETYPE 的对齐字节为 0 表示紧凑排列
+            align = 8;
+            if (desc[0] == ELEMENT_TYPE_VALUETYPE) align = len > 13 && desc[13] != 0 ? desc[13] : 1;
+            flags = 0;
             break;
         }
 
-        case ELEMENT_TYPE_SZARRAY:
+        case ZC_DESC_KIND_TENSOR:
         {
-            uint64_t elem_type_len;
-            zc_internal_result_t res = zc_get_type_desc_len(desc + 1, &elem_type_len);
-            if (res != ZC_INTERNAL_OK) return res;
-            len += elem_type_len + 4;
+            if (unlikely(avail < 4)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint16_t order;
+            memcpy(&order, desc + 2, sizeof(uint16_t));
+            len = 4 + 2 * (uint64_t)order;
+            if (unlikely(avail < len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+            uint16_t d0 = 0;
+            uint16_t d1 = 0;
+            if (order >= 1) memcpy(&d0, desc + 4, sizeof(uint16_t));
+            if (order >= 2) memcpy(&d1, desc + 6, sizeof(uint16_t));
+
+            uint64_t element_size;
+            res = zc_type_get_tensor_element_size(desc[1], &element_size);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+            align = zc_type_natural_align(element_size);
+
+            if (order == 1) res = zc_type_get_vector_obj_size(desc[1], d0, &size);
+            else if (order == 2 && d0 == d1) res = zc_type_get_sqmatrix_obj_size(desc[1], d1, &size);
+            else
+            {
+                // 元素数为各维之积，超出 uint64 时视为非法描述符
+                uint64_t element_count = 1;
+                uint16_t i;
+                for (i = 0; i < order; i++)
+                {
+                    uint16_t d;
+                    memcpy(&d, desc + 4 + 2 * i, sizeof(uint16_t));
+                    if (unlikely(d != 0 && element_count > UINT64_MAX / d)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+                    element_count *= d;
+                }
+                if (unlikely(element_size != 0 && element_count > UINT64_MAX / element_size)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+                size = element_size * element_count;
+            }
+            flags = 0;
             break;
         }
-            
+
         default:
         {
             return ZC_INTERNAL_UNREALIZED;
         }
     }
-    
-    *out_desc_len = len;
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    out_info->desc_len = len;
+    out_info->obj_size = size;
+    out_info->align = align ? align : zc_type_natural_align(size);
+    out_info->flags = flags;
     return ZC_INTERNAL_OK;
 }
 
 /**
- * 根据类型描述符获取变量长度
- * @param desc 类型描述符
- * @param desc_len 类型描述符长度
- * @param out_size 变量长度
+ * 
  */
-zc_internal_result_t zc_type_desc_get_obj_size(const uint8_t* desc,
-    uint64_t desc_len, uint64_t* out_obj_size)
+zc_internal_result_t zc_type_desc_decode(const uint8_t* desc, uint64_t desc_len, zc_type_desc_info_t* out_info)
 {
-    if (!desc || !out_obj_size || desc_len == 0) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(!desc || desc_len == 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    // 数组前缀按从外到内记录位置，解码完元素后由内向外回填
+    uint64_t prefix[ZC_TYPE_DESC_MAX_PREFIX];
+    uint32_t prefix_count = 0;
+    uint64_t pos = 0;
+    while (zc_type_desc_rules[desc[pos]].kind == ZC_DESC_KIND_ARRAY
+        || zc_type_desc_rules[desc[pos]].kind == ZC_DESC_KIND_SZARRAY)
+    {
+        if (unlikely(prefix_count == ZC_TYPE_DESC_MAX_PREFIX || pos + 1 >= desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+        prefix[prefix_count++] = pos++;
+    }
 
-    uint8_t type_tag = desc[0];
+    zc_type_desc_info_t info;
+    zc_internal_result_t res = zc_type_desc_decode_leaf(desc + pos, desc_len - pos, &info);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
 
-    switch (type_tag)
+    uint64_t end = pos + info.desc_len;
+    while (prefix_count > 0)
     {
-        case ELEMENT_TYPE_END:
-        case ELEMENT_TYPE_SEPARATOR:
-        case ELEMENT_TYPE_PREFIX:
+        uint64_t element_count = 1;
+        if (desc[prefix[--prefix_count]] == ELEMENT_TYPE_ARRAY)
         {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 0;
-            break;
-        }
+            if (unlikely(end + 1 > desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint8_t dim_count = desc[end];
+            if (unlikely(end + 1 + 16 * (uint64_t)dim_count > desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
 
-        case ELEMENT_TYPE_VOID:
-        {
-            if (unlikely(desc_len != 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            uint8_t exp = *(desc + 1);
-            if (exp == 0) *out_obj_size = 0;
-            else
+            // 每维 16 字节，后 8 字节为该维长度，元素数为各维之积
+            uint8_t i;
+            for (i = 0; i < dim_count; i++)
             {
-                *out_obj_size = (1U << (exp - 1U));
+                uint64_t d;
+                memcpy(&d, desc + end + 1 + 16 * (uint64_t)i + 8, sizeof(uint64_t));
+                if (unlikely(d != 0 && element_count > UINT64_MAX / d)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+                element_count *= d;
             }
-
-            break;
+            end += 1 + 16 * (uint64_t)dim_count;
         }
-
-        case ELEMENT_TYPE_BOOLEAN:
+        else
         {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 1;
-            break;
+            if (unlikely(end + 4 > desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+            uint32_t count;
+            memcpy(&count, desc + end, sizeof(uint32_t));
+            element_count = count;
+            end += 4;
         }
+        if (unlikely(element_count != 0 && info.obj_size > UINT64_MAX / element_count)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+        info.obj_size *= element_count;
+        info.flags &= ~ZC_TYPE_DESC_FIXED_LEAF;
+    }
 
-        case ELEMENT_TYPE_CHAR:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 2;
-            break;
-        }
+    info.desc_len = end;
+    *out_info = info;
+    return ZC_INTERNAL_OK;
+}
 
-        case ELEMENT_TYPE_I1:
-        case ELEMENT_TYPE_SIGNEDASCII:
-        case ELEMENT_TYPE_U1:
-        case ELEMENT_TYPE_ASCII:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 1;
-            break;
-        }
+/**
+ * 获取类型描述符长度。
+ * 实际上，这个函数是局部性的，
+ * 它不能识别这个desc是否是一个顶级变量的desc，但是它能识别这个desc的最小完整边界。
+ * 
+ * @param desc 类型描述符
+ * @param out_desc_len 类型描述符长度
+ */
+zc_internal_result_t zc_get_type_desc_len(const uint8_t* desc, uint64_t* out_desc_len)
+{
+    zc_type_desc_info_t info;
+    zc_internal_result_t res = zc_type_desc_decode(desc, UINT64_MAX, &info);
+    if (res != ZC_INTERNAL_OK) return res;
 
-        case ELEMENT_TYPE_I2:
-        case ELEMENT_TYPE_U2:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 2;
-            break;
-        }
+    *out_desc_len = info.desc_len;
+    return ZC_INTERNAL_OK;
+}
 
-        case ELEMENT_TYPE_I4:
-        case ELEMENT_TYPE_U4:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 4;
-            break;
-        }
+/**
+ * 根据类型描述符获取变量长度
+ * @param desc 类型描述符
+ * @param desc_len 类型描述符长度
+ * @param out_size 变量长度
+ */
+zc_internal_result_t zc_type_desc_get_obj_size(const uint8_t* desc,
+    uint64_t desc_len, uint64_t* out_obj_size)
+{
+    if (!desc || !out_obj_size || desc_len == 0) return ZC_INTERNAL_PARAM_PTRNULL;
 
-        case ELEMENT_TYPE_I8:
-        case ELEMENT_TYPE_U8:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 8;
-            break;
-        }
+    zc_type_desc_info_t info;
+    zc_internal_result_t res = zc_type_desc_decode(desc, desc_len, &info);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(info.desc_len != desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
 
-        case ELEMENT_TYPE_R4:
-        {
-            if (unlikely(desc_len != 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            zc_internal_result_t res = zc_type_get_r4_obj_size(desc[1], out_obj_size);
-            if (res != ZC_INTERNAL_OK) return res;
-            break;
-        }
+    *out_obj_size = info.obj_size;
+    return ZC_INTERNAL_OK;
+}
 
-        case ELEMENT_TYPE_FLOATTENSOR:
-        {
-            uint16_t o = *(uint16_t*)(desc + 2);
-            if (unlikely(desc_len != o * 2 + 4)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+/**
+ * 
+ */
+uint64_t zc_type_desc_hash(const uint8_t* desc, uint64_t desc_len)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    uint64_t i;
+    for (i = 0; i < desc_len; i++)
+    {
+        hash ^= desc[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
 
-            if (o == 1)
-            {
-                uint16_t d = *(uint16_t*)(desc + 4);
-                zc_internal_result_t res = zc_type_get_vector_obj_size(desc[1], d, out_obj_size);
-                if (res != ZC_INTERNAL_OK) return res;
-                break;
-            }
+/**
+ * 
+ */
+zc_internal_result_t zc_type_field_iter_init(zc_type_field_iter_t* iter, const uint8_t* desc, uint64_t desc_len)
+{
+    if (unlikely(!desc || desc_len == 0 || !zc_type_is_composite(desc[0]))) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
 
-            else if (o == 2)
-            {
-                uint16_t d0 = *(uint16_t*)(desc + 4);
-                uint16_t d1 = *(uint16_t*)(desc + 6);
-                if (likely(d0 == d1))
-                {
-                    zc_internal_result_t res = zc_type_get_sqmatrix_obj_size(desc[1], d1, out_obj_size);
-                    if (res != ZC_INTERNAL_OK) return res;
-                    break;
-                }
-            }
+    iter->desc = desc;
+    iter->desc_len = desc_len;
+    iter->next_offset = 0;
+    iter->index = 0;
+    iter->tag = desc[0];
 
-            uint64_t element_size;
-            zc_internal_result_t res = zc_type_get_tensor_element_size(desc[1], &element_size);
-            if (res != ZC_INTERNAL_OK) return res;
-            uint64_t element_count = 0;
-            for (uint16_t i = 0; i < o; i++)
-            {
-                element_count += *(uint16_t*)(desc + 4 + 2 * i);
-            }
-            *out_obj_size = element_size * element_count;
-            break;
-        }
+    if (iter->tag == ELEMENT_TYPE_VALUETYPE)
+    {
+        // tag | tokens_len(4) | width(8) | align(1) | N(1) | fields...
+        if (unlikely(desc_len < 15)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+        iter->align = desc[13];
+        iter->count = desc[14];
+        iter->cursor = 15;
+        return ZC_INTERNAL_OK;
+    }
 
-        case ELEMENT_TYPE_R8:
-        {
-            if (unlikely(desc_len != 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            zc_internal_result_t res = zc_type_get_r8_obj_size(desc[1], out_obj_size);
-            if (res != ZC_INTERNAL_OK) return res;
-            break;
-        }
+    // tag | tokens_len(4) | width(8) | N(4) | w(2) | header(w) | N * (offset(8) | desc_offset(4)) | descs...
+    if (unlikely(desc_len < 19)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    uint32_t count;
+    uint16_t header_size;
+    memcpy(&count, desc + 13, sizeof(uint32_t));
+    memcpy(&header_size, desc + 17, sizeof(uint16_t));
+
+    iter->align = 0;
+    iter->count = count;
+    iter->cursor = 19 + (uint64_t)header_size;
+    if (unlikely(iter->cursor + (uint64_t)count * 12 > desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    return ZC_INTERNAL_OK;
+}
 
-        case ELEMENT_TYPE_FIXEDPOINT:
-        {
-            if (unlikely(desc_len != 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            zc_internal_result_t res = zc_type_get_fixpoint_obj_size(desc[1], out_obj_size);
-            if (res != ZC_INTERNAL_OK) return res;
-            break;
-        }
+/**
+ * 
+ */
+zc_internal_result_t zc_type_field_iter_next(zc_type_field_iter_t* iter, zc_type_field_t* out_field)
+{
+    if (unlikely(zc_type_field_iter_done(iter))) return ZC_INTERNAL_PARAM_ERROR;
 
-        case ELEMENT_TYPE_STRING:
-        {
-            if (unlikely(desc_len != 5)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            uint32_t length = *(uint32_t*)(desc + 1);
-            *out_obj_size = length * 2; // UTF-16LE每个字符2字节
-            break;
-        }
+    uint64_t desc_pos;
+    uint64_t offset = 0;
+    if (iter->tag == ELEMENT_TYPE_VALUETYPE)
+    {
+        desc_pos = iter->cursor;
+    }
+    else
+    {
+        const uint8_t* item = iter->desc + iter->cursor + (uint64_t)iter->index * 12;
+        uint32_t desc_offset;
+        memcpy(&offset, item, sizeof(uint64_t));
+        memcpy(&desc_offset, item + 8, sizeof(uint32_t));
+        desc_pos = desc_offset;
+    }
+    if (unlikely(desc_pos >= iter->desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
 
-        case ELEMENT_TYPE_ASCIISTRING:
-        {
-            if (unlikely(desc_len != 5)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = *(uint32_t*)(desc + 1);
-            break;
-        }
+    const uint8_t* field_desc = iter->desc + desc_pos;
+    zc_type_desc_info_t info;
+    zc_internal_result_t res = zc_type_desc_decode(field_desc, iter->desc_len - desc_pos, &info);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    uint64_t field_desc_len = info.desc_len;
+    uint64_t size = info.obj_size;
 
-        case ELEMENT_TYPE_PTR:
-        {
-            if (unlikely(desc_len != 9)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 8;
-            break;
-        }
+    if (iter->tag == ELEMENT_TYPE_VALUETYPE)
+    {
+        uint64_t align = 1;
+        if (iter->align != 0) align = size < iter->align ? size : iter->align;
+        if (align == 0) align = 1;
+        offset = (iter->next_offset + align - 1) / align * align;
+        iter->next_offset = offset + size;
+        iter->cursor += field_desc_len;
+    }
 
-        case ELEMENT_TYPE_BYREF:
-        {
-            if (unlikely(desc_len != 10)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 8;
-            break;
-        }
+    out_field->offset = offset;
+    out_field->size = size;
+    out_field->desc = field_desc;
+    out_field->desc_len = field_desc_len;
+    iter->index++;
+    return ZC_INTERNAL_OK;
+}
 
-        case ELEMENT_TYPE_VALUETYPE:
-        case ELEMENT_TYPE_CLASS:
-        {
-            if (unlikely(desc_len != *(uint32_t*)(desc + 1) + 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = *(uint64_t*)(desc + 5);
-            break;
-        }
-            
-        case ELEMENT_TYPE_VAR:
-        {
-            if (unlikely(desc_len != 1)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = 1;
-            break;
-        }
-            
-        case ELEMENT_TYPE_ARRAY:
-        {
-            uint64_t element_desc_len;
-            zc_internal_result_t res = zc_get_type_desc_len(desc + 1, &element_desc_len);
-            if (res != ZC_INTERNAL_OK) return res;
+/**
+ * 低 4 bit 为宽度类别，高 4 bit 区分同宽度下的具体格式。FP6 每个元素占 1 字节，使用低 6 bit
+ */
+zc_internal_result_t zc_type_get_r4_obj_size(const uint8_t r4_type_token, uint64_t* out_obj_size)
+{
+    switch (r4_type_token)
+    {
+        case R4_TYPE_FLOAT:
+        case R4_TYPE_TF32:
+            *out_obj_size = 4;
+            return ZC_INTERNAL_OK;
 
-            uint8_t dim_count = *(uint8_t*)(desc + element_desc_len + 1);
-            if (unlikely(desc_len != element_desc_len + 2 + dim_count * 16)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+        case R4_TYPE_HALF:
+        case R4_TYPE_BFLOAT16:
+            *out_obj_size = 2;
+            return ZC_INTERNAL_OK;
+
+        case R4_TYPE_FP8_E5M2:
+        case R4_TYPE_FP8_E4M3:
+        case R4_TYPE_FP6_E3M2:
+        case R4_TYPE_FP6_E2M3:
+        case R4_TYPE_FP6_E4M1:
+        case R4_TYPE_FP6_E2M3_NOLEADING:
+            *out_obj_size = 1;
+            return ZC_INTERNAL_OK;
 
-            uint64_t element_size;
-            res = zc_type_desc_get_obj_size(desc + 1, element_desc_len, &element_size);
-            if (res != ZC_INTERNAL_OK) return res;
+        default:
+            return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    }
+}
 
-            uint64_t element_count = 0;
-            for (uint8_t i = 0; i < dim_count; i++)
-            {
-                element_count += *(uint64_t*)(desc + element_desc_len + (1 + 1 + 8) + 16 * i);
-            }
-            *out_obj_size = element_count * element_size;
-            break;
-        }
-            
-        case ELEMENT_TYPE_I:
-        case ELEMENT_TYPE_U:
-        {
-            if (unlikely(desc_len != 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            uint8_t exp = *(desc + 1);
-            *out_obj_size = (1U << exp);
-            break;
-        }
-            
-        case ELEMENT_TYPE_OBJECT:
-        case ELEMENT_TYPE_RAWBITS:
-        {
-            if (unlikely(desc_len != 9)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
-            *out_obj_size = *(uint64_t*)(desc + 1);
-            break;
-        }
-            
-        case ELEMENT_TYPE_SZARRAY:
-        {
-            uint64_t elem_desc_len;
-            zc_internal_result_t res = zc_get_type_desc_len(desc + 1, &elem_desc_len);
-            if (res != ZC_INTERNAL_OK) return res;
+/**
+ * LONGDOUBLE 的 80 bit 扩展精度按 16 字节存放，与 QUADRUPLE 同宽
+ */
+zc_internal_result_t zc_type_get_r8_obj_size(const uint8_t r8_type_token, uint64_t* out_obj_size)
+{
+    switch (r8_type_token)
+    {
+        case R8_TYPE_DOUBLE:
+            *out_obj_size = 8;
+            return ZC_INTERNAL_OK;
 
-            uint64_t single_elem_size = 0;
-            res = zc_type_desc_get_size(desc + 1, elem_desc_len, &single_elem_size);
-            if (res != ZC_INTERNAL_OK) return res;
+        case R8_TYPE_LONGDOUBLE:
+        case R8_TYPE_QUADRUPLE:
+            *out_obj_size = 16;
+            return ZC_INTERNAL_OK;
 
-            uint32_t total_count = *(uint32_t*)(desc + 1 + elem_desc_len);
-            *out_obj_size = single_elem_size * total_count;
-            break;
-        }
-            
         default:
-        {
-            return ZC_INTERNAL_UNREALIZED;
-        }
+            return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
     }
-    
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_get_tensor_element_size(const uint8_t tensor_type_token, uint64_t* out_element_size)
+{
+    return zc_type_get_r4_obj_size(tensor_type_token, out_element_size);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_get_vector_obj_size(const uint8_t vec_type_token, const uint16_t vec_dim_count,
+    uint64_t* out_obj_size)
+{
+    uint64_t element_size;
+    zc_internal_result_t res = zc_type_get_tensor_element_size(vec_type_token, &element_size);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_obj_size = element_size * vec_dim_count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_get_sqmatrix_obj_size(const uint8_t mat_type_token, const uint16_t mat_dim_count,
+    uint64_t* out_obj_size)
+{
+    uint64_t element_size;
+    zc_internal_result_t res = zc_type_get_tensor_element_size(mat_type_token, &element_size);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_obj_size = element_size * mat_dim_count * mat_dim_count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_get_fixpoint_obj_size(const uint8_t fixp_type_token, uint64_t* out_obj_size)
+{
+    if (unlikely(zc_fixp_scale(fixp_type_token) > FIXP_TYPE_SCALE_MAX)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    *out_obj_size = zc_fixp_width(fixp_type_token);
     return ZC_INTERNAL_OK;
-}
\ No newline at end of file
+}
@@ -94,11 +94,74 @@ typedef enum R8TypeTokenEnum
     R8_TYPE_QUADRUPLE           = 0x02,  // E15M112 with implied leading 1
 } R8TypeToken;
 
+/**
+ * 十进制定点数的表示：最高 1bit 表示有符号，其后 2bit 为存储宽度 1 / 2 / 4 / 8 字节，低 5bit 为小数位数。
+ * 值 = 存储的整数 / 10^scale
+ */
 typedef enum FixpTypeTokenEnum
 {
-    FIXP_TYPE_
+    FIXP_TYPE_SIGNED            = 0x80,
+    FIXP_TYPE_WIDTH_1           = 0x00,
+    FIXP_TYPE_WIDTH_2           = 0x20,
+    FIXP_TYPE_WIDTH_4           = 0x40,
+    FIXP_TYPE_WIDTH_8           = 0x60,
+    FIXP_TYPE_WIDTH_MASK        = 0x60,
+    FIXP_TYPE_SCALE_MASK        = 0x1F,
+    FIXP_TYPE_SCALE_MAX         = 18,    // 10^18 是 int64 能容纳的最大 10 的幂
 } FixpTypeToken;
 
+#define ZC_FIXP_TOKEN(is_signed, width_flag, scale) \
+    ((uint8_t)(((is_signed) ? FIXP_TYPE_SIGNED : 0) | (width_flag) | ((scale) & FIXP_TYPE_SCALE_MASK)))
+
+static inline bool zc_fixp_is_signed(uint8_t fixp_type_token)
+{
+    return (fixp_type_token & FIXP_TYPE_SIGNED) != 0;
+}
+
+static inline uint32_t zc_fixp_width(uint8_t fixp_type_token)
+{
+    return 1U << ((fixp_type_token & FIXP_TYPE_WIDTH_MASK) >> 5);
+}
+
+static inline uint32_t zc_fixp_scale(uint8_t fixp_type_token)
+{
+    return fixp_type_token & FIXP_TYPE_SCALE_MASK;
+}
+
+#define ZC_TYPE_DESC_MAX_PREFIX   16      // ARRAY / SZARRAY 前缀的最大嵌套层数
+
+#define ZC_TYPE_DESC_FIXED_LEAF   0x01    // 定长标量叶子：整型、浮点、定点、PTR / BYREF 等，不含元素或字段
+
+/**
+ * 描述符单次解码的结果
+ */
+typedef struct zc_type_desc_info
+{
+    uint64_t desc_len;
+    uint64_t obj_size;
+    uint32_t align;       // 对象的自然对齐
+    uint32_t flags;
+} zc_type_desc_info_t;
+
+/**
+ * @brief 一次解码得到描述符长度、对象大小、对齐与叶子标志。
+ *
+ * 按主类型码查表决定解码方式，ARRAY / SZARRAY 前缀迭代展开，不递归。
+ *
+ * @param desc      [in] 类型描述符。
+ * @param desc_len  [in] 可读取的字节数上限，描述符实际长度由 out_info->desc_len 给出。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符越界或字段非法。
+ * - ZC_INTERNAL_UNREALIZED: 未支持的主类型码。
+ */
+zc_internal_result_t zc_type_desc_decode(
+    const uint8_t* desc,
+    uint64_t desc_len,
+    zc_type_desc_info_t* out_info
+);
+
 zc_internal_result_t zc_get_type_desc_len(
     const uint8_t* desc,
     uint64_t* out_desc_len
@@ -110,34 +173,147 @@ zc_internal_result_t zc_type_desc_get_obj_size(
     uint64_t* out_obj_size
 );
 
-zc_internal_result_t inline zc_type_get_r4_obj_size(
+/**
+ * 类型描述符字节流的 64 位哈希 (FNV-1a)，用于描述符驻留与快速比较。
+ */
+uint64_t zc_type_desc_hash(
+    const uint8_t* desc,
+    uint64_t desc_len
+);
+
+/**
+ * 复合类型 (VALUETYPE / CLASS) 的直接字段迭代器，按内存布局顺序给出字段，偏移相对于所属对象起始。
+ * VALUETYPE 的字段偏移按布局规则推出：field_align = min(field_size, struct_align)，struct_align 为 0 表示紧凑排列。
+ */
+typedef struct zc_type_field_iter
+{
+    const uint8_t* desc;
+    uint64_t       desc_len;
+    uint64_t       cursor;       // VALUETYPE：下一个字段描述符的位置；CLASS：字段表的位置
+    uint64_t       next_offset;  // VALUETYPE：上一字段的结束偏移
+    uint32_t       count;
+    uint32_t       index;
+    uint8_t        tag;
+    uint8_t        align;
+} zc_type_field_iter_t;
+
+typedef struct zc_type_field
+{
+    uint64_t       offset;       // 相对于所属对象起始
+    uint64_t       size;
+    const uint8_t* desc;
+    uint64_t       desc_len;
+} zc_type_field_t;
+
+static inline bool zc_type_is_composite(uint8_t type_tag)
+{
+    return type_tag == ELEMENT_TYPE_VALUETYPE || type_tag == ELEMENT_TYPE_CLASS;
+}
+
+static inline bool zc_type_field_iter_done(const zc_type_field_iter_t* iter)
+{
+    return iter->index >= iter->count;
+}
+
+/**
+ * @brief 初始化复合类型的字段迭代器。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符不是 VALUETYPE / CLASS，或头部越界。
+ */
+zc_internal_result_t zc_type_field_iter_init(
+    zc_type_field_iter_t* iter,
+    const uint8_t* desc,
+    uint64_t desc_len
+);
+
+/**
+ * @brief 取出下一个直接字段。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: 已没有剩余字段。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 字段描述符越出所属描述符。
+ * - 其他 zc_type_desc_decode 的错误码。
+ */
+zc_internal_result_t zc_type_field_iter_next(
+    zc_type_field_iter_t* iter,
+    zc_type_field_t* out_field
+);
+
+/**
+ * @brief R4 token 对应的元素宽度：FLOAT / TF32 为 4 字节，HALF / BFLOAT16 为 2 字节，FP8 与 FP6 为 1 字节。
+ *
+ * TF32 以 FLOAT 的位布局存放，尾数低 13 bit 为 0；FP6 存放在字节的低 6 bit。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的 token。
+ */
+zc_internal_result_t zc_type_get_r4_obj_size(
     const uint8_t r4_type_token,
     uint64_t* out_obj_size
 );
 
-zc_internal_result_t inline zc_type_get_vector_obj_size(
+/**
+ * @brief 一阶 FLOATTENSOR（向量）的字节宽度：元素宽度 × vec_dim_count。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的元素 token。
+ */
+zc_internal_result_t zc_type_get_vector_obj_size(
     const uint8_t vec_type_token,
     const uint16_t vec_dim_count,
     uint64_t* out_obj_size
 );
 
-zc_internal_result_t inline zc_type_get_sqmatrix_obj_size(
+/**
+ * @brief 二阶且两维相等的 FLOATTENSOR（方阵）的字节宽度：元素宽度 × mat_dim_count²。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的元素 token。
+ */
+zc_internal_result_t zc_type_get_sqmatrix_obj_size(
     const uint8_t mat_type_token,
     const uint16_t mat_dim_count,
     uint64_t* out_obj_size
 );
 
-zc_internal_result_t inline zc_type_get_tensor_element_size(
+/**
+ * @brief FLOATTENSOR 的元素宽度。元素 token 与 R4 token 相同，宽度同 zc_type_get_r4_obj_size。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的元素 token。
+ */
+zc_internal_result_t zc_type_get_tensor_element_size(
     const uint8_t tensor_type_token,
     uint64_t* out_element_size
 );
 
-zc_internal_result_t inline zc_type_get_r8_obj_size(
+/**
+ * @brief R8 token 对应的元素宽度：DOUBLE 为 8 字节，LONGDOUBLE 与 QUADRUPLE 按 16 字节存放。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的 token。
+ */
+zc_internal_result_t zc_type_get_r8_obj_size(
     const uint8_t r8_type_token,
     uint64_t* out_obj_size
 );
 
-zc_internal_result_t inline zc_type_get_fixpoint_obj_size(
+/**
+ * @brief 定点 token 对应的存储宽度。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 小数位数超过 FIXP_TYPE_SCALE_MAX。
+ */
+zc_internal_result_t zc_type_get_fixpoint_obj_size(
     const uint8_t fixp_type_token,
     uint64_t* out_obj_size
 );
@@ -0,0 +1,282 @@
+#include "type_registry.h"
+#include "type_descriptor.h"
+#include <string.h>
+
+zc_type_registry_t* g_type_registry = NULL;
+
+/**
+ * 以 CAS 从池中预留 count 个单位，不足时不改动计数器。先加后减会让并发的预留在池尚有余量时误报已满
+ */
+static bool zc_type_registry_reserve(_Atomic uint32_t* counter, uint32_t count, uint32_t limit, uint32_t* out_first)
+{
+    uint32_t used = atomic_load_explicit(counter, memory_order_relaxed);
+    do
+    {
+        if ((uint64_t)used + count > limit) return false;
+    } while (!atomic_compare_exchange_weak_explicit(counter, &used, used + count,
+        memory_order_relaxed, memory_order_relaxed));
+
+    *out_first = used;
+    return true;
+}
+
+static inline bool zc_type_slot_matches(zc_type_registry_t* registry, uint64_t word,
+    uint32_t tag, const uint8_t* desc, uint64_t desc_len)
+{
+    return ZC_TYPE_SLOT_TAG(word) == tag && ZC_TYPE_SLOT_LEN(word) == desc_len
+        && memcmp(&registry->arena[ZC_TYPE_SLOT_OFFSET(word)], desc, desc_len) == 0;
+}
+
+/**
+ * 沿探测序列查找描述符。命中时传出 ID；未命中时传出第一个空槽下标（表满时为 capacity）。
+ */
+static zc_type_id_t zc_type_registry_probe(zc_type_registry_t* registry, uint64_t hash,
+    const uint8_t* desc, uint64_t desc_len, uint32_t* out_empty_index)
+{
+    uint32_t tag = (uint32_t)(hash >> 40);
+    uint32_t index = (uint32_t)hash & ZC_TYPE_REGISTRY_MASK;
+
+    uint32_t n;
+    for (n = 0; n < ZC_TYPE_REGISTRY_CAPACITY; n++)
+    {
+        uint64_t word = atomic_load_explicit(&registry->slots[index], memory_order_acquire);
+        if (word == 0)
+        {
+            *out_empty_index = index;
+            return ZC_TYPE_ID_NONE;
+        }
+        if (zc_type_slot_matches(registry, word, tag, desc, desc_len)) return index + 1;
+
+        index = (index + 1) & ZC_TYPE_REGISTRY_MASK;
+    }
+
+    *out_empty_index = ZC_TYPE_REGISTRY_CAPACITY;
+    return ZC_TYPE_ID_NONE;
+}
+
+/**
+ * 展开遍历时每层的状态
+ */
+typedef struct zc_type_layout_frame
+{
+    zc_type_field_iter_t iter;
+    uint64_t             base;     // 本层对象相对于顶层对象的偏移
+    uint32_t             parent;   // 本层所属的复合字段下标，顶层为 UINT32_MAX
+} zc_type_layout_frame_t;
+
+/**
+ * 按先序展开复合类型的全部字段。out_fields 为 NULL 时只计数
+ */
+static zc_internal_result_t zc_type_layout_walk(const uint8_t* desc, uint64_t desc_len,
+    zc_type_layout_field_t* out_fields, uint32_t* out_count)
+{
+    zc_type_layout_frame_t stack[ZC_TYPE_LAYOUT_MAX_DEPTH];
+    int32_t depth = 0;
+    uint32_t count = 0;
+
+    zc_internal_result_t res = zc_type_field_iter_init(&stack[0].iter, desc, desc_len);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    stack[0].base = 0;
+    stack[0].parent = UINT32_MAX;
+
+    while (depth >= 0)
+    {
+        zc_type_layout_frame_t* frame = &stack[depth];
+        if (zc_type_field_iter_done(&frame->iter))
+        {
+            if (out_fields && frame->parent != UINT32_MAX) out_fields[frame->parent].next = count;
+            depth--;
+            continue;
+        }
+
+        zc_type_field_t field;
+        res = zc_type_field_iter_next(&frame->iter, &field);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        uint32_t index = count++;
+        if (out_fields)
+        {
+            out_fields[index].offset = frame->base + field.offset;
+            out_fields[index].size = field.size;
+            out_fields[index].next = index + 1;
+            out_fields[index].tag = field.desc[0];
+            out_fields[index].depth = (uint8_t)depth;
+            out_fields[index].reserved = 0;
+        }
+
+        if (!zc_type_is_composite(field.desc[0])) continue;
+        if (unlikely(depth + 1 >= ZC_TYPE_LAYOUT_MAX_DEPTH)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+        zc_type_layout_frame_t* child = &stack[depth + 1];
+        res = zc_type_field_iter_init(&child->iter, field.desc, field.desc_len);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        child->base = frame->base + field.offset;
+        child->parent = index;
+        depth++;
+    }
+
+    *out_count = count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_registry_init(zc_type_registry_t* registry)
+{
+    if (unlikely(registry == NULL)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    registry->magic = ZC_TYPE_REGISTRY_MAGIC;
+    registry->capacity = ZC_TYPE_REGISTRY_CAPACITY;
+    atomic_init(&registry->arena_used, 0);
+    atomic_init(&registry->type_count, 0);
+    atomic_init(&registry->layout_used, 0);
+
+    uint32_t i;
+    for (i = 0; i < ZC_TYPE_REGISTRY_CAPACITY; i++)
+    {
+        atomic_init(&registry->slots[i], 0);
+        atomic_init(&registry->layouts[i], 0);
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_registry_attach(zc_type_registry_t* registry)
+{
+    if (registry != NULL && registry->magic != ZC_TYPE_REGISTRY_MAGIC) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+
+    g_type_registry = registry;
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_registry_find(zc_type_registry_t* registry,
+    const uint8_t* desc, uint64_t desc_len, zc_type_id_t* out_id)
+{
+    if (unlikely(desc_len == 0 || desc_len > ZC_TYPE_DESC_MAX_LEN)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    uint32_t empty_index;
+    *out_id = zc_type_registry_probe(registry, zc_type_desc_hash(desc, desc_len), desc, desc_len, &empty_index);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_registry_intern(zc_type_registry_t* registry,
+    const uint8_t* desc, uint64_t desc_len, zc_type_id_t* out_id)
+{
+    if (unlikely(desc_len == 0 || desc_len > ZC_TYPE_DESC_MAX_LEN)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    uint64_t hash = zc_type_desc_hash(desc, desc_len);
+    uint32_t index;
+    zc_type_id_t id = zc_type_registry_probe(registry, hash, desc, desc_len, &index);
+    if (likely(id != ZC_TYPE_ID_NONE))
+    {
+        *out_id = id;
+        return ZC_INTERNAL_OK;
+    }
+    if (index == ZC_TYPE_REGISTRY_CAPACITY) return ZC_INTERNAL_TYPE_REGISTRY_FULL;
+
+    // 先写字节池再发布槽位，读到槽位的线程一定能看到完整描述符与解码结果
+    uint32_t alloc_size = (uint32_t)((sizeof(zc_type_arena_header_t) + desc_len + 7) & ~7ULL);
+    uint32_t alloc;
+    if (!zc_type_registry_reserve(&registry->arena_used, alloc_size, ZC_TYPE_REGISTRY_ARENA_SIZE, &alloc))
+    {
+        return ZC_INTERNAL_TYPE_REGISTRY_FULL;
+    }
+    zc_type_arena_header_t* header = (zc_type_arena_header_t*)&registry->arena[alloc];
+    header->decode_result = zc_type_desc_decode(desc, desc_len, &header->info);
+    if (header->decode_result == ZC_INTERNAL_OK && header->info.desc_len != desc_len)
+    {
+        header->decode_result = ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    }
+    header->reserved = 0;
+
+    uint32_t offset = alloc + (uint32_t)sizeof(zc_type_arena_header_t);
+    memcpy(&registry->arena[offset], desc, desc_len);
+
+    uint32_t tag = (uint32_t)(hash >> 40);
+    uint64_t word = ((uint64_t)tag << 40) | (desc_len << 24) | offset;
+
+    uint32_t n;
+    for (n = 0; n < ZC_TYPE_REGISTRY_CAPACITY; n++)
+    {
+        uint64_t expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&registry->slots[index], &expected, word,
+            memory_order_release, memory_order_acquire))
+        {
+            atomic_fetch_add_explicit(&registry->type_count, 1, memory_order_relaxed);
+            *out_id = index + 1;
+
+            if (zc_type_is_composite(desc[0]))
+            {
+                const zc_type_layout_field_t* fields;
+                uint32_t field_count;
+                zc_type_registry_build_layout(registry, index + 1, &fields, &field_count);
+            }
+            return ZC_INTERNAL_OK;
+        }
+
+        // 被抢占的槽位可能恰好是同一描述符
+        if (zc_type_slot_matches(registry, expected, tag, desc, desc_len))
+        {
+            *out_id = index + 1;
+            return ZC_INTERNAL_OK;
+        }
+
+        index = (index + 1) & ZC_TYPE_REGISTRY_MASK;
+    }
+
+    return ZC_INTERNAL_TYPE_REGISTRY_FULL;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_type_registry_build_layout(zc_type_registry_t* registry,
+    zc_type_id_t type_id, const zc_type_layout_field_t** out_fields, uint32_t* out_field_count)
+{
+    const uint8_t* desc;
+    uint64_t desc_len;
+    zc_internal_result_t res = zc_type_registry_get_desc(registry, type_id, &desc, &desc_len);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    _Atomic uint64_t* layout = &registry->layouts[type_id - 1];
+    uint64_t word = atomic_load_explicit(layout, memory_order_acquire);
+    if (word == 0)
+    {
+        uint32_t count;
+        res = zc_type_layout_walk(desc, desc_len, NULL, &count);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        uint32_t first;
+        if (!zc_type_registry_reserve(&registry->layout_used, count, ZC_TYPE_REGISTRY_LAYOUT_CAPACITY, &first))
+        {
+            return ZC_INTERNAL_TYPE_REGISTRY_FULL;
+        }
+        res = zc_type_layout_walk(desc, desc_len, &registry->layout_fields[first], &count);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        // 先写字段再发布布局字，竞争失败时采用胜者的表
+        uint64_t expected = 0;
+        word = ((uint64_t)count << 32) | (first + 1);
+        if (!atomic_compare_exchange_strong_explicit(layout, &expected, word,
+            memory_order_release, memory_order_acquire))
+        {
+            word = expected;
+        }
+    }
+
+    *out_fields = &registry->layout_fields[ZC_TYPE_LAYOUT_FIRST(word)];
+    *out_field_count = ZC_TYPE_LAYOUT_COUNT(word);
+    return ZC_INTERNAL_OK;
+}
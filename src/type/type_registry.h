@@ -0,0 +1,246 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "type_descriptor.h"
+
+#ifndef TYPE_REGISTRY_H
+#define TYPE_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t zc_type_id_t;
+
+#define ZC_TYPE_ID_NONE 0
+
+#ifndef ZC_TYPE_REGISTRY_CAPACITY
+#define ZC_TYPE_REGISTRY_CAPACITY 4096          // 槽位数，必须是 2 的幂
+#endif
+#define ZC_TYPE_REGISTRY_MASK (ZC_TYPE_REGISTRY_CAPACITY - 1)
+
+#ifndef ZC_TYPE_REGISTRY_ARENA_SIZE
+#define ZC_TYPE_REGISTRY_ARENA_SIZE (256 * 1024) // 描述符字节池
+#endif
+
+#if ZC_TYPE_REGISTRY_ARENA_SIZE > (1 << 24)
+#error "zc_type_registry packs arena offsets into 24 bits"
+#endif
+
+#ifndef ZC_TYPE_REGISTRY_LAYOUT_CAPACITY
+#define ZC_TYPE_REGISTRY_LAYOUT_CAPACITY 16384   // 展开字段池的字段数
+#endif
+
+#define ZC_TYPE_LAYOUT_MAX_DEPTH 16              // 复合类型的最大嵌套层数
+
+#define ZC_TYPE_REGISTRY_MAGIC 0x5A435452U       // "ZCTR"
+
+/**
+ * 槽位字：[63:40] 哈希标签 | [39:24] 描述符长度 | [23:0] 描述符在字节池中的偏移。
+ * 以单次 CAS 发布，0 表示空槽。槽位只增不删，类型 ID = 槽位下标 + 1，在池生命周期内稳定。
+ */
+#define ZC_TYPE_SLOT_TAG(word)    ((uint32_t)((word) >> 40))
+#define ZC_TYPE_SLOT_LEN(word)    ((uint32_t)(((word) >> 24) & 0xFFFF))
+#define ZC_TYPE_SLOT_OFFSET(word) ((uint32_t)((word) & 0xFFFFFF))
+#define ZC_TYPE_DESC_MAX_LEN      0xFFFF
+
+/**
+ * 字节池中紧邻每个描述符之前的解码结果，驻留时计算一次。字节池按 8 字节对齐分配。
+ */
+typedef struct zc_type_arena_header {
+    zc_type_desc_info_t  info;
+    int32_t              decode_result;   // zc_type_desc_decode 的结果，描述符非法时也照常驻留
+    uint32_t             reserved;
+} zc_type_arena_header_t;
+
+/**
+ * 布局字：[63:32] 字段数 | [31:0] 首字段在展开字段池中的下标 + 1。以单次 CAS 发布，0 表示尚未建立。
+ */
+#define ZC_TYPE_LAYOUT_COUNT(word) ((uint32_t)((word) >> 32))
+#define ZC_TYPE_LAYOUT_FIRST(word) ((uint32_t)(word) - 1)
+
+/**
+ * 复合类型 (VALUETYPE / CLASS) 展开后的字段，按先序排列，偏移相对于顶层对象起始。
+ * 复合字段的子字段位于 [下标 + 1, next)，next 同时是下一个平级字段的下标。
+ */
+typedef struct zc_type_layout_field {
+    uint64_t  offset;
+    uint64_t  size;
+    uint32_t  next;
+    uint8_t   tag;         // 字段主类型码
+    uint8_t   depth;       // 顶层字段为 0
+    uint16_t  reserved;
+} zc_type_layout_field_t;
+
+/**
+ * 描述符驻留表。只包含偏移，可直接放在共享内存中，由所有进程各自映射后 attach。
+ */
+typedef struct zc_type_registry {
+    uint32_t          magic;
+    uint32_t          capacity;
+    _Atomic uint32_t  arena_used;      // 字节池已分配长度
+    _Atomic uint32_t  type_count;      // 已驻留类型数
+    _Atomic uint32_t  layout_used;     // 展开字段池已分配字段数
+    _Atomic uint64_t  slots[ZC_TYPE_REGISTRY_CAPACITY];
+    _Atomic uint64_t  layouts[ZC_TYPE_REGISTRY_CAPACITY];   // 与槽位一一对应的布局字
+    uint8_t           arena[ZC_TYPE_REGISTRY_ARENA_SIZE];
+    zc_type_layout_field_t layout_fields[ZC_TYPE_REGISTRY_LAYOUT_CAPACITY];
+} zc_type_registry_t;
+
+/**
+ * 当前进程已 attach 的驻留表，未 attach 时为 NULL。
+ */
+extern zc_type_registry_t* g_type_registry;
+
+zc_internal_result_t zc_type_registry_init(
+    zc_type_registry_t* registry
+);
+
+/**
+ * @brief 把驻留表设为当前进程的全局驻留表。传入 NULL 解除。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: registry 未初始化。
+ */
+zc_internal_result_t zc_type_registry_attach(
+    zc_type_registry_t* registry
+);
+
+/**
+ * @brief 驻留一个描述符并返回其类型 ID；已存在时返回已有 ID。
+ *
+ * 无锁：先只读探测，未命中时在字节池中分配并写入解码结果与描述符，再以 CAS 发布槽位。
+ * 与其他线程竞争同一描述符失败时返回胜者的 ID，本次分配的字节不回收。
+ *
+ * @param desc      [in] 类型描述符（非块内偏移）。
+ * @param desc_len  [in] 描述符长度，1 ~ ZC_TYPE_DESC_MAX_LEN。
+ * @param out_id    [out] 类型 ID，非 0。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符长度非法。
+ * - ZC_INTERNAL_TYPE_REGISTRY_FULL: 槽位或字节池已满。
+ *
+ * @note
+ * - 同一描述符在任何线程、任何进程中得到的 ID 相同，描述符相等等价于 ID 相等。
+ * - 复合类型在驻留时顺带建立展开字段表，失败时留待 zc_type_registry_get_layout 再建。
+ */
+zc_internal_result_t zc_type_registry_intern(
+    zc_type_registry_t* registry,
+    const uint8_t* desc,
+    uint64_t desc_len,
+    zc_type_id_t* out_id
+);
+
+/**
+ * @brief 只读查找描述符对应的类型 ID，未驻留时传出 ZC_TYPE_ID_NONE。
+ */
+zc_internal_result_t zc_type_registry_find(
+    zc_type_registry_t* registry,
+    const uint8_t* desc,
+    uint64_t desc_len,
+    zc_type_id_t* out_id
+);
+
+/**
+ * 由类型 ID 取得驻留的描述符。
+ */
+static inline zc_internal_result_t zc_type_registry_get_desc(zc_type_registry_t* registry,
+    zc_type_id_t type_id, const uint8_t** out_desc, uint64_t* out_desc_len)
+{
+    if (unlikely(type_id == ZC_TYPE_ID_NONE || type_id > ZC_TYPE_REGISTRY_CAPACITY)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    uint64_t word = atomic_load_explicit(&registry->slots[type_id - 1], memory_order_acquire);
+    if (unlikely(word == 0)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    *out_desc = &registry->arena[ZC_TYPE_SLOT_OFFSET(word)];
+    *out_desc_len = ZC_TYPE_SLOT_LEN(word);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 由类型 ID 取得驻留时解码并缓存的描述符信息，不再解码描述符。
+ */
+static inline zc_internal_result_t zc_type_registry_get_info(zc_type_registry_t* registry,
+    zc_type_id_t type_id, const zc_type_desc_info_t** out_info)
+{
+    if (unlikely(type_id == ZC_TYPE_ID_NONE || type_id > ZC_TYPE_REGISTRY_CAPACITY)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    uint64_t word = atomic_load_explicit(&registry->slots[type_id - 1], memory_order_acquire);
+    if (unlikely(word == 0)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    const zc_type_arena_header_t* header = (const zc_type_arena_header_t*)
+        &registry->arena[ZC_TYPE_SLOT_OFFSET(word) - sizeof(zc_type_arena_header_t)];
+    if (unlikely(header->decode_result != ZC_INTERNAL_OK)) return (zc_internal_result_t)header->decode_result;
+
+    *out_info = &header->info;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * @brief 校验对象宽度与描述符的对象大小一致。
+ *
+ * type_id 非 0 时取驻留时缓存的解码结果，否则解码一次描述符。registry 可为 NULL。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 宽度与描述符一致。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符无法解码，或宽度与对象大小不符。
+ */
+static inline zc_internal_result_t zc_type_registry_check_width(zc_type_registry_t* registry,
+    zc_type_id_t type_id, const uint8_t* desc, uint64_t desc_len, uint64_t obj_width)
+{
+    zc_type_desc_info_t decoded;
+    const zc_type_desc_info_t* info = &decoded;
+    if (registry != NULL && type_id != ZC_TYPE_ID_NONE)
+    {
+        if (unlikely(zc_type_registry_get_info(registry, type_id, &info) != ZC_INTERNAL_OK)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    }
+    else if (unlikely(zc_type_desc_decode(desc, desc_len, &decoded) != ZC_INTERNAL_OK)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    if (unlikely(info->obj_size != obj_width)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * @brief 为复合类型建立展开字段表并发布。已建立时直接返回已有的表。
+ *
+ * 无锁：先计数再从展开字段池分配、写入，最后以 CAS 发布布局字；竞争失败时采用胜者的表，本次分配的字段不回收。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_UNKNOWN_ID: 类型 ID 未驻留。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 不是 VALUETYPE / CLASS，描述符非法，或嵌套超过 ZC_TYPE_LAYOUT_MAX_DEPTH 层。
+ * - ZC_INTERNAL_TYPE_REGISTRY_FULL: 展开字段池已满。
+ */
+zc_internal_result_t zc_type_registry_build_layout(
+    zc_type_registry_t* registry,
+    zc_type_id_t type_id,
+    const zc_type_layout_field_t** out_fields,
+    uint32_t* out_field_count
+);
+
+/**
+ * 取得复合类型的展开字段表，尚未建立时建立。
+ */
+static inline zc_internal_result_t zc_type_registry_get_layout(zc_type_registry_t* registry,
+    zc_type_id_t type_id, const zc_type_layout_field_t** out_fields, uint32_t* out_field_count)
+{
+    if (unlikely(type_id == ZC_TYPE_ID_NONE || type_id > ZC_TYPE_REGISTRY_CAPACITY)) return ZC_INTERNAL_TYPE_UNKNOWN_ID;
+
+    uint64_t word = atomic_load_explicit(&registry->layouts[type_id - 1], memory_order_acquire);
+    if (unlikely(word == 0)) return zc_type_registry_build_layout(registry, type_id, out_fields, out_field_count);
+
+    *out_fields = &registry->layout_fields[ZC_TYPE_LAYOUT_FIRST(word)];
+    *out_field_count = ZC_TYPE_LAYOUT_COUNT(word);
+    return ZC_INTERNAL_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TYPE_REGISTRY_H */
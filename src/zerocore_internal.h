@@ -19,6 +19,11 @@ extern "C" {
 #define ZC_CACHE_LINE_SIZE 512
 #endif
 
+// 硬件缓存行大小，用于隔离线程私有的热点字段（ZC_CACHE_LINE_SIZE 指内存池的“行”即页）
+#ifndef ZC_HW_CACHE_LINE_SIZE
+#define ZC_HW_CACHE_LINE_SIZE 64
+#endif
+
 #ifndef ZC_MAX_WRITERS
 #define ZC_MAX_WRITERS 32
 #endif
@@ -47,6 +52,7 @@ extern "C" {
 typedef uint32_t zc_writer_id_t;
 typedef uint64_t zc_reader_id_t;
 typedef uint64_t zc_time_t;
+typedef uint32_t zc_short_time_t;
 
 typedef enum zc_internal_result {
     ZC_INTERNAL_OK                        = 0,
@@ -64,6 +70,9 @@ typedef enum zc_internal_result {
     ZC_INTERNAL_TYPE_ILLEGAL_DESC         = 31,
     ZC_INTERNAL_TYPE_ILLEGAL_PTR          = 32,
     ZC_INTERNAL_TYPE_ILLEGAL_BYREF        = 33,
+    ZC_INTERNAL_TYPE_REGISTRY_FULL        = 34,
+    ZC_INTERNAL_TYPE_UNKNOWN_ID           = 35,
+    ZC_INTERNAL_TYPE_ILLEGAL_TEXT         = 36,
 
     ZC_INTERNAL_ZORA_ERROR                = 40,
     ZC_INTERNAL_ZORA_UNEXPECTVERSION      = 41,
@@ -80,6 +89,7 @@ typedef enum zc_internal_result {
     ZC_INTERNAL_DTTA_DATA_CONFLICT        = 63,
     ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND      = 64,
     ZC_INTERNAL_DTTA_DESC_MISMATCH        = 65,
+    ZC_INTERNAL_DTTA_FROZEN               = 66,
 } zc_internal_result_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,318 @@
+#include "compare.h"
+#include <string.h>
+#include <math.h>
+#include "simd.h"
+#include "dtta.h"
+
+/**
+ * 比较结果掩码中是否有任一位被置位
+ */
+static inline bool zc_cmp_mask_any(const void* mask)
+{
+    uint64_t words[ZC_SIMD_VECTOR_BYTES / sizeof(uint64_t)];
+    memcpy(words, mask, sizeof(words));
+
+    uint64_t any = 0;
+    uint32_t i;
+    for (i = 0; i < ZC_SIMD_VECTOR_BYTES / sizeof(uint64_t); i++) any |= words[i];
+    return any != 0;
+}
+
+#define ZC_CMP_LEVEL baseline
+#define ZC_CMP_ATTR
+#include "compare_kernels.h"
+#undef ZC_CMP_ATTR
+#undef ZC_CMP_LEVEL
+
+#if ZC_SIMD_X86
+#define ZC_CMP_LEVEL sse42
+#define ZC_CMP_ATTR ZC_SIMD_TARGET_SSE42
+#include "compare_kernels.h"
+#undef ZC_CMP_ATTR
+#undef ZC_CMP_LEVEL
+
+#define ZC_CMP_LEVEL avx2
+#define ZC_CMP_ATTR ZC_SIMD_TARGET_AVX2
+#include "compare_kernels.h"
+#undef ZC_CMP_ATTR
+#undef ZC_CMP_LEVEL
+
+#define ZC_CMP_LEVEL avx512
+#define ZC_CMP_ATTR ZC_SIMD_TARGET_AVX512
+#include "compare_kernels.h"
+#undef ZC_CMP_ATTR
+#undef ZC_CMP_LEVEL
+#endif
+
+typedef struct zc_compare_kernels {
+    uint64_t (*find_scalar)(const void* data, uint64_t count, const void* scalar, uint32_t op);
+    uint64_t (*find_mismatch)(const void* a, const void* b, uint64_t count);
+    void     (*minmax)(const void* data, uint64_t count, void* inout_min, void* inout_max);
+} zc_compare_kernels_t;
+
+#define ZC_CMP_ENTRY(kind, level) \
+    { zc_cmp_find_scalar_##kind##_##level, zc_cmp_find_mismatch_##kind##_##level, zc_cmp_minmax_##kind##_##level }
+#define ZC_CMP_ROW(level) {                                                     \
+    ZC_CMP_ENTRY(i8, level),  ZC_CMP_ENTRY(u8, level),  ZC_CMP_ENTRY(i16, level), \
+    ZC_CMP_ENTRY(u16, level), ZC_CMP_ENTRY(i32, level), ZC_CMP_ENTRY(u32, level), \
+    ZC_CMP_ENTRY(i64, level), ZC_CMP_ENTRY(u64, level), ZC_CMP_ENTRY(f32, level), \
+    ZC_CMP_ENTRY(f64, level) }
+
+// 按 [zc_simd_level_t][zc_numeric_kind_t] 索引
+static const zc_compare_kernels_t zc_compare_kernel_table[ZC_SIMD_LEVEL_COUNT][ZC_NUMERIC_KIND_COUNT] = {
+    ZC_CMP_ROW(baseline),
+#if ZC_SIMD_X86
+    ZC_CMP_ROW(sse42),
+    ZC_CMP_ROW(avx2),
+    ZC_CMP_ROW(avx512),
+#else
+    ZC_CMP_ROW(baseline),
+    ZC_CMP_ROW(baseline),
+    ZC_CMP_ROW(baseline),
+#endif
+};
+
+#undef ZC_CMP_ROW
+#undef ZC_CMP_ENTRY
+
+static inline const zc_compare_kernels_t* zc_compare_kernels(uint32_t kind)
+{
+    return &zc_compare_kernel_table[zc_simd_level()][kind];
+}
+
+typedef struct zc_compare_ctx {
+    const zc_compare_kernels_t* kernels;
+    const uint8_t*              operand;       // 阈值或期望数组
+    uint32_t                    op;
+    uint32_t                    element_size;
+    uint64_t                    found;         // 首个命中的下标，UINT64_MAX 表示未命中
+    zc_numeric_value_t          min;
+    zc_numeric_value_t          max;
+} zc_compare_ctx_t;
+
+static bool zc_compare_chunk_scalar(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_compare_ctx_t* c = ctx;
+    uint64_t i = c->kernels->find_scalar(data, count, c->operand, c->op);
+    if (i == count) return true;
+
+    c->found = first_index + i;
+    return false;
+}
+
+static bool zc_compare_chunk_mismatch(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_compare_ctx_t* c = ctx;
+    uint64_t i = c->kernels->find_mismatch(data, c->operand + first_index * c->element_size, count);
+    if (i == count) return true;
+
+    c->found = first_index + i;
+    return false;
+}
+
+static bool zc_compare_chunk_minmax(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_compare_ctx_t* c = ctx;
+    (void)first_index;
+    c->kernels->minmax(data, count, &c->min, &c->max);
+    return true;
+}
+
+/**
+ * 极值的初值：最小值取类型上界，最大值取类型下界
+ */
+static void zc_compare_extrema_init(zc_numeric_kind_t kind, zc_numeric_value_t* min, zc_numeric_value_t* max)
+{
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  min->i8 = INT8_MAX;   max->i8 = INT8_MIN;   break;
+        case ZC_NUMERIC_U8:  min->u8 = UINT8_MAX;  max->u8 = 0;          break;
+        case ZC_NUMERIC_I16: min->i16 = INT16_MAX; max->i16 = INT16_MIN; break;
+        case ZC_NUMERIC_U16: min->u16 = UINT16_MAX; max->u16 = 0;        break;
+        case ZC_NUMERIC_I32: min->i32 = INT32_MAX; max->i32 = INT32_MIN; break;
+        case ZC_NUMERIC_U32: min->u32 = UINT32_MAX; max->u32 = 0;        break;
+        case ZC_NUMERIC_I64: min->i64 = INT64_MAX; max->i64 = INT64_MIN; break;
+        case ZC_NUMERIC_U64: min->u64 = UINT64_MAX; max->u64 = 0;        break;
+        case ZC_NUMERIC_F32: min->f32 = INFINITY;  max->f32 = -INFINITY; break;
+        default:             min->f64 = INFINITY;  max->f64 = -INFINITY; break;
+    }
+}
+
+/**
+ * 首个等于 value 的元素下标，不存在时返回 UINT64_MAX
+ */
+static zc_internal_result_t zc_compare_find_value(zc_block_header_t* block, const zc_numeric_span_t* span,
+    const zc_numeric_value_t* value, uint64_t* out_index)
+{
+    zc_compare_ctx_t ctx = {
+        .kernels = zc_compare_kernels(span->kind),
+        .operand = value->bytes,
+        .op = ZC_COMPARE_NE,
+        .element_size = span->element_size,
+        .found = UINT64_MAX,
+    };
+    zc_internal_result_t res = zc_numeric_walk(block, span, false, zc_compare_chunk_scalar, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_index = ctx.found;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_compare_equal(zc_block_header_t* block, uint64_t offset,
+    const void* expected, uint64_t size, bool* out_result)
+{
+    if (unlikely(!expected || !out_result)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    if (size != entry->obj_width)
+    {
+        *out_result = false;
+        return ZC_INTERNAL_OK;
+    }
+
+    // 逐字节比较，任何类型都不会出现跨页元素
+    zc_numeric_span_t span = { offset, size, ZC_NUMERIC_U8, 1 };
+    zc_compare_ctx_t ctx = {
+        .kernels = zc_compare_kernels(ZC_NUMERIC_U8),
+        .operand = expected,
+        .element_size = 1,
+        .found = UINT64_MAX,
+    };
+    res = zc_numeric_walk(block, &span, false, zc_compare_chunk_mismatch, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_result = ctx.found == UINT64_MAX;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_compare_all(zc_block_header_t* block, uint64_t offset, zc_compare_op_t op,
+    const void* threshold, uint64_t size, bool* out_result)
+{
+    if (unlikely(!threshold || !out_result)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely((uint32_t)op >= ZC_COMPARE_OP_COUNT)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(size != span.element_size)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_compare_ctx_t ctx = {
+        .kernels = zc_compare_kernels(span.kind),
+        .operand = threshold,
+        .op = op,
+        .element_size = span.element_size,
+        .found = UINT64_MAX,
+    };
+    res = zc_numeric_walk(block, &span, false, zc_compare_chunk_scalar, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_result = ctx.found == UINT64_MAX;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_compare_content_equal(zc_block_header_t* block, uint64_t offset,
+    const void* expected_array, uint64_t element_size, uint64_t element_count, bool* out_result)
+{
+    if (unlikely(!out_result || (!expected_array && element_count != 0))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(element_size != span.element_size)) return ZC_INTERNAL_PARAM_ERROR;
+
+    if (element_count != span.element_count)
+    {
+        *out_result = false;
+        return ZC_INTERNAL_OK;
+    }
+
+    zc_compare_ctx_t ctx = {
+        .kernels = zc_compare_kernels(span.kind),
+        .operand = expected_array,
+        .element_size = span.element_size,
+        .found = UINT64_MAX,
+    };
+    res = zc_numeric_walk(block, &span, false, zc_compare_chunk_mismatch, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_result = ctx.found == UINT64_MAX;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_compare_minmax(zc_block_header_t* block, const zc_numeric_span_t* span,
+    zc_numeric_value_t* out_min, zc_numeric_value_t* out_max)
+{
+    zc_compare_ctx_t ctx = { .kernels = zc_compare_kernels(span->kind) };
+    zc_compare_extrema_init(span->kind, &ctx.min, &ctx.max);
+    zc_internal_result_t res = zc_numeric_walk(block, span, false, zc_compare_chunk_minmax, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // 初值在浮点序列中只会因为全为 NaN 而保留到最后
+    bool all_nan = false;
+    if (span->kind == ZC_NUMERIC_F32) all_nan = ctx.min.f32 > ctx.max.f32;
+    else if (span->kind == ZC_NUMERIC_F64) all_nan = ctx.min.f64 > ctx.max.f64;
+    if (all_nan && span->element_count > 0)
+    {
+        if (span->kind == ZC_NUMERIC_F32) ctx.min.f32 = ctx.max.f32 = NAN;
+        else ctx.min.f64 = ctx.max.f64 = NAN;
+    }
+
+    *out_min = ctx.min;
+    *out_max = ctx.max;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_compare_extrema(zc_block_header_t* block, uint64_t offset,
+    zc_compare_extrema_t* out_extrema)
+{
+    if (unlikely(!out_extrema)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(span.element_count == 0)) return ZC_INTERNAL_PARAM_ERROR;
+
+    // 第一遍只归约极值，第二遍找首次出现的位置，命中即停
+    zc_numeric_value_t min;
+    zc_numeric_value_t max;
+    res = zc_compare_minmax(block, &span, &min, &max);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    uint64_t min_index;
+    uint64_t max_index;
+    res = zc_compare_find_value(block, &span, &min, &min_index);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    res = zc_compare_find_value(block, &span, &max, &max_index);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // 只有浮点元素全为 NaN 时才找不到
+    if (min_index == UINT64_MAX || max_index == UINT64_MAX) min_index = max_index = 0;
+
+    out_extrema->min = min;
+    out_extrema->max = max;
+    out_extrema->min_index = min_index;
+    out_extrema->max_index = max_index;
+    out_extrema->kind = span.kind;
+    out_extrema->reserved = 0;
+    return ZC_INTERNAL_OK;
+}
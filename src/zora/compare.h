@@ -0,0 +1,133 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+#include "numeric.h"
+
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum zc_compare_op {
+    ZC_COMPARE_EQ = 0,
+    ZC_COMPARE_NE = 1,
+    ZC_COMPARE_GT = 2,
+    ZC_COMPARE_GE = 3,
+    ZC_COMPARE_LT = 4,
+    ZC_COMPARE_LE = 5,
+    ZC_COMPARE_OP_COUNT
+} zc_compare_op_t;
+
+/**
+ * 极值查找结果。值按元素类型存放，下标为首次出现的位置
+ */
+typedef struct zc_compare_extrema {
+    zc_numeric_value_t min;
+    zc_numeric_value_t max;
+    uint64_t           min_index;
+    uint64_t           max_index;
+    uint32_t           kind;          // zc_numeric_kind_t
+    uint32_t           reserved;
+} zc_compare_extrema_t;
+
+/**
+ * @brief 变量的全部字节是否与 expected 相同，zc_is_equal / zc_is_unequal 的块内实现。
+ *
+ * @param size [in] expected 的字节数，与变量宽度不同时结果为假。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - 其他: 由 DTTA 查询透传的错误。
+ */
+zc_internal_result_t zc_compare_equal(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void* expected,
+    uint64_t size,
+    bool* out_result
+);
+
+/**
+ * @brief 数值变量的每个元素是否都满足 element op threshold，zc_is_bigger / zc_is_smaller 的块内实现。
+ *
+ * 标量变量视为单元素数组。浮点 NaN 不满足除 NE 以外的任何比较。
+ *
+ * @param threshold [in] 与元素同类型的阈值。
+ * @param size      [in] threshold 的字节数，必须等于元素大小。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: op 越界或 size 与元素大小不符。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_compare_all(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_compare_op_t op,
+    const void* threshold,
+    uint64_t size,
+    bool* out_result
+);
+
+/**
+ * @brief 数值数组是否与 expected_array 逐元素相等，zc_if_content_equal 的块内实现。
+ *
+ * 按数值比较：浮点 +0.0 与 -0.0 相等，NaN 与任何值都不相等。元素数不同时结果为假。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: element_size 与元素大小不符。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_compare_content_equal(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void* expected_array,
+    uint64_t element_size,
+    uint64_t element_count,
+    bool* out_result
+);
+
+/**
+ * @brief 对已解析的元素序列只归约最小值与最大值，不定位下标。
+ *
+ * NaN 元素不参与比较；浮点元素全为 NaN 时两个极值均为 NaN。序列为空时返回类型的上界 / 下界。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ */
+zc_internal_result_t zc_compare_minmax(
+    zc_block_header_t* block,
+    const zc_numeric_span_t* span,
+    zc_numeric_value_t* out_min,
+    zc_numeric_value_t* out_max
+);
+
+/**
+ * @brief 查找数值变量的最小值与最大值及其首次出现的下标。
+ *
+ * NaN 元素不参与比较；浮点元素全为 NaN 时两个极值均为 NaN，下标为 0。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: 变量没有元素。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_compare_extrema(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_compare_extrema_t* out_extrema
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMPARE_H */
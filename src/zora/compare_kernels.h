@@ -0,0 +1,143 @@
+/*
+*/
+/**
+ * 比较内核模板，由 compare.c 在每个指令集级别下各包含一次，不设包含保护。
+ *
+ * 包含前需定义：
+ * - ZC_CMP_LEVEL: 函数名后缀，如 avx2
+ * - ZC_CMP_ATTR:  该级别的 target 属性，基线级别为空
+ *
+ * 所有内核按 ZC_SIMD_VECTOR_BYTES 字节的 GCC 向量扩展编写，非对齐读取经 memcpy 完成；
+ * 不足一个向量的尾部逐元素处理。
+ */
+
+#define ZC_CMP_PASTE_(a, b, c) zc_cmp_##a##_##b##_##c
+#define ZC_CMP_PASTE(a, b, c) ZC_CMP_PASTE_(a, b, c)
+#define ZC_CMP_FN(name, kind) ZC_CMP_PASTE(name, kind, ZC_CMP_LEVEL)
+
+/**
+ * 首个使 x OP s 不成立的下标，向量部分与阈值广播 sv 比较
+ */
+#define ZC_CMP_SCAN_SCALAR(T, VEC, OP)                                          \
+    for (; i + lanes <= count; i += lanes)                                      \
+    {                                                                           \
+        VEC x;                                                                  \
+        memcpy(&x, p + i * sizeof(T), sizeof(x));                               \
+        __typeof__(x == x) fail = ~(x OP sv);                                   \
+        if (zc_cmp_mask_any(&fail)) break;                                      \
+    }                                                                           \
+    for (; i < count; i++)                                                      \
+    {                                                                           \
+        T x;                                                                    \
+        memcpy(&x, p + i * sizeof(T), sizeof(x));                               \
+        if (!(x OP s)) return i;                                                \
+    }                                                                           \
+    return count
+
+#define ZC_CMP_DEFINE_KERNELS(kind, T)                                                                  \
+ZC_CMP_ATTR static uint64_t ZC_CMP_FN(find_scalar, kind)(const void* data, uint64_t count,             \
+    const void* scalar, uint32_t op)                                                                    \
+{                                                                                                       \
+    typedef T vec_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                 \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(T);                                            \
+    const uint8_t* p = data;                                                                            \
+    T s;                                                                                                \
+    memcpy(&s, scalar, sizeof(T));                                                                      \
+    vec_t sv;                                                                                           \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < lanes; i++) sv[i] = s;                                                              \
+    i = 0;                                                                                              \
+    switch (op)                                                                                         \
+    {                                                                                                   \
+        case ZC_COMPARE_EQ: { ZC_CMP_SCAN_SCALAR(T, vec_t, ==); }                                       \
+        case ZC_COMPARE_NE: { ZC_CMP_SCAN_SCALAR(T, vec_t, !=); }                                       \
+        case ZC_COMPARE_GT: { ZC_CMP_SCAN_SCALAR(T, vec_t, >); }                                        \
+        case ZC_COMPARE_GE: { ZC_CMP_SCAN_SCALAR(T, vec_t, >=); }                                       \
+        case ZC_COMPARE_LT: { ZC_CMP_SCAN_SCALAR(T, vec_t, <); }                                        \
+        default:            { ZC_CMP_SCAN_SCALAR(T, vec_t, <=); }                                       \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_CMP_ATTR static uint64_t ZC_CMP_FN(find_mismatch, kind)(const void* a, const void* b, uint64_t count) \
+{                                                                                                       \
+    typedef T vec_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                 \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(T);                                            \
+    const uint8_t* pa = a;                                                                              \
+    const uint8_t* pb = b;                                                                              \
+    uint64_t i = 0;                                                                                     \
+    for (; i + lanes <= count; i += lanes)                                                              \
+    {                                                                                                   \
+        vec_t x, y;                                                                                     \
+        memcpy(&x, pa + i * sizeof(T), sizeof(x));                                                      \
+        memcpy(&y, pb + i * sizeof(T), sizeof(y));                                                      \
+        __typeof__(x == y) diff = x != y;                                                               \
+        if (zc_cmp_mask_any(&diff)) break;                                                              \
+    }                                                                                                   \
+    for (; i < count; i++)                                                                              \
+    {                                                                                                   \
+        T x, y;                                                                                         \
+        memcpy(&x, pa + i * sizeof(T), sizeof(x));                                                      \
+        memcpy(&y, pb + i * sizeof(T), sizeof(y));                                                      \
+        if (x != y) return i;                                                                           \
+    }                                                                                                   \
+    return count;                                                                                       \
+}                                                                                                       \
+                                                                                                        \
+ZC_CMP_ATTR static void ZC_CMP_FN(minmax, kind)(const void* data, uint64_t count,                     \
+    void* inout_min, void* inout_max)                                                                   \
+{                                                                                                       \
+    typedef T vec_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                 \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(T);                                            \
+    const uint8_t* p = data;                                                                            \
+    T mn, mx;                                                                                           \
+    memcpy(&mn, inout_min, sizeof(T));                                                                  \
+    memcpy(&mx, inout_max, sizeof(T));                                                                  \
+    uint64_t i = 0;                                                                                     \
+    if (count >= lanes)                                                                                 \
+    {                                                                                                   \
+        vec_t vmin, vmax;                                                                               \
+        for (i = 0; i < lanes; i++) { vmin[i] = mn; vmax[i] = mx; }                                     \
+        for (i = 0; i + lanes <= count; i += lanes)                                                     \
+        {                                                                                               \
+            vec_t x;                                                                                    \
+            memcpy(&x, p + i * sizeof(T), sizeof(x));                                                   \
+            /* NaN 不满足任何比较，不会替换当前极值 */                                                  \
+            __typeof__(x == x) lt = x < vmin;                                                           \
+            __typeof__(x == x) gt = x > vmax;                                                           \
+            vmin = (vec_t)((lt & (__typeof__(lt))x) | (~lt & (__typeof__(lt))vmin));                    \
+            vmax = (vec_t)((gt & (__typeof__(gt))x) | (~gt & (__typeof__(gt))vmax));                    \
+        }                                                                                               \
+        uint64_t l;                                                                                     \
+        for (l = 0; l < lanes; l++)                                                                     \
+        {                                                                                               \
+            if (vmin[l] < mn) mn = vmin[l];                                                             \
+            if (vmax[l] > mx) mx = vmax[l];                                                             \
+        }                                                                                               \
+    }                                                                                                   \
+    for (; i < count; i++)                                                                              \
+    {                                                                                                   \
+        T x;                                                                                            \
+        memcpy(&x, p + i * sizeof(T), sizeof(x));                                                       \
+        if (x < mn) mn = x;                                                                             \
+        if (x > mx) mx = x;                                                                             \
+    }                                                                                                   \
+    memcpy(inout_min, &mn, sizeof(T));                                                                  \
+    memcpy(inout_max, &mx, sizeof(T));                                                                  \
+}
+
+ZC_CMP_DEFINE_KERNELS(i8, int8_t)
+ZC_CMP_DEFINE_KERNELS(u8, uint8_t)
+ZC_CMP_DEFINE_KERNELS(i16, int16_t)
+ZC_CMP_DEFINE_KERNELS(u16, uint16_t)
+ZC_CMP_DEFINE_KERNELS(i32, int32_t)
+ZC_CMP_DEFINE_KERNELS(u32, uint32_t)
+ZC_CMP_DEFINE_KERNELS(i64, int64_t)
+ZC_CMP_DEFINE_KERNELS(u64, uint64_t)
+ZC_CMP_DEFINE_KERNELS(f32, float)
+ZC_CMP_DEFINE_KERNELS(f64, double)
+
+#undef ZC_CMP_DEFINE_KERNELS
+#undef ZC_CMP_SCAN_SCALAR
+#undef ZC_CMP_FN
+#undef ZC_CMP_PASTE
+#undef ZC_CMP_PASTE_
@@ -0,0 +1,543 @@
+#include "convert.h"
+#include <string.h>
+#include "simd.h"
+#include "type_descriptor.h"
+
+#if ZC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define ZC_CVT_INF_NAN           0x01   // 指数全 1 表示无穷大 / NaN（IEEE 754 约定）
+#define ZC_CVT_NAN_MAX_ONLY      0x02   // 只有幅值全 1 表示 NaN，没有无穷大（FP8 E4M3）
+#define ZC_CVT_NO_LEADING        0x04   // 没有隐含前导 1
+#define ZC_CVT_FLUSH_SUBNORMAL   0x08   // 编码时 float 非规格化输入按 0 处理
+
+/**
+ * 小浮点格式的位布局：符号位在指数之上，编码存放在容器中左移 container_shift 的位置
+ */
+typedef struct zc_convert_format {
+    uint8_t  exp_bits;
+    uint8_t  man_bits;
+    uint8_t  bias;
+    uint8_t  flags;
+    uint8_t  container_shift;
+    uint8_t  width;           // 容器字节数
+    uint32_t max_code;        // 最大有限值的编码，不含符号位
+    uint32_t overflow_code;   // 超出范围时的编码：有无穷大的格式为无穷大，否则为 max_code
+    uint32_t nan_code;        // NaN 的编码，不含载荷
+    float    scale;           // 2^(127 - bias)
+    float    sub_scale;       // 2^(bias - 1 + man_bits)，把非规格化区间缩放到整数尾数
+    float    max_value;       // 最大有限值，仅 ZC_CVT_NO_LEADING 使用
+} zc_convert_format_t;
+
+static const zc_convert_format_t zc_convert_half     = { 5,  10, 15,  ZC_CVT_INF_NAN,      0,  2, 0x7BFF,  0x7C00,  0x7E00,  0x1p112f, 0x1p24f, 0 };
+static const zc_convert_format_t zc_convert_bfloat16 = { 8,  7,  127, ZC_CVT_INF_NAN | ZC_CVT_FLUSH_SUBNORMAL,
+                                                                                           0,  2, 0x7F7F,  0x7F80,  0x7FC0,  0x1p0f,   0,       0 };
+static const zc_convert_format_t zc_convert_tf32     = { 8,  10, 127, ZC_CVT_INF_NAN,      13, 4, 0x3FBFF, 0x3FC00, 0x3FE00, 0x1p0f,   0,       0 };
+static const zc_convert_format_t zc_convert_fp8_e5m2 = { 5,  2,  15,  ZC_CVT_INF_NAN,      0,  1, 0x7B,    0x7C,    0x7E,    0x1p112f, 0x1p16f, 0 };
+static const zc_convert_format_t zc_convert_fp8_e4m3 = { 4,  3,  7,   ZC_CVT_NAN_MAX_ONLY, 0,  1, 0x7E,    0x7E,    0x7F,    0x1p120f, 0x1p9f,  0 };
+static const zc_convert_format_t zc_convert_fp6_e3m2 = { 3,  2,  3,   0,                   0,  1, 0x1F,    0x1F,    0,       0x1p124f, 0x1p4f,  0 };
+static const zc_convert_format_t zc_convert_fp6_e2m3 = { 2,  3,  1,   0,                   0,  1, 0x1F,    0x1F,    0,       0x1p126f, 0x1p3f,  0 };
+static const zc_convert_format_t zc_convert_fp6_e4m1 = { 4,  1,  7,   0,                   0,  1, 0x1F,    0x1F,    0,       0x1p120f, 0x1p7f,  0 };
+static const zc_convert_format_t zc_convert_fp6_e2m3_noleading =
+                                                       { 2,  3,  1,   ZC_CVT_NO_LEADING,   0,  1, 0x1F,    0x1F,    0,       0,        0,       3.5f };
+
+static const zc_convert_format_t* zc_convert_get_format(uint8_t r4_type_token)
+{
+    switch (r4_type_token)
+    {
+        case R4_TYPE_HALF:               return &zc_convert_half;
+        case R4_TYPE_BFLOAT16:           return &zc_convert_bfloat16;
+        case R4_TYPE_TF32:               return &zc_convert_tf32;
+        case R4_TYPE_FP8_E5M2:           return &zc_convert_fp8_e5m2;
+        case R4_TYPE_FP8_E4M3:           return &zc_convert_fp8_e4m3;
+        case R4_TYPE_FP6_E3M2:           return &zc_convert_fp6_e3m2;
+        case R4_TYPE_FP6_E2M3:           return &zc_convert_fp6_e2m3;
+        case R4_TYPE_FP6_E4M1:           return &zc_convert_fp6_e4m1;
+        case R4_TYPE_FP6_E2M3_NOLEADING: return &zc_convert_fp6_e2m3_noleading;
+        default:                         return NULL;
+    }
+}
+
+#define ZC_CVT_LANES (ZC_SIMD_VECTOR_BYTES / sizeof(uint32_t))
+
+typedef uint32_t zc_cvt_u32v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef int32_t  zc_cvt_i32v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef float    zc_cvt_f32v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+
+#define ZC_CVT_LANES64 (ZC_SIMD_VECTOR_BYTES / sizeof(uint64_t))
+
+typedef int64_t  zc_cvt_i64v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef double   zc_cvt_f64v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+
+#define ZC_CVT_BLEND(m, a, b) (((m) & (a)) | (~(m) & (b)))
+
+// 10^0 .. 10^FIXP_TYPE_SCALE_MAX，均能被 double 精确表示
+static const int64_t zc_convert_pow10[FIXP_TYPE_SCALE_MAX + 1] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+    10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+    1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL,
+};
+
+#define ZC_CVT_LEVEL baseline
+#define ZC_CVT_ATTR
+#include "convert_kernels.h"
+#undef ZC_CVT_ATTR
+#undef ZC_CVT_LEVEL
+
+#if ZC_SIMD_X86
+#define ZC_CVT_LEVEL sse42
+#define ZC_CVT_ATTR ZC_SIMD_TARGET_SSE42
+#include "convert_kernels.h"
+#undef ZC_CVT_ATTR
+#undef ZC_CVT_LEVEL
+
+#define ZC_CVT_LEVEL avx2
+#define ZC_CVT_ATTR ZC_SIMD_TARGET_AVX2
+#include "convert_kernels.h"
+#undef ZC_CVT_ATTR
+#undef ZC_CVT_LEVEL
+
+#define ZC_CVT_LEVEL avx512
+#define ZC_CVT_ATTR ZC_SIMD_TARGET_AVX512
+#include "convert_kernels.h"
+#undef ZC_CVT_ATTR
+#undef ZC_CVT_LEVEL
+
+/**
+ * HALF 由 F16C 直接转换，尾部交给同级别的通用内核
+ */
+ZC_SIMD_TARGET_AVX2 static void zc_cvt_decode_half_avx2(const zc_convert_format_t* fmt, const void* src,
+    float* dst, uint64_t count)
+{
+    const uint8_t* p = src;
+    uint64_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i h = _mm_loadu_si128((const __m128i*)(p + i * 2));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    if (i < count) zc_cvt_decode_16_avx2(fmt, p + i * 2, dst + i, count - i);
+}
+
+ZC_SIMD_TARGET_AVX2 static void zc_cvt_encode_half_avx2(const zc_convert_format_t* fmt, const float* src,
+    void* dst, uint64_t count)
+{
+    uint8_t* p = dst;
+    uint64_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(p + i * 2), h);
+    }
+    if (i < count) zc_cvt_encode_16_avx2(fmt, src + i, p + i * 2, count - i);
+}
+
+ZC_SIMD_TARGET_AVX512 static void zc_cvt_decode_half_avx512(const zc_convert_format_t* fmt, const void* src,
+    float* dst, uint64_t count)
+{
+    const uint8_t* p = src;
+    uint64_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i h = _mm256_loadu_si256((const __m256i*)(p + i * 2));
+        _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(h));
+    }
+    if (i < count) zc_cvt_decode_16_avx512(fmt, p + i * 2, dst + i, count - i);
+}
+
+ZC_SIMD_TARGET_AVX512 static void zc_cvt_encode_half_avx512(const zc_convert_format_t* fmt, const float* src,
+    void* dst, uint64_t count)
+{
+    uint8_t* p = dst;
+    uint64_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256((__m256i*)(p + i * 2), h);
+    }
+    if (i < count) zc_cvt_encode_16_avx512(fmt, src + i, p + i * 2, count - i);
+}
+
+/**
+ * BFLOAT16 编码由 AVX-512 BF16 完成；解码只是左移 16 位，通用内核已足够快
+ */
+ZC_SIMD_TARGET_AVX512_BF16 static void zc_cvt_encode_bf16_avx512(const zc_convert_format_t* fmt, const float* src,
+    void* dst, uint64_t count)
+{
+    uint8_t* p = dst;
+    uint64_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        memcpy(p + i * 2, &h, sizeof(h));
+    }
+    if (i < count) zc_cvt_encode_16_avx512(fmt, src + i, p + i * 2, count - i);
+}
+#endif
+
+typedef void (*zc_convert_decode_fn)(const zc_convert_format_t* fmt, const void* src, float* dst, uint64_t count);
+typedef void (*zc_convert_encode_fn)(const zc_convert_format_t* fmt, const float* src, void* dst, uint64_t count);
+
+typedef struct zc_convert_kernels {
+    zc_convert_decode_fn decode[3];   // 按容器宽度 1 / 2 / 4 字节
+    zc_convert_encode_fn encode[3];
+    zc_convert_decode_fn decode_half;
+    zc_convert_encode_fn encode_half;
+} zc_convert_kernels_t;
+
+#define ZC_CVT_ROW(level, half_level) {                                                                  \
+    { zc_cvt_decode_8_##level, zc_cvt_decode_16_##level, zc_cvt_decode_32_##level },                    \
+    { zc_cvt_encode_8_##level, zc_cvt_encode_16_##level, zc_cvt_encode_32_##level },                    \
+    zc_cvt_decode_##half_level, zc_cvt_encode_##half_level }
+
+// 按 zc_simd_level_t 索引
+static const zc_convert_kernels_t zc_convert_kernel_table[ZC_SIMD_LEVEL_COUNT] = {
+    ZC_CVT_ROW(baseline, 16_baseline),
+#if ZC_SIMD_X86
+    ZC_CVT_ROW(sse42, 16_sse42),
+    ZC_CVT_ROW(avx2, half_avx2),
+    ZC_CVT_ROW(avx512, half_avx512),
+#else
+    ZC_CVT_ROW(baseline, 16_baseline),
+    ZC_CVT_ROW(baseline, 16_baseline),
+    ZC_CVT_ROW(baseline, 16_baseline),
+#endif
+};
+
+#undef ZC_CVT_ROW
+
+typedef struct zc_convert_fixp_kernels {
+    void (*to_f64[8])(const void* src, double* dst, uint64_t count, int32_t scale);      // 按存储整型（zc_numeric_kind_t）
+    void (*from_f64[8])(const double* src, void* dst, uint64_t count, int32_t scale);
+    void (*to_i64[8])(const void* src, int64_t* dst, uint64_t count, int32_t shift);
+    void (*from_i64[8])(const int64_t* src, void* dst, uint64_t count, int32_t shift);
+} zc_convert_fixp_kernels_t;
+
+#define ZC_CVT_FIXP_ENTRY(name, level) {                                                                 \
+    zc_cvt_##name##_i8_##level,  zc_cvt_##name##_u8_##level,  zc_cvt_##name##_i16_##level,              \
+    zc_cvt_##name##_u16_##level, zc_cvt_##name##_i32_##level, zc_cvt_##name##_u32_##level,              \
+    zc_cvt_##name##_i64_##level, zc_cvt_##name##_u64_##level }
+
+#define ZC_CVT_FIXP_ROW(level) {                                                                         \
+    ZC_CVT_FIXP_ENTRY(fixp_to_f64, level), ZC_CVT_FIXP_ENTRY(fixp_from_f64, level),                     \
+    ZC_CVT_FIXP_ENTRY(fixp_to_i64, level), ZC_CVT_FIXP_ENTRY(fixp_from_i64, level) }
+
+// 按 zc_simd_level_t 索引
+static const zc_convert_fixp_kernels_t zc_convert_fixp_table[ZC_SIMD_LEVEL_COUNT] = {
+    ZC_CVT_FIXP_ROW(baseline),
+#if ZC_SIMD_X86
+    ZC_CVT_FIXP_ROW(sse42),
+    ZC_CVT_FIXP_ROW(avx2),
+    ZC_CVT_FIXP_ROW(avx512),
+#else
+    ZC_CVT_FIXP_ROW(baseline),
+    ZC_CVT_FIXP_ROW(baseline),
+    ZC_CVT_FIXP_ROW(baseline),
+#endif
+};
+
+#undef ZC_CVT_FIXP_ROW
+#undef ZC_CVT_FIXP_ENTRY
+
+static inline uint32_t zc_convert_width_index(uint32_t width)
+{
+    return width == 1 ? 0 : width == 2 ? 1 : 2;
+}
+
+static zc_convert_decode_fn zc_convert_decoder(const zc_convert_format_t* fmt)
+{
+    const zc_convert_kernels_t* kernels = &zc_convert_kernel_table[zc_simd_level()];
+    if (fmt == &zc_convert_half) return kernels->decode_half;
+    return kernels->decode[zc_convert_width_index(fmt->width)];
+}
+
+static zc_convert_encode_fn zc_convert_encoder(const zc_convert_format_t* fmt)
+{
+    const zc_convert_kernels_t* kernels = &zc_convert_kernel_table[zc_simd_level()];
+    if (fmt == &zc_convert_half) return kernels->encode_half;
+#if ZC_SIMD_X86
+    if (fmt == &zc_convert_bfloat16 && zc_simd_has_bf16()) return zc_cvt_encode_bf16_avx512;
+#endif
+    return kernels->encode[zc_convert_width_index(fmt->width)];
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_r4_to_f32(uint8_t r4_type_token, const void* src, float* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    if (r4_type_token == R4_TYPE_FLOAT)
+    {
+        if (count != 0) memcpy(dst, src, count * sizeof(float));
+        return ZC_INTERNAL_OK;
+    }
+
+    const zc_convert_format_t* fmt = zc_convert_get_format(r4_type_token);
+    if (unlikely(!fmt)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    zc_convert_decoder(fmt)(fmt, src, dst, count);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_f32_to_r4(uint8_t r4_type_token, const float* src, void* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    if (r4_type_token == R4_TYPE_FLOAT)
+    {
+        if (count != 0) memcpy(dst, src, count * sizeof(float));
+        return ZC_INTERNAL_OK;
+    }
+
+    const zc_convert_format_t* fmt = zc_convert_get_format(r4_type_token);
+    if (unlikely(!fmt)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    zc_convert_encoder(fmt)(fmt, src, dst, count);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 校验 FixpTypeToken 并给出存储整型在内核表中的下标
+ */
+static inline bool zc_convert_fixp_kind(uint8_t fixp_type_token, uint32_t* out_kind)
+{
+    if (unlikely(zc_fixp_scale(fixp_type_token) > FIXP_TYPE_SCALE_MAX)) return false;
+    *out_kind = ((fixp_type_token & FIXP_TYPE_WIDTH_MASK) >> 5) * 2 + (zc_fixp_is_signed(fixp_type_token) ? 0 : 1);
+    return true;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_fixp_to_f64(uint8_t fixp_type_token, const void* src, double* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint32_t kind;
+    if (unlikely(!zc_convert_fixp_kind(fixp_type_token, &kind))) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    zc_convert_fixp_table[zc_simd_level()].to_f64[kind](src, dst, count, zc_fixp_scale(fixp_type_token));
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_f64_to_fixp(uint8_t fixp_type_token, const double* src, void* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint32_t kind;
+    if (unlikely(!zc_convert_fixp_kind(fixp_type_token, &kind))) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    zc_convert_fixp_table[zc_simd_level()].from_f64[kind](src, dst, count, zc_fixp_scale(fixp_type_token));
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_fixp_to_i64(uint8_t fixp_type_token, const void* src, uint32_t scale,
+    int64_t* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(scale > FIXP_TYPE_SCALE_MAX)) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint32_t kind;
+    if (unlikely(!zc_convert_fixp_kind(fixp_type_token, &kind))) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    int32_t shift = (int32_t)scale - (int32_t)zc_fixp_scale(fixp_type_token);
+    zc_convert_fixp_table[zc_simd_level()].to_i64[kind](src, dst, count, shift);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_i64_to_fixp(uint8_t fixp_type_token, const int64_t* src, uint32_t scale,
+    void* dst, uint64_t count)
+{
+    if (unlikely(count != 0 && (!src || !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(scale > FIXP_TYPE_SCALE_MAX)) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint32_t kind;
+    if (unlikely(!zc_convert_fixp_kind(fixp_type_token, &kind))) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    int32_t shift = (int32_t)zc_fixp_scale(fixp_type_token) - (int32_t)scale;
+    zc_convert_fixp_table[zc_simd_level()].from_i64[kind](src, dst, count, shift);
+    return ZC_INTERNAL_OK;
+}
+
+typedef struct zc_convert_ctx {
+    uint8_t      token;
+    uint32_t     scale;       // 定点与 int64 互转时 int64 一侧的小数位数
+    void*        load_dst;
+    const void*  store_src;
+} zc_convert_ctx_t;
+
+static bool zc_convert_chunk_load(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_r4_to_f32(c->token, data, (float*)c->load_dst + first_index, count);
+    return true;
+}
+
+static bool zc_convert_chunk_store(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_f32_to_r4(c->token, (const float*)c->store_src + first_index, data, count);
+    return true;
+}
+
+static bool zc_convert_chunk_load_f64(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_fixp_to_f64(c->token, data, (double*)c->load_dst + first_index, count);
+    return true;
+}
+
+static bool zc_convert_chunk_store_f64(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_f64_to_fixp(c->token, (const double*)c->store_src + first_index, data, count);
+    return true;
+}
+
+static bool zc_convert_chunk_load_i64(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_fixp_to_i64(c->token, data, c->scale, (int64_t*)c->load_dst + first_index, count);
+    return true;
+}
+
+static bool zc_convert_chunk_store_i64(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_convert_ctx_t* c = ctx;
+    zc_convert_i64_to_fixp(c->token, (const int64_t*)c->store_src + first_index, c->scale, data, count);
+    return true;
+}
+
+/**
+ * 把解析出的 span 收窄到 [first_index, first_index + count)
+ */
+static zc_internal_result_t zc_convert_narrow(zc_numeric_span_t* out_span, uint64_t first_index, uint64_t count)
+{
+    if (unlikely(first_index > out_span->element_count || count > out_span->element_count - first_index))
+    {
+        return ZC_INTERNAL_PARAM_ERROR;
+    }
+
+    out_span->data_offset += first_index * out_span->element_size;
+    out_span->element_count = count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_load_f32(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, float* out)
+{
+    if (unlikely(!out)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .load_dst = out };
+    zc_internal_result_t res = zc_numeric_resolve_r4(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, false, zc_convert_chunk_load, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_store_f32(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, const float* in)
+{
+    if (unlikely(!in)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .store_src = in };
+    zc_internal_result_t res = zc_numeric_resolve_r4(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, true, zc_convert_chunk_store, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_load_f64(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, double* out)
+{
+    if (unlikely(!out)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .load_dst = out };
+    zc_internal_result_t res = zc_numeric_resolve_fixp(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, false, zc_convert_chunk_load_f64, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_store_f64(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, const double* in)
+{
+    if (unlikely(!in)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .store_src = in };
+    zc_internal_result_t res = zc_numeric_resolve_fixp(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, true, zc_convert_chunk_store_f64, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_load_i64(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, uint32_t scale, int64_t* out)
+{
+    if (unlikely(!out)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(scale > FIXP_TYPE_SCALE_MAX)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .scale = scale, .load_dst = out };
+    zc_internal_result_t res = zc_numeric_resolve_fixp(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, false, zc_convert_chunk_load_i64, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_convert_store_i64(zc_block_header_t* block, uint64_t offset,
+    uint64_t first_index, uint64_t count, uint32_t scale, const int64_t* in)
+{
+    if (unlikely(!in)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(scale > FIXP_TYPE_SCALE_MAX)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_numeric_span_t span;
+    zc_convert_ctx_t ctx = { .scale = scale, .store_src = in };
+    zc_internal_result_t res = zc_numeric_resolve_fixp(block, offset, &span, &ctx.token);
+    if (res == ZC_INTERNAL_OK) res = zc_convert_narrow(&span, first_index, count);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_walk(block, &span, true, zc_convert_chunk_store_i64, &ctx);
+}
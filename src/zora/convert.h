@@ -0,0 +1,255 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+#include "numeric.h"
+
+#ifndef CONVERT_H
+#define CONVERT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 把 count 个以 R4 token 编码的元素转换为 float。
+ *
+ * 所有格式都能精确表示为 float，转换无舍入。HALF / FP8 E5M2 / BFLOAT16 / TF32 的无穷大与 NaN 保持语义，
+ * FP8 E4M3 只有 S.1111.111 为 NaN，FP6 没有特殊值。FP6 只使用每字节的低 6 bit。
+ * FP6_E2M3_NOLEADING 的值为 (-1)^s * m * 2^(e - 4)，没有隐含前导 1。
+ *
+ * @param r4_type_token [in] R4TypeToken。
+ * @param src           [in] 按 zc_type_get_r4_obj_size 给出的宽度紧密排列的元素，不要求对齐。
+ * @param dst           [out] count 个 float。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的 token。
+ */
+zc_internal_result_t zc_convert_r4_to_f32(
+    uint8_t r4_type_token,
+    const void* src,
+    float* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 把 count 个 float 按 R4 token 编码，就近舍入到偶数。
+ *
+ * 超出范围时，有无穷大的格式得到无穷大，FP8 E4M3 与 FP6 饱和到同号的最大有限值（无穷大也饱和）。
+ * NaN 在有 NaN 的格式中保持为静默 NaN 并保留高位载荷，在 FP6 中写为同号的 0。
+ * BFLOAT16 与 AVX-512 BF16 指令一致，非规格化输入按 0 处理；HALF 与 F16C 指令逐位一致。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的 token。
+ */
+zc_internal_result_t zc_convert_f32_to_r4(
+    uint8_t r4_type_token,
+    const float* src,
+    void* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 读取 R4 变量中 [first_index, first_index + count) 的元素并加宽为 float。
+ *
+ * 变量可以是任何 R4 token 的标量、数组或 FLOATTENSOR，页内的整段元素直接从块内地址批量转换。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数。
+ * - 其他: 由 zc_numeric_resolve_r4 透传的错误。
+ */
+zc_internal_result_t zc_convert_load_f32(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    float* out
+);
+
+/**
+ * @brief 把 count 个 float 按变量的 R4 token 编码后写入 [first_index, first_index + count)。
+ *
+ * 舍入与溢出规则同 zc_convert_f32_to_r4。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: in 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数。
+ * - 其他: 由 zc_numeric_resolve_r4 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_convert_store_f32(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    const float* in
+);
+
+/**
+ * @brief 把 count 个以 FixpTypeToken 编码的十进制定点元素转换为 double，值为 raw / 10^scale。
+ *
+ * 结果为精确商就近舍入到偶数，|raw| 不超过 2^53 时 scale 为 0 的转换无误差。
+ *
+ * @param fixp_type_token [in] FixpTypeToken。
+ * @param src             [in] 按 zc_fixp_width 给出的宽度紧密排列的小端整数，不要求对齐。
+ * @param dst             [out] count 个 double。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 小数位数超过 FIXP_TYPE_SCALE_MAX。
+ */
+zc_internal_result_t zc_convert_fixp_to_f64(
+    uint8_t fixp_type_token,
+    const void* src,
+    double* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 把 count 个 double 乘以 10^scale 后舍入为定点元素，0.5 远离 0。
+ *
+ * 超出存储整型范围的值（含无穷大）饱和到同号的极值，NaN 写为 0。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 小数位数超过 FIXP_TYPE_SCALE_MAX。
+ */
+zc_internal_result_t zc_convert_f64_to_fixp(
+    uint8_t fixp_type_token,
+    const double* src,
+    void* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 把定点元素换算为指定小数位数的 int64，不经过浮点。
+ *
+ * scale 大于元素的小数位数时乘以 10 的幂，溢出饱和到 INT64_MIN / INT64_MAX；
+ * 小于时除以 10 的幂，就近舍入，0.5 远离 0。
+ *
+ * @param scale [in] 结果的小数位数，不超过 FIXP_TYPE_SCALE_MAX。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: scale 超过 FIXP_TYPE_SCALE_MAX。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: token 的小数位数超过 FIXP_TYPE_SCALE_MAX。
+ */
+zc_internal_result_t zc_convert_fixp_to_i64(
+    uint8_t fixp_type_token,
+    const void* src,
+    uint32_t scale,
+    int64_t* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 把小数位数为 scale 的 int64 换算为定点元素，舍入同 zc_convert_fixp_to_i64，结果饱和到存储整型的范围。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src / dst 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: scale 超过 FIXP_TYPE_SCALE_MAX。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: token 的小数位数超过 FIXP_TYPE_SCALE_MAX。
+ */
+zc_internal_result_t zc_convert_i64_to_fixp(
+    uint8_t fixp_type_token,
+    const int64_t* src,
+    uint32_t scale,
+    void* dst,
+    uint64_t count
+);
+
+/**
+ * @brief 读取 FIXEDPOINT 变量中 [first_index, first_index + count) 的元素并转换为 double。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数。
+ * - 其他: 由 zc_numeric_resolve_fixp 透传的错误。
+ */
+zc_internal_result_t zc_convert_load_f64(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    double* out
+);
+
+/**
+ * @brief 把 count 个 double 按变量的 FixpTypeToken 舍入后写入 [first_index, first_index + count)。
+ *
+ * 舍入与饱和规则同 zc_convert_f64_to_fixp。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: in 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数。
+ * - 其他: 由 zc_numeric_resolve_fixp 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_convert_store_f64(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    const double* in
+);
+
+/**
+ * @brief 读取 FIXEDPOINT 变量的元素并换算为小数位数为 scale 的 int64，规则同 zc_convert_fixp_to_i64。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数，或 scale 超过 FIXP_TYPE_SCALE_MAX。
+ * - 其他: 由 zc_numeric_resolve_fixp 透传的错误。
+ */
+zc_internal_result_t zc_convert_load_i64(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    uint32_t scale,
+    int64_t* out
+);
+
+/**
+ * @brief 把小数位数为 scale 的 int64 换算后写入 FIXEDPOINT 变量，规则同 zc_convert_i64_to_fixp。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: in 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 区间超出变量的元素数，或 scale 超过 FIXP_TYPE_SCALE_MAX。
+ * - 其他: 由 zc_numeric_resolve_fixp 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_convert_store_i64(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint64_t first_index,
+    uint64_t count,
+    uint32_t scale,
+    const int64_t* in
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONVERT_H */
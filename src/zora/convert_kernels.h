@@ -0,0 +1,321 @@
+/*
+*/
+/**
+ * 浮点格式转换内核模板，由 convert.c 在每个指令集级别下各包含一次，不设包含保护。
+ *
+ * 包含前需定义：
+ * - ZC_CVT_LEVEL: 函数名后缀，如 avx2
+ * - ZC_CVT_ATTR:  该级别的 target 属性，基线级别为空
+ *
+ * 每次处理 ZC_CVT_LANES 个元素：编码值零扩展到 32 位通道，按 zc_convert_format_t 描述的位布局
+ * 与 float 互转，全程无分支。不足一组的尾部补零后走同一条路径。
+ */
+
+#define ZC_CVT_PASTE_(a, b, c) zc_cvt_##a##_##b##_##c
+#define ZC_CVT_PASTE(a, b, c) ZC_CVT_PASTE_(a, b, c)
+#define ZC_CVT_FN(name, width) ZC_CVT_PASTE(name, width, ZC_CVT_LEVEL)
+
+/**
+ * 编码 c（已右移 container_shift）→ float 位模式 out
+ */
+#define ZC_CVT_DECODE(fmt, c, out) do {                                                                 \
+    const uint32_t man_bits = (fmt)->man_bits;                                                          \
+    const uint32_t sign_shift = (uint32_t)(fmt)->exp_bits + man_bits;                                   \
+    const uint32_t man_mask = (1U << man_bits) - 1;                                                     \
+    zc_cvt_u32v_t sign = ((c) >> sign_shift & 1) << 31;                                                 \
+    zc_cvt_u32v_t mag = (c) & ((1U << sign_shift) - 1);                                                 \
+    zc_cvt_u32v_t bits;                                                                                 \
+    if ((fmt)->flags & ZC_CVT_NO_LEADING)                                                               \
+    {                                                                                                   \
+        /* 2^(e - bias - M) 直接拼成 float 的指数域 */                                                   \
+        zc_cvt_u32v_t scale = ((mag >> man_bits) + (127U - (fmt)->bias - man_bits)) << 23;              \
+        zc_cvt_f32v_t f = __builtin_convertvector((zc_cvt_i32v_t)(mag & man_mask), zc_cvt_f32v_t)       \
+            * (zc_cvt_f32v_t)scale;                                                                     \
+        bits = (zc_cvt_u32v_t)f;                                                                        \
+    }                                                                                                   \
+    else                                                                                                \
+    {                                                                                                   \
+        /* 指数与尾数整体移到 float 的位置再乘 2^(127 - bias)，非规格化数也因此得到正确的值 */             \
+        zc_cvt_f32v_t f = (zc_cvt_f32v_t)(mag << (23 - man_bits)) * (fmt)->scale;                       \
+        bits = (zc_cvt_u32v_t)f;                                                                        \
+    }                                                                                                   \
+    if ((fmt)->flags & ZC_CVT_INF_NAN)                                                                  \
+    {                                                                                                   \
+        zc_cvt_u32v_t man = mag & man_mask;                                                             \
+        zc_cvt_u32v_t top = (zc_cvt_u32v_t)((mag >> man_bits) == ((1U << (fmt)->exp_bits) - 1));        \
+        zc_cvt_u32v_t quiet = (zc_cvt_u32v_t)(man != 0) & 0x00400000U;                                  \
+        zc_cvt_u32v_t special = (man << (23 - man_bits)) | quiet | 0x7F800000U;                         \
+        bits = ZC_CVT_BLEND(top, special, bits);                                                        \
+    }                                                                                                   \
+    if ((fmt)->flags & ZC_CVT_NAN_MAX_ONLY)                                                             \
+    {                                                                                                   \
+        zc_cvt_u32v_t nan = (zc_cvt_u32v_t)(mag == ((1U << sign_shift) - 1));                           \
+        bits = ZC_CVT_BLEND(nan, 0x7FC00000U, bits);                                                    \
+    }                                                                                                   \
+    (out) = bits | sign;                                                                                \
+} while (0)
+
+/**
+ * float 位模式 b → 编码 out（尚未左移 container_shift）
+ */
+#define ZC_CVT_ENCODE(fmt, b, out) do {                                                                 \
+    const uint32_t man_bits = (fmt)->man_bits;                                                          \
+    const uint32_t sign_shift = (uint32_t)(fmt)->exp_bits + man_bits;                                   \
+    const uint32_t man_mask = (1U << man_bits) - 1;                                                     \
+    const uint32_t shift = 23 - man_bits;                                                               \
+    zc_cvt_u32v_t sign = ((b) >> 31) << sign_shift;                                                     \
+    zc_cvt_u32v_t abs = (b) & 0x7FFFFFFFU;                                                              \
+    zc_cvt_u32v_t nan = (zc_cvt_u32v_t)(abs > 0x7F800000U);                                             \
+    zc_cvt_u32v_t code;                                                                                 \
+    if ((fmt)->flags & ZC_CVT_NO_LEADING)                                                               \
+    {                                                                                                   \
+        /* 先饱和，再从最小指数起找第一个能容纳尾数的指数，精度最高 */                                    \
+        zc_cvt_f32v_t a = (zc_cvt_f32v_t)abs;                                                           \
+        zc_cvt_u32v_t over = (zc_cvt_u32v_t)(a > (fmt)->max_value);                                     \
+        a = (zc_cvt_f32v_t)ZC_CVT_BLEND(over, (zc_cvt_u32v_t)((zc_cvt_f32v_t){ 0 } + (fmt)->max_value), \
+            (zc_cvt_u32v_t)a);                                                                          \
+        code = (zc_cvt_u32v_t){ 0 } + (fmt)->max_code;                                                  \
+        int e;                                                                                          \
+        for (e = (1 << (fmt)->exp_bits) - 1; e >= 0; e--)                                               \
+        {                                                                                               \
+            uint32_t scale_bits = (uint32_t)(127 + man_bits + (fmt)->bias - (uint32_t)e) << 23;         \
+            float scale;                                                                                \
+            memcpy(&scale, &scale_bits, sizeof(scale));                                                 \
+            zc_cvt_u32v_t q = (zc_cvt_u32v_t)(a * scale + 0x1p23f) - 0x4B000000U;                       \
+            zc_cvt_u32v_t fits = (zc_cvt_u32v_t)(q <= man_mask);                                        \
+            code = ZC_CVT_BLEND(fits, q | ((uint32_t)e << man_bits), code);                             \
+        }                                                                                               \
+    }                                                                                                   \
+    else                                                                                                \
+    {                                                                                                   \
+        /* 整数加法完成就近舍入到偶数，进位自然进入指数域 */                                               \
+        zc_cvt_u32v_t r = (abs + ((1U << (shift - 1)) - 1) + ((abs >> shift) & 1)) >> shift;            \
+        r -= (127U - (fmt)->bias) << man_bits;                                                          \
+        if ((fmt)->exp_bits < 8)                                                                        \
+        {                                                                                               \
+            /* 目标的非规格化区间：缩放到整数尾数后借 2^23 完成舍入 */                                     \
+            zc_cvt_u32v_t sub = (zc_cvt_u32v_t)((zc_cvt_f32v_t)abs * (fmt)->sub_scale + 0x1p23f)         \
+                - 0x4B000000U;                                                                          \
+            zc_cvt_u32v_t is_sub = (zc_cvt_u32v_t)(abs < ((128U - (fmt)->bias) << 23));                 \
+            r = ZC_CVT_BLEND(is_sub, sub, r);                                                           \
+        }                                                                                               \
+        if ((fmt)->flags & ZC_CVT_FLUSH_SUBNORMAL)                                                      \
+        {                                                                                               \
+            r &= ~(zc_cvt_u32v_t)(abs < 0x00800000U);                                                   \
+        }                                                                                               \
+        code = ZC_CVT_BLEND((zc_cvt_u32v_t)(r > (fmt)->max_code), (fmt)->overflow_code, r);             \
+    }                                                                                                   \
+    zc_cvt_u32v_t nan_code = (fmt)->flags & ZC_CVT_INF_NAN                                              \
+        ? ((abs >> shift) & man_mask) | (fmt)->nan_code                                                 \
+        : (zc_cvt_u32v_t){ 0 } + (fmt)->nan_code;                                                       \
+    (out) = ZC_CVT_BLEND(nan, nan_code, code) | sign;                                                   \
+} while (0)
+
+/**
+ * width: 容器位宽后缀
+ * CT:    容器类型
+ */
+#define ZC_CVT_DEFINE_KERNELS(width, CT)                                                                \
+ZC_CVT_ATTR static void ZC_CVT_FN(decode, width)(const zc_convert_format_t* fmt, const void* src,      \
+    float* dst, uint64_t count)                                                                         \
+{                                                                                                       \
+    typedef CT src_t __attribute__((vector_size(ZC_CVT_LANES * sizeof(CT))));                           \
+    const uint8_t* p = src;                                                                             \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES)                                                           \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES ? count - i : ZC_CVT_LANES;                               \
+        src_t x = { 0 };                                                                                \
+        if (likely(n == ZC_CVT_LANES)) memcpy(&x, p + i * sizeof(CT), sizeof(x));                       \
+        else memcpy(&x, p + i * sizeof(CT), n * sizeof(CT));                                            \
+        zc_cvt_u32v_t c = __builtin_convertvector(x, zc_cvt_u32v_t) >> (fmt)->container_shift;          \
+        zc_cvt_u32v_t y;                                                                                \
+        ZC_CVT_DECODE(fmt, c, y);                                                                       \
+        if (likely(n == ZC_CVT_LANES)) memcpy(dst + i, &y, sizeof(y));                                  \
+        else memcpy(dst + i, &y, n * sizeof(float));                                                    \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_CVT_ATTR static void ZC_CVT_FN(encode, width)(const zc_convert_format_t* fmt, const float* src,     \
+    void* dst, uint64_t count)                                                                          \
+{                                                                                                       \
+    typedef CT dst_t __attribute__((vector_size(ZC_CVT_LANES * sizeof(CT))));                           \
+    uint8_t* p = dst;                                                                                   \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES)                                                           \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES ? count - i : ZC_CVT_LANES;                               \
+        zc_cvt_u32v_t b = { 0 };                                                                        \
+        if (likely(n == ZC_CVT_LANES)) memcpy(&b, src + i, sizeof(b));                                  \
+        else memcpy(&b, src + i, n * sizeof(float));                                                    \
+        zc_cvt_u32v_t packed;                                                                           \
+        ZC_CVT_ENCODE(fmt, b, packed);                                                                  \
+        dst_t y = __builtin_convertvector(packed << (fmt)->container_shift, dst_t);                     \
+        if (likely(n == ZC_CVT_LANES)) memcpy(p + i * sizeof(CT), &y, sizeof(y));                       \
+        else memcpy(p + i * sizeof(CT), &y, n * sizeof(CT));                                            \
+    }                                                                                                   \
+}
+
+ZC_CVT_DEFINE_KERNELS(8,  uint8_t)
+ZC_CVT_DEFINE_KERNELS(16, uint16_t)
+ZC_CVT_DEFINE_KERNELS(32, uint32_t)
+
+/**
+ * int64 向量 v 乘以 10^shift（shift 可为负），结果饱和到 int64；缩小时就近舍入，0.5 远离 0
+ */
+#define ZC_CVT_RESCALE(v, shift) do {                                                                   \
+    if ((shift) > 0)                                                                                    \
+    {                                                                                                   \
+        const int64_t mul = zc_convert_pow10[(shift)];                                                  \
+        const int64_t limit = INT64_MAX / mul;                                                          \
+        zc_cvt_i64v_t hi = (zc_cvt_i64v_t)((v) > limit);                                                \
+        zc_cvt_i64v_t lo = (zc_cvt_i64v_t)((v) < -limit);                                               \
+        (v) = ZC_CVT_BLEND(hi | lo, 0, (v)) * mul;                                                      \
+        (v) = ZC_CVT_BLEND(hi, INT64_MAX, ZC_CVT_BLEND(lo, INT64_MIN, (v)));                            \
+    }                                                                                                   \
+    else if ((shift) < 0)                                                                               \
+    {                                                                                                   \
+        const int64_t d = zc_convert_pow10[-(shift)];                                                   \
+        zc_cvt_i64v_t q = (v) / d;                                                                      \
+        zc_cvt_i64v_t r = (v) - q * d;                                                                  \
+        zc_cvt_i64v_t up = (zc_cvt_i64v_t)(r >= (d + 1) / 2);                                           \
+        zc_cvt_i64v_t down = (zc_cvt_i64v_t)(r <= -(d + 1) / 2);                                        \
+        (v) = q - up + down;                                                                            \
+    }                                                                                                   \
+} while (0)
+
+/**
+ * 十进制定点内核，每次处理 8 个元素
+ *
+ * kind:     存储整型后缀
+ * T:        存储整型
+ * W:        与 double 互转时的 64 位中间类型，与 T 同符号
+ * LO, HI:   T 的取值范围
+ * FLO, FHI: T 的取值范围（double 表示，FHI 不含）
+ */
+#define ZC_CVT_DEFINE_FIXP_KERNELS(kind, T, W, LO, HI, FLO, FHI)                                        \
+ZC_CVT_ATTR static void ZC_CVT_FN(fixp_to_f64, kind)(const void* src, double* dst, uint64_t count,     \
+    int32_t scale)                                                                                      \
+{                                                                                                       \
+    typedef T src_t __attribute__((vector_size(ZC_CVT_LANES64 * sizeof(T))));                           \
+    const double divisor = (double)zc_convert_pow10[scale];                                             \
+    const uint8_t* p = src;                                                                             \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES64)                                                         \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES64 ? count - i : ZC_CVT_LANES64;                           \
+        src_t x = { 0 };                                                                                \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(&x, p + i * sizeof(T), sizeof(x));                      \
+        else memcpy(&x, p + i * sizeof(T), n * sizeof(T));                                              \
+        zc_cvt_f64v_t y = __builtin_convertvector(x, zc_cvt_f64v_t) / divisor;                          \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(dst + i, &y, sizeof(y));                                \
+        else memcpy(dst + i, &y, n * sizeof(double));                                                   \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_CVT_ATTR static void ZC_CVT_FN(fixp_from_f64, kind)(const double* src, void* dst, uint64_t count,   \
+    int32_t scale)                                                                                      \
+{                                                                                                       \
+    typedef T dst_t __attribute__((vector_size(ZC_CVT_LANES64 * sizeof(T))));                           \
+    typedef W wide_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                \
+    const double multiplier = (double)zc_convert_pow10[scale];                                          \
+    uint8_t* p = dst;                                                                                   \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES64)                                                         \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES64 ? count - i : ZC_CVT_LANES64;                           \
+        zc_cvt_f64v_t x = { 0 };                                                                        \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(&x, src + i, sizeof(x));                                \
+        else memcpy(&x, src + i, n * sizeof(double));                                                   \
+        zc_cvt_f64v_t y = x * multiplier;                                                               \
+        /* 先把越界与 NaN 通道置 0 再截断，保证浮点到整型的转换有定义 */                                     \
+        zc_cvt_i64v_t hi = (zc_cvt_i64v_t)(y >= (FHI) - 0.5);                                           \
+        zc_cvt_i64v_t lo = (zc_cvt_i64v_t)(y <= (FLO) - 0.5);                                           \
+        zc_cvt_i64v_t bad = hi | lo | (zc_cvt_i64v_t)(y != y);                                          \
+        y = (zc_cvt_f64v_t)ZC_CVT_BLEND(bad, 0, (zc_cvt_i64v_t)y);                                      \
+        wide_t t = __builtin_convertvector(y, wide_t);                                                  \
+        zc_cvt_f64v_t frac = y - __builtin_convertvector(t, zc_cvt_f64v_t);                             \
+        t += (wide_t)((zc_cvt_i64v_t)(frac >= 0.5) & 1);                                                \
+        t -= (wide_t)((zc_cvt_i64v_t)(frac <= -0.5) & 1);                                               \
+        t = (wide_t)ZC_CVT_BLEND(hi, (zc_cvt_i64v_t)((wide_t){ 0 } + (W)(HI)), (zc_cvt_i64v_t)t);      \
+        t = (wide_t)ZC_CVT_BLEND(lo, (zc_cvt_i64v_t){ 0 } + (int64_t)(LO), (zc_cvt_i64v_t)t);           \
+        dst_t z = __builtin_convertvector(t, dst_t);                                                    \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(p + i * sizeof(T), &z, sizeof(z));                      \
+        else memcpy(p + i * sizeof(T), &z, n * sizeof(T));                                              \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_CVT_ATTR static void ZC_CVT_FN(fixp_to_i64, kind)(const void* src, int64_t* dst, uint64_t count,    \
+    int32_t shift)                                                                                      \
+{                                                                                                       \
+    typedef T src_t __attribute__((vector_size(ZC_CVT_LANES64 * sizeof(T))));                           \
+    typedef W wide_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                \
+    const uint8_t* p = src;                                                                             \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES64)                                                         \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES64 ? count - i : ZC_CVT_LANES64;                           \
+        src_t x = { 0 };                                                                                \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(&x, p + i * sizeof(T), sizeof(x));                      \
+        else memcpy(&x, p + i * sizeof(T), n * sizeof(T));                                              \
+        wide_t w = __builtin_convertvector(x, wide_t);                                                  \
+        zc_cvt_i64v_t v = (zc_cvt_i64v_t)w;                                                             \
+        if ((W)-1 > 0 && shift < 0)                                                                     \
+        {                                                                                               \
+            /* 无符号缩小在 uint64 中完成，商必然落在 int64 内 */                                            \
+            const W d = (W)zc_convert_pow10[-shift];                                                    \
+            wide_t q = w / d;                                                                           \
+            v = (zc_cvt_i64v_t)(q - (wide_t)(w - q * d >= (d + 1) / 2));                                \
+        }                                                                                               \
+        else                                                                                            \
+        {                                                                                               \
+            /* 只有 uint64 会超出 int64，先饱和 */                                                         \
+            if ((W)-1 > 0) v = ZC_CVT_BLEND(v >> 63, INT64_MAX, v);                                     \
+            ZC_CVT_RESCALE(v, shift);                                                                   \
+        }                                                                                               \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(dst + i, &v, sizeof(v));                                \
+        else memcpy(dst + i, &v, n * sizeof(int64_t));                                                  \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_CVT_ATTR static void ZC_CVT_FN(fixp_from_i64, kind)(const int64_t* src, void* dst, uint64_t count,  \
+    int32_t shift)                                                                                      \
+{                                                                                                       \
+    typedef T dst_t __attribute__((vector_size(ZC_CVT_LANES64 * sizeof(T))));                           \
+    uint8_t* p = dst;                                                                                   \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < count; i += ZC_CVT_LANES64)                                                         \
+    {                                                                                                   \
+        uint64_t n = count - i < ZC_CVT_LANES64 ? count - i : ZC_CVT_LANES64;                           \
+        zc_cvt_i64v_t v = { 0 };                                                                        \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(&v, src + i, sizeof(v));                                \
+        else memcpy(&v, src + i, n * sizeof(int64_t));                                                  \
+        ZC_CVT_RESCALE(v, shift);                                                                       \
+        v = ZC_CVT_BLEND((zc_cvt_i64v_t)(v < (int64_t)(LO)), (int64_t)(LO), v);                         \
+        if ((uint64_t)(HI) <= INT64_MAX)                                                                \
+        {                                                                                               \
+            v = ZC_CVT_BLEND((zc_cvt_i64v_t)(v > (int64_t)(HI)), (int64_t)(HI), v);                     \
+        }                                                                                               \
+        dst_t z = __builtin_convertvector(v, dst_t);                                                    \
+        if (likely(n == ZC_CVT_LANES64)) memcpy(p + i * sizeof(T), &z, sizeof(z));                      \
+        else memcpy(p + i * sizeof(T), &z, n * sizeof(T));                                              \
+    }                                                                                                   \
+}
+
+ZC_CVT_DEFINE_FIXP_KERNELS(i8,  int8_t,   int64_t,  INT8_MIN,  INT8_MAX,   -0x1p7,  0x1p7)
+ZC_CVT_DEFINE_FIXP_KERNELS(u8,  uint8_t,  uint64_t, 0,         UINT8_MAX,  0,       0x1p8)
+ZC_CVT_DEFINE_FIXP_KERNELS(i16, int16_t,  int64_t,  INT16_MIN, INT16_MAX,  -0x1p15, 0x1p15)
+ZC_CVT_DEFINE_FIXP_KERNELS(u16, uint16_t, uint64_t, 0,         UINT16_MAX, 0,       0x1p16)
+ZC_CVT_DEFINE_FIXP_KERNELS(i32, int32_t,  int64_t,  INT32_MIN, INT32_MAX,  -0x1p31, 0x1p31)
+ZC_CVT_DEFINE_FIXP_KERNELS(u32, uint32_t, uint64_t, 0,         UINT32_MAX, 0,       0x1p32)
+ZC_CVT_DEFINE_FIXP_KERNELS(i64, int64_t,  int64_t,  INT64_MIN, INT64_MAX,  -0x1p63, 0x1p63)
+ZC_CVT_DEFINE_FIXP_KERNELS(u64, uint64_t, uint64_t, 0,         UINT64_MAX, 0,       0x1p64)
+
+#undef ZC_CVT_DEFINE_FIXP_KERNELS
+#undef ZC_CVT_RESCALE
+#undef ZC_CVT_DEFINE_KERNELS
+#undef ZC_CVT_ENCODE
+#undef ZC_CVT_DECODE
+#undef ZC_CVT_FN
+#undef ZC_CVT_PASTE
+#undef ZC_CVT_PASTE_
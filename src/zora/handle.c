@@ -25,6 +25,7 @@ zc_internal_result_t zora_decrypt_handle(zc_handle_t handle, uint64_t key,
     version ^= (key >> 60);
     if (version != expect_version) return ZC_INTERNAL_ZORA_UNEXPECTVERSION;
 
-    *out_block_header_ptr = (void*)(handle.address ^ key);
+    // 地址字段只有 60 位，密钥高 4 位已用于版本号
+    *out_block_header_ptr = (void*)((handle.address ^ key) & ((1ULL << 60) - 1));
     return ZC_INTERNAL_OK;
 }
\ No newline at end of file
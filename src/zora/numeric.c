@@ -0,0 +1,267 @@
+#include "numeric.h"
+#include <string.h>
+#include "block_io.h"
+#include "dtta.h"
+#include "type_descriptor.h"
+
+/**
+ * 叶子描述符对应的元素类型，非数值返回 ZC_INTERNAL_TYPE_ERROR
+ */
+static zc_internal_result_t zc_numeric_leaf_kind(const uint8_t* leaf, uint64_t avail, zc_numeric_kind_t* out_kind)
+{
+    static const int8_t int_kinds[ELEMENT_TYPE_U8 + 1] = {
+        [ELEMENT_TYPE_END] = -1, [ELEMENT_TYPE_VOID] = -1, [ELEMENT_TYPE_BOOLEAN] = -1, [ELEMENT_TYPE_CHAR] = -1,
+        [ELEMENT_TYPE_I1] = ZC_NUMERIC_I8,  [ELEMENT_TYPE_U1] = ZC_NUMERIC_U8,
+        [ELEMENT_TYPE_I2] = ZC_NUMERIC_I16, [ELEMENT_TYPE_U2] = ZC_NUMERIC_U16,
+        [ELEMENT_TYPE_I4] = ZC_NUMERIC_I32, [ELEMENT_TYPE_U4] = ZC_NUMERIC_U32,
+        [ELEMENT_TYPE_I8] = ZC_NUMERIC_I64, [ELEMENT_TYPE_U8] = ZC_NUMERIC_U64,
+    };
+
+    uint8_t tag = leaf[0];
+    if (tag <= ELEMENT_TYPE_U8)
+    {
+        if (int_kinds[tag] < 0) return ZC_INTERNAL_TYPE_ERROR;
+        *out_kind = (zc_numeric_kind_t)int_kinds[tag];
+        return ZC_INTERNAL_OK;
+    }
+
+    if (tag != ELEMENT_TYPE_R4 && tag != ELEMENT_TYPE_R8 && tag != ELEMENT_TYPE_FLOATTENSOR) return ZC_INTERNAL_TYPE_ERROR;
+    if (unlikely(avail < 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    // R4 与 FLOATTENSOR 共用 R4 token
+    if (tag == ELEMENT_TYPE_R8)
+    {
+        if (leaf[1] != R8_TYPE_DOUBLE) return ZC_INTERNAL_UNREALIZED;
+        *out_kind = ZC_NUMERIC_F64;
+    }
+    else
+    {
+        if (leaf[1] != R4_TYPE_FLOAT) return ZC_INTERNAL_UNREALIZED;
+        *out_kind = ZC_NUMERIC_F32;
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 查找 offset 处变量的描述符，并跳过数组前缀定位到叶子。数组前缀不改变元素类型
+ */
+static zc_internal_result_t zc_numeric_find_leaf(zc_block_header_t* block, uint64_t offset,
+    zc_dtt_lut_entry_t** out_entry, uint8_t** out_desc, uint64_t* out_desc_len, uint64_t* out_leaf_pos)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    uint8_t* desc = zc_dtt_entry_desc(block, entry);
+    if (unlikely(!desc)) return ZC_INTERNAL_RUN_PTRNULL;
+    uint64_t desc_len = entry->desc_length;
+
+    uint64_t pos = 0;
+    while (pos < desc_len && (desc[pos] == ELEMENT_TYPE_ARRAY || desc[pos] == ELEMENT_TYPE_SZARRAY)) pos++;
+    if (unlikely(pos >= desc_len)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    *out_entry = entry;
+    *out_desc = desc;
+    *out_desc_len = desc_len;
+    *out_leaf_pos = pos;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 由条目中的对象宽度与元素大小填写 span，不再解码描述符
+ */
+static zc_internal_result_t zc_numeric_fill_span(const zc_dtt_lut_entry_t* entry, uint64_t offset,
+    zc_numeric_kind_t kind, uint32_t element_size, zc_numeric_span_t* out_span)
+{
+    if (unlikely(entry->obj_width % element_size != 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    out_span->data_offset = offset;
+    out_span->element_count = entry->obj_width / element_size;
+    out_span->kind = kind;
+    out_span->element_size = element_size;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_numeric_resolve(zc_block_header_t* block, uint64_t offset, zc_numeric_span_t* out_span)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint8_t* desc;
+    uint64_t desc_len;
+    uint64_t pos;
+    zc_internal_result_t res = zc_numeric_find_leaf(block, offset, &entry, &desc, &desc_len, &pos);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    zc_numeric_kind_t kind;
+    res = zc_numeric_leaf_kind(desc + pos, desc_len - pos, &kind);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_numeric_fill_span(entry, offset, kind, zc_numeric_kind_size(kind), out_span);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_numeric_resolve_r4(zc_block_header_t* block, uint64_t offset,
+    zc_numeric_span_t* out_span, uint8_t* out_token)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint8_t* desc;
+    uint64_t desc_len;
+    uint64_t pos;
+    zc_internal_result_t res = zc_numeric_find_leaf(block, offset, &entry, &desc, &desc_len, &pos);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    if (desc[pos] != ELEMENT_TYPE_R4 && desc[pos] != ELEMENT_TYPE_FLOATTENSOR) return ZC_INTERNAL_TYPE_ERROR;
+    if (unlikely(desc_len - pos < 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    uint64_t element_size;
+    res = zc_type_get_r4_obj_size(desc[pos + 1], &element_size);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    *out_token = desc[pos + 1];
+    return zc_numeric_fill_span(entry, offset, ZC_NUMERIC_F32, (uint32_t)element_size, out_span);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_numeric_resolve_fixp(zc_block_header_t* block, uint64_t offset,
+    zc_numeric_span_t* out_span, uint8_t* out_token)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint8_t* desc;
+    uint64_t desc_len;
+    uint64_t pos;
+    zc_internal_result_t res = zc_numeric_find_leaf(block, offset, &entry, &desc, &desc_len, &pos);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    if (desc[pos] != ELEMENT_TYPE_FIXEDPOINT) return ZC_INTERNAL_TYPE_ERROR;
+    if (unlikely(desc_len - pos < 2)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    uint8_t token = desc[pos + 1];
+    uint64_t element_size;
+    res = zc_type_get_fixpoint_obj_size(token, &element_size);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    // I8 / U8 / I16 ... 按宽度成对排列，无符号在后
+    uint32_t width_code = (token & FIXP_TYPE_WIDTH_MASK) >> 5;
+    zc_numeric_kind_t kind = (zc_numeric_kind_t)(width_code * 2 + (zc_fixp_is_signed(token) ? 0 : 1));
+
+    *out_token = token;
+    return zc_numeric_fill_span(entry, offset, kind, (uint32_t)element_size, out_span);
+}
+
+/**
+ * 读取 offset 处的一个元素，元素可以跨页
+ */
+static zc_internal_result_t zc_numeric_load_one(zc_block_header_t* block, uint64_t offset, uint64_t size,
+    zc_numeric_value_t* out_value)
+{
+    return zc_block_read(block, offset, out_value->bytes, size);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_numeric_walk(zc_block_header_t* block, const zc_numeric_span_t* span,
+    bool write_back, zc_numeric_chunk_fn fn, void* ctx)
+{
+    uint64_t size = span->element_size;
+    uint64_t offset = span->data_offset;
+    uint64_t index = 0;
+
+    while (index < span->element_count)
+    {
+        uint64_t in_page = ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+
+        if (likely(in_page >= size))
+        {
+            uint64_t count = in_page / size;
+            if (count > span->element_count - index) count = span->element_count - index;
+
+            void* data = zc_block_offset_to_ptr(block, offset);
+            if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+
+            bool more = fn(ctx, data, count, index);
+            offset += count * size;
+            index += count;
+            if (!more) break;
+            continue;
+        }
+
+        // 元素被页边界截断，两段分别位于本页末尾与下一页开头
+        zc_numeric_value_t scratch;
+        zc_internal_result_t res = zc_block_read(block, offset, scratch.bytes, size);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+        bool more = fn(ctx, &scratch, 1, index);
+        if (write_back)
+        {
+            res = zc_block_write(block, offset, scratch.bytes, size);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        }
+        offset += size;
+        index++;
+        if (!more) break;
+    }
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_numeric_walk_pair(zc_block_header_t* block, const zc_numeric_span_t* a,
+    const zc_numeric_span_t* b, zc_numeric_pair_fn fn, void* ctx)
+{
+    if (unlikely(a->element_size != b->element_size)) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint64_t size = a->element_size;
+    uint64_t count = a->element_count < b->element_count ? a->element_count : b->element_count;
+    uint64_t offset_a = a->data_offset;
+    uint64_t offset_b = b->data_offset;
+    uint64_t index = 0;
+
+    while (index < count)
+    {
+        uint64_t run_a = (ZC_PAGE_DATA_SIZE - offset_a % ZC_PAGE_DATA_SIZE) / size;
+        uint64_t run_b = (ZC_PAGE_DATA_SIZE - offset_b % ZC_PAGE_DATA_SIZE) / size;
+        uint64_t n = run_a < run_b ? run_a : run_b;
+        bool more;
+
+        if (likely(n > 0))
+        {
+            if (n > count - index) n = count - index;
+
+            void* data_a = zc_block_offset_to_ptr(block, offset_a);
+            void* data_b = zc_block_offset_to_ptr(block, offset_b);
+            if (unlikely(!data_a || !data_b)) return ZC_INTERNAL_RUN_PTRNULL;
+
+            more = fn(ctx, data_a, data_b, n, index);
+        }
+        else
+        {
+            zc_numeric_value_t scratch_a;
+            zc_numeric_value_t scratch_b;
+            zc_internal_result_t res = zc_numeric_load_one(block, offset_a, size, &scratch_a);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+            res = zc_numeric_load_one(block, offset_b, size, &scratch_b);
+            if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+            n = 1;
+            more = fn(ctx, &scratch_a, &scratch_b, 1, index);
+        }
+
+        offset_a += n * size;
+        offset_b += n * size;
+        index += n;
+        if (!more) break;
+    }
+
+    return ZC_INTERNAL_OK;
+}
@@ -0,0 +1,171 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 数值元素的机器表示，数组、张量与标量变量统一按元素序列处理
+ */
+typedef enum zc_numeric_kind {
+    ZC_NUMERIC_I8  = 0,
+    ZC_NUMERIC_U8  = 1,
+    ZC_NUMERIC_I16 = 2,
+    ZC_NUMERIC_U16 = 3,
+    ZC_NUMERIC_I32 = 4,
+    ZC_NUMERIC_U32 = 5,
+    ZC_NUMERIC_I64 = 6,
+    ZC_NUMERIC_U64 = 7,
+    ZC_NUMERIC_F32 = 8,
+    ZC_NUMERIC_F64 = 9,
+    ZC_NUMERIC_KIND_COUNT
+} zc_numeric_kind_t;
+
+typedef union zc_numeric_value {
+    int8_t   i8;
+    uint8_t  u8;
+    int16_t  i16;
+    uint16_t u16;
+    int32_t  i32;
+    uint32_t u32;
+    int64_t  i64;
+    uint64_t u64;
+    float    f32;
+    double   f64;
+    uint8_t  bytes[8];
+} zc_numeric_value_t;
+
+/**
+ * 块内一段连续编号的数值元素
+ */
+typedef struct zc_numeric_span {
+    uint64_t data_offset;     // 首元素偏移 (相对于块首)
+    uint64_t element_count;
+    uint32_t kind;            // zc_numeric_kind_t
+    uint32_t element_size;
+} zc_numeric_span_t;
+
+static inline uint32_t zc_numeric_kind_size(zc_numeric_kind_t kind)
+{
+    static const uint8_t sizes[ZC_NUMERIC_KIND_COUNT] = { 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+    return sizes[kind];
+}
+
+/**
+ * @brief 把 offset 处的变量解析为数值元素序列。
+ *
+ * 接受 I1–I8 / U1–U8 / R4 (FLOAT) / R8 (DOUBLE) 标量，以这些类型为元素的 ARRAY / SZARRAY（可嵌套），
+ * 以及元素为 FLOAT 的 FLOATTENSOR。元素数由对象宽度除以元素大小得到。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 元素不是数值类型。
+ * - ZC_INTERNAL_UNREALIZED: 元素是尚不支持的浮点格式。
+ * - 其他: 由 DTTA 查询或描述符解码透传的错误。
+ */
+zc_internal_result_t zc_numeric_resolve(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_numeric_span_t* out_span
+);
+
+/**
+ * @brief 把 offset 处以 R4 token 编码的变量解析为元素序列，供按 token 转换的读写路径使用。
+ *
+ * 接受 R4 标量、以 R4 为元素的 ARRAY / SZARRAY 以及 FLOATTENSOR，token 可以是任何已定义的 R4 格式。
+ * out_span->kind 固定为 ZC_NUMERIC_F32（转换后的类型），element_size 为编码宽度。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 元素不是 R4 / FLOATTENSOR。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 未定义的 token。
+ * - 其他: 由 DTTA 查询或描述符解码透传的错误。
+ */
+zc_internal_result_t zc_numeric_resolve_r4(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_numeric_span_t* out_span,
+    uint8_t* out_token
+);
+
+/**
+ * @brief 把 offset 处的十进制定点变量解析为元素序列。
+ *
+ * 接受 FIXEDPOINT 标量与以其为元素的 ARRAY / SZARRAY。out_span->kind 为存储用的整型。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 元素不是 FIXEDPOINT。
+ * - 其他: 由 DTTA 查询或描述符解码透传的错误。
+ */
+zc_internal_result_t zc_numeric_resolve_fixp(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_numeric_span_t* out_span,
+    uint8_t* out_token
+);
+
+/**
+ * 分段回调。data 中有 count 个连续元素，对应序号 [first_index, first_index + count)。
+ * 返回 false 提前结束遍历。
+ */
+typedef bool (*zc_numeric_chunk_fn)(void* ctx, void* data, uint64_t count, uint64_t first_index);
+
+/**
+ * @brief 按页分段遍历元素，每个页内的整段元素直接以块内地址交给回调。
+ *
+ * 跨越页边界的单个元素拼接到栈上的临时缓冲后单独交给回调；write_back 为真时回调结束后再写回两页。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功（包括回调提前结束）。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 跨页元素超出块的页范围。
+ */
+zc_internal_result_t zc_numeric_walk(
+    zc_block_header_t* block,
+    const zc_numeric_span_t* span,
+    bool write_back,
+    zc_numeric_chunk_fn fn,
+    void* ctx
+);
+
+/**
+ * 成对分段回调。a、b 中各有 count 个连续元素，对应序号 [first_index, first_index + count)
+ */
+typedef bool (*zc_numeric_pair_fn)(void* ctx, void* a, void* b, uint64_t count, uint64_t first_index);
+
+/**
+ * @brief 按序号同步遍历两个元素大小相同的序列，长度取两者较小值。
+ *
+ * 每次交给回调的是两侧都不跨页的最长一段；任一侧元素被页边界截断时，该序号两侧都拼接到临时缓冲。只读。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功（包括回调提前结束）。
+ * - ZC_INTERNAL_PARAM_ERROR: 两侧元素大小不同。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ * - ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET: 跨页元素超出块的页范围。
+ */
+zc_internal_result_t zc_numeric_walk_pair(
+    zc_block_header_t* block,
+    const zc_numeric_span_t* a,
+    const zc_numeric_span_t* b,
+    zc_numeric_pair_fn fn,
+    void* ctx
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NUMERIC_H */
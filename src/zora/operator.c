@@ -0,0 +1,278 @@
+#include "operator.h"
+#include <string.h>
+#include "simd.h"
+#include "compare.h"
+
+#define ZC_OP_FLUSH 4096   // 窄累加通道并入总和的间隔元素数，必须是每向量元素数的倍数
+
+#define ZC_OP_LEVEL baseline
+#define ZC_OP_ATTR
+#include "operator_kernels.h"
+#undef ZC_OP_ATTR
+#undef ZC_OP_LEVEL
+
+#if ZC_SIMD_X86
+#define ZC_OP_LEVEL sse42
+#define ZC_OP_ATTR ZC_SIMD_TARGET_SSE42
+#include "operator_kernels.h"
+#undef ZC_OP_ATTR
+#undef ZC_OP_LEVEL
+
+#define ZC_OP_LEVEL avx2
+#define ZC_OP_ATTR ZC_SIMD_TARGET_AVX2
+#include "operator_kernels.h"
+#undef ZC_OP_ATTR
+#undef ZC_OP_LEVEL
+
+#define ZC_OP_LEVEL avx512
+#define ZC_OP_ATTR ZC_SIMD_TARGET_AVX512
+#include "operator_kernels.h"
+#undef ZC_OP_ATTR
+#undef ZC_OP_LEVEL
+#endif
+
+typedef struct zc_operator_kernels {
+    void (*sum)(const void* data, uint64_t count, void* inout_total);
+    void (*dot)(const void* a, const void* b, uint64_t count, void* inout_total);
+    void (*scale)(void* data, uint64_t count, const void* factor);
+    void (*clamp)(void* data, uint64_t count, const void* lo, const void* hi);
+} zc_operator_kernels_t;
+
+#define ZC_OP_ENTRY(kind, level) \
+    { zc_op_sum_##kind##_##level, zc_op_dot_##kind##_##level, zc_op_scale_##kind##_##level, zc_op_clamp_##kind##_##level }
+#define ZC_OP_ROW(level) {                                                    \
+    ZC_OP_ENTRY(i8, level),  ZC_OP_ENTRY(u8, level),  ZC_OP_ENTRY(i16, level), \
+    ZC_OP_ENTRY(u16, level), ZC_OP_ENTRY(i32, level), ZC_OP_ENTRY(u32, level), \
+    ZC_OP_ENTRY(i64, level), ZC_OP_ENTRY(u64, level), ZC_OP_ENTRY(f32, level), \
+    ZC_OP_ENTRY(f64, level) }
+
+// 按 [zc_simd_level_t][zc_numeric_kind_t] 索引
+static const zc_operator_kernels_t zc_operator_kernel_table[ZC_SIMD_LEVEL_COUNT][ZC_NUMERIC_KIND_COUNT] = {
+    ZC_OP_ROW(baseline),
+#if ZC_SIMD_X86
+    ZC_OP_ROW(sse42),
+    ZC_OP_ROW(avx2),
+    ZC_OP_ROW(avx512),
+#else
+    ZC_OP_ROW(baseline),
+    ZC_OP_ROW(baseline),
+    ZC_OP_ROW(baseline),
+#endif
+};
+
+#undef ZC_OP_ROW
+#undef ZC_OP_ENTRY
+
+static inline const zc_operator_kernels_t* zc_operator_kernels(uint32_t kind)
+{
+    return &zc_operator_kernel_table[zc_simd_level()][kind];
+}
+
+/**
+ * 求和与点积结果的类型
+ */
+static inline zc_numeric_kind_t zc_operator_total_kind(uint32_t kind)
+{
+    if (kind >= ZC_NUMERIC_F32) return ZC_NUMERIC_F64;
+    return kind % 2 == 0 ? ZC_NUMERIC_I64 : ZC_NUMERIC_U64;
+}
+
+typedef struct zc_operator_ctx {
+    const zc_operator_kernels_t* kernels;
+    const void*                  arg0;
+    const void*                  arg1;
+    zc_numeric_value_t           total;
+} zc_operator_ctx_t;
+
+static bool zc_operator_chunk_sum(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_operator_ctx_t* c = ctx;
+    (void)first_index;
+    c->kernels->sum(data, count, &c->total);
+    return true;
+}
+
+static bool zc_operator_chunk_dot(void* ctx, void* a, void* b, uint64_t count, uint64_t first_index)
+{
+    zc_operator_ctx_t* c = ctx;
+    (void)first_index;
+    c->kernels->dot(a, b, count, &c->total);
+    return true;
+}
+
+static bool zc_operator_chunk_scale(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_operator_ctx_t* c = ctx;
+    (void)first_index;
+    c->kernels->scale(data, count, c->arg0);
+    return true;
+}
+
+static bool zc_operator_chunk_clamp(void* ctx, void* data, uint64_t count, uint64_t first_index)
+{
+    zc_operator_ctx_t* c = ctx;
+    (void)first_index;
+    c->kernels->clamp(data, count, c->arg0, c->arg1);
+    return true;
+}
+
+static zc_internal_result_t zc_operator_sum_span(zc_block_header_t* block, const zc_numeric_span_t* span,
+    zc_operator_scalar_t* out_sum)
+{
+    zc_operator_ctx_t ctx = { .kernels = zc_operator_kernels(span->kind) };
+    zc_numeric_kind_t total_kind = zc_operator_total_kind(span->kind);
+    if (total_kind == ZC_NUMERIC_F64) ctx.total.f64 = 0.0;
+    else ctx.total.u64 = 0;
+
+    zc_internal_result_t res = zc_numeric_walk(block, span, false, zc_operator_chunk_sum, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    out_sum->value = ctx.total;
+    out_sum->kind = total_kind;
+    out_sum->reserved = 0;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_sum(zc_block_header_t* block, uint64_t offset, zc_operator_scalar_t* out_sum)
+{
+    if (unlikely(!out_sum)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    return zc_operator_sum_span(block, &span, out_sum);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_mean(zc_block_header_t* block, uint64_t offset, double* out_mean)
+{
+    if (unlikely(!out_mean)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(span.element_count == 0)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_operator_scalar_t sum;
+    res = zc_operator_sum_span(block, &span, &sum);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    double total;
+    if (sum.kind == ZC_NUMERIC_F64) total = sum.value.f64;
+    else if (sum.kind == ZC_NUMERIC_I64) total = (double)sum.value.i64;
+    else total = (double)sum.value.u64;
+
+    *out_mean = total / (double)span.element_count;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 最小值与最大值共用一次归约
+ */
+static zc_internal_result_t zc_operator_extreme(zc_block_header_t* block, uint64_t offset,
+    bool want_max, zc_operator_scalar_t* out_value)
+{
+    if (unlikely(!out_value)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(span.element_count == 0)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_numeric_value_t min;
+    zc_numeric_value_t max;
+    res = zc_compare_minmax(block, &span, &min, &max);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    out_value->value = want_max ? max : min;
+    out_value->kind = span.kind;
+    out_value->reserved = 0;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_min(zc_block_header_t* block, uint64_t offset, zc_operator_scalar_t* out_min)
+{
+    return zc_operator_extreme(block, offset, false, out_min);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_max(zc_block_header_t* block, uint64_t offset, zc_operator_scalar_t* out_max)
+{
+    return zc_operator_extreme(block, offset, true, out_max);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_dot(zc_block_header_t* block, uint64_t offset_a, uint64_t offset_b,
+    zc_operator_scalar_t* out_dot)
+{
+    if (unlikely(!out_dot)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span_a;
+    zc_numeric_span_t span_b;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset_a, &span_a);
+    if (res != ZC_INTERNAL_OK) return res;
+    res = zc_numeric_resolve(block, offset_b, &span_b);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (span_a.kind != span_b.kind) return ZC_INTERNAL_TYPE_ERROR;
+    if (span_a.element_count != span_b.element_count) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_operator_ctx_t ctx = { .kernels = zc_operator_kernels(span_a.kind) };
+    zc_numeric_kind_t total_kind = zc_operator_total_kind(span_a.kind);
+    if (total_kind == ZC_NUMERIC_F64) ctx.total.f64 = 0.0;
+    else ctx.total.u64 = 0;
+
+    res = zc_numeric_walk_pair(block, &span_a, &span_b, zc_operator_chunk_dot, &ctx);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+
+    out_dot->value = ctx.total;
+    out_dot->kind = total_kind;
+    out_dot->reserved = 0;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_scale(zc_block_header_t* block, uint64_t offset,
+    const void* factor, uint64_t size)
+{
+    if (unlikely(!factor)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(size != span.element_size)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_operator_ctx_t ctx = { .kernels = zc_operator_kernels(span.kind), .arg0 = factor };
+    return zc_numeric_walk(block, &span, true, zc_operator_chunk_scale, &ctx);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_operator_clamp(zc_block_header_t* block, uint64_t offset,
+    const void* lo, const void* hi, uint64_t size)
+{
+    if (unlikely(!lo || !hi)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_numeric_span_t span;
+    zc_internal_result_t res = zc_numeric_resolve(block, offset, &span);
+    if (res != ZC_INTERNAL_OK) return res;
+    if (unlikely(size != span.element_size)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_operator_ctx_t ctx = { .kernels = zc_operator_kernels(span.kind), .arg0 = lo, .arg1 = hi };
+    return zc_numeric_walk(block, &span, true, zc_operator_chunk_clamp, &ctx);
+}
@@ -0,0 +1,136 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+#include "numeric.h"
+
+#ifndef OPERATOR_H
+#define OPERATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 归约结果。求和与点积：有符号整型为 I64，无符号整型为 U64，浮点为 F64；最值为元素类型
+ */
+typedef struct zc_operator_scalar {
+    zc_numeric_value_t value;
+    uint32_t           kind;          // zc_numeric_kind_t
+    uint32_t           reserved;
+} zc_operator_scalar_t;
+
+/**
+ * @brief 数值变量所有元素之和。
+ *
+ * 整型累加到 64 位并按模回绕；浮点累加到 double，FLOAT 元素先加宽。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功，空变量的和为 0。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_operator_sum(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_operator_scalar_t* out_sum
+);
+
+/**
+ * @brief 数值变量所有元素的算术平均。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: 变量没有元素。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_operator_mean(
+    zc_block_header_t* block,
+    uint64_t offset,
+    double* out_mean
+);
+
+/**
+ * @brief 数值变量的最小值 / 最大值。NaN 不参与比较，浮点元素全为 NaN 时结果为 NaN。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: 变量没有元素。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_operator_min(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_operator_scalar_t* out_min
+);
+
+zc_internal_result_t zc_operator_max(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_operator_scalar_t* out_max
+);
+
+/**
+ * @brief 块内两个数值变量的点积，两者可以位于任意偏移，页相位可以不同。
+ *
+ * 累加规则同 zc_operator_sum，乘积在加宽后的类型中计算。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_TYPE_ERROR: 两个变量的元素类型不同。
+ * - ZC_INTERNAL_PARAM_ERROR: 两个变量的元素数不同。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ */
+zc_internal_result_t zc_operator_dot(
+    zc_block_header_t* block,
+    uint64_t offset_a,
+    uint64_t offset_b,
+    zc_operator_scalar_t* out_dot
+);
+
+/**
+ * @brief 原地把每个元素乘以 factor。整型按模回绕。
+ *
+ * @param factor [in] 与元素同类型的系数。
+ * @param size   [in] factor 的字节数，必须等于元素大小。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: size 与元素大小不符。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_operator_scale(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void* factor,
+    uint64_t size
+);
+
+/**
+ * @brief 原地把每个元素限制到 [lo, hi]。先与 lo 取大再与 hi 取小，lo > hi 时结果全为 hi；NaN 保持不变。
+ *
+ * @param size [in] lo、hi 各自的字节数，必须等于元素大小。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: size 与元素大小不符。
+ * - 其他: 由 zc_numeric_resolve 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。
+ */
+zc_internal_result_t zc_operator_clamp(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void* lo,
+    const void* hi,
+    uint64_t size
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPERATOR_H */
@@ -0,0 +1,176 @@
+/*
+*/
+/**
+ * 算子内核模板，由 operator.c 在每个指令集级别下各包含一次，不设包含保护。
+ *
+ * 包含前需定义：
+ * - ZC_OP_LEVEL: 函数名后缀，如 avx2
+ * - ZC_OP_ATTR:  该级别的 target 属性，基线级别为空
+ *
+ * 归约先把元素加宽到 64 字节累加向量，每 ZC_OP_FLUSH 个元素把各通道并入 64 位总和，窄通道不会溢出；
+ * 整型在无符号通道上运算，溢出按模回绕。不足一个向量的尾部补零后走同一条向量路径。
+ */
+
+#define ZC_OP_PASTE_(a, b, c) zc_op_##a##_##b##_##c
+#define ZC_OP_PASTE(a, b, c) ZC_OP_PASTE_(a, b, c)
+#define ZC_OP_FN(name, kind) ZC_OP_PASTE(name, kind, ZC_OP_LEVEL)
+
+/**
+ * 先抬到下界再压到上界；NaN 不满足任何比较，保持原值
+ */
+#define ZC_OP_BLEND(m, a, b) (((m) & (__typeof__(m))(a)) | (~(m) & (__typeof__(m))(b)))
+#define ZC_OP_CLAMP(x, lv, hv) do {                                             \
+    (x) = (__typeof__(x))ZC_OP_BLEND((x) < (lv), lv, x);                        \
+    (x) = (__typeof__(x))ZC_OP_BLEND((x) > (hv), hv, x);                        \
+} while (0)
+
+/**
+ * kind:  元素类型后缀
+ * T:     元素类型
+ * UT:    T 的同宽运算类型，整型为无符号，浮点为自身
+ * W, A:  求和的加宽类型与累加通道类型
+ * DW, DA: 点积的加宽类型与累加通道类型
+ * R:     总和类型，整型为 uint64_t（有符号按补码解释），浮点为 double
+ */
+#define ZC_OP_DEFINE_KERNELS(kind, T, UT, W, A, DW, DA, R)                                              \
+ZC_OP_ATTR static void ZC_OP_FN(sum, kind)(const void* data, uint64_t count, void* inout_total)         \
+{                                                                                                       \
+    typedef T src_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES / sizeof(W) * sizeof(T))));         \
+    typedef W wide_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                \
+    typedef A acc_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                 \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(W);                                            \
+    const uint8_t* p = data;                                                                            \
+    R total;                                                                                            \
+    memcpy(&total, inout_total, sizeof(R));                                                             \
+    uint64_t i = 0;                                                                                     \
+    while (i < count)                                                                                   \
+    {                                                                                                   \
+        uint64_t end = count - i > ZC_OP_FLUSH ? i + ZC_OP_FLUSH : count;                               \
+        acc_t acc = { 0 };                                                                              \
+        for (; i + lanes <= end; i += lanes)                                                            \
+        {                                                                                               \
+            src_t x;                                                                                    \
+            memcpy(&x, p + i * sizeof(T), sizeof(x));                                                   \
+            acc += (acc_t)__builtin_convertvector(x, wide_t);                                           \
+        }                                                                                               \
+        if (i < end)                                                                                    \
+        {                                                                                               \
+            src_t x = { 0 };                                                                            \
+            memcpy(&x, p + i * sizeof(T), (end - i) * sizeof(T));                                       \
+            acc += (acc_t)__builtin_convertvector(x, wide_t);                                           \
+            i = end;                                                                                    \
+        }                                                                                               \
+        uint64_t l;                                                                                     \
+        for (l = 0; l < lanes; l++) total += (R)(W)acc[l];                                              \
+    }                                                                                                   \
+    memcpy(inout_total, &total, sizeof(R));                                                             \
+}                                                                                                       \
+                                                                                                        \
+ZC_OP_ATTR static void ZC_OP_FN(dot, kind)(const void* a, const void* b, uint64_t count,                \
+    void* inout_total)                                                                                  \
+{                                                                                                       \
+    typedef T src_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES / sizeof(DW) * sizeof(T))));        \
+    typedef DW wide_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                               \
+    typedef DA acc_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(DW);                                           \
+    const uint8_t* pa = a;                                                                              \
+    const uint8_t* pb = b;                                                                              \
+    R total;                                                                                            \
+    memcpy(&total, inout_total, sizeof(R));                                                             \
+    uint64_t i = 0;                                                                                     \
+    while (i < count)                                                                                   \
+    {                                                                                                   \
+        uint64_t end = count - i > ZC_OP_FLUSH ? i + ZC_OP_FLUSH : count;                               \
+        acc_t acc = { 0 };                                                                              \
+        for (; i + lanes <= end; i += lanes)                                                            \
+        {                                                                                               \
+            src_t x, y;                                                                                 \
+            memcpy(&x, pa + i * sizeof(T), sizeof(x));                                                  \
+            memcpy(&y, pb + i * sizeof(T), sizeof(y));                                                  \
+            acc += (acc_t)__builtin_convertvector(x, wide_t) * (acc_t)__builtin_convertvector(y, wide_t); \
+        }                                                                                               \
+        if (i < end)                                                                                    \
+        {                                                                                               \
+            src_t x = { 0 };                                                                            \
+            src_t y = { 0 };                                                                            \
+            memcpy(&x, pa + i * sizeof(T), (end - i) * sizeof(T));                                      \
+            memcpy(&y, pb + i * sizeof(T), (end - i) * sizeof(T));                                      \
+            acc += (acc_t)__builtin_convertvector(x, wide_t) * (acc_t)__builtin_convertvector(y, wide_t); \
+            i = end;                                                                                    \
+        }                                                                                               \
+        uint64_t l;                                                                                     \
+        for (l = 0; l < lanes; l++) total += (R)(DW)acc[l];                                             \
+    }                                                                                                   \
+    memcpy(inout_total, &total, sizeof(R));                                                             \
+}                                                                                                       \
+                                                                                                        \
+ZC_OP_ATTR static void ZC_OP_FN(scale, kind)(void* data, uint64_t count, const void* factor)            \
+{                                                                                                       \
+    typedef UT vec_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(T);                                            \
+    uint8_t* p = data;                                                                                  \
+    UT f;                                                                                               \
+    memcpy(&f, factor, sizeof(UT));                                                                     \
+    vec_t fv;                                                                                           \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < lanes; i++) fv[i] = f;                                                              \
+    for (i = 0; i + lanes <= count; i += lanes)                                                         \
+    {                                                                                                   \
+        vec_t x;                                                                                        \
+        memcpy(&x, p + i * sizeof(T), sizeof(x));                                                       \
+        x *= fv;                                                                                        \
+        memcpy(p + i * sizeof(T), &x, sizeof(x));                                                       \
+    }                                                                                                   \
+    if (i < count)                                                                                      \
+    {                                                                                                   \
+        vec_t x = { 0 };                                                                                \
+        memcpy(&x, p + i * sizeof(T), (count - i) * sizeof(T));                                         \
+        x *= fv;                                                                                        \
+        memcpy(p + i * sizeof(T), &x, (count - i) * sizeof(T));                                         \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+ZC_OP_ATTR static void ZC_OP_FN(clamp, kind)(void* data, uint64_t count, const void* lo, const void* hi) \
+{                                                                                                       \
+    typedef T vec_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));                                 \
+    const uint64_t lanes = ZC_SIMD_VECTOR_BYTES / sizeof(T);                                            \
+    uint8_t* p = data;                                                                                  \
+    T l, h;                                                                                             \
+    memcpy(&l, lo, sizeof(T));                                                                          \
+    memcpy(&h, hi, sizeof(T));                                                                          \
+    vec_t lv, hv;                                                                                       \
+    uint64_t i;                                                                                         \
+    for (i = 0; i < lanes; i++) { lv[i] = l; hv[i] = h; }                                               \
+    for (i = 0; i + lanes <= count; i += lanes)                                                         \
+    {                                                                                                   \
+        vec_t x;                                                                                        \
+        memcpy(&x, p + i * sizeof(T), sizeof(x));                                                       \
+        ZC_OP_CLAMP(x, lv, hv);                                                                         \
+        memcpy(p + i * sizeof(T), &x, sizeof(x));                                                       \
+    }                                                                                                   \
+    if (i < count)                                                                                      \
+    {                                                                                                   \
+        vec_t x = { 0 };                                                                                \
+        memcpy(&x, p + i * sizeof(T), (count - i) * sizeof(T));                                         \
+        ZC_OP_CLAMP(x, lv, hv);                                                                         \
+        memcpy(p + i * sizeof(T), &x, (count - i) * sizeof(T));                                         \
+    }                                                                                                   \
+}
+
+ZC_OP_DEFINE_KERNELS(i8,  int8_t,   uint8_t,  int32_t,  uint32_t, int32_t,  uint32_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(u8,  uint8_t,  uint8_t,  uint32_t, uint32_t, uint32_t, uint32_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(i16, int16_t,  uint16_t, int32_t,  uint32_t, int64_t,  uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(u16, uint16_t, uint16_t, uint32_t, uint32_t, uint64_t, uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(i32, int32_t,  uint32_t, int64_t,  uint64_t, int64_t,  uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(u32, uint32_t, uint32_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(i64, int64_t,  uint64_t, int64_t,  uint64_t, int64_t,  uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(u64, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t)
+ZC_OP_DEFINE_KERNELS(f32, float,    float,    double,   double,   double,   double,   double)
+ZC_OP_DEFINE_KERNELS(f64, double,   double,   double,   double,   double,   double,   double)
+
+#undef ZC_OP_DEFINE_KERNELS
+#undef ZC_OP_CLAMP
+#undef ZC_OP_BLEND
+#undef ZC_OP_FN
+#undef ZC_OP_PASTE
+#undef ZC_OP_PASTE_
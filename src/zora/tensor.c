@@ -0,0 +1,266 @@
+#include "tensor.h"
+#include <string.h>
+#include "dtta.h"
+#include "type_descriptor.h"
+#include "block_io.h"
+
+/**
+ * gather 时最近访问的页，连续的短段多落在同一页内，省去逐段的偏移换算
+ */
+typedef struct zc_tensor_page_cache {
+    uint64_t page;       // 页号，UINT64_MAX 表示尚未缓存
+    uint8_t* data;       // 该页数据区首地址
+} zc_tensor_page_cache_t;
+
+/**
+ * 按行主序填写步长
+ */
+static void zc_tensor_view_set_dense(zc_tensor_view_t* view)
+{
+    int64_t stride = (int64_t)view->element_size;
+    uint32_t i = view->rank;
+    while (i-- > 0)
+    {
+        view->stride[i] = stride;
+        stride *= (int64_t)view->shape[i];
+    }
+}
+
+/**
+ * 拷贝块内 [offset, offset + n) 的一段，位于一页之内时直接由页地址拷贝
+ */
+static zc_internal_result_t zc_tensor_copy_run(zc_block_header_t* block, zc_tensor_page_cache_t* cache,
+    uint64_t offset, uint8_t* dst, uint64_t n)
+{
+    uint64_t page = offset / ZC_PAGE_DATA_SIZE;
+    uint64_t in_page = offset % ZC_PAGE_DATA_SIZE;
+    if (in_page + n > ZC_PAGE_DATA_SIZE) return zc_block_read(block, offset, dst, n);
+
+    if (page != cache->page)
+    {
+        uint8_t* data = zc_block_offset_to_ptr(block, offset - in_page);
+        if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+        cache->page = page;
+        cache->data = data;
+    }
+    memcpy(dst, cache->data + in_page, n);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_init(zc_block_header_t* block, uint64_t offset, zc_tensor_view_t* out_view)
+{
+    if (unlikely(!out_view)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+    uint64_t width = entry->obj_width;
+
+    uint8_t* desc = zc_dtt_entry_desc(block, entry);
+    if (unlikely(!desc)) return ZC_INTERNAL_RUN_PTRNULL;
+    uint64_t desc_len = entry->desc_length;
+    if (desc[0] != ELEMENT_TYPE_FLOATTENSOR) return ZC_INTERNAL_TYPE_ERROR;
+
+    // [0x4C][元素 token][阶数 u16][各维 u16]
+    if (unlikely(desc_len < 4)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    uint16_t order;
+    memcpy(&order, desc + 2, sizeof(uint16_t));
+    if (unlikely(desc_len < 4 + 2 * (uint64_t)order)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    if (order > ZC_TENSOR_MAX_RANK) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint64_t element_size;
+    res = zc_type_get_tensor_element_size(desc[1], &element_size);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (unlikely(element_size == 0)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+
+    zc_tensor_view_t view;
+    view.block = block;
+    view.offset = offset;
+    view.element_size = element_size;
+    view.element_token = desc[1];
+    view.rank = order;
+
+    // 按维累乘前先与 width 比较，乘积不会溢出
+    uint64_t bytes = element_size;
+    if (unlikely(bytes > width)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+    uint32_t i;
+    for (i = 0; i < order; i++)
+    {
+        uint16_t d;
+        memcpy(&d, desc + 4 + 2 * i, sizeof(uint16_t));
+        if (unlikely(d != 0 && bytes > width / d)) return ZC_INTERNAL_TYPE_ILLEGAL_DESC;
+        view.shape[i] = d;
+        bytes *= d;
+    }
+
+    zc_tensor_view_set_dense(&view);
+    *out_view = view;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_slice(zc_tensor_view_t* view, uint32_t dim, uint64_t start, uint64_t count,
+    int64_t step)
+{
+    if (unlikely(!view)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(dim >= view->rank || step == 0)) return ZC_INTERNAL_PARAM_ERROR;
+
+    if (count != 0)
+    {
+        if (unlikely(start >= view->shape[dim])) return ZC_INTERNAL_PARAM_ERROR;
+
+        // 最后一个下标 start + (count - 1) * step 仍须落在 [0, shape)
+        uint64_t reach = step > 0 ? (view->shape[dim] - 1 - start) / (uint64_t)step
+                                  : start / ((uint64_t)(-(step + 1)) + 1);
+        if (unlikely(count - 1 > reach)) return ZC_INTERNAL_PARAM_ERROR;
+
+        view->offset += start * (uint64_t)view->stride[dim];
+    }
+
+    // 只有一个下标时步长无意义，不乘以 step 以免溢出
+    view->shape[dim] = count;
+    if (count > 1) view->stride[dim] *= step;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_select(zc_tensor_view_t* view, uint32_t dim, uint64_t index)
+{
+    if (unlikely(!view)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(dim >= view->rank || index >= view->shape[dim])) return ZC_INTERNAL_PARAM_ERROR;
+
+    view->offset += index * (uint64_t)view->stride[dim];
+
+    uint32_t i;
+    for (i = dim; i + 1 < view->rank; i++)
+    {
+        view->shape[i] = view->shape[i + 1];
+        view->stride[i] = view->stride[i + 1];
+    }
+    view->rank--;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_transpose(zc_tensor_view_t* view, const uint32_t* perm)
+{
+    if (unlikely(!view || (view->rank != 0 && !perm))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t shape[ZC_TENSOR_MAX_RANK];
+    int64_t stride[ZC_TENSOR_MAX_RANK];
+    uint32_t seen = 0;
+    uint32_t i;
+    for (i = 0; i < view->rank; i++)
+    {
+        if (unlikely(perm[i] >= view->rank || (seen & (1u << perm[i])))) return ZC_INTERNAL_PARAM_ERROR;
+        seen |= 1u << perm[i];
+        shape[i] = view->shape[perm[i]];
+        stride[i] = view->stride[perm[i]];
+    }
+
+    memcpy(view->shape, shape, view->rank * sizeof(uint64_t));
+    memcpy(view->stride, stride, view->rank * sizeof(int64_t));
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_reshape(zc_tensor_view_t* view, uint32_t rank, const uint64_t* shape)
+{
+    if (unlikely(!view || (rank != 0 && !shape))) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(rank > ZC_TENSOR_MAX_RANK)) return ZC_INTERNAL_PARAM_ERROR;
+    if (!zc_tensor_view_is_contiguous(view)) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint64_t count = zc_tensor_view_element_count(view);
+    uint64_t product = 1;
+    uint32_t i;
+    for (i = 0; i < rank; i++)
+    {
+        if (shape[i] != 0 && product > count / shape[i]) return ZC_INTERNAL_PARAM_ERROR;
+        product *= shape[i];
+    }
+    if (product != count) return ZC_INTERNAL_PARAM_ERROR;
+
+    view->rank = rank;
+    memcpy(view->shape, shape, rank * sizeof(uint64_t));
+    zc_tensor_view_set_dense(view);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_read(const zc_tensor_view_t* view, const uint64_t* index, void* out_element)
+{
+    if (unlikely(!view || !out_element || (view->rank != 0 && !index))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    // 步长可为负，按无符号回绕累加
+    uint64_t offset = view->offset;
+    uint32_t i;
+    for (i = 0; i < view->rank; i++)
+    {
+        if (unlikely(index[i] >= view->shape[i])) return ZC_INTERNAL_PARAM_ERROR;
+        offset += index[i] * (uint64_t)view->stride[i];
+    }
+    return zc_block_read(view->block, offset, out_element, view->element_size);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_tensor_view_gather(const zc_tensor_view_t* view, void* dst, uint64_t capacity)
+{
+    if (unlikely(!view)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t count = zc_tensor_view_element_count(view);
+    if (count == 0) return ZC_INTERNAL_OK;
+    if (unlikely(!dst)) return ZC_INTERNAL_PARAM_PTRNULL;
+    if (unlikely(capacity / view->element_size < count)) return ZC_INTERNAL_PARAM_ERROR;
+
+    // 末尾连续的维合并为一段，只对其余 outer 维逐段遍历
+    uint64_t run = view->element_size;
+    uint32_t outer = view->rank;
+    while (outer > 0 && (view->shape[outer - 1] == 1 || view->stride[outer - 1] == (int64_t)run))
+    {
+        run *= view->shape[outer - 1];
+        outer--;
+    }
+
+    zc_tensor_page_cache_t cache = { UINT64_MAX, NULL };
+    uint64_t index[ZC_TENSOR_MAX_RANK] = { 0 };
+    uint64_t offset = view->offset;
+    uint8_t* out = dst;
+    for (;;)
+    {
+        zc_internal_result_t res = zc_tensor_copy_run(view->block, &cache, offset, out, run);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        out += run;
+
+        // 按行主序推进下标，进位时退回该维起点
+        uint32_t d;
+        for (d = outer; d > 0; d--)
+        {
+            if (++index[d - 1] < view->shape[d - 1])
+            {
+                offset += (uint64_t)view->stride[d - 1];
+                break;
+            }
+            offset -= (view->shape[d - 1] - 1) * (uint64_t)view->stride[d - 1];
+            index[d - 1] = 0;
+        }
+        if (d == 0) break;
+    }
+    return ZC_INTERNAL_OK;
+}
@@ -0,0 +1,189 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef TENSOR_H
+#define TENSOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 视图支持的最大阶数
+#ifndef ZC_TENSOR_MAX_RANK
+#define ZC_TENSOR_MAX_RANK 8
+#endif
+
+/**
+ * FLOATTENSOR 变量上的跨步视图。只记录形状与字节步长，不持有数据，
+ * 切片、选取与转置只修改元数据，读取时直接访问块内页。
+ */
+typedef struct zc_tensor_view {
+    zc_block_header_t* block;
+    uint64_t offset;                          // 视图首元素的块内偏移
+    uint64_t element_size;                    // 元素字节宽度
+    uint8_t  element_token;                   // 描述符中的元素 token
+    uint32_t rank;
+    uint64_t shape[ZC_TENSOR_MAX_RANK];
+    int64_t  stride[ZC_TENSOR_MAX_RANK];      // 各维的字节步长，反向切片时为负
+} zc_tensor_view_t;
+
+/**
+ * @brief 视图包含的元素个数，0 阶视图为 1。
+ */
+static inline uint64_t zc_tensor_view_element_count(const zc_tensor_view_t* view)
+{
+    uint64_t count = 1;
+    uint32_t i;
+    for (i = 0; i < view->rank; i++) count *= view->shape[i];
+    return count;
+}
+
+/**
+ * @brief 视图是否按行主序紧密排列，即元素在块内连续。
+ */
+static inline bool zc_tensor_view_is_contiguous(const zc_tensor_view_t* view)
+{
+    int64_t expected = (int64_t)view->element_size;
+    uint32_t i = view->rank;
+    while (i-- > 0)
+    {
+        if (view->shape[i] != 1 && view->stride[i] != expected) return false;
+        expected *= (int64_t)view->shape[i];
+    }
+    return true;
+}
+
+/**
+ * @brief 以 FLOATTENSOR 变量的描述符建立覆盖整个张量的行主序视图。
+ *
+ * @param block    [in] 已 acquire 的块头指针。
+ * @param offset   [in] 变量的起始偏移，必须是已注册变量的首字节。
+ * @param out_view [out] 视图。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out_view 为空。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 变量不是 FLOATTENSOR。
+ * - ZC_INTERNAL_PARAM_ERROR: 阶数超过 ZC_TENSOR_MAX_RANK。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_DESC: 描述符截断，或张量大于变量宽度。
+ * - 其他: 由 zc_dtt_get_entry_by_data_offset / zc_type_get_tensor_element_size 透传的错误。
+ *
+ * @note 视图在调用者释放该块之前有效。
+ */
+zc_internal_result_t zc_tensor_view_init(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_tensor_view_t* out_view
+);
+
+/**
+ * @brief 把第 dim 维限制为 start, start + step, ..., 共 count 个下标。
+ *
+ * step 为负时沿该维反向。count 为 0 得到空视图。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: view 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: dim 越界、step 为 0，或所选下标超出该维。
+ */
+zc_internal_result_t zc_tensor_view_slice(
+    zc_tensor_view_t* view,
+    uint32_t dim,
+    uint64_t start,
+    uint64_t count,
+    int64_t step
+);
+
+/**
+ * @brief 固定第 dim 维的下标并去掉该维，阶数减 1。例如对二维张量选取第 1 维得到一列。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: view 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: dim 或 index 越界。
+ */
+zc_internal_result_t zc_tensor_view_select(
+    zc_tensor_view_t* view,
+    uint32_t dim,
+    uint64_t index
+);
+
+/**
+ * @brief 按 perm 重排各维：新视图的第 i 维为原视图的第 perm[i] 维。
+ *
+ * @param perm [in] 0 .. rank - 1 的一个排列，长度为 rank。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: view 为空，或 rank 非 0 而 perm 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: perm 不是排列。
+ */
+zc_internal_result_t zc_tensor_view_transpose(
+    zc_tensor_view_t* view,
+    const uint32_t* perm
+);
+
+/**
+ * @brief 把紧密排列的视图解释为新形状，元素个数必须不变。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: view 为空，或 rank 非 0 而 shape 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: rank 超过 ZC_TENSOR_MAX_RANK、元素个数不同，或视图不连续（先 gather）。
+ */
+zc_internal_result_t zc_tensor_view_reshape(
+    zc_tensor_view_t* view,
+    uint32_t rank,
+    const uint64_t* shape
+);
+
+/**
+ * @brief 读取一个元素。
+ *
+ * @param index       [in] 各维下标，长度为 rank。
+ * @param out_element [out] 至少 element_size 字节。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 下标越界。
+ * - 其他: 由 zc_block_read 透传的错误。
+ */
+zc_internal_result_t zc_tensor_view_read(
+    const zc_tensor_view_t* view,
+    const uint64_t* index,
+    void* out_element
+);
+
+/**
+ * @brief 按视图的行主序把全部元素拷贝为 dst 中的紧密数组。
+ *
+ * 末尾连续的若干维合并为一段整体拷贝；只取少数列时只读取这些列所在的字节，不加载整个张量。
+ * 同一页内的段直接由页地址拷贝，跨页的段按页分段读取。
+ *
+ * @param dst      [out] 目标缓冲。
+ * @param capacity [in] dst 的字节数，至少为元素个数 * element_size。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: view 为空，或视图非空而 dst 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: capacity 不足。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ * - 其他: 由 zc_block_read 透传的错误。
+ */
+zc_internal_result_t zc_tensor_view_gather(
+    const zc_tensor_view_t* view,
+    void* dst,
+    uint64_t capacity
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TENSOR_H */
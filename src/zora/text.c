@@ -0,0 +1,477 @@
+#include "text.h"
+#include <string.h>
+#include "simd.h"
+#include "dtta.h"
+#include "type_descriptor.h"
+#include "block_io.h"
+
+#define ZC_TXT_LANES8  (ZC_SIMD_VECTOR_BYTES / sizeof(uint8_t))
+#define ZC_TXT_LANES16 (ZC_SIMD_VECTOR_BYTES / sizeof(uint16_t))
+
+typedef uint8_t  zc_txt_u8v_t  __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef uint16_t zc_txt_u16v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef uint8_t  zc_txt_u8h_t  __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES / 2)));   // 与 zc_txt_u16v_t 通道数相同
+
+// 上述向量比较结果的掩码类型
+typedef int8_t  zc_txt_m8v_t  __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef int16_t zc_txt_m16v_t __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES)));
+typedef int8_t  zc_txt_m8h_t  __attribute__((vector_size(ZC_SIMD_VECTOR_BYTES / 2)));
+
+/**
+ * 比较结果掩码中是否有任一位被置位
+ */
+static inline bool zc_txt_mask_any(const void* mask, size_t bytes)
+{
+    uint64_t words[ZC_SIMD_VECTOR_BYTES / sizeof(uint64_t)];
+    memcpy(words, mask, bytes);
+
+    uint64_t any = 0;
+    uint32_t i;
+    for (i = 0; i < bytes / sizeof(uint64_t); i++) any |= words[i];
+    return any != 0;
+}
+
+// 块内 UTF-16 按小端存放，与主机字节序一致
+static inline uint16_t zc_txt_load16(const uint8_t* p)
+{
+    uint16_t u;
+    memcpy(&u, p, sizeof(u));
+    return u;
+}
+
+/**
+ * 从第 i 个单元取一个码位，返回占用的单元数；不成对的代理项返回 0
+ */
+static inline uint32_t zc_txt_utf16_step(const uint8_t* src, uint64_t i, uint64_t count, uint32_t* out_cp)
+{
+    uint32_t u = zc_txt_load16(src + 2 * i);
+    if ((u & 0xF800) != 0xD800)
+    {
+        if (out_cp) *out_cp = u;
+        return 1;
+    }
+    if (u >= 0xDC00 || i + 1 >= count) return 0;
+
+    uint32_t low = zc_txt_load16(src + 2 * i + 2);
+    if ((low & 0xFC00) != 0xDC00) return 0;
+    if (out_cp) *out_cp = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+    return 2;
+}
+
+/**
+ * 解码一个 UTF-8 序列，返回其字节数；过长编码、代理项、超出 U+10FFFF 与截断的序列返回 0
+ */
+static inline uint32_t zc_txt_utf8_decode(const uint8_t* s, uint64_t avail, uint32_t* out_cp)
+{
+    uint32_t c = s[0];
+    if (c < 0x80)
+    {
+        *out_cp = c;
+        return 1;
+    }
+    if (c < 0xC2) return 0;
+    if (c < 0xE0)
+    {
+        if (avail < 2 || (s[1] & 0xC0) != 0x80) return 0;
+        *out_cp = (c & 0x1F) << 6 | (s[1] & 0x3F);
+        return 2;
+    }
+    if (c < 0xF0)
+    {
+        if (avail < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80) return 0;
+        uint32_t cp = (c & 0x0F) << 12 | (uint32_t)(s[1] & 0x3F) << 6 | (s[2] & 0x3F);
+        if (cp < 0x800 || (cp & 0xF800) == 0xD800) return 0;
+        *out_cp = cp;
+        return 3;
+    }
+    if (c < 0xF5)
+    {
+        if (avail < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80) return 0;
+        uint32_t cp = (c & 0x07) << 18 | (uint32_t)(s[1] & 0x3F) << 12 | (uint32_t)(s[2] & 0x3F) << 6 | (s[3] & 0x3F);
+        if (cp < 0x10000 || cp > 0x10FFFF) return 0;
+        *out_cp = cp;
+        return 4;
+    }
+    return 0;
+}
+
+static inline void zc_txt_put_utf8(uint8_t* dst, uint32_t cp, uint32_t bytes)
+{
+    switch (bytes)
+    {
+        case 1:
+            dst[0] = (uint8_t)cp;
+            break;
+        case 2:
+            dst[0] = (uint8_t)(0xC0 | cp >> 6);
+            dst[1] = (uint8_t)(0x80 | (cp & 0x3F));
+            break;
+        case 3:
+            dst[0] = (uint8_t)(0xE0 | cp >> 12);
+            dst[1] = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+            dst[2] = (uint8_t)(0x80 | (cp & 0x3F));
+            break;
+        default:
+            dst[0] = (uint8_t)(0xF0 | cp >> 18);
+            dst[1] = (uint8_t)(0x80 | (cp >> 12 & 0x3F));
+            dst[2] = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+            dst[3] = (uint8_t)(0x80 | (cp & 0x3F));
+            break;
+    }
+}
+
+static inline void zc_txt_put_utf16(uint8_t* dst, uint32_t cp, uint32_t units)
+{
+    uint16_t u[2];
+    if (units == 1) u[0] = (uint16_t)cp;
+    else
+    {
+        u[0] = (uint16_t)(0xD800 + ((cp - 0x10000) >> 10));
+        u[1] = (uint16_t)(0xDC00 + ((cp - 0x10000) & 0x3FF));
+    }
+    memcpy(dst, u, units * sizeof(uint16_t));
+}
+
+#define ZC_TXT_LEVEL baseline
+#define ZC_TXT_ATTR
+#include "text_kernels.h"
+#undef ZC_TXT_ATTR
+#undef ZC_TXT_LEVEL
+
+#if ZC_SIMD_X86
+#define ZC_TXT_LEVEL sse42
+#define ZC_TXT_ATTR ZC_SIMD_TARGET_SSE42
+#include "text_kernels.h"
+#undef ZC_TXT_ATTR
+#undef ZC_TXT_LEVEL
+
+#define ZC_TXT_LEVEL avx2
+#define ZC_TXT_ATTR ZC_SIMD_TARGET_AVX2
+#include "text_kernels.h"
+#undef ZC_TXT_ATTR
+#undef ZC_TXT_LEVEL
+
+#define ZC_TXT_LEVEL avx512
+#define ZC_TXT_ATTR ZC_SIMD_TARGET_AVX512
+#include "text_kernels.h"
+#undef ZC_TXT_ATTR
+#undef ZC_TXT_LEVEL
+#endif
+
+typedef struct zc_text_kernels {
+    uint64_t (*ascii_prefix)(const uint8_t* src, uint64_t length);
+    uint64_t (*utf16_zero)(const uint8_t* src, uint64_t count);
+    uint64_t (*utf16_valid_prefix)(const uint8_t* src, uint64_t count);
+    uint64_t (*utf16_to_utf8)(const uint8_t* src, uint64_t count, uint8_t* dst, uint64_t capacity, uint64_t* out_written);
+    uint64_t (*utf8_utf16_units)(const uint8_t* src, uint64_t length, uint64_t* out_units);
+    uint64_t (*utf8_to_utf16)(const uint8_t* src, uint64_t length, uint8_t* dst, uint64_t capacity, uint64_t* out_written);
+} zc_text_kernels_t;
+
+#define ZC_TXT_ROW(level) {                                                                              \
+    zc_txt_ascii_prefix_##level, zc_txt_utf16_zero_##level, zc_txt_utf16_valid_prefix_##level,          \
+    zc_txt_utf16_to_utf8_##level, zc_txt_utf8_utf16_units_##level, zc_txt_utf8_to_utf16_##level }
+
+// 按 zc_simd_level_t 索引
+static const zc_text_kernels_t zc_text_kernel_table[ZC_SIMD_LEVEL_COUNT] = {
+    ZC_TXT_ROW(baseline),
+#if ZC_SIMD_X86
+    ZC_TXT_ROW(sse42),
+    ZC_TXT_ROW(avx2),
+    ZC_TXT_ROW(avx512),
+#else
+    ZC_TXT_ROW(baseline),
+    ZC_TXT_ROW(baseline),
+    ZC_TXT_ROW(baseline),
+#endif
+};
+
+#undef ZC_TXT_ROW
+
+static inline const zc_text_kernels_t* zc_text_kernels(void)
+{
+    return &zc_text_kernel_table[zc_simd_level()];
+}
+
+/**
+ * utf16_to_utf8 停在 stop 处的原因。final 为假时末尾孤立的高代理项留给下一批，视为成功
+ */
+static zc_internal_result_t zc_text_utf16_stop(const uint8_t* src, uint64_t stop, uint64_t count, bool final)
+{
+    if (stop == count) return ZC_INTERNAL_OK;
+
+    uint32_t u = zc_txt_load16(src + 2 * stop);
+    if ((u & 0xFC00) == 0xD800 && stop + 1 == count) return final ? ZC_INTERNAL_TYPE_ILLEGAL_TEXT : ZC_INTERNAL_OK;
+    return zc_txt_utf16_step(src, stop, count, NULL) == 0 ? ZC_INTERNAL_TYPE_ILLEGAL_TEXT : ZC_INTERNAL_PARAM_ERROR;
+}
+
+/**
+ * utf8_to_utf16 停在 stop 处的原因
+ */
+static zc_internal_result_t zc_text_utf8_stop(const uint8_t* src, uint64_t stop, uint64_t length)
+{
+    if (stop == length) return ZC_INTERNAL_OK;
+
+    uint32_t cp;
+    return zc_txt_utf8_decode(src + stop, length - stop, &cp) == 0 ? ZC_INTERNAL_TYPE_ILLEGAL_TEXT : ZC_INTERNAL_PARAM_ERROR;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_validate_ascii(const void* src, uint64_t length, uint64_t* out_error_index)
+{
+    if (length == 0)
+    {
+        if (out_error_index) *out_error_index = 0;
+        return ZC_INTERNAL_OK;
+    }
+    if (unlikely(!src)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t index = zc_text_kernels()->ascii_prefix(src, length);
+    if (out_error_index) *out_error_index = index;
+    return index == length ? ZC_INTERNAL_OK : ZC_INTERNAL_TYPE_ILLEGAL_TEXT;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_validate_utf16(const void* src, uint64_t count, uint64_t* out_error_index)
+{
+    if (count == 0)
+    {
+        if (out_error_index) *out_error_index = 0;
+        return ZC_INTERNAL_OK;
+    }
+    if (unlikely(!src)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t index = zc_text_kernels()->utf16_valid_prefix(src, count);
+    if (out_error_index) *out_error_index = index;
+    return index == count ? ZC_INTERNAL_OK : ZC_INTERNAL_TYPE_ILLEGAL_TEXT;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_utf16_to_utf8(const void* src, uint64_t count, uint8_t* dst, uint64_t capacity,
+    uint64_t* out_length)
+{
+    if (unlikely(!out_length || (count != 0 && !src) || (capacity != 0 && !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    *out_length = 0;
+    if (count == 0) return ZC_INTERNAL_OK;
+
+    uint64_t stop = zc_text_kernels()->utf16_to_utf8(src, count, dst, capacity, out_length);
+    return zc_text_utf16_stop(src, stop, count, true);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_utf8_to_utf16(const uint8_t* src, uint64_t length, void* dst, uint64_t capacity,
+    uint64_t* out_count)
+{
+    if (unlikely(!out_count || (length != 0 && !src) || (capacity != 0 && !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    *out_count = 0;
+    if (length == 0) return ZC_INTERNAL_OK;
+
+    uint64_t stop = zc_text_kernels()->utf8_to_utf16(src, length, dst, capacity, out_count);
+    return zc_text_utf8_stop(src, stop, length);
+}
+
+/**
+ * 由起始偏移找到字符串变量的类型码与字节宽度
+ */
+static zc_internal_result_t zc_text_resolve(zc_block_header_t* block, uint64_t offset, uint8_t* out_type,
+    uint64_t* out_width)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    uint8_t* desc;
+    uint64_t desc_len;
+    res = zc_dtt_get_desc_by_data_offset(block, offset, &desc, &desc_len, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (unlikely(!desc || desc_len == 0)) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+    if (desc[0] != ELEMENT_TYPE_STRING && desc[0] != ELEMENT_TYPE_ASCIISTRING) return ZC_INTERNAL_TYPE_ERROR;
+
+    *out_type = desc[0];
+    *out_width = entry->obj_width;
+    return ZC_INTERNAL_OK;
+}
+
+static inline bool zc_text_in_one_page(uint64_t offset, uint64_t length)
+{
+    return offset % ZC_PAGE_DATA_SIZE + length <= ZC_PAGE_DATA_SIZE;
+}
+
+/**
+ * 把 [offset, offset + length) 填 0
+ */
+static zc_internal_result_t zc_text_fill_zero(zc_block_header_t* block, uint64_t offset, uint64_t length)
+{
+    static const uint8_t zero[ZC_PAGE_DATA_SIZE];
+    while (length != 0)
+    {
+        uint64_t n = length < sizeof(zero) ? length : sizeof(zero);
+        zc_internal_result_t res = zc_block_write(block, offset, zero, n);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        offset += n;
+        length -= n;
+    }
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * ASCIISTRING 直接读入 dst 后就地校验
+ */
+static zc_internal_result_t zc_text_load_ascii(const zc_text_kernels_t* kernels, zc_block_header_t* block,
+    uint64_t offset, uint64_t width, uint8_t* dst, uint64_t capacity, uint64_t* out_length)
+{
+    uint64_t n = width < capacity ? width : capacity;
+    const uint8_t* nul = NULL;
+    zc_internal_result_t res;
+    if (n != 0)
+    {
+        res = zc_block_read(block, offset, dst, n);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        nul = memchr(dst, 0, n);
+    }
+    uint64_t length = nul ? (uint64_t)(nul - dst) : n;
+    if (!nul && n < width)
+    {
+        // dst 已满，之后还有内容时容量不足
+        uint8_t next;
+        res = zc_block_read(block, offset + n, &next, 1);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        if (next != 0) return ZC_INTERNAL_PARAM_ERROR;
+    }
+
+    if (kernels->ascii_prefix(dst, length) != length) return ZC_INTERNAL_TYPE_ILLEGAL_TEXT;
+    *out_length = length;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * STRING 在一页之内时直接转换，跨页时每批读入 ZC_TEXT_STAGE_UNITS 个单元
+ */
+static zc_internal_result_t zc_text_load_utf16(const zc_text_kernels_t* kernels, zc_block_header_t* block,
+    uint64_t offset, uint64_t width, uint8_t* dst, uint64_t capacity, uint64_t* out_length)
+{
+    uint64_t units = width / 2;
+    if (units == 0) return ZC_INTERNAL_OK;
+
+    if (zc_text_in_one_page(offset, units * 2))
+    {
+        const uint8_t* src = zc_block_offset_to_ptr(block, offset);
+        if (unlikely(!src)) return ZC_INTERNAL_RUN_PTRNULL;
+
+        uint64_t count = kernels->utf16_zero(src, units);
+        uint64_t stop = kernels->utf16_to_utf8(src, count, dst, capacity, out_length);
+        return zc_text_utf16_stop(src, stop, count, true);
+    }
+
+    uint8_t stage[ZC_TEXT_STAGE_UNITS * 2];
+    uint64_t written = 0;
+    uint64_t pos = 0;
+    zc_internal_result_t res = ZC_INTERNAL_OK;
+    while (pos < units)
+    {
+        uint64_t take = units - pos < ZC_TEXT_STAGE_UNITS ? units - pos : ZC_TEXT_STAGE_UNITS;
+        res = zc_block_read(block, offset + 2 * pos, stage, take * 2);
+        if (unlikely(res != ZC_INTERNAL_OK)) break;
+
+        uint64_t count = kernels->utf16_zero(stage, take);
+        bool final = count < take || pos + take == units;
+        uint64_t n;
+        uint64_t stop = kernels->utf16_to_utf8(stage, count, dst + written, capacity - written, &n);
+        written += n;
+
+        res = zc_text_utf16_stop(stage, stop, count, final);
+        if (res != ZC_INTERNAL_OK || final) break;
+
+        // 批末孤立的高代理项留到下一批重新读取
+        pos += stop;
+    }
+
+    *out_length = written;
+    return res;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_load_utf8(zc_block_header_t* block, uint64_t offset, uint8_t* dst, uint64_t capacity,
+    uint64_t* out_length)
+{
+    if (unlikely(!out_length || (capacity != 0 && !dst))) return ZC_INTERNAL_PARAM_PTRNULL;
+    *out_length = 0;
+
+    uint8_t type;
+    uint64_t width;
+    zc_internal_result_t res = zc_text_resolve(block, offset, &type, &width);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    const zc_text_kernels_t* kernels = zc_text_kernels();
+    if (type == ELEMENT_TYPE_ASCIISTRING) return zc_text_load_ascii(kernels, block, offset, width, dst, capacity, out_length);
+    return zc_text_load_utf16(kernels, block, offset, width, dst, capacity, out_length);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_text_store_utf8(zc_block_header_t* block, uint64_t offset, const uint8_t* src,
+    uint64_t length)
+{
+    if (unlikely(length != 0 && !src)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint8_t type;
+    uint64_t width;
+    zc_internal_result_t res = zc_text_resolve(block, offset, &type, &width);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    const zc_text_kernels_t* kernels = zc_text_kernels();
+    if (type == ELEMENT_TYPE_ASCIISTRING)
+    {
+        if (length != 0 && kernels->ascii_prefix(src, length) != length) return ZC_INTERNAL_TYPE_ILLEGAL_TEXT;
+        if (length > width) return ZC_INTERNAL_PARAM_ERROR;
+
+        res = zc_block_write(block, offset, src, length);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        return zc_text_fill_zero(block, offset + length, width - length);
+    }
+
+    // 先整体校验并确认容量，出错时不改动变量
+    uint64_t units = width / 2;
+    uint64_t need = 0;
+    if (length != 0 && kernels->utf8_utf16_units(src, length, &need) != length) return ZC_INTERNAL_TYPE_ILLEGAL_TEXT;
+    if (need > units) return ZC_INTERNAL_PARAM_ERROR;
+
+    uint64_t written = 0;
+    if (units != 0 && zc_text_in_one_page(offset, units * 2))
+    {
+        uint8_t* dst = zc_block_offset_to_ptr(block, offset);
+        if (unlikely(!dst)) return ZC_INTERNAL_RUN_PTRNULL;
+
+        if (length != 0) kernels->utf8_to_utf16(src, length, dst, units, &written);
+        memset(dst + 2 * written, 0, (units - written) * 2);
+        return ZC_INTERNAL_OK;
+    }
+
+    uint8_t stage[ZC_TEXT_STAGE_UNITS * 2];
+    uint64_t pos = 0;
+    uint64_t consumed = 0;
+    while (consumed < length)
+    {
+        // 已确认放得下，每批只可能因缓冲已满而停止
+        consumed += kernels->utf8_to_utf16(src + consumed, length - consumed, stage, ZC_TEXT_STAGE_UNITS, &written);
+        res = zc_block_write(block, offset + 2 * pos, stage, written * 2);
+        if (unlikely(res != ZC_INTERNAL_OK)) return res;
+        pos += written;
+    }
+
+    return zc_text_fill_zero(block, offset + 2 * pos, (units - pos) * 2);
+}
@@ -0,0 +1,160 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// UTF-16 单元数为 count 的文本转为 UTF-8 后的最大字节数（代理对 2 个单元对应 4 字节）
+#define ZC_TEXT_UTF8_MAX_BYTES(count) ((count) * 3)
+
+// 跨页字符串经栈上缓冲分批转换，每批的 UTF-16 单元数
+#ifndef ZC_TEXT_STAGE_UNITS
+#define ZC_TEXT_STAGE_UNITS 256
+#endif
+
+/**
+ * @brief 检查 src 的 length 字节是否都是 7 bit ASCII。
+ *
+ * @param out_error_index [out] 首个非 ASCII 字节的下标，全部合法时为 length。可为 NULL。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 全部合法。
+ * - ZC_INTERNAL_PARAM_PTRNULL: length 非 0 而 src 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: 存在最高位为 1 的字节。
+ */
+zc_internal_result_t zc_text_validate_ascii(
+    const void* src,
+    uint64_t length,
+    uint64_t* out_error_index
+);
+
+/**
+ * @brief 检查 count 个 UTF-16LE 单元的代理项是否成对。
+ *
+ * 高代理项（D800–DBFF）必须紧跟低代理项（DC00–DFFF），低代理项不能单独出现。src 不要求对齐。
+ *
+ * @param out_error_index [out] 首个非法单元的下标，全部合法时为 count。可为 NULL。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 全部合法。
+ * - ZC_INTERNAL_PARAM_PTRNULL: count 非 0 而 src 为空。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: 存在不成对的代理项。
+ */
+zc_internal_result_t zc_text_validate_utf16(
+    const void* src,
+    uint64_t count,
+    uint64_t* out_error_index
+);
+
+/**
+ * @brief 把 count 个 UTF-16LE 单元转为 UTF-8，不写结尾的 0。
+ *
+ * 整组 ASCII 单元以向量收窄，其余逐字符编码。capacity 不小于 ZC_TEXT_UTF8_MAX_BYTES(count) 时不会因空间不足失败。
+ *
+ * @param dst        [out] 目标缓冲。
+ * @param capacity   [in] dst 的字节数。
+ * @param out_length [out] 写入的字节数；出错时为出错位置之前已写入的字节数。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_PARAM_ERROR: capacity 不足。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: 存在不成对的代理项。
+ */
+zc_internal_result_t zc_text_utf16_to_utf8(
+    const void* src,
+    uint64_t count,
+    uint8_t* dst,
+    uint64_t capacity,
+    uint64_t* out_length
+);
+
+/**
+ * @brief 把 length 字节的 UTF-8 转为 UTF-16LE。
+ *
+ * 拒绝过长编码、代理项码位、超过 U+10FFFF 的码位与截断的序列。整组 ASCII 字节以向量加宽，其余逐字符解码。
+ * dst 不要求对齐；capacity 不小于 length 时不会因空间不足失败。
+ *
+ * @param capacity  [in] dst 可容纳的 UTF-16 单元数。
+ * @param out_count [out] 写入的单元数；出错时为出错位置之前已写入的单元数。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_PARAM_ERROR: capacity 不足。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: 非法的 UTF-8。
+ */
+zc_internal_result_t zc_text_utf8_to_utf16(
+    const uint8_t* src,
+    uint64_t length,
+    void* dst,
+    uint64_t capacity,
+    uint64_t* out_count
+);
+
+/**
+ * @brief 以 UTF-8 读出 STRING 或 ASCIISTRING 变量，同时校验其内容。
+ *
+ * 变量宽度即其容量，内容在首个 0 单元（ASCIISTRING 为 0 字节）处结束，没有 0 时占满整个变量。
+ * STRING 整体位于一页之内时直接由块内地址转换，跨页时经栈上缓冲分批读取。
+ *
+ * @param block      [in] 已 acquire 的块头指针。
+ * @param offset     [in] 变量的起始偏移，必须是已注册变量的首字节。
+ * @param dst        [out] 目标缓冲，不写结尾的 0。
+ * @param capacity   [in] dst 的字节数。
+ * @param out_length [out] 写入的字节数。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 参数为空。
+ * - ZC_INTERNAL_PARAM_ERROR: capacity 不足。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 变量不是 STRING / ASCIISTRING。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: 内容不是合法的 UTF-16 / ASCII。
+ * - 其他: 由 DTTA 查询或 zc_block_read 透传的错误。
+ */
+zc_internal_result_t zc_text_load_utf8(
+    zc_block_header_t* block,
+    uint64_t offset,
+    uint8_t* dst,
+    uint64_t capacity,
+    uint64_t* out_length
+);
+
+/**
+ * @brief 把 UTF-8 文本转换后写入 STRING 或 ASCIISTRING 变量，剩余容量填 0。
+ *
+ * 先整体校验文本并确认转换后放得下，再写入：ASCIISTRING 只接受 ASCII 文本，
+ * STRING 先统计所需的 UTF-16 单元数。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: length 非 0 而 src 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: 转换后超出变量容量。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_TYPE_ERROR: 变量不是 STRING / ASCIISTRING。
+ * - ZC_INTERNAL_TYPE_ILLEGAL_TEXT: src 不是合法的 UTF-8，或写入 ASCIISTRING 的文本含非 ASCII 字符。
+ * - 其他: 由 DTTA 查询或 zc_block_write 透传的错误。
+ *
+ * @note 修改块内数据，只能由持有该块的写入者在提交前调用。校验或容量出错时变量内容不变。
+ */
+zc_internal_result_t zc_text_store_utf8(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const uint8_t* src,
+    uint64_t length
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEXT_H */
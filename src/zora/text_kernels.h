@@ -0,0 +1,219 @@
+/*
+*/
+/**
+ * 文本校验与转码内核模板，由 text.c 在每个指令集级别下各包含一次，不设包含保护。
+ *
+ * 包含前需定义：
+ * - ZC_TXT_LEVEL: 函数名后缀，如 avx2
+ * - ZC_TXT_ATTR:  该级别的 target 属性，基线级别为空
+ *
+ * 按组检查：一组全为 ASCII（或不含代理项）时整组处理，否则逐字符处理到该组末尾再回到整组检查。
+ * 非对齐读取经 memcpy 完成。
+ */
+
+#define ZC_TXT_PASTE_(a, b) zc_txt_##a##_##b
+#define ZC_TXT_PASTE(a, b) ZC_TXT_PASTE_(a, b)
+#define ZC_TXT_FN(name) ZC_TXT_PASTE(name, ZC_TXT_LEVEL)
+
+/**
+ * 首个最高位为 1 的字节的下标
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(ascii_prefix)(const uint8_t* src, uint64_t length)
+{
+    uint64_t i = 0;
+    for (; i + ZC_TXT_LANES8 <= length; i += ZC_TXT_LANES8)
+    {
+        zc_txt_u8v_t v;
+        memcpy(&v, src + i, sizeof(v));
+        zc_txt_m8v_t high = v >= 0x80;
+        if (zc_txt_mask_any(&high, sizeof(high))) break;
+    }
+    for (; i < length; i++)
+    {
+        if (src[i] >= 0x80) return i;
+    }
+    return length;
+}
+
+/**
+ * 首个 0 单元的下标
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(utf16_zero)(const uint8_t* src, uint64_t count)
+{
+    uint64_t i = 0;
+    for (; i + ZC_TXT_LANES16 <= count; i += ZC_TXT_LANES16)
+    {
+        zc_txt_u16v_t v;
+        memcpy(&v, src + 2 * i, sizeof(v));
+        zc_txt_m16v_t zero = v == 0;
+        if (zc_txt_mask_any(&zero, sizeof(zero))) break;
+    }
+    for (; i < count; i++)
+    {
+        if (zc_txt_load16(src + 2 * i) == 0) return i;
+    }
+    return count;
+}
+
+/**
+ * 首个不成对代理项的下标
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(utf16_valid_prefix)(const uint8_t* src, uint64_t count)
+{
+    uint64_t i = 0;
+    while (i < count)
+    {
+        if (i + ZC_TXT_LANES16 <= count)
+        {
+            zc_txt_u16v_t v;
+            memcpy(&v, src + 2 * i, sizeof(v));
+            zc_txt_m16v_t surrogate = (v & 0xF800) == 0xD800;
+            if (!zc_txt_mask_any(&surrogate, sizeof(surrogate)))
+            {
+                i += ZC_TXT_LANES16;
+                continue;
+            }
+        }
+
+        // 代理对可能越过组末尾，逐单元处理时以整个输入为界
+        uint64_t end = count - i < ZC_TXT_LANES16 ? count : i + ZC_TXT_LANES16;
+        while (i < end)
+        {
+            uint32_t n = zc_txt_utf16_step(src, i, count, NULL);
+            if (n == 0) return i;
+            i += n;
+        }
+    }
+    return count;
+}
+
+/**
+ * UTF-16LE → UTF-8。在不成对的代理项、末尾孤立的高代理项或空间不足处停止，返回已消耗的单元数
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(utf16_to_utf8)(const uint8_t* src, uint64_t count, uint8_t* dst,
+    uint64_t capacity, uint64_t* out_written)
+{
+    uint64_t i = 0;
+    uint64_t o = 0;
+    while (i < count)
+    {
+        if (i + ZC_TXT_LANES16 <= count && capacity - o >= ZC_TXT_LANES16)
+        {
+            zc_txt_u16v_t v;
+            memcpy(&v, src + 2 * i, sizeof(v));
+            zc_txt_m16v_t wide = v >= 0x80;
+            if (!zc_txt_mask_any(&wide, sizeof(wide)))
+            {
+                zc_txt_u8h_t narrow = __builtin_convertvector(v, zc_txt_u8h_t);
+                memcpy(dst + o, &narrow, sizeof(narrow));
+                i += ZC_TXT_LANES16;
+                o += ZC_TXT_LANES16;
+                continue;
+            }
+        }
+
+        uint64_t end = count - i < ZC_TXT_LANES16 ? count : i + ZC_TXT_LANES16;
+        while (i < end)
+        {
+            uint32_t cp = 0;
+            uint32_t n = zc_txt_utf16_step(src, i, count, &cp);
+            uint32_t bytes = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+            if (n == 0 || capacity - o < bytes) goto done;
+
+            zc_txt_put_utf8(dst + o, cp, bytes);
+            i += n;
+            o += bytes;
+        }
+    }
+
+done:
+    *out_written = o;
+    return i;
+}
+
+/**
+ * 校验 UTF-8 并统计转换为 UTF-16 所需的单元数。在首个非法或截断的序列处停止，返回已校验的字节数
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(utf8_utf16_units)(const uint8_t* src, uint64_t length, uint64_t* out_units)
+{
+    uint64_t i = 0;
+    uint64_t o = 0;
+    while (i < length)
+    {
+        if (i + ZC_TXT_LANES8 <= length)
+        {
+            zc_txt_u8v_t v;
+            memcpy(&v, src + i, sizeof(v));
+            zc_txt_m8v_t high = v >= 0x80;
+            if (!zc_txt_mask_any(&high, sizeof(high)))
+            {
+                i += ZC_TXT_LANES8;
+                o += ZC_TXT_LANES8;
+                continue;
+            }
+        }
+
+        uint64_t end = length - i < ZC_TXT_LANES8 ? length : i + ZC_TXT_LANES8;
+        while (i < end)
+        {
+            uint32_t cp = 0;
+            uint32_t n = zc_txt_utf8_decode(src + i, length - i, &cp);
+            if (n == 0) goto done;
+
+            i += n;
+            o += cp < 0x10000 ? 1 : 2;
+        }
+    }
+
+done:
+    *out_units = o;
+    return i;
+}
+
+/**
+ * UTF-8 → UTF-16LE。在非法或截断的序列、空间不足处停止（不拆开代理对），返回已消耗的字节数
+ */
+ZC_TXT_ATTR static uint64_t ZC_TXT_FN(utf8_to_utf16)(const uint8_t* src, uint64_t length, uint8_t* dst,
+    uint64_t capacity, uint64_t* out_written)
+{
+    uint64_t i = 0;
+    uint64_t o = 0;
+    while (i < length)
+    {
+        if (i + ZC_TXT_LANES16 <= length && capacity - o >= ZC_TXT_LANES16)
+        {
+            zc_txt_u8h_t v;
+            memcpy(&v, src + i, sizeof(v));
+            zc_txt_m8h_t high = v >= 0x80;
+            if (!zc_txt_mask_any(&high, sizeof(high)))
+            {
+                zc_txt_u16v_t wide = __builtin_convertvector(v, zc_txt_u16v_t);
+                memcpy(dst + 2 * o, &wide, sizeof(wide));
+                i += ZC_TXT_LANES16;
+                o += ZC_TXT_LANES16;
+                continue;
+            }
+        }
+
+        uint64_t end = length - i < ZC_TXT_LANES16 ? length : i + ZC_TXT_LANES16;
+        while (i < end)
+        {
+            uint32_t cp = 0;
+            uint32_t n = zc_txt_utf8_decode(src + i, length - i, &cp);
+            uint32_t units = cp < 0x10000 ? 1 : 2;
+            if (n == 0 || capacity - o < units) goto done;
+
+            zc_txt_put_utf16(dst + 2 * o, cp, units);
+            i += n;
+            o += units;
+        }
+    }
+
+done:
+    *out_written = o;
+    return i;
+}
+
+#undef ZC_TXT_FN
+#undef ZC_TXT_PASTE
+#undef ZC_TXT_PASTE_
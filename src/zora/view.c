@@ -0,0 +1,87 @@
+#include "view.h"
+#include "dtta.h"
+
+/**
+ * 由起始偏移找到变量的字节宽度
+ */
+static zc_internal_result_t zc_view_find(zc_block_header_t* block, uint64_t offset, uint64_t* out_length)
+{
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    zc_internal_result_t res = zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset);
+    if (unlikely(res != ZC_INTERNAL_OK)) return res;
+    if (entry == NULL || obj_offset != offset) return ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND;
+
+    *out_length = entry->obj_width;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_view_get(zc_block_header_t* block, uint64_t offset, const void** out_data,
+    uint64_t* out_length)
+{
+    if (unlikely(!out_data || !out_length)) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t length;
+    zc_internal_result_t res = zc_view_find(block, offset, &length);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    *out_length = length;
+    if (zc_view_segment_count(offset, length) > 1)
+    {
+        *out_data = NULL;
+        return ZC_INTERNAL_OK;
+    }
+
+    const void* data = zc_block_offset_to_ptr(block, offset);
+    if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    *out_data = data;
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zc_view_get_segments(zc_block_header_t* block, uint64_t offset, zc_view_segment_t* segments,
+    uint32_t capacity, uint32_t* out_count, uint64_t* out_length)
+{
+    if (unlikely(!out_count || (capacity != 0 && !segments))) return ZC_INTERNAL_PARAM_PTRNULL;
+
+    uint64_t length;
+    zc_internal_result_t res = zc_view_find(block, offset, &length);
+    if (res != ZC_INTERNAL_OK) return res;
+
+    uint64_t count = zc_view_segment_count(offset, length);
+    *out_count = (uint32_t)count;
+    if (out_length) *out_length = length;
+    if (unlikely(count > capacity)) return ZC_INTERNAL_PARAM_ERROR;
+
+    // 只有首段按偏移定位，之后沿页尾链接逐页前进
+    uint8_t* data = zc_block_offset_to_ptr(block, offset);
+    if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+
+    uint64_t i;
+    for (i = 0; i < count; i++)
+    {
+        uint64_t in_page = ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+        uint64_t n = in_page < length ? in_page : length;
+
+        segments[i].base = data;
+        segments[i].length = n;
+        offset += n;
+        length -= n;
+
+        if (i + 1 < count)
+        {
+            zc_page_t* page = (zc_page_t*)(data + n - ZC_PAGE_DATA_SIZE - ZC_PAGE_HEADER_SIZE);
+            zc_page_t* next = (zc_page_t*)(uintptr_t)page->tail.next_page_addr;
+            data = next ? (uint8_t*)next->data : zc_block_offset_to_ptr(block, offset);
+            if (unlikely(!data)) return ZC_INTERNAL_RUN_PTRNULL;
+        }
+    }
+
+    return ZC_INTERNAL_OK;
+}
@@ -0,0 +1,93 @@
+/*
+*/
+#pragma once
+
+#include "zerocore_internal.h"
+#include "block.h"
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 只读视图的一个连续段，与 struct iovec 的布局相同
+ */
+typedef struct zc_view_segment {
+    const void* base;
+    uint64_t    length;
+} zc_view_segment_t;
+
+/**
+ * @brief 用户数据区 [offset, offset + length) 在块内被页边界切成的段数。
+ */
+static inline uint64_t zc_view_segment_count(uint64_t offset, uint64_t length)
+{
+    if (length == 0) return 0;
+    return (offset + length - 1) / ZC_PAGE_DATA_SIZE - offset / ZC_PAGE_DATA_SIZE + 1;
+}
+
+/**
+ * @brief 借出变量的块内地址，不拷贝数据。
+ *
+ * 变量整体位于一页之内时 *out_data 为其块内地址；跨越页边界时 *out_data 为 NULL，
+ * 调用者改用 zc_view_get_segments 取得分段。两种情况下 *out_length 都是变量的字节宽度。
+ *
+ * @param block      [in] 已 acquire 的块头指针。
+ * @param offset     [in] 变量的起始偏移，必须是已注册变量的首字节。
+ * @param out_data   [out] 变量的块内只读地址，或 NULL。
+ * @param out_length [out] 变量的字节宽度。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功（包括跨页时返回 NULL）。
+ * - ZC_INTERNAL_PARAM_PTRNULL: 输出参数为空。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ * - 其他: 由 zc_dtt_get_entry_by_data_offset 透传的错误。
+ *
+ * @note 返回的地址在调用者释放该块（读取者为 zc_release_block_from_reading_epoch）之前有效，不应被缓存。
+ */
+zc_internal_result_t zc_view_get(
+    zc_block_header_t* block,
+    uint64_t offset,
+    const void** out_data,
+    uint64_t* out_length
+);
+
+/**
+ * @brief 以 iovec 形式借出变量的全部字节，每段对应变量在一页内的部分。
+ *
+ * 段的个数为 zc_view_segment_count(offset, 变量宽度)，变量位于一页之内时只有一段。
+ * *out_count 总是写入所需段数；capacity 不足时不写 segments。
+ *
+ * @param segments   [out] 段数组，按数据顺序排列。
+ * @param capacity   [in] segments 的容量。
+ * @param out_count  [out] 所需段数。
+ * @param out_length [out] 变量的字节宽度，可为 NULL。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_PTRNULL: out_count 为空，或 capacity 非 0 而 segments 为空。
+ * - ZC_INTERNAL_PARAM_ERROR: capacity 小于所需段数。
+ * - ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND: offset 不是已注册变量的起始偏移。
+ * - ZC_INTERNAL_RUN_PTRNULL: 偏移转换失败。
+ * - 其他: 由 zc_dtt_get_entry_by_data_offset 透传的错误。
+ *
+ * @note 生命周期同 zc_view_get。
+ */
+zc_internal_result_t zc_view_get_segments(
+    zc_block_header_t* block,
+    uint64_t offset,
+    zc_view_segment_t* segments,
+    uint32_t capacity,
+    uint32_t* out_count,
+    uint64_t* out_length
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VIEW_H */
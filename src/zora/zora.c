@@ -0,0 +1,134 @@
+#include "zora.h"
+
+_Thread_local zora_thread_cache_t zora_tls_cache;
+
+// 仅用于注册、注销和投递密钥，加解密路径不访问。信箱静态分配，生命周期与进程相同
+static zora_key_mailbox_t g_thread_cache_pool[ZC_MAX_WRITERS][ZC_MAX_READERS_PER + 1];
+
+static zc_internal_result_t zora_register_cache(zora_key_mailbox_t* mailbox,
+    int16_t thread_state, void* workspace, uint64_t key)
+{
+    zora_thread_cache_t* cache = &zora_tls_cache;
+    if (cache->magic == ZORA_CACHE_MAGIC && cache->thread_state != ZORA_THREAD_UNREGISTERED) return ZC_INTERNAL_PARAM_ERROR;
+
+    bool expected = false;
+    if (!atomic_compare_exchange_strong_explicit(&mailbox->registered, &expected, true,
+        memory_order_acq_rel, memory_order_relaxed))
+    {
+        return ZC_INTERNAL_PARAM_ERROR;
+    }
+
+    // 丢弃上一个注册者未取走的密钥
+    atomic_store_explicit(&mailbox->pending_key, 0, memory_order_relaxed);
+
+    cache->encryption_key = key;
+    cache->thread_state = thread_state;
+    cache->current_version = 0;
+    cache->magic = ZORA_CACHE_MAGIC;
+    cache->workspace = workspace;
+    cache->mailbox = mailbox;
+
+    return ZC_INTERNAL_OK;
+}
+
+static zc_internal_result_t zora_unregister_cache(zora_key_mailbox_t* mailbox)
+{
+    zora_thread_cache_t* cache = &zora_tls_cache;
+    if (cache->mailbox != mailbox) return ZC_INTERNAL_PARAM_ERROR;
+
+    cache->thread_state = ZORA_THREAD_UNREGISTERED;
+    cache->encryption_key = 0;
+    cache->workspace = NULL;
+    cache->mailbox = NULL;
+
+    atomic_store_explicit(&mailbox->registered, false, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+static zc_internal_result_t zora_post_key(zora_key_mailbox_t* mailbox, uint64_t key)
+{
+    if (unlikely(key == 0)) return ZC_INTERNAL_PARAM_ERROR;
+    if (!atomic_load_explicit(&mailbox->registered, memory_order_acquire)) return ZC_INTERNAL_RUN_NOT_INITIALIZED;
+
+    // 信箱只有一个原子字，重复投递时以最后一次为准
+    atomic_store_explicit(&mailbox->pending_key, key, memory_order_release);
+
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_register_writer(zc_writer_id_t writer_id,
+    void* workspace, uint64_t key)
+{
+    if (unlikely(writer_id >= ZC_MAX_WRITERS)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_internal_result_t result = zora_register_cache(&g_thread_cache_pool[writer_id][0],
+        ZORA_THREAD_WRITER, workspace, key);
+    if (result == ZC_INTERNAL_OK) zora_tls_cache.thread_id.writer_id = writer_id;
+
+    return result;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_register_reader(zc_reader_id_t reader_id,
+    void* workspace, uint64_t key)
+{
+    zc_writer_id_t writer_id = (zc_writer_id_t)(reader_id >> 32);
+    uint32_t reader_idx = (uint32_t)reader_id;
+    if (unlikely(writer_id >= ZC_MAX_WRITERS || reader_idx >= ZC_MAX_READERS_PER)) return ZC_INTERNAL_PARAM_ERROR;
+
+    zc_internal_result_t result = zora_register_cache(&g_thread_cache_pool[writer_id][reader_idx + 1],
+        ZORA_THREAD_READER, workspace, key);
+    if (result == ZC_INTERNAL_OK) zora_tls_cache.thread_id.reader_id = reader_id;
+
+    return result;
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_unregister_writer(zc_writer_id_t writer_id)
+{
+    if (unlikely(writer_id >= ZC_MAX_WRITERS)) return ZC_INTERNAL_PARAM_ERROR;
+
+    return zora_unregister_cache(&g_thread_cache_pool[writer_id][0]);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_unregister_reader(zc_reader_id_t reader_id)
+{
+    zc_writer_id_t writer_id = (zc_writer_id_t)(reader_id >> 32);
+    uint32_t reader_idx = (uint32_t)reader_id;
+    if (unlikely(writer_id >= ZC_MAX_WRITERS || reader_idx >= ZC_MAX_READERS_PER)) return ZC_INTERNAL_PARAM_ERROR;
+
+    return zora_unregister_cache(&g_thread_cache_pool[writer_id][reader_idx + 1]);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_post_key_to_writer(zc_writer_id_t writer_id, uint64_t key)
+{
+    if (unlikely(writer_id >= ZC_MAX_WRITERS)) return ZC_INTERNAL_PARAM_ERROR;
+
+    return zora_post_key(&g_thread_cache_pool[writer_id][0], key);
+}
+
+/**
+ *
+ */
+zc_internal_result_t zora_post_key_to_reader(zc_reader_id_t reader_id, uint64_t key)
+{
+    zc_writer_id_t writer_id = (zc_writer_id_t)(reader_id >> 32);
+    uint32_t reader_idx = (uint32_t)reader_id;
+    if (unlikely(writer_id >= ZC_MAX_WRITERS || reader_idx >= ZC_MAX_READERS_PER)) return ZC_INTERNAL_PARAM_ERROR;
+
+    return zora_post_key(&g_thread_cache_pool[writer_id][reader_idx + 1], key);
+}
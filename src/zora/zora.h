@@ -0,0 +1,165 @@
+/*
+*/
+#pragma once
+
+#include <stdatomic.h>
+#include "zerocore_internal.h"
+#include "handle.h"
+
+#ifndef ZORA_H
+#define ZORA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZORA_CACHE_MAGIC   0x5A4F5241U   // "ZORA"
+#define ZORA_ADDRESS_MASK  ((1ULL << 60) - 1)
+#define ZORA_VERSION_MASK  0xFU
+
+typedef enum zora_thread_state {
+    ZORA_THREAD_UNREGISTERED = 0,
+    ZORA_THREAD_WRITER       = 1,
+    ZORA_THREAD_READER       = 2,
+} zora_thread_state_t;
+
+/**
+ * 密钥轮换信箱，每个写入者 / 读取者槽位一个，静态分配。
+ * 清理者只写信箱，不接触线程本地缓存，因此目标线程退出后投递也不会访问已释放的 TLS。
+ */
+typedef struct zora_key_mailbox {
+    _Alignas(ZC_HW_CACHE_LINE_SIZE) _Atomic uint64_t pending_key;   // 待生效的新密钥，0 表示信箱为空
+    _Atomic bool registered;                                        // 槽位已被某个线程注册
+} zora_key_mailbox_t;
+
+/**
+ * Zora 线程本地缓存。
+ * 只由所属线程读写，句柄加解密只访问这一条缓存行；
+ * 新密钥由清理者投递到 mailbox 指向的静态信箱，本线程在 commit / cancel / release 时取走。
+ */
+typedef struct zora_thread_cache {
+    uint64_t  encryption_key;   // 当前线程加密密钥
+    int16_t   thread_state;     // 当前线程状态 zora_thread_state_t
+    uint16_t  current_version;  // 当前版本号，句柄中只保存低 4 位
+    uint32_t  magic;            // ZORA_CACHE_MAGIC 表示已初始化
+    void*     workspace;        // 指向线程工作空间 (zc_writer_workspace_t / zc_reader_workspace_t)
+    union {
+        zc_writer_id_t writer_id;
+        zc_reader_id_t reader_id;
+    } thread_id;                // 线程 ID
+    zora_key_mailbox_t* mailbox; // 本线程槽位的密钥信箱，未注册时为 NULL
+} zora_thread_cache_t;
+
+extern _Thread_local zora_thread_cache_t zora_tls_cache;
+
+/**
+ * @brief 为当前线程注册写入者 / 读取者的 Zora 缓存。
+ *
+ * 初始化当前线程的 TLS 缓存，并登记到 g_thread_cache_pool，供清理者投递新密钥。
+ * 在 zc_writer_register / zc_reader_register 中由注册线程调用。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: ID 越界、ID 已被注册或当前线程已注册为其他身份。
+ */
+zc_internal_result_t zora_register_writer(
+    zc_writer_id_t writer_id,
+    void* workspace,
+    uint64_t key
+);
+
+zc_internal_result_t zora_register_reader(
+    zc_reader_id_t reader_id,
+    void* workspace,
+    uint64_t key
+);
+
+zc_internal_result_t zora_unregister_writer(
+    zc_writer_id_t writer_id
+);
+
+zc_internal_result_t zora_unregister_reader(
+    zc_reader_id_t reader_id
+);
+
+/**
+ * @brief 向目标线程投递新密钥（清理者调用）。
+ *
+ * 只写目标槽位的静态信箱，不打断目标线程；新密钥在目标线程下一次 zora_tls_advance 时生效。
+ * 多次投递时以最后一次为准。
+ *
+ * @return
+ * - ZC_INTERNAL_OK: 成功。
+ * - ZC_INTERNAL_PARAM_ERROR: ID 越界，或 key 为 0（0 表示信箱为空）。
+ * - ZC_INTERNAL_RUN_NOT_INITIALIZED: 目标线程未注册。
+ */
+zc_internal_result_t zora_post_key_to_writer(
+    zc_writer_id_t writer_id,
+    uint64_t key
+);
+
+zc_internal_result_t zora_post_key_to_reader(
+    zc_reader_id_t reader_id,
+    uint64_t key
+);
+
+static inline bool zora_tls_is_writer(zc_writer_id_t writer_id)
+{
+    return zora_tls_cache.thread_state == ZORA_THREAD_WRITER && zora_tls_cache.thread_id.writer_id == writer_id;
+}
+
+static inline bool zora_tls_is_reader(zc_reader_id_t reader_id)
+{
+    return zora_tls_cache.thread_state == ZORA_THREAD_READER && zora_tls_cache.thread_id.reader_id == reader_id;
+}
+
+/**
+ * 以当前线程的密钥和版本号加密块 Header 地址。只访问 TLS。
+ */
+static inline void zora_tls_encode(void* block_header_ptr, zc_handle_t* out_handle)
+{
+    uint64_t key = zora_tls_cache.encryption_key;
+    out_handle->address = ((uint64_t)block_header_ptr ^ key) & ZORA_ADDRESS_MASK;
+    out_handle->version = (zora_tls_cache.current_version ^ (key >> 60)) & ZORA_VERSION_MASK;
+}
+
+/**
+ * 以当前线程的密钥和版本号解密句柄。只访问 TLS。
+ */
+static inline zc_internal_result_t zora_tls_decode(zc_handle_t handle, void** out_block_header_ptr)
+{
+    uint64_t key = zora_tls_cache.encryption_key;
+    if (unlikely(((handle.version ^ (key >> 60)) & ZORA_VERSION_MASK) != (zora_tls_cache.current_version & ZORA_VERSION_MASK)))
+    {
+        return ZC_INTERNAL_ZORA_UNEXPECTVERSION;
+    }
+
+    *out_block_header_ptr = (void*)((handle.address ^ key) & ZORA_ADDRESS_MASK);
+    return ZC_INTERNAL_OK;
+}
+
+/**
+ * 在 commit / cancel / release 时调用：版本号 +1 使旧句柄失效，并取走信箱中的新密钥。
+ * 返回是否发生了密钥轮换。
+ */
+static inline bool zora_tls_advance(void)
+{
+    zora_tls_cache.current_version++;
+
+    zora_key_mailbox_t* mailbox = zora_tls_cache.mailbox;
+    if (unlikely(mailbox == NULL)) return false;
+    if (likely(atomic_load_explicit(&mailbox->pending_key, memory_order_relaxed) == 0)) return false;
+
+    // 取走与清空是同一次原子操作，其间投递的新密钥不会被覆盖丢失
+    uint64_t key = atomic_exchange_explicit(&mailbox->pending_key, 0, memory_order_acquire);
+    if (unlikely(key == 0)) return false;
+
+    zora_tls_cache.encryption_key = key;
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZORA_H */
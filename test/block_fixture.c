@@ -0,0 +1,63 @@
+#include "block_fixture.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+
+static zc_block_header_t header;
+static zc_page_t* pages;
+
+/**
+ *
+ */
+zc_block_header_t* zc_test_block_setup_pages(uint64_t page_count, bool shuffled, bool linked)
+{
+    pages = calloc(page_count, sizeof(zc_page_t));
+    uint32_t* page_map = malloc(page_count * sizeof(uint32_t));
+    assert(pages != NULL && page_map != NULL);
+
+    uint64_t i;
+    for (i = 0; i < page_count; i++) page_map[i] = (uint32_t)i;
+    if (shuffled)
+    {
+        for (i = page_count - 1; i > 1; i--)
+        {
+            uint64_t j = 1 + (uint64_t)rand() % i;
+            uint32_t t = page_map[i];
+            page_map[i] = page_map[j];
+            page_map[j] = t;
+        }
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.cover_page_count = page_count;
+    for (i = 0; i < ZC_BLOCK_MAX_CACHED_PAGES && i < page_count; i++) header.page_cache[i] = &pages[page_map[i]];
+    for (i = 0; i + 1 < page_count; i++)
+    {
+        if (!linked && i + 1 < ZC_BLOCK_MAX_CACHED_PAGES) continue;
+        pages[page_map[i]].tail.next_page_addr = (uint64_t)(uintptr_t)&pages[page_map[i + 1]];
+    }
+
+    free(page_map);
+    return &header;
+}
+
+/**
+ *
+ */
+zc_block_header_t* zc_test_block_setup(uint64_t lut_offset, uint64_t page_count)
+{
+    zc_block_header_t* block = zc_test_block_setup_pages(page_count, false, true);
+    block->lut_offset = lut_offset;
+    assert(zc_dtt_init(block) == ZC_INTERNAL_OK);
+    return block;
+}
+
+/**
+ *
+ */
+void zc_test_block_teardown(void)
+{
+    free(pages);
+    pages = NULL;
+}
@@ -0,0 +1,50 @@
+/*
+*/
+#pragma once
+
+#include <stdbool.h>
+#include "../src/memory/block.h"
+
+#ifndef BLOCK_FIXTURE_H
+#define BLOCK_FIXTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 构造测试用的块并初始化 DTTA。页连续分配，页缓存与页尾链接按 zc_block_create 的方式填好。
+ * @param lut_offset LUT 头相对块首的偏移
+ * @param page_count 块覆盖的页数
+ * @return 块头，放在页外，整个数据区都可用于测试
+ * @note 同一时刻只有一个测试块，下次构造前须调用 zc_test_block_teardown
+ */
+zc_block_header_t* zc_test_block_setup(
+    uint64_t lut_offset,
+    uint64_t page_count
+);
+
+/**
+ * @brief 构造不带 DTTA 的测试块，用于直接读写块页。
+ * @param page_count 块覆盖的页数
+ * @param shuffled 为 true 时除首页外按打乱的顺序映射块页，块页在内存中不再连续
+ * @param linked 为 false 时断开页缓存覆盖范围内的页尾链接，迫使调用者回退到 zc_block_offset_to_ptr；
+ *               之后的页仍须沿页尾链接才能找到，因此保持链接
+ * @return 块头，放在页外
+ */
+zc_block_header_t* zc_test_block_setup_pages(
+    uint64_t page_count,
+    bool shuffled,
+    bool linked
+);
+
+/**
+ * @brief 释放测试块的页。
+ */
+void zc_test_block_teardown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_FIXTURE_H */
@@ -6,20 +6,21 @@
 #include "../src/memory/page.h"
 #include "../src/memory/segment.h"
 
+// 块头之后的用户数据区大小
+#define USERDATA_SIZE 1024
+
 // 辅助函数，用于创建测试用的内存页面
 zc_page_t* create_test_pages(int page_count) {
-    zc_page_t* pages = malloc(sizeof(zc_page_t) * page_count);
+    zc_page_t* pages = calloc(page_count, sizeof(zc_page_t));
     for (int i = 0; i < page_count; i++) {
         pages[i].header.state = ZC_PAGE_STATE_IDLE;
         pages[i].header.line_seq = i;
-        pages[i].header.prev_page_addr = (i > 0) ? (uint64_t)&pages[i-1] : 0;
-        pages[i].tail.next_page_addr = (i < page_count - 1) ? (uint64_t)&pages[i+1] : 0;
     }
     return pages;
 }
 
-void test_zc_block_create_new_header() {
-    printf("Testing zc_block_create_new_header...\n");
+void test_zc_block_create() {
+    printf("Testing zc_block_create...\n");
 
     // 创建测试用的页面
     size_t page_count = 5;
@@ -27,13 +28,13 @@ void test_zc_block_create_new_header() {
     
     // 测试创建新的块头
     zc_block_header_t* block = (zc_block_header_t*)pages[0].data;
-    zc_internal_result_t result = zc_block_create_new_header(block, pages, page_count);
+    zc_internal_result_t result = zc_block_create(block, USERDATA_SIZE, page_count);
     
     // 验证结果
     assert(result == ZC_INTERNAL_OK);
     assert(block->state == ZC_BLOCK_STATE_FREE);
-    assert(block->lut_offset == page_count * ZC_PAGE_DATA_SIZE);
-    assert(block->lut_entry_count == 0);
+    assert(block->cover_page_count == page_count);
+    assert(block->lut_offset == ZC_BLOCK_HEADER_SIZE + USERDATA_SIZE);
     
     // 验证页面状态
     assert(pages[0].header.state == ZC_PAGE_STATE_AS_HEAD);
@@ -50,7 +51,45 @@ void test_zc_block_create_new_header() {
         assert(block->reader_visited[i] == false);
     }
     
-    printf("  Passed zc_block_create_new_header test\n");
+    // 验证页缓存与页链
+    for (size_t i = 0; i < page_count; i++) {
+        if (i < ZC_BLOCK_MAX_CACHED_PAGES) assert(block->page_cache[i] == &pages[i]);
+        assert(pages[i].header.prev_page_addr == ((i > 0) ? (uint64_t)(uintptr_t)&pages[i-1] : 0));
+        assert(pages[i].tail.next_page_addr == ((i < page_count - 1) ? (uint64_t)(uintptr_t)&pages[i+1] : 0));
+    }
+    
+    printf("  Passed zc_block_create test\n");
+    free(pages);
+}
+
+void test_zc_block_offset_to_ptr() {
+    printf("Testing zc_block_offset_to_ptr...\n");
+
+    // 页数超过页缓存，后面的页沿页尾链接查找
+    size_t page_count = ZC_BLOCK_MAX_CACHED_PAGES + 5;
+    zc_page_t* pages = create_test_pages(page_count);
+    zc_block_header_t* block = (zc_block_header_t*)pages[0].data;
+    assert(zc_block_create(block, (page_count - 2) * ZC_PAGE_DATA_SIZE, page_count) == ZC_INTERNAL_OK);
+
+    const uint64_t offsets[] = { 0, ZC_PAGE_DATA_SIZE - 1, ZC_PAGE_DATA_SIZE,
+        (ZC_BLOCK_MAX_CACHED_PAGES - 1) * ZC_PAGE_DATA_SIZE + 7, ZC_BLOCK_MAX_CACHED_PAGES * ZC_PAGE_DATA_SIZE,
+        page_count * ZC_PAGE_DATA_SIZE - 1 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        char* ptr = zc_block_offset_to_ptr(block, offsets[i]);
+        assert(ptr == pages[offsets[i] / ZC_PAGE_DATA_SIZE].data + offsets[i] % ZC_PAGE_DATA_SIZE);
+        assert(zc_block_ptr_to_offset(block, ptr) == offsets[i]);
+    }
+    assert(zc_block_offset_to_ptr(block, 0) == block);
+    printf("  Passed cached and linked page lookup test\n");
+
+    // 越界、页头页尾与块外地址
+    assert(zc_block_offset_to_ptr(block, page_count * ZC_PAGE_DATA_SIZE) == NULL);
+    assert(zc_block_ptr_to_offset(block, &pages[1].header) == UINT64_MAX);
+    assert(zc_block_ptr_to_offset(block, &pages[ZC_BLOCK_MAX_CACHED_PAGES + 1].tail) == UINT64_MAX);
+    char outside;
+    assert(zc_block_ptr_to_offset(block, &outside) == UINT64_MAX);
+    printf("  Passed out of block test\n");
+
     free(pages);
 }
 
@@ -63,7 +102,7 @@ void test_zc_acquire_block_for_writing() {
     zc_block_header_t* block = (zc_block_header_t*)pages[0].data;
     
     // 首先初始化块
-    zc_block_create_new_header(block, pages, page_count);
+    zc_block_create(block, USERDATA_SIZE, page_count);
     
     // 测试正常获取写入权限
     zc_writer_id_t writer_id = 1;
@@ -80,14 +119,14 @@ void test_zc_acquire_block_for_writing() {
     // 测试块不是FREE状态的情况
     block->state = ZC_BLOCK_STATE_USING;
     result = zc_acquire_block_for_writing(block, size, writer_id);
-    assert(result == ZC_INTERNAL_RUN_BLOCK_UNEXPECTED);
+    assert(result == ZC_INTERNAL_BLOCK_UNEXPECTED);
     printf("  Passed block not FREE state test\n");
     
     // 测试块空间不足的情况
     block->state = ZC_BLOCK_STATE_FREE;
-    block->lut_offset = size - 100; // 设置为小于所需空间
-    result = zc_acquire_block_for_writing(block, size, writer_id);
-    assert(result == ZC_INTERNAL_RUN_BLOCK_UNEXPECTED);
+    block->writer_ref[writer_id] = false;
+    result = zc_acquire_block_for_writing(block, block->cover_page_count * ZC_PAGE_DATA_SIZE, writer_id); // 请求超过块覆盖的页
+    assert(result == ZC_INTERNAL_BLOCK_UNEXPECTED);
     printf("  Passed insufficient space test\n");
     
     free(pages);
@@ -102,7 +141,7 @@ void test_zc_acquire_block_for_reading() {
     zc_block_header_t* block = (zc_block_header_t*)pages[0].data;
     
     // 首先初始化块
-    zc_block_create_new_header(block, pages, page_count);
+    zc_block_create(block, USERDATA_SIZE, page_count);
     
     // 设置块为USING状态并分配writer_id
     zc_writer_id_t writer_id = 5;
@@ -122,14 +161,14 @@ void test_zc_acquire_block_for_reading() {
     // 测试块不是USING状态的情况
     block->state = ZC_BLOCK_STATE_FREE;
     result = zc_acquire_block_for_reading(block, reader_id);
-    assert(result == ZC_INTERNAL_RUN_BLOCK_UNEXPECTED);
+    assert(result == ZC_INTERNAL_BLOCK_UNEXPECTED);
     printf("  Passed block not USING state test\n");
     
     // 测试writer_id不匹配的情况
     block->state = ZC_BLOCK_STATE_USING;
     block->writer_id = writer_id + 1; // 设置不匹配的writer_id
     result = zc_acquire_block_for_reading(block, reader_id);
-    assert(result == ZC_INTERNAL_RUN_BLOCK_UNEXPECTED);
+    assert(result == ZC_INTERNAL_BLOCK_UNEXPECTED);
     printf("  Passed writer_id mismatch test\n");
     
     free(pages);
@@ -144,7 +183,7 @@ void test_zc_acquire_block_for_cleaning() {
     zc_block_header_t* block = (zc_block_header_t*)pages[0].data;
     
     // 首先初始化块
-    zc_block_create_new_header(block, pages, page_count);
+    zc_block_create(block, USERDATA_SIZE, page_count);
     
     // 设置块为USING状态
     block->state = ZC_BLOCK_STATE_USING;
@@ -165,7 +204,7 @@ void test_zc_acquire_block_for_cleaning() {
     // 测试块不是USING状态的情况
     block->state = ZC_BLOCK_STATE_FREE;
     result = zc_acquire_block_for_cleaning(block);
-    assert(result == ZC_INTERNAL_RUN_BLOCK_UNEXPECTED);
+    assert(result == ZC_INTERNAL_BLOCK_UNEXPECTED);
     printf("  Passed block not USING state test\n");
     
     free(pages);
@@ -174,7 +213,8 @@ void test_zc_acquire_block_for_cleaning() {
 int main() {
     printf("Starting block unit tests...\n\n");
 
-    test_zc_block_create_new_header();
+    test_zc_block_create();
+    test_zc_block_offset_to_ptr();
     test_zc_acquire_block_for_writing();
     test_zc_acquire_block_for_reading();
     test_zc_acquire_block_for_cleaning();
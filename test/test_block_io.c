@@ -0,0 +1,181 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/memory/block_io.h"
+#include "block_fixture.h"
+
+// 块页按打乱的顺序映射；构建时以 -Wl,--wrap 包装 zc_block_offset_to_ptr，统计回退查找的次数
+void* __real_zc_block_offset_to_ptr(zc_block_header_t* block, uint64_t offset);
+
+static uint64_t lookup_count;
+
+void* __wrap_zc_block_offset_to_ptr(zc_block_header_t* block, uint64_t offset)
+{
+    lookup_count++;
+    return __real_zc_block_offset_to_ptr(block, offset);
+}
+
+// 逐字节检查块内内容
+static void check_bytes(zc_block_header_t* block, uint64_t offset, const uint8_t* expected, uint64_t length)
+{
+    uint64_t i;
+    for (i = 0; i < length; i++) assert(*(uint8_t*)zc_block_offset_to_ptr(block, offset + i) == expected[i]);
+}
+
+static void run_round_trip(bool linked)
+{
+    const uint64_t page_count = 300;
+    zc_block_header_t* block = zc_test_block_setup_pages(page_count, true, linked);
+    const uint64_t sizes[] = { 1, 7, ZC_PAGE_DATA_SIZE - 3, ZC_PAGE_DATA_SIZE, ZC_PAGE_DATA_SIZE * 3 + 5,
+        ZC_BLOCK_STREAM_THRESHOLD - 1, ZC_BLOCK_STREAM_THRESHOLD, ZC_BLOCK_STREAM_THRESHOLD * 3 + 11 };
+    const uint64_t offsets[] = { 0, ZC_PAGE_DATA_SIZE - 1, ZC_PAGE_DATA_SIZE * 5, ZC_PAGE_DATA_SIZE * 9 + 333 };
+
+    uint64_t max = ZC_BLOCK_STREAM_THRESHOLD * 3 + 11;
+    uint8_t* in = malloc(max);
+    uint8_t* out = malloc(max + 1);
+
+    uint32_t s, o;
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        for (o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++)
+        {
+            uint64_t i;
+            for (i = 0; i < sizes[s]; i++) in[i] = (uint8_t)rand();
+
+            lookup_count = 0;
+            assert(zc_block_write(block, offsets[o], in, sizes[s]) == ZC_INTERNAL_OK);
+            uint64_t pages_touched = (offsets[o] + sizes[s] - 1) / ZC_PAGE_DATA_SIZE - offsets[o] / ZC_PAGE_DATA_SIZE + 1;
+            // 链接后只在起点查找一次，未链接的页逐页查找
+            if (linked) assert(lookup_count == 1);
+            else assert(lookup_count <= pages_touched + 1);
+
+            check_bytes(block, offsets[o], in, sizes[s]);
+
+            out[sizes[s]] = 0x5A;
+            assert(zc_block_read(block, offsets[o], out, sizes[s]) == ZC_INTERNAL_OK);
+            assert(memcmp(out, in, sizes[s]) == 0 && out[sizes[s]] == 0x5A);
+        }
+    }
+
+    free(in);
+    free(out);
+    zc_test_block_teardown();
+}
+
+void test_block_io_round_trip() {
+    printf("Testing block gather / scatter round trip...\n");
+
+    run_round_trip(false);
+    run_round_trip(true);
+
+    printf("  Passed\n");
+}
+
+void test_block_io_copy() {
+    printf("Testing block in-place copy...\n");
+
+    zc_block_header_t* block = zc_test_block_setup_pages(300, true, true);
+    const uint64_t length = ZC_BLOCK_STREAM_THRESHOLD + 1001;
+    uint8_t* in = malloc(length);
+    uint8_t* out = malloc(length);
+
+    uint64_t i;
+    for (i = 0; i < length; i++) in[i] = (uint8_t)rand();
+
+    // 两端页内位置不同，分段互相错开
+    const uint64_t src_offset = 200;
+    const uint64_t dst_offset = ZC_PAGE_DATA_SIZE * 150 + 77;
+    assert(zc_block_write(block, src_offset, in, length) == ZC_INTERNAL_OK);
+    assert(zc_block_copy(block, dst_offset, src_offset, length) == ZC_INTERNAL_OK);
+    assert(zc_block_read(block, dst_offset, out, length) == ZC_INTERNAL_OK);
+    assert(memcmp(out, in, length) == 0);
+
+    // 小段走普通拷贝
+    assert(zc_block_copy(block, 5, ZC_PAGE_DATA_SIZE * 150 + 77 + 480, 100) == ZC_INTERNAL_OK);
+    check_bytes(block, 5, in + 480, 100);
+
+    assert(zc_block_copy(block, 1000, 900, 101) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_block_copy(block, 900, 1000, 101) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_block_copy(block, 900, 1000, 100) == ZC_INTERNAL_OK);
+    assert(zc_block_copy(block, 900, 900, 0) == ZC_INTERNAL_OK);
+
+    free(in);
+    free(out);
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_block_io_bounds() {
+    printf("Testing block gather / scatter bounds...\n");
+
+    zc_block_header_t* block = zc_test_block_setup_pages(4, true, false);
+    const uint64_t end = 4 * ZC_PAGE_DATA_SIZE;
+    uint8_t buf[64] = { 0 };
+
+    assert(zc_block_read(block, end - 64, buf, 64) == ZC_INTERNAL_OK);
+    assert(zc_block_write(block, end - 64, buf, 64) == ZC_INTERNAL_OK);
+    assert(zc_block_read(block, end - 63, buf, 64) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_write(block, end, buf, 1) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_read(block, UINT64_MAX, buf, 2) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_copy(block, 0, end - 10, 11) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_read(block, 0, NULL, 1) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_block_write(block, 0, NULL, 1) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_block_read(block, end, NULL, 0) == ZC_INTERNAL_OK);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_block_io_place() {
+    printf("Testing block aligned placement...\n");
+
+    zc_block_header_t* block = zc_test_block_setup_pages(16, true, false);
+    const uint64_t end = 16 * ZC_PAGE_DATA_SIZE;
+    const uint64_t widths[] = { 1, 8, 40, 64, 200, ZC_PAGE_DATA_SIZE - 64, ZC_PAGE_DATA_SIZE, ZC_PAGE_DATA_SIZE + 1 };
+
+    uint32_t alignment;
+    for (alignment = 1; alignment <= ZC_BLOCK_MAX_ALIGN; alignment <<= 1)
+    {
+        uint32_t w;
+        for (w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+        {
+            uint64_t min_offset;
+            for (min_offset = 0; min_offset < 3 * ZC_PAGE_DATA_SIZE; min_offset += 13)
+            {
+                uint64_t offset;
+                assert(zc_block_place(block, min_offset, widths[w], alignment, &offset) == ZC_INTERNAL_OK);
+                assert(offset >= min_offset && offset + widths[w] <= end);
+                assert(((uintptr_t)zc_block_offset_to_ptr(block, offset) & (alignment - 1)) == 0);
+
+                // 一页放得下的变量只在下一页的对齐填充容不下时跨页
+                bool crosses = offset % ZC_PAGE_DATA_SIZE + widths[w] > ZC_PAGE_DATA_SIZE;
+                if (crosses && widths[w] <= ZC_PAGE_DATA_SIZE) assert(widths[w] > ZC_PAGE_DATA_SIZE - (alignment - 1));
+                if (!crosses) assert(offset - min_offset < ZC_PAGE_DATA_SIZE + alignment);
+            }
+        }
+    }
+
+    uint64_t offset;
+    assert(zc_block_place(block, 0, 8, 3, &offset) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_block_place(block, 0, 8, ZC_BLOCK_MAX_ALIGN * 2, &offset) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_block_place(block, 0, 8, 8, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_block_place(block, end - 4, 8, 1, &offset) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_place(block, end, 1, 1, &offset) == ZC_INTERNAL_BLOCK_ILLEGAL_OFFSET);
+    assert(zc_block_place(block, 5, 8, 0, &offset) == ZC_INTERNAL_OK && offset == 5);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(46);
+
+    test_block_io_round_trip();
+    test_block_io_copy();
+    test_block_io_bounds();
+    test_block_io_place();
+
+    printf("All block io tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/zora/compare.h"
+#include "../src/simd/simd.h"
+#include "block_fixture.h"
+
+// 逐页写入，模拟写入者把变量放进块
+static void block_write(zc_block_header_t* block, uint64_t offset, const void* src, uint64_t len)
+{
+    const uint8_t* p = src;
+    while (len > 0)
+    {
+        uint64_t n = ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+        if (n > len) n = len;
+        memcpy(zc_block_offset_to_ptr(block, offset), p, n);
+        offset += n;
+        p += n;
+        len -= n;
+    }
+}
+
+static const uint8_t kind_tags[ZC_NUMERIC_KIND_COUNT] = { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D };
+
+static void store_value(zc_numeric_kind_t kind, void* dst, double v)
+{
+    zc_numeric_value_t value;
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  value.i8 = (int8_t)v;    break;
+        case ZC_NUMERIC_U8:  value.u8 = (uint8_t)v;   break;
+        case ZC_NUMERIC_I16: value.i16 = (int16_t)v;  break;
+        case ZC_NUMERIC_U16: value.u16 = (uint16_t)v; break;
+        case ZC_NUMERIC_I32: value.i32 = (int32_t)v;  break;
+        case ZC_NUMERIC_U32: value.u32 = (uint32_t)v; break;
+        case ZC_NUMERIC_I64: value.i64 = (int64_t)v;  break;
+        case ZC_NUMERIC_U64: value.u64 = (uint64_t)v; break;
+        case ZC_NUMERIC_F32: value.f32 = (float)v;    break;
+        default:             value.f64 = v;           break;
+    }
+    memcpy(dst, value.bytes, zc_numeric_kind_size(kind));
+}
+
+static double load_value(zc_numeric_kind_t kind, const zc_numeric_value_t* value)
+{
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  return value->i8;
+        case ZC_NUMERIC_U8:  return value->u8;
+        case ZC_NUMERIC_I16: return value->i16;
+        case ZC_NUMERIC_U16: return value->u16;
+        case ZC_NUMERIC_I32: return value->i32;
+        case ZC_NUMERIC_U32: return value->u32;
+        case ZC_NUMERIC_I64: return (double)value->i64;
+        case ZC_NUMERIC_U64: return (double)value->u64;
+        case ZC_NUMERIC_F32: return value->f32;
+        default:             return value->f64;
+    }
+}
+
+static bool compare_all(zc_block_header_t* block, uint64_t offset, zc_numeric_kind_t kind, zc_compare_op_t op, double t)
+{
+    zc_numeric_value_t threshold;
+    store_value(kind, threshold.bytes, t);
+
+    bool result;
+    assert(zc_compare_all(block, offset, op, threshold.bytes, zc_numeric_kind_size(kind), &result) == ZC_INTERNAL_OK);
+    return result;
+}
+
+// 每种元素类型的 SZARRAY 从奇数偏移开始，跨越多个页边界，部分元素被页边界截断
+static void run_arrays(uint32_t count)
+{
+    zc_block_header_t* block = zc_test_block_setup(16384, 64);
+    uint64_t offset = 1001;
+    uint8_t* values = malloc((uint64_t)count * 8);
+
+    uint32_t kind;
+    for (kind = 0; kind < ZC_NUMERIC_KIND_COUNT; kind++)
+    {
+        uint32_t size = zc_numeric_kind_size(kind);
+        uint8_t desc[7] = { 0x1D, kind_tags[kind], 0x00 };
+        uint32_t desc_len = kind >= ZC_NUMERIC_F32 ? 7 : 6;
+        memcpy(desc + desc_len - 4, &count, sizeof(count));
+        assert(zc_dtt_add(block, offset, (uint64_t)count * size, desc, desc_len) == ZC_INTERNAL_OK);
+
+        // 值域 [lo, lo + 200]，极值各只出现一次
+        double lo = kind % 2 == 1 ? 10 : -100;
+        uint32_t min_at = count / 3;
+        uint32_t max_at = count - 1 - count / 5;
+        uint32_t i;
+        for (i = 0; i < count; i++)
+        {
+            double v = lo + 1 + (double)(rand() % 199);
+            if (i == min_at) v = lo;
+            if (i == max_at) v = lo + 200;
+            store_value(kind, values + (uint64_t)i * size, v);
+        }
+        block_write(block, offset, values, (uint64_t)count * size);
+
+        assert(compare_all(block, offset, kind, ZC_COMPARE_GT, lo - 1));
+        assert(!compare_all(block, offset, kind, ZC_COMPARE_GT, lo));
+        assert(compare_all(block, offset, kind, ZC_COMPARE_GE, lo));
+        assert(compare_all(block, offset, kind, ZC_COMPARE_LT, lo + 201));
+        assert(!compare_all(block, offset, kind, ZC_COMPARE_LT, lo + 200));
+        assert(compare_all(block, offset, kind, ZC_COMPARE_LE, lo + 200));
+        assert(compare_all(block, offset, kind, ZC_COMPARE_NE, lo + 201));
+        assert(!compare_all(block, offset, kind, ZC_COMPARE_NE, lo + 200));
+        assert(!compare_all(block, offset, kind, ZC_COMPARE_EQ, lo));
+
+        bool result;
+        assert(zc_compare_content_equal(block, offset, values, size, count, &result) == ZC_INTERNAL_OK && result);
+        assert(zc_compare_content_equal(block, offset, values, size, count - 1, &result) == ZC_INTERNAL_OK && !result);
+        assert(zc_compare_content_equal(block, offset, values, size == 1 ? 2 : 1, count, &result) == ZC_INTERNAL_PARAM_ERROR);
+
+        // 逐个位置改动一个元素，每个页内段与跨页元素都要能被发现
+        for (i = 0; i < count; i += 7)
+        {
+            uint8_t saved[8];
+            memcpy(saved, values + (uint64_t)i * size, size);
+            store_value(kind, values + (uint64_t)i * size, lo + 201);
+            assert(zc_compare_content_equal(block, offset, values, size, count, &result) == ZC_INTERNAL_OK && !result);
+            memcpy(values + (uint64_t)i * size, saved, size);
+        }
+
+        assert(zc_compare_equal(block, offset, values, (uint64_t)count * size, &result) == ZC_INTERNAL_OK && result);
+        values[(uint64_t)count * size - 1] ^= 1;
+        assert(zc_compare_equal(block, offset, values, (uint64_t)count * size, &result) == ZC_INTERNAL_OK && !result);
+        assert(zc_compare_equal(block, offset, values, (uint64_t)count * size - 1, &result) == ZC_INTERNAL_OK && !result);
+
+        zc_compare_extrema_t extrema;
+        assert(zc_compare_extrema(block, offset, &extrema) == ZC_INTERNAL_OK);
+        assert(extrema.kind == kind);
+        assert(load_value(kind, &extrema.min) == lo && extrema.min_index == min_at);
+        assert(load_value(kind, &extrema.max) == lo + 200 && extrema.max_index == max_at);
+
+        offset += (uint64_t)count * size + 3;
+    }
+
+    free(values);
+    zc_test_block_teardown();
+}
+
+// 每个指令集级别都跑一遍，长度覆盖只有尾部、恰好整向量与多个页
+void test_compare_arrays() {
+    printf("Testing compare over numeric arrays...\n");
+
+    static const uint32_t counts[] = { 7, 64, 300 };
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+        uint32_t i;
+        for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) run_arrays(counts[i]);
+    }
+    assert(zc_simd_set_level(ZC_SIMD_LEVEL_COUNT) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+    assert(zc_simd_level() == zc_simd_detect());
+
+    printf("  Passed\n");
+}
+
+// FLOATTENSOR 与含 NaN 的浮点数组
+void test_compare_float() {
+    printf("Testing compare over float tensors...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(8192, 32);
+
+    uint8_t tensor_desc[] = { 0x4C, 0x00, 0x02, 0x00, 0x10, 0x00, 0x10, 0x00 };
+    float tensor[256];
+    uint32_t i;
+    for (i = 0; i < 256; i++) tensor[i] = (float)i * 0.5f - 10.0f;
+    tensor[77] = NAN;
+    tensor[200] = -0.0f;
+    assert(zc_dtt_add(block, 130, sizeof(tensor), tensor_desc, sizeof(tensor_desc)) == ZC_INTERNAL_OK);
+    block_write(block, 130, tensor, sizeof(tensor));
+
+    float t = -11.0f;
+    bool result;
+    assert(zc_compare_all(block, 130, ZC_COMPARE_GT, &t, sizeof(t), &result) == ZC_INTERNAL_OK && !result);
+    assert(zc_compare_all(block, 130, ZC_COMPARE_NE, &t, sizeof(t), &result) == ZC_INTERNAL_OK && result);
+    assert(zc_compare_all(block, 130, ZC_COMPARE_GT, &t, sizeof(double), &result) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_compare_all(block, 130, ZC_COMPARE_OP_COUNT, &t, sizeof(t), &result) == ZC_INTERNAL_PARAM_ERROR);
+
+    // NaN 与自身不相等；+0.0 与 -0.0 相等
+    assert(zc_compare_content_equal(block, 130, tensor, 4, 256, &result) == ZC_INTERNAL_OK && !result);
+    tensor[77] = 0.0f;
+    block_write(block, 130, tensor, sizeof(tensor));
+    tensor[200] = 0.0f;
+    assert(zc_compare_content_equal(block, 130, tensor, 4, 256, &result) == ZC_INTERNAL_OK && result);
+    tensor[77] = NAN;
+    block_write(block, 130, tensor, sizeof(tensor));
+
+    zc_compare_extrema_t extrema;
+    assert(zc_compare_extrema(block, 130, &extrema) == ZC_INTERNAL_OK);
+    assert(extrema.min.f32 == -10.0f && extrema.min_index == 0);
+    assert(extrema.max.f32 == 117.5f && extrema.max_index == 255);
+
+    // 全为 NaN 的 R8 数组
+    uint8_t nan_desc[] = { 0x1D, 0x0D, 0x00, 0x05, 0x00, 0x00, 0x00 };
+    double nans[5] = { NAN, NAN, NAN, NAN, NAN };
+    assert(zc_dtt_add(block, 2000, sizeof(nans), nan_desc, sizeof(nan_desc)) == ZC_INTERNAL_OK);
+    block_write(block, 2000, nans, sizeof(nans));
+    assert(zc_compare_extrema(block, 2000, &extrema) == ZC_INTERNAL_OK);
+    assert(isnan(extrema.min.f64) && isnan(extrema.max.f64) && extrema.min_index == 0 && extrema.max_index == 0);
+
+    // 标量变量视为单元素数组
+    uint8_t r8_desc[] = { 0x0D, 0x00 };
+    double scalar = 3.25;
+    assert(zc_dtt_add(block, 2100, sizeof(scalar), r8_desc, sizeof(r8_desc)) == ZC_INTERNAL_OK);
+    block_write(block, 2100, &scalar, sizeof(scalar));
+    double th = 3.0;
+    assert(zc_compare_all(block, 2100, ZC_COMPARE_GT, &th, sizeof(th), &result) == ZC_INTERNAL_OK && result);
+    th = 3.25;
+    assert(zc_compare_all(block, 2100, ZC_COMPARE_EQ, &th, sizeof(th), &result) == ZC_INTERNAL_OK && result);
+
+    // 非数值变量与非变量起始偏移
+    uint8_t str_desc[] = { 0x0E, 0x04, 0x00, 0x00, 0x00 };
+    assert(zc_dtt_add(block, 2200, 8, str_desc, sizeof(str_desc)) == ZC_INTERNAL_OK);
+    assert(zc_compare_extrema(block, 2200, &extrema) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_compare_equal(block, 2200, "a\0b\0c\0d\0", 8, &result) == ZC_INTERNAL_OK && !result);
+    assert(zc_compare_all(block, 2101, ZC_COMPARE_GT, &th, sizeof(th), &result) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_compare_equal(block, 2300, &th, sizeof(th), &result) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(41);
+
+    test_compare_arrays();
+    test_compare_float();
+
+    printf("All compare tests passed.\n");
+    return 0;
+}
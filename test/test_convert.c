@@ -0,0 +1,622 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/type/type_descriptor.h"
+#include "../src/zora/convert.h"
+#include "../src/simd/simd.h"
+#include "block_fixture.h"
+
+/**
+ * 参考实现：按位布局逐个求值，与内核无共享代码
+ */
+typedef struct ref_format {
+    uint8_t token;
+    int     exp_bits;
+    int     man_bits;
+    int     bias;
+    int     inf_nan;       // IEEE 约定的无穷大与 NaN
+    int     nan_max_only;  // 只有幅值全 1 为 NaN
+    int     no_leading;
+    int     shift;         // 容器内的左移位数
+} ref_format_t;
+
+static const ref_format_t ref_formats[] = {
+    { R4_TYPE_HALF,               5, 10, 15,  1, 0, 0, 0 },
+    { R4_TYPE_BFLOAT16,           8, 7,  127, 1, 0, 0, 0 },
+    { R4_TYPE_TF32,               8, 10, 127, 1, 0, 0, 13 },
+    { R4_TYPE_FP8_E5M2,           5, 2,  15,  1, 0, 0, 0 },
+    { R4_TYPE_FP8_E4M3,           4, 3,  7,   0, 1, 0, 0 },
+    { R4_TYPE_FP6_E3M2,           3, 2,  3,   0, 0, 0, 0 },
+    { R4_TYPE_FP6_E2M3,           2, 3,  1,   0, 0, 0, 0 },
+    { R4_TYPE_FP6_E4M1,           4, 1,  7,   0, 0, 0, 0 },
+    { R4_TYPE_FP6_E2M3_NOLEADING, 2, 3,  1,   0, 0, 1, 0 },
+};
+
+#define REF_FORMAT_COUNT (sizeof(ref_formats) / sizeof(ref_formats[0]))
+
+static uint32_t ref_code_count(const ref_format_t* f)
+{
+    return 1U << (f->exp_bits + f->man_bits + 1);
+}
+
+static float ref_decode(const ref_format_t* f, uint32_t code)
+{
+    uint32_t man_mask = (1U << f->man_bits) - 1;
+    uint32_t mag = code & ((1U << (f->exp_bits + f->man_bits)) - 1);
+    int sign = (code >> (f->exp_bits + f->man_bits)) & 1;
+    int e = (int)(mag >> f->man_bits);
+    uint32_t m = mag & man_mask;
+    double v;
+
+    if (f->inf_nan && e == (1 << f->exp_bits) - 1) v = m ? NAN : INFINITY;
+    else if (f->nan_max_only && mag == (1U << (f->exp_bits + f->man_bits)) - 1) v = NAN;
+    else if (f->no_leading) v = ldexp(m, e - f->bias - f->man_bits);
+    else if (e == 0) v = ldexp(m, 1 - f->bias - f->man_bits);
+    else v = ldexp(m + (1U << f->man_bits), e - f->bias - f->man_bits);
+
+    return (float)(sign ? -v : v);
+}
+
+static uint32_t ref_width(const ref_format_t* f)
+{
+    uint64_t size;
+    assert(zc_type_get_r4_obj_size(f->token, &size) == ZC_INTERNAL_OK);
+    return (uint32_t)size;
+}
+
+static float decode_one(const ref_format_t* f, uint32_t code)
+{
+    uint32_t container = code << f->shift;
+    float out;
+    assert(zc_convert_r4_to_f32(f->token, &container, &out, 1) == ZC_INTERNAL_OK);
+    return out;
+}
+
+static uint32_t encode_one(const ref_format_t* f, float v)
+{
+    uint32_t container = 0;
+    assert(zc_convert_f32_to_r4(f->token, &v, &container, 1) == ZC_INTERNAL_OK);
+    return container >> f->shift;
+}
+
+static bool same_value(float a, float b)
+{
+    return (isnan(a) && isnan(b)) || memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// 每个编码解码后与参考值一致，再编码回到自身；相邻编码的中点按偶数编码舍入
+static void run_exhaustive(const ref_format_t* f)
+{
+    uint32_t count = ref_code_count(f);
+    uint32_t width = ref_width(f);
+    uint8_t* codes = malloc((uint64_t)count * width);
+    float* values = malloc((uint64_t)count * sizeof(float));
+    uint32_t* back = calloc(count, sizeof(uint32_t));
+
+    uint32_t c;
+    for (c = 0; c < count; c++)
+    {
+        uint32_t container = c << f->shift;
+        memcpy(codes + (uint64_t)c * width, &container, width);
+    }
+    assert(zc_convert_r4_to_f32(f->token, codes, values, count) == ZC_INTERNAL_OK);
+
+    uint8_t* encoded = malloc((uint64_t)count * width);
+    assert(zc_convert_f32_to_r4(f->token, values, encoded, count) == ZC_INTERNAL_OK);
+
+    for (c = 0; c < count; c++)
+    {
+        float ref = ref_decode(f, c);
+        assert(same_value(values[c], ref));
+
+        uint32_t container = 0;
+        memcpy(&container, encoded + (uint64_t)c * width, width);
+        back[c] = container >> f->shift;
+
+        if (isnan(ref))
+        {
+            if (f->inf_nan || f->nan_max_only) assert(isnan(ref_decode(f, back[c])));
+            continue;
+        }
+        // BFLOAT16 的非规格化数编码时按 0 处理；无前导 1 的格式同一个值有多种编码
+        if (f->token == R4_TYPE_BFLOAT16 && fabsf(ref) < 0x1p-126f && ref != 0) assert(back[c] == (c & 0x8000));
+        else if (f->no_leading) assert(ref_decode(f, back[c]) == ref);
+        else assert(back[c] == c);
+    }
+
+    if (!f->no_leading)
+    {
+        uint32_t sign_bit = 1U << (f->exp_bits + f->man_bits);
+        for (c = 0; c + 1 < sign_bit; c++)
+        {
+            float lo = ref_decode(f, c);
+            float hi = ref_decode(f, c + 1);
+            if (!isfinite(lo) || !isfinite(hi)) continue;
+            if (f->token == R4_TYPE_BFLOAT16 && lo < 0x1p-126f) continue;
+
+            float mid = (float)(((double)lo + hi) / 2);
+            uint32_t even = c % 2 == 0 ? c : c + 1;
+            assert(encode_one(f, mid) == even);
+            assert(encode_one(f, -mid) == (even | sign_bit));
+            assert(encode_one(f, nextafterf(mid, 0)) == c);
+            assert(encode_one(f, nextafterf(mid, INFINITY)) == c + 1);
+        }
+    }
+
+    free(codes);
+    free(values);
+    free(back);
+    free(encoded);
+}
+
+void test_convert_exhaustive() {
+    printf("Testing reduced-precision float conversion...\n");
+
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+        uint32_t i;
+        for (i = 0; i < REF_FORMAT_COUNT; i++) run_exhaustive(&ref_formats[i]);
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    printf("  Passed\n");
+}
+
+// 溢出、饱和与 NaN 的编码
+void test_convert_special() {
+    printf("Testing reduced-precision float special values...\n");
+
+    const ref_format_t* half = &ref_formats[0];
+    const ref_format_t* bf16 = &ref_formats[1];
+    const ref_format_t* e5m2 = &ref_formats[3];
+    const ref_format_t* e4m3 = &ref_formats[4];
+    const ref_format_t* e2m3 = &ref_formats[6];
+    const ref_format_t* e2m3_nl = &ref_formats[8];
+
+    assert(encode_one(half, 1.0f) == 0x3C00);
+    assert(encode_one(half, 65504.0f) == 0x7BFF);
+    assert(encode_one(half, 65519.0f) == 0x7BFF);
+    assert(encode_one(half, 65520.0f) == 0x7C00);
+    assert(encode_one(half, -INFINITY) == 0xFC00);
+    assert(encode_one(half, 0x1p-24f) == 0x0001);
+    assert(encode_one(half, 0x1p-26f) == 0x0000);
+    assert(encode_one(half, NAN) == 0x7E00);
+
+    assert(encode_one(bf16, 1.0f) == 0x3F80);
+    assert(encode_one(bf16, 0x1p-130f) == 0x0000);
+    assert(encode_one(bf16, -0x1p-130f) == 0x8000);
+    assert(encode_one(bf16, 3.4e38f) == 0x7F80);
+
+    assert(encode_one(e5m2, 57344.0f) == 0x7B);
+    assert(encode_one(e5m2, 1e6f) == 0x7C);
+    assert(isnan(ref_decode(e5m2, encode_one(e5m2, NAN))));
+
+    assert(encode_one(e4m3, 448.0f) == 0x7E);
+    assert(encode_one(e4m3, 1000.0f) == 0x7E);
+    assert(encode_one(e4m3, -INFINITY) == 0xFE);
+    assert((encode_one(e4m3, NAN) & 0x7F) == 0x7F);
+
+    assert(encode_one(e2m3, 7.5f) == 0x1F);
+    assert(encode_one(e2m3, 100.0f) == 0x1F);
+    assert(encode_one(e2m3, -INFINITY) == 0x3F);
+    assert(encode_one(e2m3, NAN) == 0x00);
+    assert(encode_one(e2m3_nl, 3.5f) == 0x1F);
+    assert(encode_one(e2m3_nl, 0.0625f) == 0x01);
+    assert(decode_one(e2m3_nl, 0x0F) == 0.875f);
+
+    // FP6 的高 2 bit 不参与解码
+    uint8_t fp6 = 0xC0 | 0x08;
+    float out;
+    assert(zc_convert_r4_to_f32(R4_TYPE_FP6_E2M3, &fp6, &out, 1) == ZC_INTERNAL_OK && out == 1.0f);
+
+    uint64_t size;
+    assert(zc_type_get_r4_obj_size(R4_TYPE_FLOAT, &size) == ZC_INTERNAL_OK && size == 4);
+    assert(zc_type_get_r4_obj_size(0x55, &size) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_convert_r4_to_f32(0x55, &fp6, &out, 1) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_convert_f32_to_r4(R4_TYPE_HALF, NULL, &fp6, 1) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_convert_f32_to_r4(R4_TYPE_HALF, NULL, NULL, 0) == ZC_INTERNAL_OK);
+
+    printf("  Passed\n");
+}
+
+// 各级别对任意位模式（含 NaN 与非规格化数）的编码结果与基线逐位一致
+void test_convert_levels() {
+    printf("Testing reduced-precision float conversion across levels...\n");
+
+    const uint32_t count = 4099;
+    uint32_t* bits = malloc(count * sizeof(uint32_t));
+    uint32_t* expected = malloc(count * sizeof(uint32_t));
+    uint32_t* actual = malloc(count * sizeof(uint32_t));
+    float* widened = malloc(count * sizeof(float));
+    float* widened_base = malloc(count * sizeof(float));
+
+    uint32_t i;
+    for (i = 0; i < count; i++) bits[i] = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+
+    for (i = 0; i < REF_FORMAT_COUNT; i++)
+    {
+        const ref_format_t* f = &ref_formats[i];
+        assert(zc_simd_set_level(ZC_SIMD_BASELINE) == ZC_INTERNAL_OK);
+        assert(zc_convert_f32_to_r4(f->token, (const float*)bits, expected, count) == ZC_INTERNAL_OK);
+        assert(zc_convert_r4_to_f32(f->token, bits, widened_base, count) == ZC_INTERNAL_OK);
+
+        int level;
+        for (level = ZC_SIMD_SSE42; level < ZC_SIMD_LEVEL_COUNT; level++)
+        {
+            assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+            memset(actual, 0, count * sizeof(uint32_t));
+            assert(zc_convert_f32_to_r4(f->token, (const float*)bits, actual, count) == ZC_INTERNAL_OK);
+            assert(memcmp(actual, expected, (uint64_t)count * ref_width(f)) == 0);
+            assert(zc_convert_r4_to_f32(f->token, bits, widened, count) == ZC_INTERNAL_OK);
+            assert(memcmp(widened, widened_base, count * sizeof(float)) == 0);
+        }
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    free(bits);
+    free(expected);
+    free(actual);
+    free(widened);
+    free(widened_base);
+    printf("  Passed\n");
+}
+
+// 块内变量按 token 读写，数组从奇数偏移开始，部分元素被页边界截断
+void test_convert_block() {
+    printf("Testing reduced-precision float load / store in block...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(32768, 100);
+    const uint32_t count = 1000;
+    float* in = malloc(count * sizeof(float));
+    float* out = malloc(count * sizeof(float));
+    float* rounded = malloc(count * sizeof(float));
+    uint8_t* scratch = malloc(count * sizeof(float));
+
+    uint32_t i;
+    for (i = 0; i < count; i++) in[i] = (float)(rand() % 20001 - 10000) / 64.0f;
+
+    uint64_t offset = 1001;
+    static const uint8_t tokens[] = { R4_TYPE_FLOAT, R4_TYPE_HALF, R4_TYPE_BFLOAT16, R4_TYPE_TF32, R4_TYPE_FP8_E4M3 };
+    uint32_t t;
+    for (t = 0; t < sizeof(tokens); t++)
+    {
+        uint64_t width;
+        assert(zc_type_get_r4_obj_size(tokens[t], &width) == ZC_INTERNAL_OK);
+        uint8_t desc[7] = { 0x1D, 0x0C, tokens[t] };
+        memcpy(desc + 3, &count, sizeof(count));
+        assert(zc_dtt_add(block, offset, count * width, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+
+        assert(zc_convert_f32_to_r4(tokens[t], in, scratch, count) == ZC_INTERNAL_OK);
+        assert(zc_convert_r4_to_f32(tokens[t], scratch, rounded, count) == ZC_INTERNAL_OK);
+
+        assert(zc_convert_store_f32(block, offset, 0, count, in) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_f32(block, offset, 0, count, out) == ZC_INTERNAL_OK);
+        assert(memcmp(out, rounded, count * sizeof(float)) == 0);
+
+        // 只改写中间一段
+        float patch[3] = { 1.5f, -2.0f, 0.25f };
+        assert(zc_convert_store_f32(block, offset, 333, 3, patch) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_f32(block, offset, 332, 5, out) == ZC_INTERNAL_OK);
+        assert(out[0] == rounded[332] && out[1] == 1.5f && out[2] == -2.0f && out[3] == 0.25f && out[4] == rounded[336]);
+
+        assert(zc_convert_load_f32(block, offset, count, 0, out) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_f32(block, offset, count - 1, 2, out) == ZC_INTERNAL_PARAM_ERROR);
+        assert(zc_convert_store_f32(block, offset, count + 1, 0, in) == ZC_INTERNAL_PARAM_ERROR);
+
+        offset += count * width + 3;
+    }
+
+    // 标量与非 R4 变量
+    uint8_t half_desc[] = { 0x0C, R4_TYPE_HALF };
+    assert(zc_dtt_add(block, 20001, 2, half_desc, sizeof(half_desc)) == ZC_INTERNAL_OK);
+    float v = 0.333333f;
+    assert(zc_convert_store_f32(block, 20001, 0, 1, &v) == ZC_INTERNAL_OK);
+    assert(zc_convert_load_f32(block, 20001, 0, 1, &v) == ZC_INTERNAL_OK && v == 0.333251953125f);
+
+    uint8_t i4_desc[] = { 0x08 };
+    assert(zc_dtt_add(block, 20011, 4, i4_desc, sizeof(i4_desc)) == ZC_INTERNAL_OK);
+    assert(zc_convert_load_f32(block, 20011, 0, 1, &v) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_convert_load_f32(block, 20002, 0, 1, &v) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_convert_load_f32(block, 20001, 0, 1, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+
+    free(in);
+    free(out);
+    free(rounded);
+    free(scratch);
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+/**
+ * 定点参考实现：逐个元素用 long double / __int128 求值
+ */
+static const uint8_t fixp_widths[] = { FIXP_TYPE_WIDTH_1, FIXP_TYPE_WIDTH_2, FIXP_TYPE_WIDTH_4, FIXP_TYPE_WIDTH_8 };
+
+static int64_t fixp_pow10(uint32_t n)
+{
+    int64_t p = 1;
+    while (n--) p *= 10;
+    return p;
+}
+
+static void fixp_range(uint8_t token, __int128* lo, __int128* hi)
+{
+    uint32_t bits = zc_fixp_width(token) * 8;
+    if (zc_fixp_is_signed(token))
+    {
+        *hi = ((__int128)1 << (bits - 1)) - 1;
+        *lo = -*hi - 1;
+    }
+    else
+    {
+        *hi = ((__int128)1 << bits) - 1;
+        *lo = 0;
+    }
+}
+
+static __int128 fixp_get(uint8_t token, const uint8_t* p)
+{
+    uint64_t raw = 0;
+    uint32_t width = zc_fixp_width(token);
+    memcpy(&raw, p, width);
+    if (zc_fixp_is_signed(token) && width < 8 && (raw >> (width * 8 - 1) & 1)) raw |= ~0ULL << (width * 8);
+    return zc_fixp_is_signed(token) ? (__int128)(int64_t)raw : (__int128)raw;
+}
+
+static void fixp_put(uint8_t token, uint8_t* p, __int128 v)
+{
+    uint64_t raw = (uint64_t)v;
+    memcpy(p, &raw, zc_fixp_width(token));
+}
+
+static __int128 fixp_clamp(__int128 v, __int128 lo, __int128 hi)
+{
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// v * 10^shift，缩小时 0.5 远离 0
+static __int128 fixp_rescale(__int128 v, int32_t shift)
+{
+    if (shift >= 0) return v * fixp_pow10((uint32_t)shift);
+    __int128 d = fixp_pow10((uint32_t)-shift);
+    __int128 q = v / d, r = v % d;
+    if (2 * r >= d) q++;
+    if (2 * r <= -d) q--;
+    return q;
+}
+
+static void fixp_encode_ref(uint8_t token, double x, uint8_t* p)
+{
+    __int128 lo, hi;
+    fixp_range(token, &lo, &hi);
+    long double y = x * (double)fixp_pow10(zc_fixp_scale(token));
+    __int128 v;
+    if (x != x) v = 0;
+    else if (y >= (long double)hi + 0.5L) v = hi;
+    else if (y <= (long double)lo - 0.5L) v = lo;
+    else v = (__int128)roundl(y);
+    fixp_put(token, p, fixp_clamp(v, lo, hi));
+}
+
+// 与参考实现逐元素比较，并检查各级别逐位一致
+void test_convert_fixp() {
+    printf("Testing decimal fixed-point conversion...\n");
+
+    static const uint8_t scales[] = { 0, 2, 7, 18 };
+    const uint32_t count = 1037;
+    uint8_t* raw = malloc(count * 8);
+    uint8_t* actual = malloc(count * 8 + 1);
+    uint8_t* expected = malloc(count * 8);
+    double* values = malloc(count * sizeof(double));
+    double* widened = malloc(count * sizeof(double));
+    int64_t* ints = malloc(count * sizeof(int64_t));
+    int64_t* rescaled = malloc(count * sizeof(int64_t));
+
+    uint32_t i;
+    for (i = 0; i < count * 8; i++) raw[i] = (uint8_t)rand();
+    for (i = 0; i < count; i++)
+    {
+        int64_t r = (int64_t)((uint64_t)rand() << 42 ^ (uint64_t)rand() << 21 ^ (uint64_t)rand());
+        switch (i % 8)
+        {
+        case 0: values[i] = (double)(r % 100000) / 64.0; break;
+        case 1: values[i] = (double)(r % 2001 - 1000) + 0.5; break;           // 恰好在两个整数中间
+        case 2: values[i] = (double)r; break;
+        case 3: values[i] = (double)(r % 1000) * 1e-3; break;
+        case 4: values[i] = i % 16 < 8 ? INFINITY : -INFINITY; break;
+        case 5: values[i] = NAN; break;
+        case 6: values[i] = ldexp((double)(r % 1000), (int)(i % 140) - 70); break;
+        default: values[i] = (double)(r % 1000000) * 0.001 - 500.0; break;
+        }
+        ints[i] = i % 5 == 0 ? (i % 10 == 0 ? INT64_MAX : INT64_MIN) : r >> (i % 60);
+    }
+
+    uint32_t s, w, sg;
+    for (sg = 0; sg < 2; sg++)
+    {
+        for (w = 0; w < 4; w++)
+        {
+            for (s = 0; s < sizeof(scales); s++)
+            {
+                uint8_t token = ZC_FIXP_TOKEN(sg, fixp_widths[w], scales[s]);
+                uint32_t width = zc_fixp_width(token);
+                uint64_t size;
+                assert(zc_type_get_fixpoint_obj_size(token, &size) == ZC_INTERNAL_OK && size == width);
+
+                int level;
+                for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+                {
+                    assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+
+                    // raw / 10^scale
+                    assert(zc_convert_fixp_to_f64(token, raw, widened, count) == ZC_INTERNAL_OK);
+                    for (i = 0; i < count; i++)
+                    {
+                        double ref = (double)fixp_get(token, raw + i * width) / (double)fixp_pow10(scales[s]);
+                        assert(memcmp(&widened[i], &ref, sizeof(double)) == 0);
+                    }
+
+                    // 就近舍入、饱和、NaN
+                    for (i = 0; i < count; i++) fixp_encode_ref(token, values[i], expected + i * width);
+                    memset(actual, 0xAA, count * 8 + 1);
+                    assert(zc_convert_f64_to_fixp(token, values, actual, count) == ZC_INTERNAL_OK);
+                    assert(memcmp(actual, expected, count * width) == 0);
+                    assert(actual[count * width] == 0xAA);
+
+                    // 定点 -> int64，换算到多个目标小数位数
+                    uint32_t target;
+                    for (target = 0; target <= FIXP_TYPE_SCALE_MAX; target += 3)
+                    {
+                        assert(zc_convert_fixp_to_i64(token, raw, target, rescaled, count) == ZC_INTERNAL_OK);
+                        for (i = 0; i < count; i++)
+                        {
+                            __int128 ref = fixp_clamp(fixp_rescale(fixp_get(token, raw + i * width),
+                                (int32_t)target - scales[s]), INT64_MIN, INT64_MAX);
+                            assert(rescaled[i] == (int64_t)ref);
+                        }
+
+                        assert(zc_convert_i64_to_fixp(token, ints, target, actual, count) == ZC_INTERNAL_OK);
+                        __int128 lo, hi;
+                        fixp_range(token, &lo, &hi);
+                        for (i = 0; i < count; i++)
+                        {
+                            __int128 ref = fixp_clamp(fixp_rescale(ints[i], scales[s] - (int32_t)target),
+                                INT64_MIN, INT64_MAX);
+                            assert(fixp_get(token, actual + i * width) == fixp_clamp(ref, lo, hi));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    // 典型值
+    uint8_t token = ZC_FIXP_TOKEN(1, FIXP_TYPE_WIDTH_4, 2);
+    int32_t cents[4];
+    double prices[4] = { 19.995, -0.005, 1234.5678, -21474836.48 };
+    assert(zc_convert_f64_to_fixp(token, prices, cents, 4) == ZC_INTERNAL_OK);
+    assert(cents[0] == 2000 && cents[1] == -1 && cents[2] == 123457 && cents[3] == INT32_MIN);
+    int64_t mills[4];
+    assert(zc_convert_fixp_to_i64(token, cents, 3, mills, 4) == ZC_INTERNAL_OK);
+    assert(mills[0] == 20000 && mills[1] == -10 && mills[2] == 1234570);
+    assert(zc_convert_fixp_to_i64(token, cents, 0, mills, 4) == ZC_INTERNAL_OK);
+    assert(mills[0] == 20 && mills[1] == 0 && mills[2] == 1235 && mills[3] == -21474836);
+
+    // 非法参数
+    uint64_t size;
+    assert(zc_type_get_fixpoint_obj_size(ZC_FIXP_TOKEN(1, FIXP_TYPE_WIDTH_8, 19), &size) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_convert_fixp_to_f64(ZC_FIXP_TOKEN(0, FIXP_TYPE_WIDTH_2, 31), raw, widened, 1) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_convert_fixp_to_i64(token, raw, 19, ints, 1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_convert_f64_to_fixp(token, NULL, actual, 1) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_convert_f64_to_fixp(token, NULL, NULL, 0) == ZC_INTERNAL_OK);
+
+    free(raw);
+    free(actual);
+    free(expected);
+    free(values);
+    free(widened);
+    free(ints);
+    free(rescaled);
+    printf("  Passed\n");
+}
+
+void test_convert_fixp_block() {
+    printf("Testing decimal fixed-point load / store in block...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(32768, 100);
+    const uint32_t count = 700;
+    double* in = malloc(count * sizeof(double));
+    double* out = malloc(count * sizeof(double));
+    int64_t* ints = malloc(count * sizeof(int64_t));
+    int64_t* ints_out = malloc(count * sizeof(int64_t));
+
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        ints[i] = (int64_t)(rand() % 200001) - 100000;
+        in[i] = (double)ints[i] / 1000.0;
+    }
+
+    uint64_t offset = 777;
+    uint32_t w;
+    for (w = 0; w < 4; w++)
+    {
+        uint8_t token = ZC_FIXP_TOKEN(1, fixp_widths[w], 1);
+        uint32_t width = zc_fixp_width(token);
+        uint8_t desc[8] = { 0x1D, 0x4D, token };
+        memcpy(desc + 3, &count, sizeof(count));
+        assert(zc_dtt_add(block, offset, count * width, desc, 7) == ZC_INTERNAL_OK);
+
+        // 三位小数的输入舍入到一位，再按 int64 小数位数 3 读回
+        assert(zc_convert_store_f64(block, offset, 0, count, in) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_i64(block, offset, 0, count, 3, ints_out) == ZC_INTERNAL_OK);
+        for (i = 0; i < count; i++)
+        {
+            __int128 lo, hi;
+            fixp_range(token, &lo, &hi);
+            assert(ints_out[i] == (int64_t)fixp_clamp(fixp_rescale(ints[i], -2), lo, hi) * 100);
+        }
+
+        assert(zc_convert_store_i64(block, offset, 0, count, 1, ints) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_f64(block, offset, 0, count, out) == ZC_INTERNAL_OK);
+        for (i = 0; i < count; i++)
+        {
+            __int128 lo, hi;
+            fixp_range(token, &lo, &hi);
+            assert(out[i] == (double)fixp_clamp(ints[i], lo, hi) / 10.0);
+        }
+
+        // 只改写中间一段
+        double patch[2] = { 1.25, -2.35 };
+        assert(zc_convert_store_f64(block, offset, 300, 2, patch) == ZC_INTERNAL_OK);
+        assert(zc_convert_load_i64(block, offset, 299, 4, 2, ints_out) == ZC_INTERNAL_OK);
+        assert(ints_out[1] == 130 && ints_out[2] == -240);
+
+        assert(zc_convert_load_f64(block, offset, count - 1, 2, out) == ZC_INTERNAL_PARAM_ERROR);
+        assert(zc_convert_load_i64(block, offset, 0, 1, 19, ints_out) == ZC_INTERNAL_PARAM_ERROR);
+
+        offset += count * width + 5;
+    }
+
+    // 标量，以及 R4 变量不能按定点读取
+    uint8_t fixp_desc[] = { 0x4D, ZC_FIXP_TOKEN(0, FIXP_TYPE_WIDTH_8, 18) };
+    assert(zc_dtt_add(block, 20003, 8, fixp_desc, sizeof(fixp_desc)) == ZC_INTERNAL_OK);
+    int64_t v = 1234567890123456789LL;
+    assert(zc_convert_store_i64(block, 20003, 0, 1, 18, &v) == ZC_INTERNAL_OK);
+    assert(zc_convert_load_i64(block, 20003, 0, 1, 9, &v) == ZC_INTERNAL_OK && v == 1234567890LL);
+    double d = -1.0;
+    assert(zc_convert_store_f64(block, 20003, 0, 1, &d) == ZC_INTERNAL_OK);
+    assert(zc_convert_load_f64(block, 20003, 0, 1, &d) == ZC_INTERNAL_OK && d == 0.0);
+
+    uint8_t half_desc[] = { 0x0C, R4_TYPE_HALF };
+    assert(zc_dtt_add(block, 20021, 2, half_desc, sizeof(half_desc)) == ZC_INTERNAL_OK);
+    assert(zc_convert_load_f64(block, 20021, 0, 1, &d) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_convert_load_f32(block, 20003, 0, 1, (float*)&d) == ZC_INTERNAL_TYPE_ERROR);
+
+    free(in);
+    free(out);
+    free(ints);
+    free(ints_out);
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(43);
+
+    test_convert_exhaustive();
+    test_convert_special();
+    test_convert_levels();
+    test_convert_block();
+    test_convert_fixp();
+    test_convert_fixp_block();
+
+    printf("All convert tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,798 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/type/schema.h"
+#include "block_fixture.h"
+
+// LUT 头放不进当前页剩余部分时位于下一页页首
+static zc_dtt_lut_header_t* lut_header(zc_block_header_t* block)
+{
+    uint64_t offset = ZC_BLOCK_HEADER_SIZE + block->lut_offset;
+    if (offset % ZC_PAGE_DATA_SIZE + ZC_DTT_LUT_HEADER_SIZE > ZC_PAGE_DATA_SIZE) offset += ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+    return zc_block_offset_to_ptr(block, offset);
+}
+
+// 任意宽度的 RAWBITS 描述符，对象大小即描述符中的宽度
+static void rawbits_desc(uint8_t desc[9], uint64_t width)
+{
+    desc[0] = 0x5C;
+    memcpy(desc + 1, &width, sizeof(width));
+}
+
+static void shuffle(uint32_t* values, uint32_t count)
+{
+    uint32_t i;
+    for (i = count - 1; i > 0; i--)
+    {
+        uint32_t j = (uint32_t)rand() % (i + 1);
+        uint32_t tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
+
+// 沿叶子链表检查键严格升序、条目与键一致，返回条目总数
+static uint32_t check_leaf_chain(zc_block_header_t* block)
+{
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    if (hdr->index_height == 0) return 0;
+
+    zc_dtt_index_node_t* node = zc_block_offset_to_ptr(block, hdr->index_root_offset);
+    uint32_t level;
+    for (level = 1; level < hdr->index_height; level++)
+    {
+        assert(!node->is_leaf && node->count > 0);
+        node = zc_block_offset_to_ptr(block, node->slots[0]);
+    }
+
+    uint32_t total = 0;
+    uint64_t last = 0;
+    while (node != NULL)
+    {
+        assert(node->is_leaf && node->count > 0 && node->count <= ZC_DTT_INDEX_FANOUT);
+        uint32_t i;
+        for (i = 0; i < node->count; i++)
+        {
+            zc_dtt_lut_entry_t* entry = zc_block_offset_to_ptr(block, node->slots[i]);
+            assert(entry->data_offset == node->keys[i]);
+            assert(total == 0 || node->keys[i] > last);
+            last = node->keys[i];
+            total++;
+        }
+        for (; i < ZC_DTT_INDEX_FANOUT; i++) assert(node->keys[i] == UINT64_MAX);
+        node = node->next_leaf ? zc_block_offset_to_ptr(block, node->next_leaf) : NULL;
+    }
+    return total;
+}
+
+// 测试数百个条目的乱序插入与查找
+void test_dtt_index_insert() {
+    printf("Testing DTTA index insert...\n");
+
+    const uint32_t count = 1000;
+    zc_block_header_t* block = zc_test_block_setup(count * 16 + 64, 600);
+    uint8_t desc_i8[] = { 0x0A };
+
+    uint32_t* order = malloc(count * sizeof(uint32_t));
+    uint32_t i;
+    for (i = 0; i < count; i++) order[i] = i;
+    shuffle(order, count);
+
+    for (i = 0; i < count; i++)
+    {
+        assert(zc_dtt_add(block, (uint64_t)order[i] * 16, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_OK);
+    }
+
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    assert(hdr->entry_count == count);
+    assert(hdr->index_height >= 3);
+    assert(hdr->descriptor_length == count);
+    assert(check_leaf_chain(block) == count);
+
+    uint64_t q;
+    for (q = 0; q < (uint64_t)count * 16 + 64; q++)
+    {
+        zc_dtt_lut_entry_t* entry;
+        uint64_t obj_offset;
+        assert(zc_dtt_get_entry_by_data_offset(block, q, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        if (q < (uint64_t)count * 16 && q % 16 < 8)
+        {
+            assert(entry != NULL && entry->data_offset == q - q % 16 && entry->obj_width == 8);
+            assert(entry->type_tag == 0x0A);
+            assert(obj_offset == q - q % 16);
+        }
+        else
+        {
+            assert(entry == NULL);
+            assert(obj_offset == (q < (uint64_t)count * 16 ? q - q % 16 + 8 : (uint64_t)count * 16 - 8));
+        }
+    }
+
+    uint8_t* desc;
+    uint64_t desc_len, obj_offset;
+    assert(zc_dtt_get_desc_by_data_offset(block, 16 * 517 + 3, &desc, &desc_len, &obj_offset) == ZC_INTERNAL_OK);
+    assert(desc != NULL && desc[0] == 0x0A && desc_len == 1 && obj_offset == 16 * 517);
+
+    // 与前后条目重叠
+    assert(zc_dtt_add(block, 16 * 300 + 4, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(zc_dtt_add(block, 16 * 300 + 9, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(zc_dtt_add(block, 16 * 300, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(hdr->entry_count == count);
+
+    // 宽度须与描述符的对象大小一致，截断的描述符被拒绝
+    uint8_t desc_bad[] = { 0x0D };
+    assert(zc_dtt_add(block, 16 * 300 + 8, 4, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_dtt_add(block, 16 * 300 + 8, 8, desc_bad, sizeof(desc_bad)) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(hdr->entry_count == count);
+
+    // 填满空洞
+    assert(zc_dtt_add(block, 16 * 300 + 8, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_OK);
+    assert(check_leaf_chain(block) == count + 1);
+
+    free(order);
+    zc_test_block_teardown();
+    printf("  Passed index insert test\n");
+}
+
+// 测试 modify 移动条目，叶子被清空时从树中摘除
+void test_dtt_index_modify() {
+    printf("Testing DTTA index modify...\n");
+
+    const uint32_t count = 300;
+    const uint64_t moved_base = 16 * count;
+    zc_block_header_t* block = zc_test_block_setup(moved_base * 2, 600);
+    uint8_t desc_raw4[9], desc_raw8[9], desc_raw17[9];
+    uint8_t desc_i4[] = { 0x08 };
+    rawbits_desc(desc_raw4, 4);
+    rawbits_desc(desc_raw8, 8);
+    rawbits_desc(desc_raw17, 17);
+
+    uint32_t* order = malloc(count * sizeof(uint32_t));
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        order[i] = i;
+        assert(zc_dtt_add(block, (uint64_t)i * 16, 4, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_OK);
+    }
+
+    // 自身不参与重叠检查，但不可覆盖相邻条目
+    assert(zc_dtt_modify(block, 160, 160, 8, desc_raw8, sizeof(desc_raw8)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_modify(block, 160, 160, 17, desc_raw17, sizeof(desc_raw17)) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(zc_dtt_modify(block, 160, 170, 8, desc_raw8, sizeof(desc_raw8)) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(zc_dtt_modify(block, 160, 164, 4, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_modify(block, 164, 160, 4, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_modify(block, 161, 161, 4, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_dtt_modify(block, 160, 160, 4, desc_i4, sizeof(desc_i4)) == ZC_INTERNAL_DTTA_DESC_MISMATCH);
+
+    // 宽度须与新描述符的对象大小一致
+    assert(zc_dtt_modify(block, 160, 160, 8, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_dtt_modify(block, 160, 164, 4, desc_raw8, sizeof(desc_raw8)) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    // 乱序把全部条目逆序移到高区
+    shuffle(order, count);
+    for (i = 0; i < count; i++)
+    {
+        uint64_t from = (uint64_t)order[i] * 16;
+        uint64_t to = moved_base + (uint64_t)(count - 1 - order[i]) * 16;
+        assert(zc_dtt_modify(block, from, to, 4, desc_raw4, sizeof(desc_raw4)) == ZC_INTERNAL_OK);
+        if (i % 37 == 0) assert(check_leaf_chain(block) == count);
+    }
+
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    assert(hdr->entry_count == count);
+    assert(check_leaf_chain(block) == count);
+
+    for (i = 0; i < count; i++)
+    {
+        zc_dtt_lut_entry_t* entry;
+        uint64_t obj_offset;
+        assert(zc_dtt_get_entry_by_data_offset(block, (uint64_t)i * 16, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        assert(entry == NULL && obj_offset == 0);
+
+        assert(zc_dtt_get_entry_by_data_offset(block, moved_base + (uint64_t)i * 16 + 3, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        assert(entry != NULL && entry->data_offset == moved_base + (uint64_t)i * 16 && obj_offset == entry->data_offset);
+    }
+
+    // 单条目树移动后仍可查找
+    zc_test_block_teardown();
+    zc_block_header_t* small = zc_test_block_setup(1024, 8);
+    assert(zc_dtt_add(small, 64, 8, desc_raw8, sizeof(desc_raw8)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_modify(small, 64, 256, 8, desc_raw8, sizeof(desc_raw8)) == ZC_INTERNAL_OK);
+    assert(lut_header(small)->index_height == 1);
+    assert(check_leaf_chain(small) == 1);
+
+    free(order);
+    zc_test_block_teardown();
+    printf("  Passed index modify test\n");
+}
+
+// 测试堆空间不足时不留下部分修改
+void test_dtt_index_overflow() {
+    printf("Testing DTTA index overflow...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(1024, 6);
+    uint8_t desc_i8[] = { 0x0A };
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+
+    uint32_t added = 0;
+    zc_internal_result_t res = ZC_INTERNAL_OK;
+    while (res == ZC_INTERNAL_OK)
+    {
+        uint64_t heap_used = hdr->heap_used;
+        res = zc_dtt_add(block, (uint64_t)added * 8, 8, desc_i8, sizeof(desc_i8));
+        if (res == ZC_INTERNAL_OK) added++;
+        else assert(hdr->heap_used == heap_used);
+    }
+    assert(res == ZC_INTERNAL_DTTA_OVERFLOW);
+    assert(added > 0 && hdr->entry_count == added);
+    assert(check_leaf_chain(block) == added);
+
+    zc_test_block_teardown();
+    printf("  Passed index overflow test\n");
+}
+
+// 测试批量添加：乱序输入、与现有条目归并、失败时不留下部分修改
+void test_dtt_add_bulk() {
+    printf("Testing zc_dtt_add_bulk...\n");
+
+    const uint32_t count = 500;
+    zc_block_header_t* block = zc_test_block_setup(count * 16 + 64, 600);
+    uint8_t desc_i8[] = { 0x0A };
+    uint8_t desc_r4[] = { 0x0C, 0x00 };
+
+    uint32_t* order = malloc(count * sizeof(uint32_t));
+    zc_dtt_field_t* fields = malloc(count * sizeof(zc_dtt_field_t));
+    uint32_t i;
+    for (i = 0; i < count; i++) order[i] = i;
+    shuffle(order, count);
+
+    // 偶数槽逐个添加，奇数槽批量添加
+    for (i = 0; i < count; i += 2)
+    {
+        assert(zc_dtt_add(block, (uint64_t)i * 16, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_OK);
+    }
+    uint32_t field_count = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (order[i] % 2 == 0) continue;
+        fields[field_count].data_offset = (uint64_t)order[i] * 16;
+        fields[field_count].obj_width = 4;
+        fields[field_count].type_desc = desc_r4;
+        fields[field_count].desc_len = sizeof(desc_r4);
+        field_count++;
+    }
+
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    uint64_t heap_used = hdr->heap_used;
+
+    // 与现有条目重叠时整体失败
+    fields[field_count].data_offset = 16 * 10 + 4;
+    fields[field_count].obj_width = 4;
+    fields[field_count].type_desc = desc_r4;
+    fields[field_count].desc_len = sizeof(desc_r4);
+    assert(zc_dtt_add_bulk(block, fields, field_count + 1) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(hdr->entry_count == count / 2 && hdr->heap_used == heap_used);
+    assert(check_leaf_chain(block) == count / 2);
+
+    // 批内重复
+    fields[field_count].data_offset = fields[0].data_offset;
+    assert(zc_dtt_add_bulk(block, fields, field_count + 1) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(hdr->entry_count == count / 2 && hdr->heap_used == heap_used);
+
+    fields[field_count].obj_width = 0;
+    assert(zc_dtt_add_bulk(block, &fields[field_count], 1) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    // 宽度与描述符不符时整体失败
+    fields[field_count].data_offset = 16 * count;
+    fields[field_count].obj_width = 8;
+    assert(zc_dtt_add_bulk(block, fields, field_count + 1) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(hdr->entry_count == count / 2 && hdr->heap_used == heap_used);
+
+    assert(zc_dtt_add_bulk(block, fields, field_count) == ZC_INTERNAL_OK);
+    assert(hdr->entry_count == count);
+    assert(check_leaf_chain(block) == count);
+
+    for (i = 0; i < count; i++)
+    {
+        zc_dtt_lut_entry_t* entry;
+        uint64_t obj_offset;
+        assert(zc_dtt_get_entry_by_data_offset(block, (uint64_t)i * 16 + 3, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        assert(entry != NULL && entry->data_offset == (uint64_t)i * 16);
+        assert(entry->type_tag == (i % 2 ? 0x0C : 0x0A) && entry->obj_width == (i % 2 ? 4u : 8u));
+
+        uint8_t* desc;
+        uint64_t desc_len;
+        assert(zc_dtt_get_desc_by_data_offset(block, (uint64_t)i * 16, &desc, &desc_len, &obj_offset) == ZC_INTERNAL_OK);
+        assert(desc != NULL && desc[0] == entry->type_tag && desc_len == entry->desc_length);
+    }
+
+    // 之后仍可逐个添加
+    assert(zc_dtt_add(block, 16 * 7 + 8, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_OK);
+    assert(check_leaf_chain(block) == count + 1);
+
+    free(fields);
+    free(order);
+    zc_test_block_teardown();
+
+    // 空 DTTA 上批量建表
+    block = zc_test_block_setup(4096, 64);
+    zc_dtt_field_t layout[64];
+    for (i = 0; i < 64; i++)
+    {
+        layout[i].data_offset = (uint64_t)(63 - i) * 8;
+        layout[i].obj_width = 8;
+        layout[i].type_desc = desc_i8;
+        layout[i].desc_len = sizeof(desc_i8);
+    }
+    assert(zc_dtt_add_bulk(block, layout, 64) == ZC_INTERNAL_OK);
+    hdr = lut_header(block);
+    assert(hdr->entry_count == 64 && hdr->index_height == 2);
+    assert(check_leaf_chain(block) == 64);
+    zc_test_block_teardown();
+
+    // 非空 DTTA 上反复批量添加时复用旧索引节点，堆用量与一次批量添加相当
+    zc_dtt_field_t* many = malloc(400 * sizeof(zc_dtt_field_t));
+    for (i = 0; i < 400; i++)
+    {
+        many[i].data_offset = (uint64_t)i * 8;
+        many[i].obj_width = 8;
+        many[i].type_desc = desc_i8;
+        many[i].desc_len = sizeof(desc_i8);
+    }
+    block = zc_test_block_setup(4096, 200);
+    assert(zc_dtt_add_bulk(block, many, 400) == ZC_INTERNAL_OK);
+    uint64_t heap_once = lut_header(block)->heap_used;
+    zc_test_block_teardown();
+
+    block = zc_test_block_setup(4096, 200);
+    assert(zc_dtt_add_bulk(block, many, 300) == ZC_INTERNAL_OK);
+    for (i = 300; i < 400; i += 2)
+    {
+        assert(zc_dtt_add_bulk(block, &many[i], 2) == ZC_INTERNAL_OK);
+    }
+    hdr = lut_header(block);
+    assert(hdr->entry_count == 400);
+    assert(check_leaf_chain(block) == 400);
+    assert(hdr->heap_used < heap_once + heap_once / 8);
+    free(many);
+
+    zc_test_block_teardown();
+    printf("  Passed bulk add test\n");
+}
+
+// 测试冻结后的只读形式与 B+ 树查找结果一致
+void test_dtt_freeze() {
+    printf("Testing zc_dtt_freeze...\n");
+
+    const uint32_t count = 700;
+    const uint64_t extent = (uint64_t)count * 64;
+    zc_block_header_t* block = zc_test_block_setup(extent, 800);
+    uint8_t desc_i8[] = { 0x0A };
+
+    // 间隔与宽度不规则，部分粒度内有多个条目
+    zc_dtt_field_t* fields = malloc(count * sizeof(zc_dtt_field_t));
+    uint8_t (*descs)[9] = malloc(count * sizeof(*descs));
+    uint64_t next = 0;
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        next += (uint64_t)(rand() % 48);
+        fields[i].data_offset = next;
+        fields[i].obj_width = 1 + (uint64_t)(rand() % 24);
+        rawbits_desc(descs[i], fields[i].obj_width);
+        fields[i].type_desc = descs[i];
+        fields[i].desc_len = sizeof(descs[i]);
+        next += fields[i].obj_width;
+    }
+    assert(next < extent);
+    assert(zc_dtt_add_bulk(block, fields, count) == ZC_INTERNAL_OK);
+
+    uint64_t* expected_offset = malloc(extent * sizeof(uint64_t));
+    uint64_t* expected_obj = malloc(extent * sizeof(uint64_t));
+    uint64_t q;
+    for (q = 0; q < extent; q++)
+    {
+        zc_dtt_lut_entry_t* entry;
+        assert(zc_dtt_get_entry_by_data_offset(block, q, &entry, &expected_obj[q]) == ZC_INTERNAL_OK);
+        expected_offset[q] = entry ? entry->data_offset : UINT64_MAX;
+    }
+
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    assert(hdr->frozen);
+    assert(hdr->frozen_entry_offset % ZC_PAGE_DATA_SIZE == 0 && hdr->frozen_table_offset % ZC_PAGE_DATA_SIZE == 0);
+    assert(hdr->frozen_granule_count <= count * ZC_DTT_FROZEN_GRANULES_PER_ENTRY);
+    assert(hdr->frozen_dir_addr != 0);
+    assert(((uint64_t*)((zc_page_t*)(uintptr_t)hdr->frozen_dir_addr)->data)[0]
+        == (uint64_t)(uintptr_t)zc_block_offset_to_ptr(block, hdr->frozen_entry_offset));
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+
+    for (q = 0; q < extent; q++)
+    {
+        zc_dtt_lut_entry_t* entry;
+        uint64_t obj_offset;
+        assert(zc_dtt_get_entry_by_data_offset(block, q, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        assert((entry ? entry->data_offset : UINT64_MAX) == expected_offset[q]);
+        assert(obj_offset == expected_obj[q]);
+    }
+
+    // 冻结后只读
+    assert(zc_dtt_add(block, extent - 8, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_DTTA_FROZEN);
+    assert(zc_dtt_add_bulk(block, fields, 1) == ZC_INTERNAL_DTTA_FROZEN);
+    assert(zc_dtt_modify(block, fields[0].data_offset, fields[0].data_offset, fields[0].obj_width,
+        fields[0].type_desc, fields[0].desc_len) == ZC_INTERNAL_DTTA_FROZEN);
+
+    free(expected_obj);
+    free(expected_offset);
+    zc_test_block_teardown();
+
+    // 堆空间不足时保持可变形式
+    block = zc_test_block_setup(1024, 8);
+    assert(zc_dtt_add_bulk(block, fields, 20) == ZC_INTERNAL_OK);
+    hdr = lut_header(block);
+    uint64_t heap_used = hdr->heap_used;
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_DTTA_OVERFLOW);
+    assert(!hdr->frozen && hdr->heap_used == heap_used);
+    assert(zc_dtt_add(block, 1000, 8, desc_i8, sizeof(desc_i8)) == ZC_INTERNAL_OK);
+
+    // 空 DTTA 冻结后所有偏移都是空洞
+    zc_test_block_teardown();
+    block = zc_test_block_setup(1024, 16);
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    assert(zc_dtt_get_entry_by_data_offset(block, 512, &entry, &obj_offset) == ZC_INTERNAL_OK);
+    assert(entry == NULL && obj_offset == 0);
+    zc_test_block_teardown();
+
+    // 条目集中在一个粒度内时在粒度内二分
+    block = zc_test_block_setup(extent, 800);
+    for (i = 0; i < 200; i++)
+    {
+        fields[i].data_offset = (uint64_t)i * 2;
+        fields[i].obj_width = 1;
+        rawbits_desc(descs[i], 1);
+        fields[i].type_desc = descs[i];
+        fields[i].desc_len = sizeof(descs[i]);
+    }
+    assert(zc_dtt_add_bulk(block, fields, 200) == ZC_INTERNAL_OK);
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+    hdr = lut_header(block);
+    assert(((uint64_t)64 >> hdr->frozen_granule_shift) == 0);
+    for (q = 0; q < 1024; q++)
+    {
+        assert(zc_dtt_get_entry_by_data_offset(block, q, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        if (q < 400 && q % 2 == 0) assert(entry && entry->data_offset == q && obj_offset == q);
+        else if (q < 400) assert(entry == NULL && obj_offset == q);
+        else assert(entry == NULL && obj_offset == 399);
+    }
+
+    free(descs);
+    free(fields);
+    zc_test_block_teardown();
+    printf("  Passed freeze test\n");
+}
+
+static zc_internal_result_t resolve_byref(zc_block_header_t* block, uint64_t byref_offset, uint64_t target_offset,
+    uint64_t* out_obj_offset, uint64_t* out_obj_size)
+{
+    uint8_t* desc;
+    uint64_t desc_len;
+    *(uint64_t*)zc_block_offset_to_ptr(block, byref_offset) = target_offset;
+    return zc_dtt_get_desc_by_byref_offset(block, byref_offset, &desc, &desc_len, out_obj_offset, out_obj_size);
+}
+
+static uint64_t next_sibling(zc_block_header_t* block, uint64_t offset)
+{
+    uint64_t next;
+    assert(zc_dtt_get_next_sibling_offset(block, offset, &next) == ZC_INTERNAL_OK);
+    return next;
+}
+
+static void check_byref_ranges(zc_block_header_t* block, uint32_t count)
+{
+    uint64_t outer = (uint64_t)count * 24;
+    uint64_t refs = outer + 48;
+    uint64_t obj_offset, obj_size;
+
+    // 连续多条记录，跨越多个叶子
+    assert(resolve_byref(block, refs, 240, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(obj_offset == 240 && obj_size == 24);
+    assert(resolve_byref(block, refs + 16, 0, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(obj_offset == 0 && obj_size == 24);
+
+    // 范围止于记录中间、越过空洞、类型码不符、落在填充字节
+    assert(resolve_byref(block, refs + 32, 240, &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+    assert(resolve_byref(block, refs + 32, 24 * (count - 1), &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+    assert(resolve_byref(block, refs + 48, 240, &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+    assert(resolve_byref(block, refs + 64, 244, &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+
+    // 记录内部的平级字段：b、b..c、a..b（含填充）
+    assert(resolve_byref(block, refs + 64, 248, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(obj_offset == 240 && obj_size == 24);
+    assert(resolve_byref(block, refs + 80, 248, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(resolve_byref(block, refs + 96, 240, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(resolve_byref(block, refs + 112, 248, &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+    assert(resolve_byref(block, refs + 128, 240, &obj_offset, &obj_size) == ZC_INTERNAL_TYPE_ILLEGAL_BYREF);
+
+    // 嵌套两层：outer.inner.b .. outer.inner.c
+    assert(resolve_byref(block, refs + 80, outer + 16, &obj_offset, &obj_size) == ZC_INTERNAL_OK);
+    assert(obj_offset == outer && obj_size == 32);
+
+    assert(next_sibling(block, 240) == 264);
+    assert(next_sibling(block, 248) == 256);
+    assert(next_sibling(block, 256) == 258);
+    assert(next_sibling(block, 244) == 0);
+    assert(next_sibling(block, outer + 8) == outer + 32);
+    assert(next_sibling(block, outer + 16) == outer + 24);
+    assert(next_sibling(block, outer + 40) == 0);
+    assert(next_sibling(block, refs) == refs + 8);
+}
+
+static void run_byref_range()
+{
+    // record { I4 a; I8 b; I2 c; } 按 8 字节对齐：a@0, b@8, c@16，宽 24
+    uint8_t desc_record[] = { 0x11, 17, 0, 0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 8, 3, 0x08, 0x0A, 0x06 };
+    // outer { U1 flag; record inner; }：flag@0, inner@8，宽 32
+    uint8_t desc_outer[34] = { 0x11, 33, 0, 0, 0, 32, 0, 0, 0, 0, 0, 0, 0, 8, 2, 0x05 };
+    memcpy(desc_outer + 16, desc_record, sizeof(desc_record));
+
+    // 各 BYREF 声明的目标大小与类型码，第 4 个的类型码与记录不符
+    uint64_t sizes[] = { 24 * 5, 24, 24 * 5 + 8, 24 * 2, 8, 10, 16, 16, 22 };
+    uint8_t tags[] = { 0x11, 0x11, 0x11, 0x08, 0x11, 0x11, 0x11, 0x11, 0x11 };
+
+    const uint32_t count = 100;
+    uint64_t refs = (uint64_t)count * 24 + 48;
+    zc_block_header_t* block = zc_test_block_setup(refs + 256, 64);
+
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        assert(zc_dtt_add(block, (uint64_t)i * 24, 24, desc_record, sizeof(desc_record)) == ZC_INTERNAL_OK);
+    }
+    assert(zc_dtt_add(block, (uint64_t)count * 24, 32, desc_outer, sizeof(desc_outer)) == ZC_INTERNAL_OK);
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        uint8_t desc_byref[10] = { 0x10, tags[i] };
+        memcpy(desc_byref + 2, &sizes[i], sizeof(uint64_t));
+        assert(zc_dtt_add(block, refs + 16 * i, 8, desc_byref, sizeof(desc_byref)) == ZC_INTERNAL_OK);
+    }
+
+    check_byref_ranges(block, count);
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+    check_byref_ranges(block, count);
+
+    zc_test_block_teardown();
+}
+
+// 测试 BYREF 范围检查与平级字段边界，分别走描述符解析与驻留类型的展开字段表
+void test_dtt_byref_range() {
+    printf("Testing DTTA BYREF range validation...\n");
+
+    run_byref_range();
+
+    zc_type_registry_t* registry = malloc(sizeof(zc_type_registry_t));
+    assert(registry != NULL);
+    assert(zc_type_registry_init(registry) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_OK);
+
+    run_byref_range();
+    assert(atomic_load(&registry->layout_used) == 3 + 5);
+
+    zc_type_registry_attach(NULL);
+    free(registry);
+    printf("  Passed BYREF range test\n");
+}
+
+// 测试引用模式的块在首次写入时装入块内索引
+void test_dtt_index_from_schema() {
+    printf("Testing DTTA schema materialization...\n");
+
+    zc_type_registry_t* registry = malloc(sizeof(zc_type_registry_t));
+    zc_schema_table_t* table = malloc(sizeof(zc_schema_table_t));
+    assert(registry != NULL && table != NULL);
+    assert(zc_type_registry_init(registry) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_OK);
+    assert(zc_schema_table_init(table) == ZC_INTERNAL_OK);
+    assert(zc_schema_table_attach(table) == ZC_INTERNAL_OK);
+
+    const uint32_t count = 200;
+    uint8_t desc_r8[] = { 0x0D, 0x00 };
+    zc_schema_field_t* fields = malloc(count * sizeof(zc_schema_field_t));
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        fields[i].data_offset = (uint64_t)(count - 1 - i) * 16;
+        fields[i].obj_width = 8;
+        fields[i].type_desc = desc_r8;
+        fields[i].desc_len = sizeof(desc_r8);
+    }
+    zc_schema_id_t id;
+    assert(zc_schema_register(table, fields, count, &id) == ZC_INTERNAL_OK);
+
+    zc_block_header_t* block = zc_test_block_setup(count * 16 + 64, 200);
+    assert(zc_dtt_init_from_schema(block, id) == ZC_INTERNAL_OK);
+
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    assert(zc_dtt_get_entry_by_data_offset(block, 16 * 150 + 2, &entry, &obj_offset) == ZC_INTERNAL_OK);
+    assert(entry != NULL && entry->data_offset == 16 * 150 && obj_offset == 16 * 150);
+    assert(zc_dtt_get_entry_by_data_offset(block, 16 * 150 + 9, &entry, &obj_offset) == ZC_INTERNAL_OK);
+    assert(entry == NULL && obj_offset == 16 * 150 + 8);
+
+    // 首次写入装入块内 B+ 树
+    assert(zc_dtt_add(block, 16 * 150 + 8, 8, desc_r8, sizeof(desc_r8)) == ZC_INTERNAL_OK);
+    zc_dtt_lut_header_t* hdr = lut_header(block);
+    assert(hdr->schema_id == ZC_SCHEMA_ID_NONE);
+    assert(hdr->entry_count == count + 1);
+    assert(check_leaf_chain(block) == count + 1);
+
+    for (i = 0; i < count; i++)
+    {
+        assert(zc_dtt_get_entry_by_data_offset(block, (uint64_t)i * 16 + 7, &entry, &obj_offset) == ZC_INTERNAL_OK);
+        assert(entry != NULL && entry->data_offset == (uint64_t)i * 16 && entry->type_id != ZC_TYPE_ID_NONE);
+    }
+
+    free(fields);
+    zc_test_block_teardown();
+    zc_schema_table_attach(NULL);
+    zc_type_registry_attach(NULL);
+    free(table);
+    free(registry);
+    printf("  Passed schema materialization test\n");
+}
+
+// 测试对齐放置：张量与大数组按向量宽度对齐，其余取自然对齐，不跨页
+void test_dtt_add_aligned() {
+    printf("Testing DTTA aligned placement...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(ZC_PAGE_DATA_SIZE * 30, 120);
+    uint8_t desc_i1[] = { 0x04 };
+    uint8_t desc_r8[] = { 0x0D, 0x00 };
+    uint8_t desc_tensor[] = { 0x4C, 0x00, 0x01, 0x00, 0x20, 0x00 };
+    uint8_t desc_array[] = { 0x1D, 0x0D, 0x00, 0x10, 0x00, 0x00, 0x00 };
+    uint8_t desc_small[] = { 0x1D, 0x0D, 0x00, 0x02, 0x00, 0x00, 0x00 };
+
+    struct { const uint8_t* desc; uint64_t desc_len; uint64_t width; uint32_t align; } vars[] = {
+        { desc_i1, sizeof(desc_i1), 1, 1 },
+        { desc_r8, sizeof(desc_r8), 8, 8 },
+        { desc_tensor, sizeof(desc_tensor), 128, ZC_DTT_VECTOR_ALIGN },
+        { desc_i1, sizeof(desc_i1), 1, 1 },
+        { desc_array, sizeof(desc_array), 128, ZC_DTT_VECTOR_ALIGN },
+        { desc_small, sizeof(desc_small), 16, 8 },
+    };
+
+    uint64_t cursor = 0;
+    uint32_t round, i;
+    for (round = 0; round < 20; round++)
+    {
+        for (i = 0; i < sizeof(vars) / sizeof(vars[0]); i++)
+        {
+            uint64_t offset;
+            assert(zc_dtt_add_aligned(block, cursor, vars[i].width, vars[i].desc, vars[i].desc_len, 0, &offset)
+                == ZC_INTERNAL_OK);
+            assert(offset >= cursor);
+            assert(((uintptr_t)zc_block_offset_to_ptr(block, offset) & (vars[i].align - 1)) == 0);
+            assert(offset / ZC_PAGE_DATA_SIZE == (offset + vars[i].width - 1) / ZC_PAGE_DATA_SIZE);
+
+            zc_dtt_lut_entry_t* entry;
+            uint64_t obj_offset;
+            assert(zc_dtt_get_entry_by_data_offset(block, offset, &entry, &obj_offset) == ZC_INTERNAL_OK);
+            assert(entry != NULL && entry->data_offset == offset && entry->obj_width == vars[i].width);
+            cursor = offset + vars[i].width;
+        }
+    }
+    assert(lut_header(block)->entry_count == 20 * sizeof(vars) / sizeof(vars[0]));
+    assert(check_leaf_chain(block) == 20 * sizeof(vars) / sizeof(vars[0]));
+
+    // 显式对齐覆盖推导结果
+    uint64_t offset;
+    assert(zc_dtt_add_aligned(block, cursor, 1, desc_i1, sizeof(desc_i1), 32, &offset) == ZC_INTERNAL_OK);
+    assert(((uintptr_t)zc_block_offset_to_ptr(block, offset) & 31) == 0);
+    cursor = offset + 1;
+
+    assert(zc_dtt_add_aligned(block, cursor, 1, desc_i1, sizeof(desc_i1), 24, &offset) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_dtt_add_aligned(block, cursor, 1, desc_i1, sizeof(desc_i1), 0, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_dtt_add_aligned(block, 0, 8, desc_r8, sizeof(desc_r8), 0, &offset) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+
+    zc_test_block_teardown();
+    printf("  Passed aligned placement test\n");
+}
+
+// 测试带类型的查找：指纹在 add / modify 时写入，驻留与否结果一致，指纹碰撞时以字节比较兜底
+static void run_entry_typed()
+{
+    zc_block_header_t* block = zc_test_block_setup(ZC_PAGE_DATA_SIZE * 4, 20);
+    uint8_t desc_r8[] = { 0x0D, 0x00 };
+    uint8_t desc_r4[] = { 0x0C, 0x00 };
+    uint8_t desc_arr4[] = { 0x1D, 0x0D, 0x00, 0x04, 0x00, 0x00, 0x00 };
+    uint8_t desc_arr5[] = { 0x1D, 0x0D, 0x00, 0x05, 0x00, 0x00, 0x00 };
+    assert(zc_dtt_add(block, 0, 8, desc_r8, sizeof(desc_r8)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_add(block, 8, 4, desc_r4, sizeof(desc_r4)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_add(block, 16, 32, desc_arr4, sizeof(desc_arr4)) == ZC_INTERNAL_OK);
+
+    zc_dtt_type_key_t key_r8, key_r4, key_arr4, key_arr5;
+    assert(zc_dtt_type_key_init(desc_r8, sizeof(desc_r8), &key_r8) == ZC_INTERNAL_OK);
+    assert(zc_dtt_type_key_init(desc_r4, sizeof(desc_r4), &key_r4) == ZC_INTERNAL_OK);
+    assert(zc_dtt_type_key_init(desc_arr4, sizeof(desc_arr4), &key_arr4) == ZC_INTERNAL_OK);
+    assert(zc_dtt_type_key_init(desc_arr5, sizeof(desc_arr5), &key_arr5) == ZC_INTERNAL_OK);
+    // 准备键时即驻留，尚无条目使用的描述符也取得 ID
+    assert((key_r8.type_id != ZC_TYPE_ID_NONE) == (g_type_registry != NULL));
+    assert((key_arr5.type_id != ZC_TYPE_ID_NONE) == (g_type_registry != NULL));
+
+    zc_dtt_lut_entry_t* entry;
+    assert(zc_dtt_get_entry_typed(block, 0, &key_r8, &entry) == ZC_INTERNAL_OK && entry->data_offset == 0);
+    assert(entry->desc_hash == key_r8.desc_hash && zc_dtt_entry_fingerprint_matches(entry, &key_r8));
+    assert(zc_dtt_get_entry_typed(block, 0, &key_r4, &entry) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_dtt_get_entry_typed(block, 8, &key_r4, &entry) == ZC_INTERNAL_OK && entry->data_offset == 8);
+    assert(zc_dtt_get_entry_typed(block, 16, &key_arr4, &entry) == ZC_INTERNAL_OK);
+    assert(zc_dtt_get_entry_typed(block, 16, &key_arr5, &entry) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_dtt_get_entry_typed(block, 4, &key_r8, &entry) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_dtt_get_entry_typed(block, 12, &key_r4, &entry) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_dtt_get_entry_typed(block, 0, NULL, &entry) == ZC_INTERNAL_PARAM_PTRNULL);
+
+    // 修改描述符后指纹随之更新
+    assert(zc_dtt_modify(block, 16, 16, 40, desc_arr5, sizeof(desc_arr5)) == ZC_INTERNAL_OK);
+    assert(zc_dtt_type_key_init(desc_arr5, sizeof(desc_arr5), &key_arr5) == ZC_INTERNAL_OK);
+    assert(zc_dtt_get_entry_typed(block, 16, &key_arr5, &entry) == ZC_INTERNAL_OK);
+    assert(zc_dtt_entry_is_type(entry, key_arr5.type_id) == (g_type_registry != NULL));
+    assert(zc_dtt_get_entry_typed(block, 16, &key_arr4, &entry) == ZC_INTERNAL_TYPE_ERROR);
+
+    // 伪造指纹碰撞：指纹与长度相同，字节不同
+    zc_dtt_type_key_t forged = key_arr4;
+    forged.desc_hash = entry->desc_hash;
+    forged.type_id = ZC_TYPE_ID_NONE;
+    assert(zc_dtt_entry_fingerprint_matches(entry, &forged));
+    assert(zc_dtt_get_entry_typed(block, 16, &forged, &entry) == ZC_INTERNAL_TYPE_ERROR);
+
+    // 按 ID 添加时以驻留时缓存的解码结果校验宽度
+    if (g_type_registry != NULL)
+    {
+        assert(zc_dtt_add_by_id(block, 64, 4, key_r8.type_id) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+        assert(zc_dtt_add_by_id(block, 64, 8, key_r8.type_id) == ZC_INTERNAL_OK);
+    }
+
+    // 冻结后条目保留指纹
+    assert(zc_dtt_freeze(block) == ZC_INTERNAL_OK);
+    assert(zc_dtt_get_entry_typed(block, 8, &key_r4, &entry) == ZC_INTERNAL_OK);
+    assert(zc_dtt_get_entry_typed(block, 8, &key_r8, &entry) == ZC_INTERNAL_TYPE_ERROR);
+
+    zc_test_block_teardown();
+}
+
+void test_dtt_entry_typed() {
+    printf("Testing DTTA typed entry lookup...\n");
+
+    run_entry_typed();
+
+    zc_type_registry_t* registry = malloc(sizeof(zc_type_registry_t));
+    assert(registry != NULL);
+    assert(zc_type_registry_init(registry) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_OK);
+
+    run_entry_typed();
+
+    zc_type_registry_attach(NULL);
+    free(registry);
+    printf("  Passed typed entry lookup test\n");
+}
+
+int main() {
+    printf("Starting DTTA index tests...\n");
+
+    srand(35);
+    test_dtt_index_insert();
+    test_dtt_index_modify();
+    test_dtt_index_overflow();
+    test_dtt_add_bulk();
+    test_dtt_freeze();
+    test_dtt_byref_range();
+    test_dtt_index_from_schema();
+    test_dtt_add_aligned();
+    test_dtt_entry_typed();
+
+    printf("All DTTA index tests passed!\n");
+    return 0;
+}
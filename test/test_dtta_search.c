@@ -0,0 +1,84 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta_search.h"
+
+static uint32_t reference_rank(const uint64_t* keys, uint32_t count, uint64_t key)
+{
+    uint32_t rank = 0;
+    while (rank < count && keys[rank] <= key) rank++;
+    return rank;
+}
+
+// 测试单组 16 个键
+void test_dtt_key_rank16() {
+    printf("Testing zc_dtt_key_rank16...\n");
+
+    uint64_t keys[ZC_DTT_KEY_BLOCK];
+    uint32_t i;
+    for (i = 0; i < ZC_DTT_KEY_BLOCK; i++) keys[i] = 128 + i * 8;
+
+    assert(zc_dtt_key_rank16(keys, 0) == 0);
+    assert(zc_dtt_key_rank16(keys, 127) == 0);
+    assert(zc_dtt_key_rank16(keys, 128) == 1);
+    assert(zc_dtt_key_rank16(keys, 135) == 1);
+    assert(zc_dtt_key_rank16(keys, 136) == 2);
+    assert(zc_dtt_key_rank16(keys, 128 + 15 * 8) == 16);
+    assert(zc_dtt_key_rank16(keys, UINT64_MAX) == 16);
+
+    // 高位键（无符号比较）
+    for (i = 0; i < ZC_DTT_KEY_BLOCK; i++) keys[i] = 0x7FFFFFFFFFFFFFF0ULL + i * 4;
+    assert(zc_dtt_key_rank16(keys, 0x7FFFFFFFFFFFFFFFULL) == 4);
+    assert(zc_dtt_key_rank16(keys, 0x8000000000000000ULL) == 5);
+    assert(zc_dtt_key_rank16(keys, 100) == 0);
+
+    printf("  Passed rank16 test\n");
+}
+
+// 测试哨兵填充与多组
+void test_dtt_key_rank_padded() {
+    printf("Testing zc_dtt_key_rank with sentinel padding...\n");
+
+    uint32_t count;
+    for (count = 0; count <= 70; count++)
+    {
+        uint32_t padded = ZC_DTT_KEY_PADDED_COUNT(count);
+        assert(padded % ZC_DTT_KEY_BLOCK == 0 && padded >= count && padded < count + ZC_DTT_KEY_BLOCK);
+
+        uint64_t* keys = malloc((padded + 1) * sizeof(uint64_t));
+        uint64_t next = 128;
+        uint32_t i;
+        for (i = 0; i < count; i++)
+        {
+            next += 1 + (uint64_t)(rand() % 32);
+            keys[i] = next;
+        }
+        for (; i < padded; i++) keys[i] = ZC_DTT_KEY_SENTINEL;
+
+        uint64_t q;
+        for (q = 0; q < next + 40; q++)
+        {
+            assert(zc_dtt_key_rank(keys, padded, q) == reference_rank(keys, count, q));
+        }
+        free(keys);
+    }
+
+    printf("  Passed padded rank test\n");
+}
+
+int main() {
+    printf("Starting DTTA search tests...\n");
+
+    // 每个指令集级别都跑一遍
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+        test_dtt_key_rank16();
+        test_dtt_key_rank_padded();
+    }
+
+    printf("All DTTA search tests passed!\n");
+    return 0;
+}
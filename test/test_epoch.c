@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "../src/memory/epoch.h"
+
+static zc_block_header_t* create_using_block(zc_writer_id_t writer_id, zc_time_t timestamp)
+{
+    zc_block_header_t* block = calloc(1, sizeof(zc_block_header_t));
+    block->state = ZC_BLOCK_STATE_USING;
+    block->writer_id = writer_id;
+    block->timestamp = timestamp;
+    return block;
+}
+
+void test_zc_acquire_block_for_reading_epoch() {
+    printf("Testing zc_acquire_block_for_reading_epoch...\n");
+
+    zc_epoch_domain_t* domain = malloc(sizeof(zc_epoch_domain_t));
+    assert(zc_epoch_domain_init(domain) == ZC_INTERNAL_OK);
+
+    zc_writer_id_t writer_id = 3;
+    zc_reader_id_t reader_id = ((uint64_t)writer_id << 32) | 1;
+    assert(zc_epoch_reader_register(domain, reader_id) == ZC_INTERNAL_OK);
+    assert(zc_epoch_reader_register(domain, reader_id) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 注册之前提交的块不可见
+    zc_epoch_slot_t* slot = zc_epoch_get_slot(domain, reader_id);
+    zc_time_t base = slot->visited_ts;
+    assert(base != 0);
+    zc_block_header_t* old_block = create_using_block(writer_id, base - 1);
+    assert(zc_acquire_block_for_reading_epoch(domain, old_block, reader_id) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    free(old_block);
+    printf("  Passed register watermark test\n");
+
+    zc_block_header_t* block = create_using_block(writer_id, base + 100);
+    zc_block_header_t snapshot;
+    memcpy(&snapshot, block, sizeof(snapshot));
+
+    // 正常获取，且不写块 Header
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_id) == ZC_INTERNAL_OK);
+    assert(memcmp(&snapshot, block, sizeof(snapshot)) == 0);
+    assert(slot->epoch == ZC_EPOCH_INITIAL);
+    assert(slot->visited_ts == base + 100);
+    printf("  Passed read-only acquire test\n");
+
+    // 同一个块不能被重复获取
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_id) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    printf("  Passed visited watermark test\n");
+
+    // 写入者不匹配
+    block->timestamp = base + 200;
+    block->writer_id = writer_id + 1;
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_id) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    printf("  Passed writer_id mismatch test\n");
+
+    assert(zc_release_block_from_reading_epoch(domain, reader_id) == ZC_INTERNAL_OK);
+    assert(slot->epoch == ZC_EPOCH_QUIESCENT);
+    printf("  Passed release test\n");
+
+    free(block);
+    free(domain);
+}
+
+void test_zc_acquire_block_for_cleaning_epoch() {
+    printf("Testing zc_acquire_block_for_cleaning_epoch...\n");
+
+    zc_epoch_domain_t* domain = malloc(sizeof(zc_epoch_domain_t));
+    zc_epoch_domain_init(domain);
+
+    zc_writer_id_t writer_id = 0;
+    zc_reader_id_t reader_a = ((uint64_t)writer_id << 32) | 0;
+    zc_reader_id_t reader_b = ((uint64_t)writer_id << 32) | 5;
+    zc_epoch_reader_register(domain, reader_a);
+    zc_epoch_reader_register(domain, reader_b);
+
+    zc_block_header_t* block = create_using_block(writer_id, zc_epoch_get_slot(domain, reader_b)->visited_ts + 10);
+
+    // 读取者 B 尚未访问
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_a) == ZC_INTERNAL_OK);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    assert(block->retire_epoch == 0);
+    printf("  Passed unvisited reader test\n");
+
+    // 两者都已访问后退役，A 仍持有块，宽限期未过
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_b) == ZC_INTERNAL_OK);
+    zc_release_block_from_reading_epoch(domain, reader_b);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    assert(block->retire_epoch == ZC_EPOCH_INITIAL);
+    assert(domain->global_epoch == ZC_EPOCH_INITIAL + 1);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    printf("  Passed grace period test\n");
+
+    // 退役后进入新纪元的读取者不能再获取该块
+    zc_reader_id_t reader_c = ((uint64_t)writer_id << 32) | 7;
+    zc_epoch_reader_register(domain, reader_c);
+    assert(zc_acquire_block_for_reading_epoch(domain, block, reader_c) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    zc_release_block_from_reading_epoch(domain, reader_c);
+    printf("  Passed retired block test\n");
+
+    // A 释放后宽限期结束
+    zc_release_block_from_reading_epoch(domain, reader_a);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_OK);
+    assert(block->state == ZC_BLOCK_STATE_CLEAN);
+    assert(block->retire_epoch == 0);
+    printf("  Passed reclaim test\n");
+
+    // 写入者引用
+    block->state = ZC_BLOCK_STATE_USING;
+    block->writer_ref[2] = true;
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    printf("  Passed writer reference test\n");
+
+    free(block);
+    free(domain);
+}
+
+static zc_block_header_t* create_writing_block(zc_writer_id_t writer_id)
+{
+    zc_block_header_t* block = calloc(1, sizeof(zc_block_header_t));
+    block->state = ZC_BLOCK_STATE_FREE;
+    block->writer_id = writer_id;
+    block->writer_ref[writer_id] = true;
+    return block;
+}
+
+void test_zc_commit_block_for_writing() {
+    printf("Testing zc_commit_block_for_writing...\n");
+
+    zc_epoch_domain_t* domain = malloc(sizeof(zc_epoch_domain_t));
+    zc_epoch_domain_init(domain);
+
+    zc_writer_id_t writer_id = 4;
+    zc_reader_id_t reader_id = ((uint64_t)writer_id << 32) | 2;
+    zc_epoch_reader_register(domain, reader_id);
+
+    // 先获取 A 再获取 B，B 先提交并被读取
+    zc_block_header_t* block_a = create_writing_block(writer_id);
+    zc_block_header_t* block_b = create_writing_block(writer_id);
+    assert(zc_commit_block_for_writing(block_b, writer_id) == ZC_INTERNAL_OK);
+    assert(block_b->state == ZC_BLOCK_STATE_USING);
+    assert(zc_acquire_block_for_reading_epoch(domain, block_b, reader_id) == ZC_INTERNAL_OK);
+    zc_release_block_from_reading_epoch(domain, reader_id);
+
+    // 后提交的 A 时间戳更新，不会被水位线误判为已访问
+    assert(zc_commit_block_for_writing(block_a, writer_id) == ZC_INTERNAL_OK);
+    assert(block_a->timestamp > block_b->timestamp);
+    assert(zc_acquire_block_for_reading_epoch(domain, block_a, reader_id) == ZC_INTERNAL_OK);
+    zc_release_block_from_reading_epoch(domain, reader_id);
+    printf("  Passed out-of-order commit test\n");
+
+    // 已提交或不由该写入者持有的块不能提交
+    assert(zc_commit_block_for_writing(block_a, writer_id) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    zc_block_header_t* block_c = create_writing_block(writer_id);
+    assert(zc_commit_block_for_writing(block_c, writer_id + 1) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    block_c->writer_ref[writer_id] = false;
+    assert(zc_commit_block_for_writing(block_c, writer_id) == ZC_INTERNAL_BLOCK_UNEXPECTED);
+    assert(block_c->state == ZC_BLOCK_STATE_FREE && block_c->timestamp == 0);
+    printf("  Passed commit ownership test\n");
+
+    free(block_c);
+    free(block_b);
+    free(block_a);
+    free(domain);
+}
+
+int main() {
+    printf("Starting epoch unit tests...\n\n");
+
+    test_zc_acquire_block_for_reading_epoch();
+    test_zc_acquire_block_for_cleaning_epoch();
+    test_zc_commit_block_for_writing();
+
+    printf("\nAll epoch unit tests passed!\n");
+    return 0;
+}
@@ -4,13 +4,16 @@
 #include <string.h>
 #include "../src/zora/handle.h"
 
+// 句柄地址字段只有 60 位，测试地址须落在其中
+#define HANDLE_ADDRESS_MASK ((1ULL << 60) - 1)
+
 // 测试 zora_encrypt_handle 函数
 void test_zora_encrypt_handle() {
     printf("Testing zora_encrypt_handle...\n");
     
     // 测试正常情况
     zc_handle_t out_handle;
-    void* test_ptr = (void*)0x123456789ABCDEF0;
+    void* test_ptr = (void*)0x023456789ABCDEF0;
     uint64_t key = 0xFEDCBA9876543210;
     uint8_t version = 0x05;
     
@@ -18,7 +21,7 @@ void test_zora_encrypt_handle() {
     
     // 验证结果
     assert(result == ZC_INTERNAL_OK);
-    assert(out_handle.address == ((uint64_t)test_ptr ^ key));
+    assert(out_handle.address == (((uint64_t)test_ptr ^ key) & HANDLE_ADDRESS_MASK));
     assert(out_handle.version == (version ^ (key >> 60)));
     
     // 测试空指针情况
@@ -34,7 +37,7 @@ void test_zora_decrypt_handle() {
     
     // 先创建一个加密的 handle
     zc_handle_t handle;
-    void* original_ptr = (void*)0x123456789ABCDEF0;
+    void* original_ptr = (void*)0x023456789ABCDEF0;
     uint64_t key = 0xFEDCBA9876543210;
     
     // 使用 encrypt 函数创建 handle
@@ -66,7 +69,7 @@ void test_zora_decrypt_handle() {
 void test_encrypt_then_decrypt() {
     printf("Testing encrypt then decrypt...\n");
     
-    void* original_ptr = (void*)0x123456789ABCDEF0;
+    void* original_ptr = (void*)0x023456789ABCDEF0;
     uint64_t key = 0xFEDCBA9876543210;
     uint8_t version = 0x05;
     
@@ -0,0 +1,358 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/zora/operator.h"
+#include "../src/simd/simd.h"
+#include "block_fixture.h"
+
+// 逐页读写，模拟写入者与读取者访问块内变量
+static void block_write(zc_block_header_t* block, uint64_t offset, const void* src, uint64_t len)
+{
+    const uint8_t* p = src;
+    while (len > 0)
+    {
+        uint64_t n = ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+        if (n > len) n = len;
+        memcpy(zc_block_offset_to_ptr(block, offset), p, n);
+        offset += n;
+        p += n;
+        len -= n;
+    }
+}
+
+static void block_read(zc_block_header_t* block, uint64_t offset, void* dst, uint64_t len)
+{
+    uint8_t* p = dst;
+    while (len > 0)
+    {
+        uint64_t n = ZC_PAGE_DATA_SIZE - offset % ZC_PAGE_DATA_SIZE;
+        if (n > len) n = len;
+        memcpy(p, zc_block_offset_to_ptr(block, offset), n);
+        offset += n;
+        p += n;
+        len -= n;
+    }
+}
+
+static const uint8_t kind_tags[ZC_NUMERIC_KIND_COUNT] = { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D };
+
+static void add_array(zc_block_header_t* block, uint64_t offset, zc_numeric_kind_t kind, uint32_t count)
+{
+    uint8_t desc[7] = { 0x1D, kind_tags[kind], 0x00 };
+    uint32_t desc_len = kind >= ZC_NUMERIC_F32 ? 7 : 6;
+    memcpy(desc + desc_len - 4, &count, sizeof(count));
+    assert(zc_dtt_add(block, offset, (uint64_t)count * zc_numeric_kind_size(kind), desc, desc_len) == ZC_INTERNAL_OK);
+}
+
+static void store_value(zc_numeric_kind_t kind, void* dst, double v)
+{
+    zc_numeric_value_t value;
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  value.i8 = (int8_t)v;    break;
+        case ZC_NUMERIC_U8:  value.u8 = (uint8_t)v;   break;
+        case ZC_NUMERIC_I16: value.i16 = (int16_t)v;  break;
+        case ZC_NUMERIC_U16: value.u16 = (uint16_t)v; break;
+        case ZC_NUMERIC_I32: value.i32 = (int32_t)v;  break;
+        case ZC_NUMERIC_U32: value.u32 = (uint32_t)v; break;
+        case ZC_NUMERIC_I64: value.i64 = (int64_t)v;  break;
+        case ZC_NUMERIC_U64: value.u64 = (uint64_t)v; break;
+        case ZC_NUMERIC_F32: value.f32 = (float)v;    break;
+        default:             value.f64 = v;           break;
+    }
+    memcpy(dst, value.bytes, zc_numeric_kind_size(kind));
+}
+
+static double load_value(zc_numeric_kind_t kind, const void* src)
+{
+    zc_numeric_value_t value;
+    memcpy(value.bytes, src, zc_numeric_kind_size(kind));
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  return value.i8;
+        case ZC_NUMERIC_U8:  return value.u8;
+        case ZC_NUMERIC_I16: return value.i16;
+        case ZC_NUMERIC_U16: return value.u16;
+        case ZC_NUMERIC_I32: return value.i32;
+        case ZC_NUMERIC_U32: return value.u32;
+        case ZC_NUMERIC_I64: return (double)value.i64;
+        case ZC_NUMERIC_U64: return (double)value.u64;
+        case ZC_NUMERIC_F32: return value.f32;
+        default:             return value.f64;
+    }
+}
+
+static double scalar_value(const zc_operator_scalar_t* s)
+{
+    return load_value((zc_numeric_kind_t)s->kind, s->value.bytes);
+}
+
+// 整型的取值跨越窄类型的全部范围，和与积必须在加宽后的类型中累加；浮点取半整数使结果可精确比较
+static double random_value(zc_numeric_kind_t kind)
+{
+    switch (kind)
+    {
+        case ZC_NUMERIC_I8:  return (double)(rand() % 256 - 128);
+        case ZC_NUMERIC_U8:  return (double)(rand() % 256);
+        case ZC_NUMERIC_I16: return (double)(rand() % 65536 - 32768);
+        case ZC_NUMERIC_U16: return (double)(rand() % 65536);
+        case ZC_NUMERIC_F32:
+        case ZC_NUMERIC_F64: return (double)(rand() % 2001 - 1000) * 0.5;
+        default:             return (double)(rand() % 200001 - (kind % 2 == 0 ? 100000 : 0));
+    }
+}
+
+// 每种元素类型的两个 SZARRAY 页相位不同，跨越多个页边界
+static void run_arrays(uint32_t count)
+{
+    zc_block_header_t* block = zc_test_block_setup(131072, 300);
+    uint64_t offset = 1001;
+    uint8_t* a = malloc((uint64_t)count * 8);
+    uint8_t* b = malloc((uint64_t)count * 8);
+
+    uint32_t kind;
+    for (kind = 0; kind < ZC_NUMERIC_KIND_COUNT; kind++)
+    {
+        uint32_t size = zc_numeric_kind_size(kind);
+        uint64_t offset_a = offset;
+        uint64_t offset_b = offset_a + (uint64_t)count * size + 5;
+        add_array(block, offset_a, kind, count);
+        add_array(block, offset_b, kind, count);
+
+        double sum = 0;
+        double dot = 0;
+        double lo = INFINITY;
+        double hi = -INFINITY;
+        uint32_t i;
+        for (i = 0; i < count; i++)
+        {
+            double va = random_value(kind);
+            double vb = random_value(kind);
+            store_value(kind, a + (uint64_t)i * size, va);
+            store_value(kind, b + (uint64_t)i * size, vb);
+            sum += va;
+            dot += va * vb;
+            if (va < lo) lo = va;
+            if (va > hi) hi = va;
+        }
+        block_write(block, offset_a, a, (uint64_t)count * size);
+        block_write(block, offset_b, b, (uint64_t)count * size);
+
+        zc_operator_scalar_t result;
+        assert(zc_operator_sum(block, offset_a, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == (kind >= ZC_NUMERIC_F32 ? ZC_NUMERIC_F64 : kind % 2 == 0 ? ZC_NUMERIC_I64 : ZC_NUMERIC_U64));
+        assert(scalar_value(&result) == sum);
+
+        double mean;
+        assert(zc_operator_mean(block, offset_a, &mean) == ZC_INTERNAL_OK);
+        assert(fabs(mean - sum / count) < 1e-9);
+
+        assert(zc_operator_dot(block, offset_a, offset_b, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == (kind >= ZC_NUMERIC_F32 ? ZC_NUMERIC_F64 : kind % 2 == 0 ? ZC_NUMERIC_I64 : ZC_NUMERIC_U64));
+        if (kind == ZC_NUMERIC_U64 || kind == ZC_NUMERIC_I64 || kind == ZC_NUMERIC_U32 || kind == ZC_NUMERIC_I32)
+        {
+            // 积可能超过 double 的精确范围，按 64 位整型重算
+            uint64_t ref = 0;
+            for (i = 0; i < count; i++)
+            {
+                ref += (uint64_t)(int64_t)load_value(kind, a + (uint64_t)i * size) *
+                       (uint64_t)(int64_t)load_value(kind, b + (uint64_t)i * size);
+            }
+            assert(result.value.u64 == ref);
+        }
+        else
+        {
+            assert(scalar_value(&result) == dot);
+        }
+
+        assert(zc_operator_min(block, offset_a, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == kind && scalar_value(&result) == lo);
+        assert(zc_operator_max(block, offset_a, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == kind && scalar_value(&result) == hi);
+
+        // 限制到中间一半的值域，再与逐元素结果比较
+        uint8_t clamp_lo[8];
+        uint8_t clamp_hi[8];
+        double cl = lo + (hi - lo) / 4;
+        double ch = hi - (hi - lo) / 4;
+        store_value(kind, clamp_lo, cl);
+        store_value(kind, clamp_hi, ch);
+        cl = load_value(kind, clamp_lo);
+        ch = load_value(kind, clamp_hi);
+        assert(zc_operator_clamp(block, offset_a, clamp_lo, clamp_hi, size) == ZC_INTERNAL_OK);
+        block_read(block, offset_a, b, (uint64_t)count * size);
+        for (i = 0; i < count; i++)
+        {
+            double v = load_value(kind, a + (uint64_t)i * size);
+            if (v < cl) v = cl;
+            if (v > ch) v = ch;
+            assert(load_value(kind, b + (uint64_t)i * size) == v);
+        }
+
+        // 乘 3，整型按元素类型回绕
+        uint8_t factor[8];
+        store_value(kind, factor, 3);
+        memcpy(a, b, (uint64_t)count * size);
+        assert(zc_operator_scale(block, offset_a, factor, size) == ZC_INTERNAL_OK);
+        block_read(block, offset_a, b, (uint64_t)count * size);
+        for (i = 0; i < count; i++)
+        {
+            zc_numeric_value_t v;
+            memcpy(v.bytes, a + (uint64_t)i * size, size);
+            switch (kind)
+            {
+                case ZC_NUMERIC_I8:
+                case ZC_NUMERIC_U8:  v.u8 = (uint8_t)(v.u8 * 3u);    break;
+                case ZC_NUMERIC_I16:
+                case ZC_NUMERIC_U16: v.u16 = (uint16_t)(v.u16 * 3u); break;
+                case ZC_NUMERIC_I32:
+                case ZC_NUMERIC_U32: v.u32 = v.u32 * 3u;             break;
+                case ZC_NUMERIC_I64:
+                case ZC_NUMERIC_U64: v.u64 = v.u64 * 3u;             break;
+                case ZC_NUMERIC_F32: v.f32 = v.f32 * 3.0f;           break;
+                default:             v.f64 = v.f64 * 3.0;            break;
+            }
+            assert(memcmp(b + (uint64_t)i * size, v.bytes, size) == 0);
+        }
+
+        assert(zc_operator_scale(block, offset_a, factor, size == 8 ? 4 : 8) == ZC_INTERNAL_PARAM_ERROR);
+        assert(zc_operator_clamp(block, offset_a, clamp_lo, clamp_hi, size == 8 ? 4 : 8) == ZC_INTERNAL_PARAM_ERROR);
+
+        offset = offset_b + (uint64_t)count * size + 3;
+    }
+
+    free(a);
+    free(b);
+    zc_test_block_teardown();
+}
+
+// 每个指令集级别都跑一遍，长度覆盖只有尾部、恰好整向量与多个页
+void test_operator_arrays() {
+    printf("Testing operators over numeric arrays...\n");
+
+    static const uint32_t counts[] = { 7, 64, 300, 1500 };
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+        uint32_t i;
+        for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) run_arrays(counts[i]);
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    printf("  Passed\n");
+}
+
+// 元素数超过窄累加通道的并入间隔，通道不能溢出
+void test_operator_wide_sum() {
+    printf("Testing operator accumulation width...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(81920, 200);
+    uint32_t count = 20000;
+    uint8_t* values = malloc(count * 2);
+
+    memset(values, 0xFF, count);
+    add_array(block, 777, ZC_NUMERIC_U8, count);
+    block_write(block, 777, values, count);
+
+    uint16_t* halves = (uint16_t*)values;
+    uint32_t i;
+    for (i = 0; i < count; i++) halves[i] = 0x8000;   // INT16_MIN
+    add_array(block, 30001, ZC_NUMERIC_I16, count);
+    block_write(block, 30001, values, (uint64_t)count * 2);
+
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+
+        zc_operator_scalar_t result;
+        assert(zc_operator_sum(block, 777, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == ZC_NUMERIC_U64 && result.value.u64 == 255ull * count);
+        assert(zc_operator_dot(block, 777, 777, &result) == ZC_INTERNAL_OK);
+        assert(result.value.u64 == 255ull * 255ull * count);
+
+        assert(zc_operator_sum(block, 30001, &result) == ZC_INTERNAL_OK);
+        assert(result.kind == ZC_NUMERIC_I64 && result.value.i64 == -32768ll * count);
+        assert(zc_operator_dot(block, 30001, 30001, &result) == ZC_INTERNAL_OK);
+        assert(result.value.i64 == 32768ll * 32768ll * count);
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    free(values);
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+// FLOATTENSOR、NaN 与错误路径
+void test_operator_float() {
+    printf("Testing operators over float tensors...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(8192, 32);
+
+    uint8_t tensor_desc[] = { 0x4C, 0x00, 0x02, 0x00, 0x10, 0x00, 0x10, 0x00 };
+    float tensor[256];
+    uint32_t i;
+    for (i = 0; i < 256; i++) tensor[i] = (float)i * 0.5f - 10.0f;
+    assert(zc_dtt_add(block, 130, sizeof(tensor), tensor_desc, sizeof(tensor_desc)) == ZC_INTERNAL_OK);
+    block_write(block, 130, tensor, sizeof(tensor));
+
+    zc_operator_scalar_t result;
+    assert(zc_operator_sum(block, 130, &result) == ZC_INTERNAL_OK);
+    assert(result.kind == ZC_NUMERIC_F64 && result.value.f64 == 13760.0);
+    double mean;
+    assert(zc_operator_mean(block, 130, &mean) == ZC_INTERNAL_OK && mean == 53.75);
+
+    // NaN 不参与最值，限制后保持 NaN
+    tensor[3] = NAN;
+    block_write(block, 130, tensor, sizeof(tensor));
+    assert(zc_operator_min(block, 130, &result) == ZC_INTERNAL_OK && result.value.f32 == -10.0f);
+    assert(zc_operator_max(block, 130, &result) == ZC_INTERNAL_OK && result.value.f32 == 117.5f);
+    assert(zc_operator_sum(block, 130, &result) == ZC_INTERNAL_OK && isnan(result.value.f64));
+
+    float lo = 0.0f;
+    float hi = 1.0f;
+    assert(zc_operator_clamp(block, 130, &lo, &hi, sizeof(float)) == ZC_INTERNAL_OK);
+    block_read(block, 130, tensor, sizeof(tensor));
+    assert(isnan(tensor[3]) && tensor[0] == 0.0f && tensor[21] == 0.5f && tensor[255] == 1.0f);
+
+    // 标量变量视为单元素数组
+    uint8_t r8_desc[] = { 0x0D, 0x00 };
+    double scalar = 3.25;
+    assert(zc_dtt_add(block, 2100, sizeof(scalar), r8_desc, sizeof(r8_desc)) == ZC_INTERNAL_OK);
+    block_write(block, 2100, &scalar, sizeof(scalar));
+    double factor = -2.0;
+    assert(zc_operator_scale(block, 2100, &factor, sizeof(factor)) == ZC_INTERNAL_OK);
+    assert(zc_operator_max(block, 2100, &result) == ZC_INTERNAL_OK && result.value.f64 == -6.5);
+
+    // 元素类型或元素数不同的点积
+    uint8_t r8_pair_desc[] = { 0x1D, 0x0D, 0x00, 0x02, 0x00, 0x00, 0x00 };
+    assert(zc_dtt_add(block, 2120, 16, r8_pair_desc, sizeof(r8_pair_desc)) == ZC_INTERNAL_OK);
+    assert(zc_operator_dot(block, 130, 2100, &result) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_operator_dot(block, 2100, 2120, &result) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 非数值变量与非变量起始偏移
+    uint8_t str_desc[] = { 0x0E, 0x04, 0x00, 0x00, 0x00 };
+    assert(zc_dtt_add(block, 2200, 8, str_desc, sizeof(str_desc)) == ZC_INTERNAL_OK);
+    assert(zc_operator_sum(block, 2200, &result) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_operator_sum(block, 2101, &result) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_operator_sum(block, 130, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_operator_clamp(block, 130, NULL, &hi, sizeof(float)) == ZC_INTERNAL_PARAM_PTRNULL);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(42);
+
+    test_operator_arrays();
+    test_operator_wide_sum();
+    test_operator_float();
+
+    printf("All operator tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "../src/system/reaper.h"
+
+#define MS 1000000ULL
+
+static uint32_t g_hook_count = 0;
+static zc_thread_timeout_info_t g_last_info;
+
+static void on_thread_timeout(int event, void* data, void* user_ctx)
+{
+    assert(event == ZC_REAPER_HOOK_ON_THREAD_TIMEOUT);
+    assert(user_ctx == &g_hook_count);
+    g_hook_count++;
+    memcpy(&g_last_info, data, sizeof(g_last_info));
+}
+
+static zc_block_header_t* create_using_block(zc_writer_id_t writer_id, zc_time_t timestamp)
+{
+    zc_block_header_t* block = calloc(1, sizeof(zc_block_header_t));
+    block->state = ZC_BLOCK_STATE_USING;
+    block->writer_id = writer_id;
+    block->timestamp = timestamp;
+    return block;
+}
+
+// 测试纪元模式下超时的读取者不再阻挡回收
+void test_zc_reaper_epoch_reader() {
+    printf("Testing zc_reaper epoch reader timeout...\n");
+
+    zc_epoch_domain_t* domain = malloc(sizeof(zc_epoch_domain_t));
+    zc_watchdog_t* wd = malloc(sizeof(zc_watchdog_t));
+    zc_reaper_t* reaper = malloc(sizeof(zc_reaper_t));
+    assert(zc_epoch_domain_init(domain) == ZC_INTERNAL_OK);
+    assert(zc_reaper_init(reaper, domain, on_thread_timeout, &g_hook_count) == ZC_INTERNAL_OK);
+    assert(zc_watchdog_init(wd, 100 * MS, 0, zc_reaper_on_timeout, reaper) == ZC_INTERNAL_OK);
+    g_hook_count = 0;
+
+    zc_writer_id_t writer_id = 2;
+    zc_reader_id_t live = ((uint64_t)writer_id << 32) | 1;
+    zc_reader_id_t dead = ((uint64_t)writer_id << 32) | 4;
+    assert(zc_epoch_reader_register(domain, live) == ZC_INTERNAL_OK);
+    assert(zc_epoch_reader_register(domain, dead) == ZC_INTERNAL_OK);
+    assert(zc_watchdog_watch(wd, zc_heartbeat_slot_of_reader(live), 0) == ZC_INTERNAL_OK);
+    assert(zc_watchdog_watch(wd, zc_heartbeat_slot_of_reader(dead), 0) == ZC_INTERNAL_OK);
+
+    zc_block_header_t* block = create_using_block(writer_id, zc_epoch_get_slot(domain, dead)->visited_ts + 10);
+    assert(zc_acquire_block_for_reading_epoch(domain, block, live) == ZC_INTERNAL_OK);
+    assert(zc_release_block_from_reading_epoch(domain, live) == ZC_INTERNAL_OK);
+
+    // dead 从未访问该块，超时前块无法退役
+    zc_time_t now;
+    for (now = 50 * MS; now < 100 * MS; now += 50 * MS)
+    {
+        zc_heartbeat_send(wd, zc_heartbeat_slot_of_reader(live), now);
+        assert(zc_watchdog_advance(wd, now, NULL) == ZC_INTERNAL_OK);
+    }
+    assert(g_hook_count == 0);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    assert(block->retire_epoch == 0);
+
+    uint32_t expired = 0;
+    for (; now <= 400 * MS; now += 50 * MS)
+    {
+        uint32_t count;
+        zc_heartbeat_send(wd, zc_heartbeat_slot_of_reader(live), now);
+        assert(zc_watchdog_advance(wd, now, &count) == ZC_INTERNAL_OK);
+        expired += count;
+    }
+    assert(expired == 1 && g_hook_count == 1 && reaper->reaped_count == 1);
+    assert(!g_last_info.is_writer && g_last_info.reader_id == dead && g_last_info.writer_id == writer_id);
+    assert(g_last_info.block == NULL);
+    assert(!zc_epoch_get_slot(domain, dead)->online);
+    assert(zc_epoch_get_slot(domain, live)->online);
+
+    // 退役后宽限期结束即可回收
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+    assert(block->retire_epoch != 0);
+    assert(zc_acquire_block_for_cleaning_epoch(domain, block) == ZC_INTERNAL_OK);
+    assert(block->state == ZC_BLOCK_STATE_CLEAN);
+
+    printf("  Passed epoch reader timeout test\n");
+    free(block);
+    free(reaper);
+    free(wd);
+    free(domain);
+}
+
+// 测试标志模式下超时线程的 writer_ref / reader_ref 被清除
+void test_zc_reaper_block_refs() {
+    printf("Testing zc_reaper block ref timeout...\n");
+
+    zc_watchdog_t* wd = malloc(sizeof(zc_watchdog_t));
+    zc_reaper_t* reaper = malloc(sizeof(zc_reaper_t));
+    assert(zc_reaper_init(reaper, NULL, on_thread_timeout, &g_hook_count) == ZC_INTERNAL_OK);
+    assert(zc_watchdog_init(wd, 100 * MS, 0, zc_reaper_on_timeout, reaper) == ZC_INTERNAL_OK);
+    g_hook_count = 0;
+
+    zc_writer_id_t writer_id = 1;
+    zc_reader_id_t reader_id = ((uint64_t)writer_id << 32) | 7;
+    uint32_t writer_slot = zc_heartbeat_slot_of_writer(writer_id);
+    uint32_t reader_slot = zc_heartbeat_slot_of_reader(reader_id);
+    zc_watchdog_watch(wd, writer_slot, 0);
+    zc_watchdog_watch(wd, reader_slot, 0);
+
+    zc_block_header_t* block = create_using_block(writer_id, 10);
+    assert(zc_acquire_block_for_reading(block, reader_id) == ZC_INTERNAL_OK);
+    zc_reaper_hold(reaper, reader_slot, block);
+    assert(zc_acquire_block_for_cleaning(block) == ZC_INTERNAL_BLOCK_UNRELEASED);
+
+    // 写入者仍持有另一个块
+    zc_block_header_t* writing = create_using_block(writer_id, 20);
+    writing->writer_ref[writer_id] = true;
+    zc_reaper_hold(reaper, writer_slot, writing);
+
+    // 读取者先停止心跳
+    zc_time_t now;
+    for (now = 50 * MS; now <= 300 * MS; now += 50 * MS)
+    {
+        zc_heartbeat_send(wd, writer_slot, now);
+        zc_watchdog_advance(wd, now, NULL);
+    }
+    assert(g_hook_count == 1);
+    assert(!g_last_info.is_writer && g_last_info.reader_id == reader_id && g_last_info.block == block);
+    assert(!block->reader_ref[7] && block->reader_visited[7]);
+    assert(reaper->held[reader_slot].block == NULL);
+    assert(zc_acquire_block_for_cleaning(block) == ZC_INTERNAL_OK);
+    assert(zc_acquire_block_for_cleaning(writing) == ZC_INTERNAL_BLOCK_UNRELEASED);
+
+    zc_watchdog_advance(wd, 1000 * MS, NULL);
+    assert(g_hook_count == 2);
+    assert(g_last_info.is_writer && g_last_info.writer_id == writer_id && g_last_info.block == writing);
+    assert(!writing->writer_ref[writer_id]);
+    assert(zc_acquire_block_for_cleaning(writing) == ZC_INTERNAL_OK);
+
+    // 未持有块的线程超时只触发钩子
+    zc_watchdog_watch(wd, 0, 1000 * MS);
+    zc_watchdog_advance(wd, 2000 * MS, NULL);
+    assert(g_hook_count == 3 && g_last_info.is_writer && g_last_info.writer_id == 0 && g_last_info.block == NULL);
+
+    printf("  Passed block ref timeout test\n");
+    free(writing);
+    free(block);
+    free(reaper);
+    free(wd);
+}
+
+int main() {
+    printf("Starting reaper tests...\n");
+
+    test_zc_reaper_epoch_reader();
+    test_zc_reaper_block_refs();
+
+    printf("All reaper tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/schema.h"
+
+static zc_type_registry_t* registry;
+static zc_schema_table_t* table;
+
+static void setup()
+{
+    registry = malloc(sizeof(zc_type_registry_t));
+    table = malloc(sizeof(zc_schema_table_t));
+    assert(registry != NULL && table != NULL);
+    assert(zc_type_registry_init(registry) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_OK);
+    assert(zc_schema_table_init(table) == ZC_INTERNAL_OK);
+    assert(zc_schema_table_attach(table) == ZC_INTERNAL_OK);
+}
+
+static void teardown()
+{
+    zc_schema_table_attach(NULL);
+    zc_type_registry_attach(NULL);
+    free(table);
+    free(registry);
+}
+
+// 测试注册：乱序字段被排序，描述符被驻留
+void test_schema_register() {
+    printf("Testing zc_schema_register...\n");
+    setup();
+
+    uint8_t desc_i8[] = { 0x0A };
+    uint8_t desc_r8[] = { 0x0D, 0x00 };
+    uint8_t desc_u2[] = { 0x07 };
+
+    zc_schema_field_t fields[] = {
+        { 144, 8, desc_r8, sizeof(desc_r8) },
+        { 128, 8, desc_i8, sizeof(desc_i8) },
+        { 136, 2, desc_u2, sizeof(desc_u2) },
+    };
+
+    zc_schema_id_t id;
+    assert(zc_schema_register(table, fields, 3, &id) == ZC_INTERNAL_OK);
+    assert(id != ZC_SCHEMA_ID_NONE);
+
+    zc_schema_slot_t* schema = zc_schema_get(table, id);
+    assert(schema != NULL);
+    assert(schema->entry_count == 3);
+    assert(zc_schema_data_extent(schema) == 152);
+
+    zc_dtt_lut_entry_t* entries = &table->entries[schema->first_entry];
+    assert(entries[0].data_offset == 128 && entries[0].obj_width == 8 && entries[0].type_tag == 0x0A);
+    assert(entries[1].data_offset == 136 && entries[1].obj_width == 2 && entries[1].type_tag == 0x07);
+    assert(entries[2].data_offset == 144 && entries[2].obj_width == 8 && entries[2].type_tag == 0x0D);
+
+    zc_type_id_t r8_id;
+    assert(zc_type_registry_find(registry, desc_r8, sizeof(desc_r8), &r8_id) == ZC_INTERNAL_OK);
+    assert(entries[2].type_id == r8_id);
+    assert(zc_dtt_entry_is_type(&entries[2], r8_id));
+    assert(!zc_dtt_entry_is_type(&entries[0], r8_id));
+
+    // 第二个模式得到不同的 ID
+    zc_schema_id_t id2;
+    assert(zc_schema_register(table, fields, 1, &id2) == ZC_INTERNAL_OK);
+    assert(id2 != id);
+
+    printf("  Passed register test\n");
+    teardown();
+}
+
+// 测试非法布局
+void test_schema_register_invalid() {
+    printf("Testing zc_schema_register invalid layouts...\n");
+    setup();
+
+    uint8_t desc_i4[] = { 0x08 };
+    zc_schema_field_t overlap[] = {
+        { 128, 4, desc_i4, sizeof(desc_i4) },
+        { 130, 4, desc_i4, sizeof(desc_i4) },
+    };
+    zc_schema_field_t zero_width[] = {
+        { 128, 0, desc_i4, sizeof(desc_i4) },
+    };
+    zc_schema_field_t wrong_width[] = {
+        { 128, 4, desc_i4, sizeof(desc_i4) },
+        { 136, 8, desc_i4, sizeof(desc_i4) },
+    };
+
+    zc_schema_id_t id;
+    assert(zc_schema_register(table, overlap, 0, &id) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_schema_register(table, overlap, 2, &id) == ZC_INTERNAL_DTTA_DATA_CONFLICT);
+    assert(zc_schema_register(table, zero_width, 1, &id) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_schema_register(table, wrong_width, 2, &id) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    // 非法布局不占用模式槽位
+    assert(atomic_load(&table->schema_count) == 0);
+    assert(zc_schema_get(table, 1) == NULL);
+    assert(zc_schema_get(table, ZC_SCHEMA_ID_NONE) == NULL);
+
+    // 未 attach 驻留表
+    zc_type_registry_attach(NULL);
+    assert(zc_schema_register(table, overlap, 1, &id) == ZC_INTERNAL_RUN_NOT_INITIALIZED);
+
+    printf("  Passed invalid layout test\n");
+    teardown();
+}
+
+int main() {
+    printf("Starting schema tests...\n");
+
+    test_schema_register();
+    test_schema_register_invalid();
+
+    printf("All schema tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "../src/system/stale_index.h"
+
+#define MS 1000000ULL
+
+static uint32_t g_stale_count = 0;
+static uint32_t g_last_missing = 0;
+static zc_block_header_t* g_last_block = NULL;
+
+static void on_stale(void* ctx, zc_writer_id_t writer_id, zc_block_header_t* block,
+    uint32_t missing_reader_mask, zc_time_t age)
+{
+    (void)ctx;
+    (void)writer_id;
+    (void)age;
+    g_stale_count++;
+    g_last_missing = missing_reader_mask;
+    g_last_block = block;
+}
+
+void test_zc_stale_index_scan() {
+    printf("Testing zc_stale_index_scan...\n");
+
+    zc_stale_index_t* index = malloc(sizeof(zc_stale_index_t));
+    assert(zc_stale_index_init(index, 10 * MS, on_stale, NULL) == ZC_INTERNAL_OK);
+
+    zc_writer_id_t writer_id = 2;
+    zc_stale_index_set_reader(index, ((uint64_t)writer_id << 32) | 0, true);
+    zc_stale_index_set_reader(index, ((uint64_t)writer_id << 32) | 3, true);
+
+    zc_block_header_t* blocks = calloc(3, sizeof(zc_block_header_t));
+    uint32_t i;
+    for (i = 0; i < 3; i++)
+    {
+        blocks[i].state = ZC_BLOCK_STATE_USING;
+        blocks[i].writer_id = writer_id;
+        blocks[i].timestamp = (i + 1) * MS;
+        assert(zc_stale_index_push(index, writer_id, &blocks[i], blocks[i].timestamp) == ZC_INTERNAL_OK);
+    }
+
+    // 块 0 已被全部访问，块 1 缺读取者 3，块 2 尚未过期
+    blocks[0].reader_visited[0] = true;
+    blocks[0].reader_visited[3] = true;
+    blocks[1].reader_visited[0] = true;
+
+    uint32_t stale = 0;
+    assert(zc_stale_index_scan(index, 12 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 1);
+    assert(g_last_block == &blocks[1]);
+    assert(g_last_missing == (1U << 3));
+    // 报告后出队，停在尚未过期的块 2
+    assert(index->fifos[writer_id].head == 2);
+    printf("  Passed stale detection test\n");
+
+    // 同一个块只报告一次
+    assert(zc_stale_index_scan(index, 12 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 0);
+    printf("  Passed report once test\n");
+
+    // 块 2 过期
+    assert(zc_stale_index_scan(index, 14 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 1);
+    assert(g_last_block == &blocks[2]);
+    assert(g_last_missing == ((1U << 0) | (1U << 3)));
+    assert(index->fifos[writer_id].head == 3);
+    printf("  Passed expired block test\n");
+
+    // 被回收复用的块出队，不报告
+    blocks[0].timestamp = 20 * MS;
+    assert(zc_stale_index_push(index, writer_id, &blocks[0], 20 * MS) == ZC_INTERNAL_OK);
+    blocks[0].timestamp = 50 * MS;
+    assert(zc_stale_index_scan(index, 40 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 0);
+    assert(index->fifos[writer_id].head == 4);
+    printf("  Passed recycled block test\n");
+
+    // 读取者注销后不再等待
+    blocks[1].timestamp = 60 * MS;
+    assert(zc_stale_index_push(index, writer_id, &blocks[1], 60 * MS) == ZC_INTERNAL_OK);
+    zc_stale_index_set_reader(index, ((uint64_t)writer_id << 32) | 0, false);
+    zc_stale_index_set_reader(index, ((uint64_t)writer_id << 32) | 3, false);
+    assert(zc_stale_index_scan(index, 61 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 0);
+    assert(index->fifos[writer_id].head == 5);
+    printf("  Passed unregistered reader test\n");
+
+    free(blocks);
+    free(index);
+}
+
+void test_zc_stale_index_push_full() {
+    printf("Testing zc_stale_index_push with full FIFO...\n");
+
+    zc_stale_index_t* index = malloc(sizeof(zc_stale_index_t));
+    zc_stale_index_init(index, 10 * MS, NULL, NULL);
+
+    zc_block_header_t block;
+    memset(&block, 0, sizeof(block));
+    uint32_t i;
+    for (i = 0; i < ZC_STALE_FIFO_CAPACITY; i++)
+    {
+        assert(zc_stale_index_push(index, 0, &block, block.timestamp) == ZC_INTERNAL_OK);
+    }
+    assert(zc_stale_index_push(index, 0, &block, block.timestamp) == ZC_INTERNAL_GENERAL_ERROR);
+    assert(index->fifos[0].dropped_count == 1);
+    printf("  Passed full FIFO test\n");
+
+    // 过期块报告后出队，FIFO 重新可用
+    block.state = ZC_BLOCK_STATE_USING;
+    zc_stale_index_set_reader(index, 1, true);
+    uint32_t stale = 0;
+    assert(zc_stale_index_scan(index, 20 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == ZC_STALE_FIFO_CAPACITY);
+    assert(zc_stale_index_push(index, 0, &block, block.timestamp) == ZC_INTERNAL_OK);
+    printf("  Passed drain after report test\n");
+
+    free(index);
+}
+
+void test_zc_stale_index_epoch() {
+    printf("Testing zc_stale_index_scan in epoch mode...\n");
+
+    zc_stale_index_t* index = malloc(sizeof(zc_stale_index_t));
+    zc_epoch_domain_t* domain = malloc(sizeof(zc_epoch_domain_t));
+    assert(zc_stale_index_init(index, 10 * MS, on_stale, NULL) == ZC_INTERNAL_OK);
+    assert(zc_epoch_domain_init(domain) == ZC_INTERNAL_OK);
+    assert(zc_stale_index_set_epoch_domain(index, domain) == ZC_INTERNAL_OK);
+
+    zc_writer_id_t writer_id = 1;
+    zc_reader_id_t reader_a = ((uint64_t)writer_id << 32) | 0;
+    zc_reader_id_t reader_b = ((uint64_t)writer_id << 32) | 2;
+    assert(zc_epoch_reader_register(domain, reader_a) == ZC_INTERNAL_OK);
+    assert(zc_epoch_reader_register(domain, reader_b) == ZC_INTERNAL_OK);
+    zc_stale_index_set_reader(index, reader_a, true);
+    zc_stale_index_set_reader(index, reader_b, true);
+
+    zc_block_header_t* blocks = calloc(2, sizeof(zc_block_header_t));
+    uint32_t i;
+    for (i = 0; i < 2; i++)
+    {
+        blocks[i].state = ZC_BLOCK_STATE_USING;
+        blocks[i].writer_id = writer_id;
+        blocks[i].timestamp = zc_epoch_get_slot(domain, reader_a)->visited_ts + (i + 1) * MS;
+        assert(zc_stale_index_push(index, writer_id, &blocks[i], blocks[i].timestamp) == ZC_INTERNAL_OK);
+    }
+
+    // 纪元模式不写 reader_visited：读取者 a 读过两块，读取者 b 只读过块 0
+    assert(zc_acquire_block_for_reading_epoch(domain, &blocks[0], reader_a) == ZC_INTERNAL_OK);
+    assert(zc_acquire_block_for_reading_epoch(domain, &blocks[0], reader_b) == ZC_INTERNAL_OK);
+    assert(zc_acquire_block_for_reading_epoch(domain, &blocks[1], reader_a) == ZC_INTERNAL_OK);
+    assert(!blocks[0].reader_visited[0] && !blocks[1].reader_visited[0]);
+
+    uint32_t stale = 0;
+    g_last_block = NULL;
+    assert(zc_stale_index_scan(index, blocks[1].timestamp + 10 * MS, &stale) == ZC_INTERNAL_OK);
+    assert(stale == 1);
+    assert(g_last_block == &blocks[1]);
+    assert(g_last_missing == (1U << 2));
+    assert(index->fifos[writer_id].head == 2);
+    printf("  Passed epoch watermark test\n");
+
+    free(blocks);
+    free(domain);
+    free(index);
+}
+
+int main() {
+    printf("Starting stale index unit tests...\n\n");
+
+    test_zc_stale_index_scan();
+    test_zc_stale_index_push_full();
+    test_zc_stale_index_epoch();
+
+    printf("\nAll stale index unit tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/zora/tensor.h"
+#include "block_fixture.h"
+
+// 3 x 4 x 5 的 FLOAT 张量，跨越页边界，元素 (i, j, k) 的位模式为 100 * i + 10 * j + k
+#define D0 3
+#define D1 4
+#define D2 5
+
+static const uint64_t tensor_offset = ZC_PAGE_DATA_SIZE - 100;
+
+static zc_block_header_t* setup_tensor()
+{
+    zc_block_header_t* block = zc_test_block_setup(ZC_PAGE_DATA_SIZE * 4, 10);
+    uint8_t desc[] = { 0x4C, 0x00, 3, 0, D0, 0, D1, 0, D2, 0 };
+    assert(zc_dtt_add(block, tensor_offset, D0 * D1 * D2 * 4, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+
+    uint32_t i;
+    for (i = 0; i < D0 * D1 * D2; i++)
+    {
+        uint32_t value = 100 * (i / (D1 * D2)) + 10 * (i / D2 % D1) + i % D2;
+        uint32_t b;
+        for (b = 0; b < 4; b++)
+        {
+            *(uint8_t*)zc_block_offset_to_ptr(block, tensor_offset + 4 * i + b) = (uint8_t)(value >> (8 * b));
+        }
+    }
+    return block;
+}
+
+void test_tensor_view_init() {
+    printf("Testing tensor view shape and stride...\n");
+
+    zc_block_header_t* block = setup_tensor();
+    zc_tensor_view_t view;
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(view.rank == 3 && view.element_size == 4 && view.offset == tensor_offset);
+    assert(view.shape[0] == D0 && view.shape[1] == D1 && view.shape[2] == D2);
+    assert(view.stride[0] == 4 * D1 * D2 && view.stride[1] == 4 * D2 && view.stride[2] == 4);
+    assert(zc_tensor_view_element_count(&view) == D0 * D1 * D2);
+    assert(zc_tensor_view_is_contiguous(&view));
+
+    uint64_t index[3] = { 2, 3, 4 };
+    uint32_t value;
+    assert(zc_tensor_view_read(&view, index, &value) == ZC_INTERNAL_OK && value == 234);
+    index[2] = D2;
+    assert(zc_tensor_view_read(&view, index, &value) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 非张量变量与非起始偏移
+    uint8_t desc_i4[] = { 0x08 };
+    assert(zc_dtt_add(block, 0, 4, desc_i4, sizeof(desc_i4)) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_init(block, 0, &view) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_tensor_view_init(block, tensor_offset + 4, &view) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_tensor_view_init(block, tensor_offset, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+
+    // 描述符声明的张量大于变量宽度：添加时即被拒绝，条目被改坏时视图同样拒绝
+    uint8_t desc_big[] = { 0x4C, 0x00, 2, 0, 10, 0, 10, 0 };
+    assert(zc_dtt_add(block, 1000, 16, desc_big, sizeof(desc_big)) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_dtt_add(block, 1000, 400, desc_big, sizeof(desc_big)) == ZC_INTERNAL_OK);
+    zc_dtt_lut_entry_t* entry;
+    uint64_t obj_offset;
+    assert(zc_dtt_get_entry_by_data_offset(block, 1000, &entry, &obj_offset) == ZC_INTERNAL_OK && entry != NULL);
+    entry->obj_width = 16;
+    assert(zc_tensor_view_init(block, 1000, &view) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_tensor_view_slice() {
+    printf("Testing tensor view slice and select...\n");
+
+    zc_block_header_t* block = setup_tensor();
+    zc_tensor_view_t view;
+    uint32_t out[D0 * D1 * D2];
+
+    // 取第 1、3 列：[:, :, 1:5:2]
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_slice(&view, 2, 1, 2, 2) == ZC_INTERNAL_OK);
+    assert(!zc_tensor_view_is_contiguous(&view));
+    assert(zc_tensor_view_gather(&view, out, sizeof(out)) == ZC_INTERNAL_OK);
+    uint32_t i, j, k, n = 0;
+    for (i = 0; i < D0; i++)
+        for (j = 0; j < D1; j++)
+            for (k = 1; k < D2; k += 2) assert(out[n++] == 100 * i + 10 * j + k);
+
+    // 反向切片：[2::-1, 1, :]
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_slice(&view, 0, 2, 3, -1) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_select(&view, 1, 1) == ZC_INTERNAL_OK);
+    assert(view.rank == 2 && view.shape[0] == D0 && view.shape[1] == D2);
+    assert(zc_tensor_view_gather(&view, out, sizeof(out)) == ZC_INTERNAL_OK);
+    for (n = 0, i = 0; i < D0; i++)
+        for (k = 0; k < D2; k++) assert(out[n++] == 100 * (2 - i) + 10 + k);
+
+    // 单列：[1, :, 4]
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_select(&view, 2, 4) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_select(&view, 0, 1) == ZC_INTERNAL_OK);
+    assert(view.rank == 1 && view.shape[0] == D1);
+    assert(zc_tensor_view_gather(&view, out, D1 * 4) == ZC_INTERNAL_OK);
+    for (j = 0; j < D1; j++) assert(out[j] == 100 + 10 * j + 4);
+    assert(zc_tensor_view_gather(&view, out, D1 * 4 - 1) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 越界与非法参数
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_slice(&view, 3, 0, 1, 1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_slice(&view, 2, 0, 1, 0) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_slice(&view, 2, 5, 1, 1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_slice(&view, 2, 1, 3, 2) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_slice(&view, 2, 1, 3, -1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_slice(&view, 2, 1, 1, INT64_MIN) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_select(&view, 0, D0) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 空视图
+    assert(zc_tensor_view_slice(&view, 1, 0, 0, 1) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_element_count(&view) == 0);
+    assert(zc_tensor_view_gather(&view, NULL, 0) == ZC_INTERNAL_OK);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_tensor_view_transpose() {
+    printf("Testing tensor view transpose and reshape...\n");
+
+    zc_block_header_t* block = setup_tensor();
+    zc_tensor_view_t view;
+    uint32_t out[D0 * D1 * D2];
+
+    // (i, j, k) -> (k, i, j)
+    const uint32_t perm[3] = { 2, 0, 1 };
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_transpose(&view, perm) == ZC_INTERNAL_OK);
+    assert(view.shape[0] == D2 && view.shape[1] == D0 && view.shape[2] == D1);
+    assert(zc_tensor_view_gather(&view, out, sizeof(out)) == ZC_INTERNAL_OK);
+    uint32_t i, j, k, n = 0;
+    for (k = 0; k < D2; k++)
+        for (i = 0; i < D0; i++)
+            for (j = 0; j < D1; j++) assert(out[n++] == 100 * i + 10 * j + k);
+
+    // 转置后不连续，不能直接改变形状
+    const uint64_t flat[1] = { D0 * D1 * D2 };
+    assert(zc_tensor_view_reshape(&view, 1, flat) == ZC_INTERNAL_PARAM_ERROR);
+
+    const uint32_t bad[3] = { 0, 0, 1 };
+    assert(zc_tensor_view_transpose(&view, bad) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 连续视图：(3, 4, 5) -> (12, 5)，再取第 7 行
+    const uint64_t shape[2] = { D0 * D1, D2 };
+    const uint64_t wrong[2] = { D0 * D1, D2 + 1 };
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_reshape(&view, 2, wrong) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_tensor_view_reshape(&view, 2, shape) == ZC_INTERNAL_OK);
+    assert(view.stride[0] == 4 * D2 && view.stride[1] == 4);
+    assert(zc_tensor_view_select(&view, 0, 7) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_gather(&view, out, sizeof(out)) == ZC_INTERNAL_OK);
+    for (k = 0; k < D2; k++) assert(out[k] == 100 * 1 + 10 * 3 + k);
+
+    // 整体紧密拷贝
+    assert(zc_tensor_view_init(block, tensor_offset, &view) == ZC_INTERNAL_OK);
+    assert(zc_tensor_view_gather(&view, out, sizeof(out)) == ZC_INTERNAL_OK);
+    for (n = 0; n < D0 * D1 * D2; n++) assert(out[n] == 100 * (n / (D1 * D2)) + 10 * (n / D2 % D1) + n % D2);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    test_tensor_view_init();
+    test_tensor_view_slice();
+    test_tensor_view_transpose();
+
+    printf("All tensor view tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,323 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/simd/simd.h"
+#include "../src/zora/text.h"
+#include "block_fixture.h"
+
+// 参考实现：码位序列 → UTF-8 / UTF-16LE
+static uint64_t ref_utf8(const uint32_t* cps, uint64_t count, uint8_t* out)
+{
+    uint64_t n = 0;
+    uint64_t i;
+    for (i = 0; i < count; i++)
+    {
+        uint32_t c = cps[i];
+        if (c < 0x80) out[n++] = (uint8_t)c;
+        else if (c < 0x800)
+        {
+            out[n++] = (uint8_t)(0xC0 | c >> 6);
+            out[n++] = (uint8_t)(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            out[n++] = (uint8_t)(0xE0 | c >> 12);
+            out[n++] = (uint8_t)(0x80 | (c >> 6 & 0x3F));
+            out[n++] = (uint8_t)(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            out[n++] = (uint8_t)(0xF0 | c >> 18);
+            out[n++] = (uint8_t)(0x80 | (c >> 12 & 0x3F));
+            out[n++] = (uint8_t)(0x80 | (c >> 6 & 0x3F));
+            out[n++] = (uint8_t)(0x80 | (c & 0x3F));
+        }
+    }
+    return n;
+}
+
+static uint64_t ref_utf16(const uint32_t* cps, uint64_t count, uint16_t* out)
+{
+    uint64_t n = 0;
+    uint64_t i;
+    for (i = 0; i < count; i++)
+    {
+        uint32_t c = cps[i];
+        if (c < 0x10000) out[n++] = (uint16_t)c;
+        else
+        {
+            out[n++] = (uint16_t)(0xD800 + ((c - 0x10000) >> 10));
+            out[n++] = (uint16_t)(0xDC00 + ((c - 0x10000) & 0x3FF));
+        }
+    }
+    return n;
+}
+
+// 以长 ASCII 段为主，夹杂 2 / 3 / 4 字节字符，使向量路径与逐字符路径交替出现
+static uint32_t random_cp(uint32_t mix)
+{
+    uint32_t r = (uint32_t)rand();
+    if (r % 100 >= mix) return 0x20 + r / 100 % 0x5F;
+    switch (r / 100 % 3)
+    {
+        case 0:  return 0x80 + r / 300 % 0x780;
+        case 1:
+        {
+            uint32_t c = 0x800 + r / 300 % 0xF800;
+            return (c & 0xF800) == 0xD800 ? c + 0x800 : c;
+        }
+        default: return 0x10000 + r / 300 % 0x100000;
+    }
+}
+
+void test_text_validate() {
+    printf("Testing ASCII / UTF-16 validation...\n");
+
+    int level;
+    for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+    {
+        assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+
+        uint8_t ascii[300];
+        uint64_t index;
+        memset(ascii, 'a', sizeof(ascii));
+        assert(zc_text_validate_ascii(ascii, sizeof(ascii), &index) == ZC_INTERNAL_OK && index == sizeof(ascii));
+
+        uint32_t pos;
+        for (pos = 0; pos < sizeof(ascii); pos += 7)
+        {
+            ascii[pos] = 0x80;
+            assert(zc_text_validate_ascii(ascii, sizeof(ascii), &index) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && index == pos);
+            ascii[pos] = 'a';
+        }
+
+        // 代理对跨越向量组边界；组末孤立的高代理项、单独的低代理项与结尾的高代理项
+        uint16_t units[200];
+        uint32_t i;
+        for (i = 0; i < 200; i++) units[i] = (uint16_t)('A' + i % 26);
+        units[31] = 0xD83D;
+        units[32] = 0xDE00;
+        units[100] = 0x4E2D;
+        assert(zc_text_validate_utf16(units, 200, &index) == ZC_INTERNAL_OK && index == 200);
+
+        units[32] = 'x';
+        assert(zc_text_validate_utf16(units, 200, &index) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && index == 31);
+        units[31] = 'x';
+        units[70] = 0xDC00;
+        assert(zc_text_validate_utf16(units, 200, &index) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && index == 70);
+        units[70] = 'x';
+        units[199] = 0xDBFF;
+        assert(zc_text_validate_utf16(units, 200, &index) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && index == 199);
+
+        // 非对齐输入
+        uint8_t raw[2 * 64 + 1];
+        for (i = 0; i < 64; i++)
+        {
+            uint16_t u = (uint16_t)('a' + i % 26);
+            memcpy(raw + 1 + 2 * i, &u, 2);
+        }
+        assert(zc_text_validate_utf16(raw + 1, 64, &index) == ZC_INTERNAL_OK && index == 64);
+
+        assert(zc_text_validate_ascii(NULL, 0, &index) == ZC_INTERNAL_OK && index == 0);
+        assert(zc_text_validate_ascii(NULL, 1, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    }
+
+    printf("  Passed\n");
+}
+
+void test_text_transcode() {
+    printf("Testing UTF-16 / UTF-8 transcoding...\n");
+
+    const uint32_t count = 4000;
+    uint32_t* cps = malloc(count * sizeof(uint32_t));
+    uint8_t* utf8 = malloc(count * 4);
+    uint16_t* utf16 = malloc(count * 4);
+    uint8_t* out8 = malloc(count * 4 + 1);
+    uint16_t* out16 = malloc(count * 4 + 2);
+
+    const uint32_t mixes[] = { 0, 2, 30, 100 };
+    uint32_t m;
+    for (m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++)
+    {
+        uint32_t i;
+        for (i = 0; i < count; i++) cps[i] = random_cp(mixes[m]);
+        uint64_t len8 = ref_utf8(cps, count, utf8);
+        uint64_t len16 = ref_utf16(cps, count, utf16);
+
+        int level;
+        for (level = ZC_SIMD_BASELINE; level < ZC_SIMD_LEVEL_COUNT; level++)
+        {
+            assert(zc_simd_set_level((zc_simd_level_t)level) == ZC_INTERNAL_OK);
+
+            uint64_t n;
+            out8[len8] = 0x5A;
+            assert(zc_text_utf16_to_utf8(utf16, len16, out8, ZC_TEXT_UTF8_MAX_BYTES(len16), &n) == ZC_INTERNAL_OK);
+            assert(n == len8 && memcmp(out8, utf8, len8) == 0);
+
+            out16[len16] = 0x5A5A;
+            assert(zc_text_utf8_to_utf16(utf8, len8, out16, len8, &n) == ZC_INTERNAL_OK);
+            assert(n == len16 && memcmp(out16, utf16, len16 * 2) == 0 && out16[len16] == 0x5A5A);
+
+            // 容量恰好与差一
+            assert(zc_text_utf16_to_utf8(utf16, len16, out8, len8, &n) == ZC_INTERNAL_OK && n == len8);
+            assert(zc_text_utf16_to_utf8(utf16, len16, out8, len8 - 1, &n) == ZC_INTERNAL_PARAM_ERROR && n < len8);
+            assert(out8[len8] == 0x5A);
+            assert(zc_text_utf8_to_utf16(utf8, len8, out16, len16 - 1, &n) == ZC_INTERNAL_PARAM_ERROR && n < len16);
+        }
+    }
+    assert(zc_simd_set_level(ZC_SIMD_AVX512) == ZC_INTERNAL_OK);
+
+    // 非法 UTF-8：续字节开头、过长编码、代理项、超出范围、截断
+    const struct { uint8_t bytes[4]; uint32_t length; } bad[] = {
+        { { 0x80 }, 1 }, { { 0xC0, 0x80 }, 2 }, { { 0xC1, 0xBF }, 2 }, { { 0xE0, 0x80, 0x80 }, 3 },
+        { { 0xED, 0xA0, 0x80 }, 3 }, { { 0xF0, 0x80, 0x80, 0x80 }, 4 }, { { 0xF4, 0x90, 0x80, 0x80 }, 4 },
+        { { 0xF5, 0x80, 0x80, 0x80 }, 4 }, { { 0xE2, 0x82 }, 2 }, { { 0xC3, 0x41 }, 2 },
+    };
+    uint32_t b;
+    for (b = 0; b < sizeof(bad) / sizeof(bad[0]); b++)
+    {
+        uint8_t text[80];
+        memset(text, 'a', sizeof(text));
+        memcpy(text + 70, bad[b].bytes, bad[b].length);
+        uint64_t n;
+        assert(zc_text_utf8_to_utf16(text, 70 + bad[b].length, out16, 100, &n) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+        assert(n == 70);
+    }
+
+    // 不成对的代理项
+    uint16_t lone[] = { 'a', 0xDC00, 'b' };
+    uint64_t n;
+    assert(zc_text_utf16_to_utf8(lone, 3, out8, 16, &n) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && n == 1);
+    uint16_t tail[] = { 'a', 'b', 0xD800 };
+    assert(zc_text_utf16_to_utf8(tail, 3, out8, 16, &n) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT && n == 2);
+
+    assert(zc_text_utf16_to_utf8(lone, 0, NULL, 0, &n) == ZC_INTERNAL_OK && n == 0);
+    assert(zc_text_utf8_to_utf16(utf8, 1, NULL, 1, &n) == ZC_INTERNAL_PARAM_PTRNULL);
+
+    free(cps);
+    free(utf8);
+    free(utf16);
+    free(out8);
+    free(out16);
+    printf("  Passed\n");
+}
+
+// 在 offset 处注册 chars 个字符的 STRING（或字节的 ASCIISTRING）
+static void add_string(zc_block_header_t* block, uint64_t offset, uint8_t type, uint32_t chars)
+{
+    uint8_t desc[5] = { type };
+    memcpy(desc + 1, &chars, sizeof(chars));
+    uint64_t width = type == 0x0E ? (uint64_t)chars * 2 : chars;
+    assert(zc_dtt_add(block, offset, width, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+}
+
+void test_text_block() {
+    printf("Testing STRING / ASCIISTRING load and store...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(ZC_PAGE_DATA_SIZE * 12, 20);
+    const uint64_t small = 200;                              // 一页之内
+    const uint64_t large = ZC_PAGE_DATA_SIZE * 2 + 11;       // 奇数偏移且跨越多页
+    const uint64_t ascii = ZC_PAGE_DATA_SIZE * 9 - 5;        // 跨页
+    add_string(block, small, 0x0E, 16);
+    add_string(block, large, 0x0E, 1500);
+    add_string(block, ascii, 0x4E, 40);
+
+    uint32_t cps[1500];
+    uint8_t utf8[6000];
+    uint8_t out[6000];
+    uint64_t n;
+
+    // 一页之内：写满后读回，短串以 0 结束
+    uint32_t i;
+    for (i = 0; i < 16; i++)
+    {
+        cps[i] = random_cp(50);
+        if (cps[i] >= 0x10000) cps[i] = 0xE9;
+    }
+    cps[15] = 0x4E2D;
+    uint64_t len = ref_utf8(cps, 16, utf8);
+    assert(zc_text_store_utf8(block, small, utf8, len) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, small, out, sizeof(out), &n) == ZC_INTERNAL_OK);
+    assert(n == len && memcmp(out, utf8, len) == 0);
+
+    assert(zc_text_store_utf8(block, small, (const uint8_t*)"IBM", 3) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, small, out, sizeof(out), &n) == ZC_INTERNAL_OK);
+    assert(n == 3 && memcmp(out, "IBM", 3) == 0);
+    assert(*(uint16_t*)zc_block_offset_to_ptr(block, small + 30) == 0);
+
+    // 跨页：代理对落在分批缓冲的边界上
+    uint64_t units = 0;
+    for (i = 0; i < 1000; i++)
+    {
+        cps[i] = (units == ZC_TEXT_STAGE_UNITS - 1 || units == 2 * ZC_TEXT_STAGE_UNITS - 1) ? 0x1F600 : random_cp(20);
+        units += cps[i] >= 0x10000 ? 2 : 1;
+        if (units >= 1400) break;
+    }
+    uint32_t cp_count = i + 1 < 1000 ? i + 1 : 1000;
+    len = ref_utf8(cps, cp_count, utf8);
+    assert(zc_text_store_utf8(block, large, utf8, len) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, large, out, sizeof(out), &n) == ZC_INTERNAL_OK);
+    assert(n == len && memcmp(out, utf8, len) == 0);
+    assert(zc_text_load_utf8(block, large, out, len - 1, &n) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 超出容量与非法 UTF-8
+    memset(utf8, 'z', 1501);
+    assert(zc_text_store_utf8(block, large, utf8, 1500) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, large, out, sizeof(out), &n) == ZC_INTERNAL_OK && n == 1500);
+    assert(zc_text_store_utf8(block, large, utf8, 1501) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_text_store_utf8(block, small, utf8, 17) == ZC_INTERNAL_PARAM_ERROR);
+    const uint8_t bad[] = { 'a', 0xC0, 0x80 };
+    assert(zc_text_store_utf8(block, small, bad, sizeof(bad)) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+
+    // 出错时变量内容不变：非法序列在长文本末尾，或超出容量的部分只在末尾
+    memset(out, 'y', 1400);
+    out[1400] = 0xFF;
+    assert(zc_text_store_utf8(block, large, out, 1401) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+    out[1400] = 0xE9;
+    assert(zc_text_store_utf8(block, large, out, 1401) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+    assert(zc_text_store_utf8(block, large, out, 1400) == ZC_INTERNAL_OK);
+    assert(zc_text_store_utf8(block, large, utf8, 1501) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_text_load_utf8(block, large, out, sizeof(out), &n) == ZC_INTERNAL_OK && n == 1400);
+    for (i = 0; i < 1400; i++) assert(out[i] == 'y');
+
+    // 块内出现不成对的代理项
+    assert(zc_text_store_utf8(block, small, (const uint8_t*)"abc", 3) == ZC_INTERNAL_OK);
+    *(uint16_t*)zc_block_offset_to_ptr(block, small + 2) = 0xD800;
+    assert(zc_text_load_utf8(block, small, out, sizeof(out), &n) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+
+    // ASCIISTRING
+    assert(zc_text_store_utf8(block, ascii, (const uint8_t*)"NASDAQ", 6) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, ascii, out, sizeof(out), &n) == ZC_INTERNAL_OK);
+    assert(n == 6 && memcmp(out, "NASDAQ", 6) == 0);
+    assert(zc_text_load_utf8(block, ascii, out, 6, &n) == ZC_INTERNAL_OK && n == 6);
+    assert(zc_text_load_utf8(block, ascii, out, 5, &n) == ZC_INTERNAL_PARAM_ERROR);
+    const uint8_t accent[] = { 'c', 0xC3, 0xA9 };
+    assert(zc_text_store_utf8(block, ascii, accent, sizeof(accent)) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+    assert(zc_text_store_utf8(block, ascii, utf8, 41) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zc_text_store_utf8(block, ascii, utf8, 40) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, ascii, out, sizeof(out), &n) == ZC_INTERNAL_OK && n == 40);
+    *(uint8_t*)zc_block_offset_to_ptr(block, ascii + 3) = 0xFF;
+    assert(zc_text_load_utf8(block, ascii, out, sizeof(out), &n) == ZC_INTERNAL_TYPE_ILLEGAL_TEXT);
+
+    // 非字符串变量与非起始偏移
+    uint8_t desc_i4[] = { 0x08 };
+    assert(zc_dtt_add(block, 0, 4, desc_i4, sizeof(desc_i4)) == ZC_INTERNAL_OK);
+    assert(zc_text_load_utf8(block, 0, out, sizeof(out), &n) == ZC_INTERNAL_TYPE_ERROR);
+    assert(zc_text_store_utf8(block, small + 2, utf8, 1) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(49);
+
+    test_text_validate();
+    test_text_transcode();
+    test_text_block();
+
+    printf("All text tests passed.\n");
+    return 0;
+}
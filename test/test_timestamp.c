@@ -0,0 +1,84 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "../src/system/timestamp.h"
+
+static zc_time_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (zc_time_t)ts.tv_sec * 1000000000ULL + (zc_time_t)ts.tv_nsec;
+}
+
+static zc_time_t g_calibrated_ns = 0;
+
+// 允许 1 ms 加上自校准以来时长的 1%，校准误差随时间累积，直到下一次同步
+static zc_time_t clock_tolerance(zc_time_t real)
+{
+    return 1000000ULL + (real - g_calibrated_ns) / 100;
+}
+
+void test_zc_timestamp_monotonic() {
+    printf("Testing zc_timestamp monotonicity...\n");
+
+    zc_internal_result_t result = zc_timestamp_init();
+    g_calibrated_ns = monotonic_ns();
+    assert(result == ZC_INTERNAL_OK || result == ZC_INTERNAL_UNREALIZED);
+    assert(zc_timestamp_source() != ZC_CLOCK_SOURCE_UNINITIALIZED);
+    printf("  Clock source: %s\n", zc_timestamp_source() == ZC_CLOCK_SOURCE_TSC ? "TSC" : "CLOCK_MONOTONIC");
+
+    zc_time_t prev = zc_timestamp();
+    for (int i = 0; i < 1000000; i++)
+    {
+        zc_time_t now = zc_timestamp();
+        assert(now >= prev);
+        prev = now;
+    }
+    printf("  Passed monotonicity test\n");
+}
+
+void test_zc_timestamp_accuracy() {
+    printf("Testing zc_timestamp accuracy...\n");
+
+    // 与系统时钟的偏差在容差内
+    for (int i = 0; i < 5; i++)
+    {
+        zc_time_t real = monotonic_ns();
+        zc_time_t ours = zc_timestamp();
+        zc_time_t diff = ours > real ? ours - real : real - ours;
+        assert(diff < clock_tolerance(real));
+
+        struct timespec sleep_time = { 0, 50000000L };
+        nanosleep(&sleep_time, NULL);
+    }
+    printf("  Passed accuracy test\n");
+
+    assert(zc_timestamp_resync() == ZC_INTERNAL_OK || zc_timestamp_source() == ZC_CLOCK_SOURCE_MONOTONIC);
+    zc_time_t real = monotonic_ns();
+    zc_time_t ours = zc_timestamp();
+    assert((ours > real ? ours - real : real - ours) < clock_tolerance(real));
+    printf("  Passed resync test\n");
+}
+
+void test_zc_short_timestamp() {
+    printf("Testing zc_short_timestamp...\n");
+
+    zc_short_time_t short_time = zc_short_timestamp();
+    zc_short_time_t expected = (zc_short_time_t)(zc_timestamp() >> ZC_SHORT_TIME_SHIFT);
+    assert(expected - short_time <= 1);
+    printf("  Passed short timestamp test\n");
+}
+
+int main() {
+    printf("Starting timestamp unit tests...\n\n");
+
+    test_zc_timestamp_monotonic();
+    test_zc_timestamp_accuracy();
+    test_zc_short_timestamp();
+
+    printf("\nAll timestamp unit tests passed!\n");
+    return 0;
+}
@@ -11,7 +11,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_BOOLEAN
     desc[0] = ELEMENT_TYPE_BOOLEAN;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 1) {
         printf("PASS: ELEMENT_TYPE_BOOLEAN size = 1\n");
     } else {
@@ -20,7 +20,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_CHAR
     desc[0] = ELEMENT_TYPE_CHAR;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 2) {
         printf("PASS: ELEMENT_TYPE_CHAR size = 2\n");
     } else {
@@ -29,7 +29,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_I1
     desc[0] = ELEMENT_TYPE_I1;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 1) {
         printf("PASS: ELEMENT_TYPE_I1 size = 1\n");
     } else {
@@ -38,7 +38,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_I2
     desc[0] = ELEMENT_TYPE_I2;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 2) {
         printf("PASS: ELEMENT_TYPE_I2 size = 2\n");
     } else {
@@ -47,7 +47,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_I4
     desc[0] = ELEMENT_TYPE_I4;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 4) {
         printf("PASS: ELEMENT_TYPE_I4 size = 4\n");
     } else {
@@ -56,7 +56,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_I8
     desc[0] = ELEMENT_TYPE_I8;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 8) {
         printf("PASS: ELEMENT_TYPE_I8 size = 8\n");
     } else {
@@ -65,7 +65,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_R4
     desc[0] = ELEMENT_TYPE_R4;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 4) {
         printf("PASS: ELEMENT_TYPE_R4 size = 4\n");
     } else {
@@ -74,7 +74,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_R8
     desc[0] = ELEMENT_TYPE_R8;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 8) {
         printf("PASS: ELEMENT_TYPE_R8 size = 8\n");
     } else {
@@ -83,7 +83,7 @@ void test_simple_types() {
 
     // 测试 ELEMENT_TYPE_VAR
     desc[0] = ELEMENT_TYPE_VAR;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 1) {
         printf("PASS: ELEMENT_TYPE_VAR size = 1\n");
     } else {
@@ -99,7 +99,7 @@ void test_void_type() {
     // 测试 ELEMENT_TYPE_VOID with width
     desc[0] = ELEMENT_TYPE_VOID;
     desc[1] = 16; // width = 16
-    result = zc_type_desc_get_size(desc, 2, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 2, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 16) {
         printf("PASS: ELEMENT_TYPE_VOID with width = 16\n");
     } else {
@@ -108,7 +108,7 @@ void test_void_type() {
 
     // 测试 ELEMENT_TYPE_VOID without width
     desc[0] = ELEMENT_TYPE_VOID;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_TYPE_ILLEGAL_DESC) {
         printf("PASS: ELEMENT_TYPE_VOID without width correctly returns error\n");
     } else {
@@ -124,7 +124,7 @@ void test_string_type() {
     // 测试 ELEMENT_TYPE_STRING with length
     desc[0] = ELEMENT_TYPE_STRING;
     *((uint32_t*)(desc + 1)) = 10; // length = 10 chars
-    result = zc_type_desc_get_size(desc, 5, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 5, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 20) { // 10 chars * 2 bytes each
         printf("PASS: ELEMENT_TYPE_STRING with length = 10 chars (20 bytes)\n");
     } else {
@@ -133,7 +133,7 @@ void test_string_type() {
 
     // 测试 ELEMENT_TYPE_STRING without length
     desc[0] = ELEMENT_TYPE_STRING;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_TYPE_ILLEGAL_DESC) {
         printf("PASS: ELEMENT_TYPE_STRING without length correctly returns error\n");
     } else {
@@ -148,7 +148,7 @@ void test_ptr_type() {
 
     // 测试 ELEMENT_TYPE_PTR
     desc[0] = ELEMENT_TYPE_PTR;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 8) {
         printf("PASS: ELEMENT_TYPE_PTR size = 8\n");
     } else {
@@ -164,7 +164,7 @@ void test_platform_types() {
     // 测试 ELEMENT_TYPE_I with width
     desc[0] = ELEMENT_TYPE_I;
     desc[1] = 4; // width = 4 bytes
-    result = zc_type_desc_get_size(desc, 2, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 2, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 4) {
         printf("PASS: ELEMENT_TYPE_I with width = 4\n");
     } else {
@@ -173,7 +173,7 @@ void test_platform_types() {
 
     // 测试 ELEMENT_TYPE_I without width
     desc[0] = ELEMENT_TYPE_I;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_PARAM_ERROR) {
         printf("PASS: ELEMENT_TYPE_I without width correctly returns error\n");
     } else {
@@ -183,7 +183,7 @@ void test_platform_types() {
     // 测试 ELEMENT_TYPE_U with width
     desc[0] = ELEMENT_TYPE_U;
     desc[1] = 8; // width = 8 bytes
-    result = zc_type_desc_get_size(desc, 2, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 2, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 8) {
         printf("PASS: ELEMENT_TYPE_U with width = 8\n");
     } else {
@@ -199,7 +199,7 @@ void test_object_type() {
     // 测试 ELEMENT_TYPE_OBJECT with size
     desc[0] = ELEMENT_TYPE_OBJECT;
     *((uint64_t*)(desc + 1)) = 128; // size = 128 bytes
-    result = zc_type_desc_get_size(desc, 9, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 9, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 128) {
         printf("PASS: ELEMENT_TYPE_OBJECT with size = 128\n");
     } else {
@@ -208,7 +208,7 @@ void test_object_type() {
 
     // 测试 ELEMENT_TYPE_OBJECT without size
     desc[0] = ELEMENT_TYPE_OBJECT;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_PARAM_ERROR) {
         printf("PASS: ELEMENT_TYPE_OBJECT without size correctly returns error\n");
     } else {
@@ -223,7 +223,7 @@ void test_internal_type() {
 
     // 测试 ELEMENT_TYPE_INTERNAL
     desc[0] = ELEMENT_TYPE_INTERNAL;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 0) {
         printf("PASS: ELEMENT_TYPE_INTERNAL size = 0\n");
     } else {
@@ -238,7 +238,7 @@ void test_szarray_type() {
 
     // 测试 ELEMENT_TYPE_SZARRAY
     desc[0] = ELEMENT_TYPE_SZARRAY;
-    result = zc_type_desc_get_size(desc, 1, &obj_size);
+    result = zc_type_desc_get_obj_size(desc, 1, &obj_size);
     if (result == ZC_INTERNAL_OK && obj_size == 0) {
         printf("PASS: ELEMENT_TYPE_SZARRAY size = 0 (dynamic)\n");
     } else {
@@ -246,6 +246,104 @@ void test_szarray_type() {
     }
 }
 
+void test_decode() {
+    zc_type_desc_info_t info;
+    zc_internal_result_t result;
+
+    // 测试标量叶子
+    uint8_t desc_i4[] = { ELEMENT_TYPE_I4 };
+    result = zc_type_desc_decode(desc_i4, sizeof(desc_i4), &info);
+    if (result == ZC_INTERNAL_OK && info.desc_len == 1 && info.obj_size == 4 && info.align == 4
+        && (info.flags & ZC_TYPE_DESC_FIXED_LEAF)) {
+        printf("PASS: decode ELEMENT_TYPE_I4\n");
+    } else {
+        printf("FAIL: decode ELEMENT_TYPE_I4\n");
+    }
+
+    // 测试嵌套数组前缀：SZARRAY(5) of ARRAY[3, 4] of I2，各维长度相乘
+    uint8_t desc_arr[40] = { ELEMENT_TYPE_SZARRAY, ELEMENT_TYPE_ARRAY, ELEMENT_TYPE_I2, 2 };
+    uint64_t dim0 = 3, dim1 = 4;
+    uint32_t count = 5;
+    memcpy(desc_arr + 4 + 8, &dim0, sizeof(dim0));
+    memcpy(desc_arr + 4 + 24, &dim1, sizeof(dim1));
+    memcpy(desc_arr + 36, &count, sizeof(count));
+    result = zc_type_desc_decode(desc_arr, sizeof(desc_arr), &info);
+    if (result == ZC_INTERNAL_OK && info.desc_len == 40 && info.obj_size == 2 * 12 * 5 && info.align == 2
+        && !(info.flags & ZC_TYPE_DESC_FIXED_LEAF)) {
+        printf("PASS: decode nested array prefix\n");
+    } else {
+        printf("FAIL: decode nested array prefix\n");
+    }
+
+    result = zc_type_desc_decode(desc_arr, sizeof(desc_arr) - 1, &info);
+    if (result == ZC_INTERNAL_TYPE_ILLEGAL_DESC) {
+        printf("PASS: decode truncated array correctly returns error\n");
+    } else {
+        printf("FAIL: decode truncated array should return error\n");
+    }
+
+    // 测试二维数组：I4[3][4] 共 48 字节
+    uint8_t desc_arr2d[35] = { ELEMENT_TYPE_ARRAY, ELEMENT_TYPE_I4, 2 };
+    memcpy(desc_arr2d + 3 + 8, &dim0, sizeof(dim0));
+    memcpy(desc_arr2d + 3 + 24, &dim1, sizeof(dim1));
+    result = zc_type_desc_decode(desc_arr2d, sizeof(desc_arr2d), &info);
+    if (result == ZC_INTERNAL_OK && info.desc_len == 35 && info.obj_size == 48) {
+        printf("PASS: decode ARRAY I4[3][4]\n");
+    } else {
+        printf("FAIL: decode ARRAY I4[3][4]\n");
+    }
+
+    // 测试数组维度之积或对象大小溢出
+    uint64_t dim_huge = UINT64_MAX / 2;
+    memcpy(desc_arr2d + 3 + 8, &dim_huge, sizeof(dim_huge));
+    result = zc_type_desc_decode(desc_arr2d, sizeof(desc_arr2d), &info);
+    if (result == ZC_INTERNAL_TYPE_ILLEGAL_DESC) {
+        printf("PASS: decode overflowing ARRAY correctly returns error\n");
+    } else {
+        printf("FAIL: decode overflowing ARRAY should return error\n");
+    }
+
+    // 测试非方阵张量：2 x 3 x 4，元素数为各维之积
+    uint8_t desc_tensor[] = { ELEMENT_TYPE_FLOATTENSOR, 0x00, 3, 0, 2, 0, 3, 0, 4, 0 };
+    uint64_t element_size = 0;
+    zc_type_get_tensor_element_size(0x00, &element_size);
+    result = zc_type_desc_decode(desc_tensor, sizeof(desc_tensor), &info);
+    if (result == ZC_INTERNAL_OK && info.desc_len == sizeof(desc_tensor) && info.obj_size == element_size * 24) {
+        printf("PASS: decode rank-3 FLOATTENSOR\n");
+    } else {
+        printf("FAIL: decode rank-3 FLOATTENSOR\n");
+    }
+
+    // 测试向量与方阵：HALF 元素宽 2 字节
+    uint8_t desc_vec[] = { ELEMENT_TYPE_FLOATTENSOR, R4_TYPE_HALF, 1, 0, 5, 0 };
+    uint8_t desc_mat[] = { ELEMENT_TYPE_FLOATTENSOR, R4_TYPE_FLOAT, 2, 0, 3, 0, 3, 0 };
+    zc_type_desc_info_t info_mat;
+    result = zc_type_desc_decode(desc_vec, sizeof(desc_vec), &info);
+    if (result == ZC_INTERNAL_OK && info.obj_size == 2 * 5 && info.align == 2
+        && zc_type_desc_decode(desc_mat, sizeof(desc_mat), &info_mat) == ZC_INTERNAL_OK && info_mat.obj_size == 4 * 9) {
+        printf("PASS: decode vector and square matrix FLOATTENSOR\n");
+    } else {
+        printf("FAIL: decode vector and square matrix FLOATTENSOR\n");
+    }
+
+    desc_vec[1] = 0x7F;
+    result = zc_type_desc_decode(desc_vec, sizeof(desc_vec), &info);
+    if (result == ZC_INTERNAL_TYPE_ILLEGAL_DESC) {
+        printf("PASS: decode FLOATTENSOR with unknown element token returns error\n");
+    } else {
+        printf("FAIL: decode FLOATTENSOR with unknown element token should return error\n");
+    }
+
+    // 测试 VALUETYPE 头部：宽 24，按 8 字节对齐
+    uint8_t desc_vt[] = { ELEMENT_TYPE_VALUETYPE, 17, 0, 0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 8, 3, 0x08, 0x0A, 0x06 };
+    result = zc_type_desc_decode(desc_vt, sizeof(desc_vt), &info);
+    if (result == ZC_INTERNAL_OK && info.desc_len == sizeof(desc_vt) && info.obj_size == 24 && info.align == 8) {
+        printf("PASS: decode ELEMENT_TYPE_VALUETYPE\n");
+    } else {
+        printf("FAIL: decode ELEMENT_TYPE_VALUETYPE\n");
+    }
+}
+
 int main() {
     printf("Starting type_descriptor unit tests...\n\n");
 
@@ -257,6 +355,7 @@ int main() {
     test_object_type();
     test_internal_type();
     test_szarray_type();
+    test_decode();
 
     printf("\nUnit tests completed.\n");
     return 0;
@@ -0,0 +1,211 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/type_registry.h"
+
+static zc_type_registry_t* create_test_registry()
+{
+    zc_type_registry_t* registry = malloc(sizeof(zc_type_registry_t));
+    assert(registry != NULL);
+    assert(zc_type_registry_init(registry) == ZC_INTERNAL_OK);
+    return registry;
+}
+
+// 测试驻留与去重
+void test_type_registry_intern() {
+    printf("Testing zc_type_registry_intern...\n");
+
+    zc_type_registry_t* registry = create_test_registry();
+
+    uint8_t desc_i4[] = { 0x08 };
+    uint8_t desc_ptr[] = { 0x0F, 0x08, 0, 0, 0, 0, 0, 0, 0 };
+    uint8_t desc_ptr2[] = { 0x0F, 0x10, 0, 0, 0, 0, 0, 0, 0 };
+
+    zc_type_id_t id_i4, id_ptr, id_ptr2, id_again;
+    assert(zc_type_registry_intern(registry, desc_i4, sizeof(desc_i4), &id_i4) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_intern(registry, desc_ptr, sizeof(desc_ptr), &id_ptr) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_intern(registry, desc_ptr2, sizeof(desc_ptr2), &id_ptr2) == ZC_INTERNAL_OK);
+    assert(id_i4 != ZC_TYPE_ID_NONE && id_ptr != ZC_TYPE_ID_NONE && id_ptr2 != ZC_TYPE_ID_NONE);
+    assert(id_i4 != id_ptr && id_ptr != id_ptr2);
+
+    // 相同描述符得到相同 ID，且不再占用字节池
+    uint32_t arena_used = atomic_load(&registry->arena_used);
+    uint8_t desc_ptr_copy[sizeof(desc_ptr)];
+    memcpy(desc_ptr_copy, desc_ptr, sizeof(desc_ptr));
+    assert(zc_type_registry_intern(registry, desc_ptr_copy, sizeof(desc_ptr_copy), &id_again) == ZC_INTERNAL_OK);
+    assert(id_again == id_ptr);
+    assert(atomic_load(&registry->arena_used) == arena_used);
+    assert(atomic_load(&registry->type_count) == 3);
+
+    // 非法长度
+    assert(zc_type_registry_intern(registry, desc_i4, 0, &id_again) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    printf("  Passed intern test\n");
+    free(registry);
+}
+
+// 测试查找与取回描述符
+void test_type_registry_lookup() {
+    printf("Testing zc_type_registry_find / get_desc...\n");
+
+    zc_type_registry_t* registry = create_test_registry();
+
+    uint8_t desc[] = { 0x14, 0x08, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 };
+    zc_type_id_t id, found;
+
+    assert(zc_type_registry_find(registry, desc, sizeof(desc), &found) == ZC_INTERNAL_OK);
+    assert(found == ZC_TYPE_ID_NONE);
+
+    assert(zc_type_registry_intern(registry, desc, sizeof(desc), &id) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_find(registry, desc, sizeof(desc), &found) == ZC_INTERNAL_OK);
+    assert(found == id);
+
+    const uint8_t* out_desc;
+    uint64_t out_len;
+    assert(zc_type_registry_get_desc(registry, id, &out_desc, &out_len) == ZC_INTERNAL_OK);
+    assert(out_len == sizeof(desc));
+    assert(memcmp(out_desc, desc, sizeof(desc)) == 0);
+
+    assert(zc_type_registry_get_desc(registry, ZC_TYPE_ID_NONE, &out_desc, &out_len) == ZC_INTERNAL_TYPE_UNKNOWN_ID);
+    assert(zc_type_registry_get_desc(registry, id == 1 ? 2 : 1, &out_desc, &out_len) == ZC_INTERNAL_TYPE_UNKNOWN_ID);
+    assert(zc_type_registry_get_desc(registry, ZC_TYPE_REGISTRY_CAPACITY + 1, &out_desc, &out_len) == ZC_INTERNAL_TYPE_UNKNOWN_ID);
+
+    printf("  Passed lookup test\n");
+    free(registry);
+}
+
+// 测试槽位耗尽
+void test_type_registry_full() {
+    printf("Testing zc_type_registry full...\n");
+
+    zc_type_registry_t* registry = create_test_registry();
+
+    uint8_t desc[5] = { 0x5C };
+    zc_type_id_t id;
+    uint32_t i;
+    for (i = 0; i < ZC_TYPE_REGISTRY_CAPACITY; i++)
+    {
+        memcpy(&desc[1], &i, sizeof(i));
+        assert(zc_type_registry_intern(registry, desc, sizeof(desc), &id) == ZC_INTERNAL_OK);
+    }
+
+    i = ZC_TYPE_REGISTRY_CAPACITY;
+    memcpy(&desc[1], &i, sizeof(i));
+    assert(zc_type_registry_intern(registry, desc, sizeof(desc), &id) == ZC_INTERNAL_TYPE_REGISTRY_FULL);
+
+    // 已驻留的描述符仍可取得
+    i = 7;
+    memcpy(&desc[1], &i, sizeof(i));
+    assert(zc_type_registry_intern(registry, desc, sizeof(desc), &id) == ZC_INTERNAL_OK);
+    free(registry);
+
+    // 字节池不足时预留失败且不改动已用量
+    registry = create_test_registry();
+    atomic_store(&registry->arena_used, ZC_TYPE_REGISTRY_ARENA_SIZE - 8);
+    i = 0;
+    memcpy(&desc[1], &i, sizeof(i));
+    assert(zc_type_registry_intern(registry, desc, sizeof(desc), &id) == ZC_INTERNAL_TYPE_REGISTRY_FULL);
+    assert(atomic_load(&registry->arena_used) == ZC_TYPE_REGISTRY_ARENA_SIZE - 8);
+
+    printf("  Passed full test\n");
+    free(registry);
+}
+
+// 测试复合类型的展开字段表
+void test_type_registry_layout() {
+    printf("Testing zc_type_registry layout...\n");
+
+    zc_type_registry_t* registry = create_test_registry();
+
+    // outer { U1 flag; inner { I4 a; I8 b; I2 c; } } 按 8 字节对齐
+    uint8_t desc_inner[] = { 0x11, 17, 0, 0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 8, 3, 0x08, 0x0A, 0x06 };
+    uint8_t desc_outer[34] = { 0x11, 33, 0, 0, 0, 32, 0, 0, 0, 0, 0, 0, 0, 8, 2, 0x05 };
+    memcpy(desc_outer + 16, desc_inner, sizeof(desc_inner));
+
+    zc_type_id_t id;
+    assert(zc_type_registry_intern(registry, desc_outer, sizeof(desc_outer), &id) == ZC_INTERNAL_OK);
+    uint32_t layout_used = atomic_load(&registry->layout_used);
+    assert(layout_used == 5);
+
+    const zc_type_layout_field_t* fields;
+    uint32_t count;
+    assert(zc_type_registry_get_layout(registry, id, &fields, &count) == ZC_INTERNAL_OK);
+    assert(count == 5);
+
+    uint64_t offsets[] = { 0, 8, 8, 16, 24 };
+    uint64_t sizes[] = { 1, 24, 4, 8, 2 };
+    uint32_t nexts[] = { 1, 5, 3, 4, 5 };
+    uint8_t tags[] = { 0x05, 0x11, 0x08, 0x0A, 0x06 };
+    uint8_t depths[] = { 0, 0, 1, 1, 1 };
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        assert(fields[i].offset == offsets[i] && fields[i].size == sizes[i]);
+        assert(fields[i].next == nexts[i] && fields[i].tag == tags[i] && fields[i].depth == depths[i]);
+    }
+
+    // 已建立的表直接返回
+    const zc_type_layout_field_t* again;
+    assert(zc_type_registry_get_layout(registry, id, &again, &count) == ZC_INTERNAL_OK);
+    assert(again == fields && atomic_load(&registry->layout_used) == layout_used);
+
+    // 驻留时缓存的解码结果
+    const zc_type_desc_info_t* info;
+    assert(zc_type_registry_get_info(registry, id, &info) == ZC_INTERNAL_OK);
+    assert(info->desc_len == sizeof(desc_outer) && info->obj_size == 32 && info->align == 8);
+
+    uint8_t desc_bad[] = { 0x5C, 1, 2, 3, 4 };
+    zc_type_id_t id_bad;
+    assert(zc_type_registry_intern(registry, desc_bad, sizeof(desc_bad), &id_bad) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_get_info(registry, id_bad, &info) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+
+    // 非复合类型与未驻留的 ID
+    uint8_t desc_i4[] = { 0x08 };
+    zc_type_id_t id_i4;
+    assert(zc_type_registry_intern(registry, desc_i4, sizeof(desc_i4), &id_i4) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_get_layout(registry, id_i4, &again, &count) == ZC_INTERNAL_TYPE_ILLEGAL_DESC);
+    assert(zc_type_registry_get_layout(registry, ZC_TYPE_ID_NONE, &again, &count) == ZC_INTERNAL_TYPE_UNKNOWN_ID);
+    free(registry);
+
+    // 字段表容量不足时建表失败且不改动已用量
+    registry = create_test_registry();
+    atomic_store(&registry->layout_used, ZC_TYPE_REGISTRY_LAYOUT_CAPACITY - 2);
+    assert(zc_type_registry_intern(registry, desc_inner, sizeof(desc_inner), &id) == ZC_INTERNAL_OK);
+    assert(zc_type_registry_get_layout(registry, id, &fields, &count) == ZC_INTERNAL_TYPE_REGISTRY_FULL);
+    assert(atomic_load(&registry->layout_used) == ZC_TYPE_REGISTRY_LAYOUT_CAPACITY - 2);
+
+    printf("  Passed layout test\n");
+    free(registry);
+}
+
+// 测试 attach
+void test_type_registry_attach() {
+    printf("Testing zc_type_registry_attach...\n");
+
+    zc_type_registry_t* registry = create_test_registry();
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_OK);
+    assert(g_type_registry == registry);
+
+    registry->magic = 0;
+    assert(zc_type_registry_attach(registry) == ZC_INTERNAL_RUN_NOT_INITIALIZED);
+
+    assert(zc_type_registry_attach(NULL) == ZC_INTERNAL_OK);
+    assert(g_type_registry == NULL);
+
+    printf("  Passed attach test\n");
+    free(registry);
+}
+
+int main() {
+    printf("Starting type registry tests...\n");
+
+    test_type_registry_intern();
+    test_type_registry_lookup();
+    test_type_registry_full();
+    test_type_registry_layout();
+    test_type_registry_attach();
+
+    printf("All type registry tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/type/dtta.h"
+#include "../src/zora/view.h"
+#include "block_fixture.h"
+
+// 按字节写入变量内容，跨页时逐页写
+static void fill_bytes(zc_block_header_t* block, uint64_t offset, const uint8_t* src, uint64_t length)
+{
+    uint64_t i;
+    for (i = 0; i < length; i++) *(uint8_t*)zc_block_offset_to_ptr(block, offset + i) = src[i];
+}
+
+void test_view_segment_count() {
+    printf("Testing view segment count...\n");
+
+    assert(zc_view_segment_count(0, 0) == 0);
+    assert(zc_view_segment_count(0, 1) == 1);
+    assert(zc_view_segment_count(0, ZC_PAGE_DATA_SIZE) == 1);
+    assert(zc_view_segment_count(0, ZC_PAGE_DATA_SIZE + 1) == 2);
+    assert(zc_view_segment_count(ZC_PAGE_DATA_SIZE - 1, 1) == 1);
+    assert(zc_view_segment_count(ZC_PAGE_DATA_SIZE - 1, 2) == 2);
+    assert(zc_view_segment_count(ZC_PAGE_DATA_SIZE - 1, ZC_PAGE_DATA_SIZE * 2 + 2) == 4);
+
+    printf("  Passed\n");
+}
+
+void test_view_contiguous() {
+    printf("Testing view of variable within one page...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(16384, 40);
+    uint8_t desc[] = { 0x1D, 0x05, 100, 0, 0, 0 };
+    uint64_t offset = ZC_PAGE_DATA_SIZE * 3 + 17;
+    assert(zc_dtt_add(block, offset, 100, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+
+    uint8_t bytes[100];
+    uint32_t i;
+    for (i = 0; i < sizeof(bytes); i++) bytes[i] = (uint8_t)(i * 7 + 3);
+    fill_bytes(block, offset, bytes, sizeof(bytes));
+
+    const void* data;
+    uint64_t length;
+    assert(zc_view_get(block, offset, &data, &length) == ZC_INTERNAL_OK);
+    assert(data == zc_block_offset_to_ptr(block, offset) && length == 100);
+    assert(memcmp(data, bytes, sizeof(bytes)) == 0);
+
+    zc_view_segment_t segments[2];
+    uint32_t count;
+    assert(zc_view_get_segments(block, offset, segments, 2, &count, &length) == ZC_INTERNAL_OK);
+    assert(count == 1 && segments[0].base == data && segments[0].length == 100 && length == 100);
+
+    // 恰好占满一页的剩余部分
+    uint8_t tail_desc[] = { 0x1D, 0x05, 0x10, 0, 0, 0 };
+    uint64_t tail_offset = ZC_PAGE_DATA_SIZE * 5 - 16;
+    assert(zc_dtt_add(block, tail_offset, 16, tail_desc, sizeof(tail_desc)) == ZC_INTERNAL_OK);
+    assert(zc_view_get(block, tail_offset, &data, &length) == ZC_INTERNAL_OK);
+    assert(data != NULL && length == 16);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_view_segmented() {
+    printf("Testing view of variable across pages...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(16384, 40);
+    const uint32_t width = 3000;
+    uint8_t desc[6] = { 0x1D, 0x05 };
+    memcpy(desc + 2, &width, sizeof(width));
+    uint64_t offset = 401;
+    assert(zc_dtt_add(block, offset, width, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+
+    uint8_t* bytes = malloc(width);
+    uint32_t i;
+    for (i = 0; i < width; i++) bytes[i] = (uint8_t)rand();
+    fill_bytes(block, offset, bytes, width);
+
+    const void* data = bytes;
+    uint64_t length;
+    assert(zc_view_get(block, offset, &data, &length) == ZC_INTERNAL_OK);
+    assert(data == NULL && length == width);
+
+    // 容量不足时只报告段数
+    uint32_t expected = (uint32_t)zc_view_segment_count(offset, width);
+    assert(expected == 7);
+    uint32_t count = 0;
+    assert(zc_view_get_segments(block, offset, NULL, 0, &count, NULL) == ZC_INTERNAL_PARAM_ERROR);
+    assert(count == expected);
+
+    zc_view_segment_t segments[7];
+    memset(segments, 0, sizeof(segments));
+    assert(zc_view_get_segments(block, offset, segments, 6, &count, NULL) == ZC_INTERNAL_PARAM_ERROR);
+    assert(count == expected && segments[0].base == NULL);
+
+    assert(zc_view_get_segments(block, offset, segments, 7, &count, &length) == ZC_INTERNAL_OK);
+    assert(count == expected && length == width);
+    assert(segments[0].length == ZC_PAGE_DATA_SIZE - offset);
+
+    // 各段首尾相接即为变量内容
+    uint64_t pos = 0;
+    for (i = 0; i < count; i++)
+    {
+        assert(segments[i].base == zc_block_offset_to_ptr(block, offset + pos));
+        assert(i == 0 || i == count - 1 || segments[i].length == ZC_PAGE_DATA_SIZE);
+        assert(memcmp(segments[i].base, bytes + pos, segments[i].length) == 0);
+        pos += segments[i].length;
+    }
+    assert(pos == width);
+
+    free(bytes);
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+void test_view_errors() {
+    printf("Testing view error handling...\n");
+
+    zc_block_header_t* block = zc_test_block_setup(16384, 40);
+    uint8_t desc[] = { 0x08 };
+    assert(zc_dtt_add(block, 1000, 4, desc, sizeof(desc)) == ZC_INTERNAL_OK);
+
+    const void* data;
+    uint64_t length;
+    uint32_t count;
+    zc_view_segment_t segment;
+    assert(zc_view_get(block, 1001, &data, &length) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_view_get(block, 2000, &data, &length) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_view_get(block, 1000, NULL, &length) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_view_get(block, 1000, &data, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_view_get_segments(block, 1000, NULL, 1, &count, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_view_get_segments(block, 1000, &segment, 1, NULL, NULL) == ZC_INTERNAL_PARAM_PTRNULL);
+    assert(zc_view_get_segments(block, 1002, &segment, 1, &count, NULL) == ZC_INTERNAL_DTTA_ENTRY_NOT_FOUND);
+    assert(zc_view_get_segments(block, 1000, &segment, 1, &count, NULL) == ZC_INTERNAL_OK);
+    assert(count == 1 && segment.length == 4);
+
+    zc_test_block_teardown();
+    printf("  Passed\n");
+}
+
+int main() {
+    srand(45);
+
+    test_view_segment_count();
+    test_view_contiguous();
+    test_view_segmented();
+    test_view_errors();
+
+    printf("All view tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "../src/system/watchdog.h"
+#include "../src/system/timestamp.h"
+
+#define MS 1000000ULL
+
+static uint32_t g_timeout_count = 0;
+static uint32_t g_last_timeout_slot = 0;
+
+static void on_timeout(void* ctx, uint32_t slot_index, zc_time_t last_beat)
+{
+    (void)ctx;
+    (void)last_beat;
+    g_timeout_count++;
+    g_last_timeout_slot = slot_index;
+}
+
+void test_zc_heartbeat_slot_index() {
+    printf("Testing heartbeat slot index...\n");
+
+    assert(zc_heartbeat_slot_of_writer(0) == 0);
+    assert(zc_heartbeat_slot_of_reader(0) == 1);
+    assert(zc_heartbeat_slot_of_writer(2) == 2 * (ZC_MAX_READERS_PER + 1));
+    assert(zc_heartbeat_slot_of_reader(((uint64_t)2 << 32) | 4) == 2 * (ZC_MAX_READERS_PER + 1) + 5);
+    assert(zc_heartbeat_slot_of_reader(((uint64_t)(ZC_MAX_WRITERS - 1) << 32) | (ZC_MAX_READERS_PER - 1)) == ZC_HEARTBEAT_SLOT_COUNT - 1);
+    printf("  Passed slot index test\n");
+}
+
+void test_zc_watchdog_timeout() {
+    printf("Testing zc_watchdog_advance timeout...\n");
+
+    zc_watchdog_t* wd = malloc(sizeof(zc_watchdog_t));
+    g_timeout_count = 0;
+    assert(zc_watchdog_init(wd, 300 * MS, 0, on_timeout, NULL) == ZC_INTERNAL_OK);
+
+    uint32_t i;
+    for (i = 0; i < ZC_HEARTBEAT_SLOT_COUNT; i++) assert(zc_watchdog_watch(wd, i, 0) == ZC_INTERNAL_OK);
+    assert(zc_watchdog_watch(wd, ZC_HEARTBEAT_SLOT_COUNT, 0) == ZC_INTERNAL_PARAM_ERROR);
+
+    // 所有线程持续发送心跳，只有 slot 7 停止
+    uint32_t expired = 0;
+    zc_time_t now;
+    for (now = 100 * MS; now <= 1000 * MS; now += 100 * MS)
+    {
+        for (i = 0; i < ZC_HEARTBEAT_SLOT_COUNT; i++)
+        {
+            if (i != 7) zc_heartbeat_send(wd, i, now);
+        }
+        uint32_t count = 0;
+        assert(zc_watchdog_advance(wd, now, &count) == ZC_INTERNAL_OK);
+        expired += count;
+        if (now < 300 * MS) assert(count == 0);
+    }
+
+    assert(expired == 1);
+    assert(g_timeout_count == 1);
+    assert(g_last_timeout_slot == 7);
+    assert(wd->missed_count == 1);
+    printf("  Passed single dead thread test\n");
+
+    // 超时线程不再被检查
+    assert(zc_watchdog_advance(wd, 5000 * MS, &expired) == ZC_INTERNAL_OK);
+    assert(expired == ZC_HEARTBEAT_SLOT_COUNT - 1);
+    printf("  Passed all threads dead test\n");
+
+    free(wd);
+}
+
+void test_zc_watchdog_unwatch() {
+    printf("Testing zc_watchdog_unwatch...\n");
+
+    zc_watchdog_t* wd = malloc(sizeof(zc_watchdog_t));
+    g_timeout_count = 0;
+    zc_watchdog_init(wd, 100 * MS, 0, on_timeout, NULL);
+
+    zc_watchdog_watch(wd, 3, 0);
+    zc_watchdog_watch(wd, 4, 0);
+    assert(zc_watchdog_unwatch(wd, 3) == ZC_INTERNAL_OK);
+
+    // 请求在看门狗线程推进时才作用到时间轮
+    assert(!wd->nodes[3].linked && !wd->nodes[4].linked);
+    uint32_t expired = 0;
+    assert(zc_watchdog_advance(wd, 0, &expired) == ZC_INTERNAL_OK);
+    assert(expired == 0);
+    assert(!wd->nodes[3].linked && wd->nodes[4].linked);
+    printf("  Passed deferred request test\n");
+
+    // 长时间跨度触发多层级联
+    assert(zc_watchdog_advance(wd, 20000 * MS, &expired) == ZC_INTERNAL_OK);
+    assert(expired == 1);
+    assert(g_last_timeout_slot == 4);
+    printf("  Passed unwatch test\n");
+
+    // 超过一层范围的超时阈值
+    zc_watchdog_init(wd, 10000 * MS, 0, on_timeout, NULL);
+    zc_watchdog_watch(wd, 9, 0);
+    assert(zc_watchdog_advance(wd, 9999 * MS, &expired) == ZC_INTERNAL_OK);
+    assert(expired == 0);
+    assert(zc_watchdog_advance(wd, 10000 * MS, &expired) == ZC_INTERNAL_OK);
+    assert(expired == 1);
+    printf("  Passed cascaded timer test\n");
+
+    free(wd);
+}
+
+void test_zc_send_heartbeat() {
+    printf("Testing zc_writer_send_heartbeat / zc_reader_send_heartbeat...\n");
+
+    zc_watchdog_t* wd = malloc(sizeof(zc_watchdog_t));
+    zc_watchdog_init(wd, 100 * MS, 0, on_timeout, NULL);
+
+    // 未 attach 时忽略
+    zc_writer_send_heartbeat(2);
+    assert(wd->beats[zc_heartbeat_slot_of_writer(2)].last_beat == 0);
+
+    assert(zc_watchdog_attach(wd) == ZC_INTERNAL_OK && g_watchdog == wd);
+    zc_reader_id_t reader_id = ((uint64_t)2 << 32) | 3;
+    zc_time_t before = zc_timestamp();
+    zc_writer_send_heartbeat(2);
+    zc_reader_send_heartbeat(reader_id);
+    assert(wd->beats[zc_heartbeat_slot_of_writer(2)].last_beat >= before);
+    assert(wd->beats[zc_heartbeat_slot_of_reader(reader_id)].last_beat >= before);
+    assert(wd->beats[zc_heartbeat_slot_of_reader(reader_id) + 1].last_beat == 0);
+
+    // 越界 ID 被忽略
+    zc_writer_send_heartbeat(ZC_MAX_WRITERS);
+    zc_reader_send_heartbeat(((uint64_t)2 << 32) | ZC_MAX_READERS_PER);
+    assert(wd->beats[zc_heartbeat_slot_of_writer(3)].last_beat == 0);
+
+    assert(zc_watchdog_attach(NULL) == ZC_INTERNAL_OK && g_watchdog == NULL);
+    printf("  Passed send heartbeat test\n");
+    free(wd);
+}
+
+int main() {
+    printf("Starting watchdog unit tests...\n\n");
+
+    test_zc_heartbeat_slot_index();
+    test_zc_watchdog_timeout();
+    test_zc_watchdog_unwatch();
+    test_zc_send_heartbeat();
+
+    printf("\nAll watchdog unit tests passed!\n");
+    return 0;
+}
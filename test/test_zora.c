@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/zora/zora.h"
+
+static zc_reader_id_t make_reader_id(zc_writer_id_t writer_id, uint32_t reader_idx)
+{
+    return ((zc_reader_id_t)writer_id << 32) | reader_idx;
+}
+
+// 测试注册与重复注册
+void test_zora_register() {
+    printf("Testing zora_register_writer...\n");
+
+    int workspace;
+    assert(zora_register_writer(ZC_MAX_WRITERS, &workspace, 1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zora_register_writer(3, &workspace, 0x1111) == ZC_INTERNAL_OK);
+    assert(zora_tls_cache.magic == ZORA_CACHE_MAGIC);
+    assert(zora_tls_cache.workspace == &workspace);
+    assert(zora_tls_is_writer(3));
+    assert(!zora_tls_is_writer(4));
+    assert(!zora_tls_is_reader(make_reader_id(3, 0)));
+
+    // 当前线程已注册
+    assert(zora_register_reader(make_reader_id(3, 0), &workspace, 1) == ZC_INTERNAL_PARAM_ERROR);
+
+    assert(zora_unregister_writer(4) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zora_unregister_writer(3) == ZC_INTERNAL_OK);
+    assert(!zora_tls_is_writer(3));
+
+    assert(zora_register_reader(make_reader_id(3, ZC_MAX_READERS_PER), &workspace, 1) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zora_register_reader(make_reader_id(3, 1), &workspace, 1) == ZC_INTERNAL_OK);
+    assert(zora_tls_is_reader(make_reader_id(3, 1)));
+    assert(zora_unregister_reader(make_reader_id(3, 1)) == ZC_INTERNAL_OK);
+
+    printf("  Passed register test\n");
+}
+
+// 测试 TLS 加解密与版本号
+void test_zora_tls_encode_decode() {
+    printf("Testing zora_tls_encode / zora_tls_decode...\n");
+
+    void* original_ptr = (void*)0x00007F123456A000;
+    uint64_t key = 0xFEDCBA9876543210;
+    assert(zora_register_writer(1, NULL, key) == ZC_INTERNAL_OK);
+
+    zc_handle_t handle;
+    zora_tls_encode(original_ptr, &handle);
+
+    // 与显式传入密钥的接口结果一致
+    zc_handle_t expected;
+    assert(zora_encrypt_handle(original_ptr, key, 0, &expected) == ZC_INTERNAL_OK);
+    assert(handle.address == expected.address);
+    assert(handle.version == expected.version);
+
+    void* decoded = NULL;
+    assert(zora_tls_decode(handle, &decoded) == ZC_INTERNAL_OK);
+    assert(decoded == original_ptr);
+
+    // commit / cancel / release 之后旧句柄失效
+    assert(!zora_tls_advance());
+    assert(zora_tls_decode(handle, &decoded) == ZC_INTERNAL_ZORA_UNEXPECTVERSION);
+
+    zora_tls_encode(original_ptr, &handle);
+    assert(zora_tls_decode(handle, &decoded) == ZC_INTERNAL_OK);
+    assert(decoded == original_ptr);
+
+    assert(zora_unregister_writer(1) == ZC_INTERNAL_OK);
+
+    printf("  Passed encode / decode test\n");
+}
+
+// 测试密钥轮换延迟生效
+void test_zora_key_rotation() {
+    printf("Testing zora key rotation...\n");
+
+    void* original_ptr = (void*)0x00007F123456B000;
+    uint64_t old_key = 0x0123456789ABCDEF;
+    uint64_t new_key = 0xA5A5A5A55A5A5A5A;
+
+    zc_reader_id_t reader_id = make_reader_id(2, 4);
+    assert(zora_post_key_to_reader(reader_id, new_key) == ZC_INTERNAL_RUN_NOT_INITIALIZED);
+    assert(zora_register_reader(reader_id, NULL, old_key) == ZC_INTERNAL_OK);
+
+    zc_handle_t handle;
+    zora_tls_encode(original_ptr, &handle);
+
+    // 投递后在 advance 之前不生效
+    assert(zora_post_key_to_reader(reader_id, new_key) == ZC_INTERNAL_OK);
+    assert(zora_tls_cache.encryption_key == old_key);
+    void* decoded = NULL;
+    assert(zora_tls_decode(handle, &decoded) == ZC_INTERNAL_OK);
+    assert(decoded == original_ptr);
+
+    assert(zora_tls_advance());
+    assert(zora_tls_cache.encryption_key == new_key);
+    assert(!zora_tls_advance());
+
+    // 0 表示信箱为空，不可投递；多次投递以最后一次为准
+    assert(zora_post_key_to_reader(reader_id, 0) == ZC_INTERNAL_PARAM_ERROR);
+    assert(zora_post_key_to_reader(reader_id, old_key) == ZC_INTERNAL_OK);
+    assert(zora_post_key_to_reader(reader_id, new_key) == ZC_INTERNAL_OK);
+    assert(zora_tls_advance());
+    assert(zora_tls_cache.encryption_key == new_key);
+
+    zora_tls_encode(original_ptr, &handle);
+    assert(zora_tls_decode(handle, &decoded) == ZC_INTERNAL_OK);
+    assert(decoded == original_ptr);
+
+    // 未取走的密钥不留给下一个注册者
+    assert(zora_post_key_to_reader(reader_id, old_key) == ZC_INTERNAL_OK);
+    assert(zora_unregister_reader(reader_id) == ZC_INTERNAL_OK);
+    assert(zora_tls_cache.mailbox == NULL);
+    assert(!zora_tls_advance());
+    assert(zora_post_key_to_reader(reader_id, old_key) == ZC_INTERNAL_RUN_NOT_INITIALIZED);
+    assert(zora_register_reader(reader_id, NULL, new_key) == ZC_INTERNAL_OK);
+    assert(!zora_tls_advance());
+    assert(zora_tls_cache.encryption_key == new_key);
+
+    assert(zora_unregister_reader(reader_id) == ZC_INTERNAL_OK);
+
+    printf("  Passed key rotation test\n");
+}
+
+int main() {
+    printf("Starting Zora thread cache tests...\n");
+
+    test_zora_register();
+    test_zora_tls_encode_decode();
+    test_zora_key_rotation();
+
+    printf("All Zora thread cache tests passed!\n");
+    return 0;
+}